@@ -0,0 +1,198 @@
+// contadores.cpp
+// Runtime dos contadores por função de `jp build -contadores` (Linux)
+//
+// Compilar:
+//   Linux:   g++ -c -fPIC -O2 -fno-exceptions -o runtime/contadores.o runtime/contadores.cpp
+//
+// O codegen injeta, em toda função, método e no main:
+//   entrada  → __jp_cont_entrar(&contador_da_funcao)   (depois de salvar params)
+//   saída    → __jp_cont_sair()                        (antes de cada epílogo)
+// e os contadores ficam numa tabela em .data (ver codegen_contadores.hpp):
+//
+//   cabeçalho  magica "JPCT", versao, n, reservado
+//   n × { chamadas, inclusivo, exclusivo (u64, ciclos rdtsc),
+//         profundidade (u32), nome (i32, PC32 → "funcao (arquivo.jp:linha)") }
+//
+// Inclusivo só soma na chamada mais externa de uma recursão; exclusivo é o
+// tempo da própria função menos o das chamadas JP feitas por ela. Código
+// nativo (FFI, libc) conta como tempo da função JP que o chamou.
+//
+// Relatório no stderr ao sair, ou no arquivo da variável JP_CONTADORES.
+// Só usa libc (nada de libstdc++), para o linkador embutido aceitar o objeto.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <x86intrin.h>
+
+extern "C" int __cxa_atexit(void (*func)(void*), void* arg, void* dso_handle);
+
+namespace {
+
+constexpr uint32_t CONT_MAGICA = 0x5443504A;   // "JPCT"
+constexpr uint32_t CONT_VERSAO = 1;
+
+struct Cabecalho {
+    uint32_t magica;
+    uint32_t versao;
+    uint32_t n;
+    uint32_t reservado;
+};
+
+struct Contador {
+    uint64_t chamadas;
+    uint64_t inclusivo;
+    uint64_t exclusivo;
+    uint32_t profundidade;
+    int32_t  nome;
+};
+
+struct Quadro {
+    Contador* contador;
+    uint64_t  inicio;
+    uint64_t  filhos;         // ciclos das chamadas JP feitas neste quadro
+};
+
+// =============================================================================
+// ESTADO
+// =============================================================================
+
+constexpr uint32_t MAX_QUADROS = 1u << 16;
+
+Cabecalho* g_tabela = nullptr;
+Quadro     g_pilha[MAX_QUADROS];
+uint32_t   g_topo = 0;          // pode passar de MAX_QUADROS (só conta chamadas)
+uint64_t   g_custo = 0;         // ciclos de um par entrar/sair vazio
+bool       g_estourou = false;  // recursão passou de MAX_QUADROS
+
+Contador* contador(uint32_t i) {
+    return reinterpret_cast<Contador*>(g_tabela + 1) + i;
+}
+
+const char* nome(const Contador* c) {
+    return reinterpret_cast<const char*>(&c->nome) + c->nome;
+}
+
+// =============================================================================
+// GANCHOS
+// =============================================================================
+
+inline void entrar(Contador* c) {
+    uint64_t t = __rdtsc();
+    c->chamadas++;
+    c->profundidade++;
+    if (g_topo < MAX_QUADROS) g_pilha[g_topo] = {c, t, 0};
+    else g_estourou = true;
+    g_topo++;
+}
+
+inline void sair(uint64_t t) {
+    if (g_topo == 0) return;
+    g_topo--;
+    if (g_topo >= MAX_QUADROS) return;
+    Quadro& q = g_pilha[g_topo];
+    uint64_t decorrido = t - q.inicio;
+    Contador* c = q.contador;
+    c->exclusivo += decorrido - q.filhos;
+    if (--c->profundidade == 0) c->inclusivo += decorrido;
+    if (g_topo > 0) g_pilha[g_topo - 1].filhos += decorrido;
+}
+
+// =============================================================================
+// RELATÓRIO
+// =============================================================================
+
+int comparar(const void* a, const void* b) {
+    uint64_t x = (*static_cast<Contador* const*>(a))->exclusivo;
+    uint64_t y = (*static_cast<Contador* const*>(b))->exclusivo;
+    return x < y ? 1 : (x > y ? -1 : 0);
+}
+
+void relatorio(void*) {
+    // sair()/exit no meio de funções: fecha os quadros ainda abertos
+    uint64_t agora = __rdtsc();
+    while (g_topo > 0) sair(agora);
+
+    uint32_t n = g_tabela->n;
+    Contador** ordem = static_cast<Contador**>(calloc(n + 1, sizeof(Contador*)));
+    if (!ordem) return;
+    uint64_t total = 0;
+    uint32_t usados = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        Contador* c = contador(i);
+        total += c->exclusivo;
+        if (c->chamadas) ordem[usados++] = c;
+    }
+    qsort(ordem, usados, sizeof(Contador*), comparar);
+
+    const char* caminho = getenv("JP_CONTADORES");
+    FILE* out = (caminho && *caminho) ? fopen(caminho, "w") : nullptr;
+    if (caminho && *caminho && !out) {
+        fprintf(stderr, "[JP CONTADORES] nao foi possivel gravar %s\n", caminho);
+    }
+    if (!out) out = stderr;
+
+    double pct = total ? 100.0 / static_cast<double>(total) : 0.0;
+    fprintf(out, "\n[JP CONTADORES] %llu ciclos (rdtsc); cada chamada inclui ~%llu ciclos de instrumentacao\n",
+            static_cast<unsigned long long>(total), static_cast<unsigned long long>(g_custo));
+    fprintf(out, "%12s %12s %12s %16s %6s %16s %6s  %s\n", "chamadas", "incl/chamada",
+            "excl/chamada", "inclusivo", "%", "exclusivo", "%", "funcao");
+    for (uint32_t i = 0; i < usados; i++) {
+        const Contador* c = ordem[i];
+        fprintf(out, "%12llu %12llu %12llu %16llu %6.1f %16llu %6.1f  %s\n",
+                static_cast<unsigned long long>(c->chamadas),
+                static_cast<unsigned long long>(c->inclusivo / c->chamadas),
+                static_cast<unsigned long long>(c->exclusivo / c->chamadas),
+                static_cast<unsigned long long>(c->inclusivo), c->inclusivo * pct,
+                static_cast<unsigned long long>(c->exclusivo), c->exclusivo * pct,
+                nome(c));
+    }
+    if (g_estourou) {
+        fprintf(out, "(recursao acima de %u quadros: tempos parciais)\n", MAX_QUADROS);
+    }
+    if (out != stderr) fclose(out);
+    free(ordem);
+}
+
+} // namespace
+
+// =============================================================================
+// ENTRADA — chamadas pelo código gerado
+// =============================================================================
+
+extern "C" __attribute__((visibility("default")))
+void __jp_cont_entrar(void* c) {
+    entrar(static_cast<Contador*>(c));
+}
+
+extern "C" __attribute__((visibility("default")))
+void __jp_cont_sair() {
+    sair(__rdtsc());
+}
+
+// Chamada pelo main antes do próprio gancho de entrada
+extern "C" __attribute__((visibility("default")))
+void __jp_cont_iniciar(void* tabela) {
+    Cabecalho* t = static_cast<Cabecalho*>(tabela);
+    if (!t || t->magica != CONT_MAGICA || t->versao != CONT_VERSAO) {
+        fprintf(stderr, "[JP CONTADORES] tabela invalida, contadores desligados\n");
+        return;
+    }
+
+    // Custo de um par de ganchos, para o leitor descontar em funções curtas
+    Contador vazio;
+    memset(&vazio, 0, sizeof(vazio));
+    uint64_t melhor = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t t0 = __rdtsc();
+        __jp_cont_entrar(&vazio);
+        __jp_cont_sair();
+        uint64_t d = __rdtsc() - t0;
+        if (d < melhor) melhor = d;
+    }
+    g_custo = melhor;
+
+    g_tabela = t;
+    __cxa_atexit(relatorio, nullptr, nullptr);
+}
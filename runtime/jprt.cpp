@@ -0,0 +1,144 @@
+// jprt.cpp
+// Runtime de suporte do código gerado (Linux): operações grandes ou frias
+// que o codegen expandia em cada uso viram chamadas para cá
+//
+// Compilar:
+//   Linux:   g++ -c -fPIC -O2 -fno-exceptions -mstackrealign -ffunction-sections -o runtime/jprt.o runtime/jprt.cpp
+//
+// Entra em todo build Linux quando runtime/jprt.o existe (ao lado do jp ou
+// no diretório atual, ver localizar_objeto_runtime); sem ele o codegen
+// continua gerando tudo inline. O que fica inline é só o caminho quente:
+// lista[i], .tamanho() e a escrita do .adicionar() quando há capacidade.
+//
+//   __jp_lista_crescer(l)         .adicionar() sem capacidade: dobra os dados
+//   __jp_lista_remover(l, i)      .remover(i): memmove + tamanho--
+//   __jp_lista_exibir(l, tipo)    .exibir() / saida(lista)
+//   __jp_texto_int(v)             texto(inteiro), inteiro + texto
+//   __jp_texto_float(v)           texto(decimal), decimal + texto
+//   __jp_concat(a, b)             texto + texto
+//
+// Lista (Linux, ver codegen_listas.hpp): { dados, tamanho, capacidade },
+// elementos de 8 bytes. Uma lista no frame (codegen_escape.hpp) tem os
+// dados logo depois do header: crescer copia para o heap em vez de realloc.
+//
+// A saída é a mesma dos printf que o código inline fazia ("%d" nos
+// inteiros da lista, "%g" nos decimais, "%lld" em texto()). O código
+// gerado pode chamar com a pilha fora do alinhamento de 16 (operando
+// empilhado no meio de uma expressão): -mstackrealign realinha aqui.
+// Só usa libc (nada de libstdc++), para o linkador embutido aceitar o objeto.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Lista {
+    int64_t* dados;
+    int64_t  tamanho;
+    int64_t  capacidade;
+};
+
+enum TipoElemento : int64_t { ELEM_INT = 0, ELEM_FLOAT = 1, ELEM_TEXTO = 2 };
+
+// Dígitos de v no fim de buf; devolve o início
+char* formatar_int(int64_t v, char* fim) {
+    uint64_t u = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+    char* p = fim;
+    do {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) *--p = '-';
+    return p;
+}
+
+char* copia_heap(const char* s, size_t n, size_t minimo) {
+    char* r = static_cast<char*>(malloc(n + 1 > minimo ? n + 1 : minimo));
+    memcpy(r, s, n);
+    r[n] = '\0';
+    return r;
+}
+
+} // namespace
+
+// =============================================================================
+// LISTAS
+// =============================================================================
+
+extern "C" __attribute__((visibility("default")))
+void __jp_lista_crescer(Lista* l) {
+    size_t bytes = static_cast<size_t>(l->capacidade) * 16;
+    int64_t* dados;
+    if (l->dados == reinterpret_cast<int64_t*>(l + 1)) {
+        dados = static_cast<int64_t*>(malloc(bytes));
+        memcpy(dados, l->dados, static_cast<size_t>(l->tamanho) * 8);
+    } else {
+        dados = static_cast<int64_t*>(realloc(l->dados, bytes));
+    }
+    l->dados = dados;
+    l->capacidade *= 2;
+}
+
+extern "C" __attribute__((visibility("default")))
+void __jp_lista_remover(Lista* l, int64_t i) {
+    memmove(l->dados + i, l->dados + i + 1,
+            static_cast<size_t>(l->tamanho - i - 1) * 8);
+    l->tamanho--;
+}
+
+extern "C" __attribute__((visibility("default")))
+void __jp_lista_exibir(const Lista* l, int64_t tipo) {
+    char buf[32];
+    flockfile(stdout);
+    putc_unlocked('[', stdout);
+    for (int64_t i = 0; i < l->tamanho; i++) {
+        if (i > 0) fputs_unlocked(", ", stdout);
+        int64_t v = l->dados[i];
+        if (tipo == ELEM_TEXTO) {
+            const char* s = reinterpret_cast<const char*>(v);
+            fputs_unlocked(s ? s : "(null)", stdout);
+        } else if (tipo == ELEM_FLOAT) {
+            double d;
+            memcpy(&d, &v, sizeof(d));
+            int n = snprintf(buf, sizeof(buf), "%g", d);
+            fwrite_unlocked(buf, 1, static_cast<size_t>(n), stdout);
+        } else {
+            char* fim = buf + sizeof(buf);
+            char* p = formatar_int(static_cast<int32_t>(v), fim);
+            fwrite_unlocked(p, 1, static_cast<size_t>(fim - p), stdout);
+        }
+    }
+    fputs_unlocked("]\n", stdout);
+    funlockfile(stdout);
+}
+
+// =============================================================================
+// TEXTO
+// =============================================================================
+
+extern "C" __attribute__((visibility("default")))
+char* __jp_texto_int(int64_t v) {
+    char buf[24];
+    char* fim = buf + sizeof(buf);
+    char* p = formatar_int(v, fim);
+    return copia_heap(p, static_cast<size_t>(fim - p), 32);
+}
+
+extern "C" __attribute__((visibility("default")))
+char* __jp_texto_float(double v) {
+    char* r = static_cast<char*>(malloc(64));
+    snprintf(r, 64, "%g", v);
+    return r;
+}
+
+extern "C" __attribute__((visibility("default")))
+char* __jp_concat(const char* a, const char* b) {
+    size_t na = strlen(a);
+    size_t nb = strlen(b);
+    char* r = static_cast<char*>(malloc(na + nb + 1));
+    memcpy(r, a, na);
+    memcpy(r + na, b, nb + 1);
+    return r;
+}
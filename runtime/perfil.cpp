@@ -0,0 +1,428 @@
+// perfil.cpp
+// Runtime do perfilador por amostragem de `jp build -perfil` (Linux)
+//
+// Compilar:
+//   Linux:   g++ -c -fPIC -O2 -fno-exceptions -fno-omit-frame-pointer -o runtime/perfil.o runtime/perfil.cpp
+//
+// O main gerado chama __jp_perfil_iniciar(&tabela) logo depois do prólogo.
+// A tabela (em .rodata, montada pelo codegen — ver codegen_perfil.hpp) tem
+// o intervalo e o nome de cada função JP, as linhas por offset em .text e
+// os símbolos das bibliotecas nativas estáticas chamadas pelo programa.
+//
+//   - setitimer(ITIMER_PROF) pede SIGPROF a cada 1 ms de CPU (o kernel
+//     arredonda para o tick do relógio)
+//   - o handler lê RIP/RSP/RBP do ucontext e segue a cadeia de RBP
+//     (todo frame JP começa com push rbp; mov rbp, rsp) até o frame do main
+//   - pilhas iguais são contadas numa tabela hash fixa (sem malloc no handler)
+//   - na saída os endereços viram "funcao (arquivo.jp:linha)" e as pilhas
+//     são gravadas em jp-perfil.folded, uma por linha: "a;b;c N"
+//
+// Frames fora do código JP: .jpd e libc aparecem como "simbolo [lib.so]"
+// via dladdr; bibliotecas estáticas como "simbolo [biblioteca]" pela tabela.
+//
+// Só usa libc (nada de libstdc++), para o linkador embutido aceitar o objeto.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <dlfcn.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+
+extern "C" int __cxa_atexit(void (*func)(void*), void* arg, void* dso_handle);
+
+// =============================================================================
+// TABELA GERADA PELO CODEGEN
+// =============================================================================
+
+namespace {
+
+constexpr uint32_t PERFIL_MAGICA = 0x4650504A;   // "JPPF"
+constexpr uint32_t PERFIL_VERSAO = 1;
+
+struct Cabecalho {
+    uint32_t magica;
+    uint32_t versao;
+    int32_t  text;           // PC32: &text + text = início do .text JP
+    uint32_t tamanho_text;
+    uint32_t n_funcoes;
+    uint32_t n_linhas;
+    uint32_t n_nativas;
+    uint32_t reservado;
+};
+
+struct Funcao {              // ordenadas por inicio
+    uint32_t inicio;
+    uint32_t fim;
+    uint32_t nome;           // offsets de string: relativos ao cabeçalho
+    uint32_t arquivo;
+};
+
+struct Linha {               // ordenadas por offset
+    uint32_t offset;
+    uint32_t linha;
+};
+
+struct Nativa {
+    int32_t  endereco;       // PC32 para o símbolo
+    uint32_t nome;
+    uint32_t biblioteca;
+};
+
+struct NativaResolvida {
+    uintptr_t endereco;
+    const char* nome;
+    const char* biblioteca;
+};
+
+// =============================================================================
+// ESTADO
+// =============================================================================
+
+constexpr int      PROFUNDIDADE = 128;
+constexpr uint32_t SLOTS        = 2048;          // potência de 2
+constexpr long     INTERVALO_US = 1000;
+
+struct Pilha {
+    uint64_t hash;
+    uint32_t n;
+    uint32_t contagem;
+    uintptr_t frames[PROFUNDIDADE];
+};
+
+const Cabecalho* g_tabela = nullptr;
+const Funcao*    g_funcoes = nullptr;
+const Linha*     g_linhas = nullptr;
+uintptr_t        g_text = 0;
+uintptr_t        g_topo = 0;                     // RBP do main
+long             g_tid = 0;
+double           g_cpu_inicio = 0;               // ms
+
+NativaResolvida* g_nativas = nullptr;
+uint32_t         g_n_nativas = 0;
+
+Pilha            g_pilhas[SLOTS];
+volatile uint32_t g_amostras = 0;
+volatile uint32_t g_perdidas = 0;                // tabela cheia
+volatile uint32_t g_truncadas = 0;               // mais fundas que PROFUNDIDADE
+volatile sig_atomic_t g_ativo = 0;
+
+double cpu_ms() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+const char* texto(uint32_t off) {
+    return reinterpret_cast<const char*>(g_tabela) + off;
+}
+
+bool no_text(uintptr_t a) {
+    return a >= g_text && a < g_text + g_tabela->tamanho_text;
+}
+
+// Endereço logo depois de um call rel32 dentro do .text JP
+bool retorno_jp(uintptr_t a) {
+    return a >= g_text + 5 && no_text(a) &&
+           *reinterpret_cast<const uint8_t*>(a - 5) == 0xE8;
+}
+
+const Funcao* funcao_de(uintptr_t a) {
+    if (!no_text(a)) return nullptr;
+    uint32_t off = static_cast<uint32_t>(a - g_text);
+    uint32_t lo = 0, hi = g_tabela->n_funcoes;
+    while (lo < hi) {
+        uint32_t m = (lo + hi) / 2;
+        if (g_funcoes[m].inicio <= off) lo = m + 1; else hi = m;
+    }
+    if (lo == 0) return nullptr;
+    const Funcao* f = &g_funcoes[lo - 1];
+    return off < f->fim ? f : nullptr;
+}
+
+uint32_t linha_de(uintptr_t a) {
+    uint32_t off = static_cast<uint32_t>(a - g_text);
+    uint32_t lo = 0, hi = g_tabela->n_linhas;
+    while (lo < hi) {
+        uint32_t m = (lo + hi) / 2;
+        if (g_linhas[m].offset <= off) lo = m + 1; else hi = m;
+    }
+    return lo ? g_linhas[lo - 1].linha : 0;
+}
+
+// =============================================================================
+// AMOSTRAGEM (handler de SIGPROF)
+// =============================================================================
+
+void registrar(const uintptr_t* frames, uint32_t n) {
+    uint64_t h = 1469598103934665603ull;
+    for (uint32_t i = 0; i < n; i++) {
+        h ^= frames[i];
+        h *= 1099511628211ull;
+    }
+    h |= 1;                                      // 0 = slot livre
+    for (uint32_t k = 0; k < SLOTS; k++) {
+        Pilha& p = g_pilhas[(h + k) & (SLOTS - 1)];
+        if (p.hash == 0) {
+            p.hash = h;
+            p.n = n;
+            p.contagem = 1;
+            memcpy(p.frames, frames, n * sizeof(uintptr_t));
+            return;
+        }
+        if (p.hash == h && p.n == n &&
+            memcmp(p.frames, frames, n * sizeof(uintptr_t)) == 0) {
+            p.contagem++;
+            return;
+        }
+    }
+    g_perdidas = g_perdidas + 1;
+}
+
+void ao_sinal(int, siginfo_t*, void* ctx) {
+    if (!g_ativo) return;
+    g_amostras = g_amostras + 1;
+
+    const mcontext_t& mc = static_cast<ucontext_t*>(ctx)->uc_mcontext;
+    uintptr_t rip = static_cast<uintptr_t>(mc.gregs[REG_RIP]);
+    uintptr_t sp  = static_cast<uintptr_t>(mc.gregs[REG_RSP]);
+    uintptr_t fp  = static_cast<uintptr_t>(mc.gregs[REG_RBP]);
+
+    uintptr_t frames[PROFUNDIDADE];
+    uint32_t n = 0;
+    frames[n++] = rip;
+
+    // Outras threads: a pilha não é a do main, só o RIP é confiável
+    if (syscall(SYS_gettid) != g_tid) {
+        registrar(frames, n);
+        return;
+    }
+
+    if (const Funcao* f = funcao_de(rip)) {
+        // Prólogo ainda não montou o frame: o chamador está em [rsp]
+        uint32_t off = static_cast<uint32_t>(rip - g_text);
+        if (off == f->inicio)          frames[n++] = *reinterpret_cast<uintptr_t*>(sp);
+        else if (off == f->inicio + 1) frames[n++] = *reinterpret_cast<uintptr_t*>(sp + 8);
+    } else if (sp < g_topo) {
+        // Código nativo (RBP pode ser registrador comum): o primeiro
+        // endereço de retorno para o .text JP na pilha é o da chamada FFI;
+        // acima dele, o primeiro par (rbp salvo, retorno JP) é o frame do
+        // chamador JP. Heurística — basta para atribuir a amostra.
+        fp = g_topo;
+        for (uintptr_t p = sp; p < g_topo; p += 8) {
+            uintptr_t v = *reinterpret_cast<uintptr_t*>(p);
+            if (!retorno_jp(v)) continue;
+            frames[n++] = v;
+            for (uintptr_t q = p + 8; q < g_topo; q += 8) {
+                uintptr_t salvo = *reinterpret_cast<uintptr_t*>(q);
+                if (salvo > q && salvo <= g_topo && (salvo & 7) == 0 &&
+                    retorno_jp(*reinterpret_cast<uintptr_t*>(q + 8))) {
+                    fp = q;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    while (fp >= sp && fp <= g_topo && (fp & 7) == 0 && fp != g_topo) {
+        if (n == PROFUNDIDADE) {
+            g_truncadas = g_truncadas + 1;
+            break;
+        }
+        uintptr_t ret  = reinterpret_cast<uintptr_t*>(fp)[1];
+        uintptr_t prox = reinterpret_cast<uintptr_t*>(fp)[0];
+        frames[n++] = ret;
+        if (prox <= fp) break;
+        fp = prox;
+    }
+    registrar(frames, n);
+}
+
+// =============================================================================
+// RESOLUÇÃO E SAÍDA
+// =============================================================================
+
+const char* base_nome(const char* caminho) {
+    const char* b = strrchr(caminho, '/');
+    return b ? b + 1 : caminho;
+}
+
+int comparar_nativas(const void* a, const void* b) {
+    uintptr_t x = static_cast<const NativaResolvida*>(a)->endereco;
+    uintptr_t y = static_cast<const NativaResolvida*>(b)->endereco;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Nome de um frame; `exato` = RIP da amostra, senão endereço de retorno
+void nome_frame(uintptr_t a, bool exato, char* buf, size_t tam) {
+    uintptr_t alvo = exato ? a : a - 1;
+
+    if (const Funcao* f = funcao_de(alvo)) {
+        snprintf(buf, tam, "%s (%s:%u)", texto(f->nome), texto(f->arquivo), linha_de(alvo));
+        return;
+    }
+    if (no_text(alvo)) {
+        snprintf(buf, tam, "[jp]");
+        return;
+    }
+
+    // Bibliotecas dinâmicas (.jpd, libc): símbolo exportado mais próximo
+    Dl_info info;
+    Dl_info proprio;
+    if (dladdr(reinterpret_cast<void*>(alvo), &info) && info.dli_fname &&
+        dladdr(g_tabela, &proprio) &&
+        info.dli_fbase != proprio.dli_fbase) {
+        if (info.dli_sname) snprintf(buf, tam, "%s [%s]", info.dli_sname, base_nome(info.dli_fname));
+        else                snprintf(buf, tam, "[%s]", base_nome(info.dli_fname));
+        return;
+    }
+
+    // Bibliotecas estáticas: símbolo da tabela imediatamente anterior
+    uint32_t lo = 0, hi = g_n_nativas;
+    while (lo < hi) {
+        uint32_t m = (lo + hi) / 2;
+        if (g_nativas[m].endereco <= alvo) lo = m + 1; else hi = m;
+    }
+    if (lo > 0 && alvo - g_nativas[lo - 1].endereco < 0x10000) {
+        snprintf(buf, tam, "%s [%s]", g_nativas[lo - 1].nome, g_nativas[lo - 1].biblioteca);
+        return;
+    }
+    snprintf(buf, tam, "[nativo]");
+}
+
+struct Linha_saida {
+    char* pilha;
+    uint32_t contagem;
+};
+
+int comparar_saida(const void* a, const void* b) {
+    return strcmp(static_cast<const Linha_saida*>(a)->pilha,
+                  static_cast<const Linha_saida*>(b)->pilha);
+}
+
+void ao_sair(void*) {
+    if (!g_ativo) return;
+    g_ativo = 0;
+    itimerval zero;
+    memset(&zero, 0, sizeof(zero));
+    setitimer(ITIMER_PROF, &zero, nullptr);
+    double cpu = cpu_ms() - g_cpu_inicio;
+
+    // Uma linha por pilha distinta: frames da raiz para a folha
+    Linha_saida* linhas = static_cast<Linha_saida*>(calloc(SLOTS, sizeof(Linha_saida)));
+    uint32_t n_linhas = 0;
+    char frame[512];
+    for (uint32_t s = 0; linhas && s < SLOTS; s++) {
+        const Pilha& p = g_pilhas[s];
+        if (p.hash == 0) continue;
+        size_t cap = 256, len = 0;
+        char* txt = static_cast<char*>(malloc(cap));
+        if (!txt) break;
+        txt[0] = '\0';
+        for (uint32_t i = p.n; i-- > 0;) {
+            nome_frame(p.frames[i], i == 0, frame, sizeof(frame));
+            for (char* c = frame; *c; c++) if (*c == ';') *c = ':';
+            size_t fl = strlen(frame);
+            if (len + fl + 2 > cap) {
+                while (len + fl + 2 > cap) cap *= 2;
+                char* novo = static_cast<char*>(realloc(txt, cap));
+                if (!novo) break;
+                txt = novo;
+            }
+            if (len) txt[len++] = ';';
+            memcpy(txt + len, frame, fl + 1);
+            len += fl;
+        }
+        linhas[n_linhas++] = {txt, p.contagem};
+    }
+
+    // Endereços diferentes podem dar o mesmo texto (mesma linha)
+    qsort(linhas, n_linhas, sizeof(Linha_saida), comparar_saida);
+
+    const char* caminho = "jp-perfil.folded";
+    FILE* out = fopen(caminho, "w");
+    if (!out) {
+        fprintf(stderr, "[JP PERFIL] nao foi possivel gravar %s\n", caminho);
+        return;
+    }
+    for (uint32_t i = 0; i < n_linhas;) {
+        uint32_t j = i;
+        uint64_t total = 0;
+        while (j < n_linhas && strcmp(linhas[j].pilha, linhas[i].pilha) == 0) {
+            total += linhas[j].contagem;
+            j++;
+        }
+        fprintf(out, "%s %llu\n", linhas[i].pilha, static_cast<unsigned long long>(total));
+        for (uint32_t k = i; k < j; k++) free(linhas[k].pilha);
+        i = j;
+    }
+    fclose(out);
+    free(linhas);
+
+    // O kernel entrega SIGPROF no tick do relógio: com HZ=250 são ~4 ms
+    // por amostra, não 1 ms
+    fprintf(stderr, "[JP PERFIL] %u amostras em %.1f ms de CPU -> %s",
+            g_amostras, cpu, caminho);
+    if (g_perdidas) fprintf(stderr, ", %u descartadas (tabela cheia)", g_perdidas);
+    if (g_truncadas) fprintf(stderr, ", %u pilhas truncadas", g_truncadas);
+    fprintf(stderr, "\n");
+}
+
+} // namespace
+
+// =============================================================================
+// ENTRADA — chamada pelo main gerado
+// =============================================================================
+
+extern "C" __attribute__((visibility("default")))
+void __jp_perfil_iniciar(const void* tabela) {
+    const Cabecalho* t = static_cast<const Cabecalho*>(tabela);
+    if (!t || t->magica != PERFIL_MAGICA || t->versao != PERFIL_VERSAO) {
+        fprintf(stderr, "[JP PERFIL] tabela de enderecos invalida, perfil desligado\n");
+        return;
+    }
+    g_tabela = t;
+    g_text = reinterpret_cast<uintptr_t>(&t->text) + static_cast<intptr_t>(t->text);
+    g_funcoes = reinterpret_cast<const Funcao*>(t + 1);
+    g_linhas = reinterpret_cast<const Linha*>(g_funcoes + t->n_funcoes);
+    // Compilado com frame pointer: [rbp] deste frame é o RBP do main
+    g_topo = *static_cast<uintptr_t*>(__builtin_frame_address(0));
+    g_tid = syscall(SYS_gettid);
+
+    // Endereços das nativas estáticas, ordenados para busca binária
+    const Nativa* nat = reinterpret_cast<const Nativa*>(g_linhas + t->n_linhas);
+    g_nativas = static_cast<NativaResolvida*>(calloc(t->n_nativas + 1, sizeof(NativaResolvida)));
+    if (g_nativas) {
+        for (uint32_t i = 0; i < t->n_nativas; i++) {
+            g_nativas[i].endereco = reinterpret_cast<uintptr_t>(&nat[i].endereco) +
+                                    static_cast<intptr_t>(nat[i].endereco);
+            g_nativas[i].nome = texto(nat[i].nome);
+            g_nativas[i].biblioteca = texto(nat[i].biblioteca);
+        }
+        g_n_nativas = t->n_nativas;
+        qsort(g_nativas, g_n_nativas, sizeof(NativaResolvida), comparar_nativas);
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = ao_sinal;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, nullptr) != 0) return;
+
+    __cxa_atexit(ao_sair, nullptr, nullptr);
+    g_cpu_inicio = cpu_ms();
+    g_ativo = 1;
+
+    itimerval it;
+    it.it_interval.tv_sec = 0;
+    it.it_interval.tv_usec = INTERVALO_US;
+    it.it_value = it.it_interval;
+    setitimer(ITIMER_PROF, &it, nullptr);
+}
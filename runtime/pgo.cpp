@@ -0,0 +1,168 @@
+// pgo.cpp
+// Runtime de `jp build -pgo-gerar` (Linux): grava o perfil .jpprof ao sair
+//
+// Compilar:
+//   Linux:   g++ -c -fPIC -O2 -fno-exceptions -o runtime/pgo.o runtime/pgo.cpp
+//
+// Os contadores são incrementados direto pelo código gerado
+// (inc qword [rip+contador]); este objeto só registra o atexit e, na
+// saída, escreve a tabela (ver codegen_pgo.hpp) no formato de src/pgo.hpp:
+//
+//   cabeçalho  magica "JPPG", versao, n, saida (i32, PC32 → "prog.jpprof")
+//   n × { contagem1, contagem2 (u64), chave (i32, PC32), reservado (u32) }
+//
+// Se o arquivo já existe as contagens são somadas às dele (várias
+// execuções de treino). JP_PGO=arquivo troca o destino.
+// Só usa libc (nada de libstdc++), para o linkador embutido aceitar o objeto.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" int __cxa_atexit(void (*func)(void*), void* arg, void* dso_handle);
+
+namespace {
+
+constexpr uint32_t PGO_MAGICA = 0x4750504A;   // "JPPG"
+constexpr uint32_t PGO_VERSAO = 1;
+
+struct Cabecalho {
+    uint32_t magica;
+    uint32_t versao;
+    uint32_t n;
+    int32_t  saida;
+};
+
+struct Ponto {
+    uint64_t c1;
+    uint64_t c2;
+    int32_t  chave;
+    uint32_t reservado;
+};
+
+struct Registro {
+    const char* chave;
+    uint64_t c1;
+    uint64_t c2;
+};
+
+const Cabecalho* g_tabela = nullptr;
+
+const char* texto(const int32_t* campo) {
+    return reinterpret_cast<const char*>(campo) + *campo;
+}
+
+int comparar(const void* a, const void* b) {
+    return strcmp(static_cast<const Registro*>(a)->chave,
+                  static_cast<const Registro*>(b)->chave);
+}
+
+// Lê o .jpprof existente; as chaves apontam para dentro de `buffer`
+size_t ler_existente(FILE* f, char*& buffer, Registro*& regs) {
+    fseek(f, 0, SEEK_END);
+    long tam = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (tam <= 0) return 0;
+    buffer = static_cast<char*>(malloc(static_cast<size_t>(tam) + 1));
+    if (!buffer) return 0;
+    size_t lido = fread(buffer, 1, static_cast<size_t>(tam), f);
+    buffer[lido] = '\0';
+
+    size_t linhas = 1;
+    for (size_t i = 0; i < lido; i++) linhas += buffer[i] == '\n';
+    regs = static_cast<Registro*>(calloc(linhas, sizeof(Registro)));
+    if (!regs) return 0;
+
+    size_t n = 0;
+    char* p = buffer;
+    while (*p) {
+        char* fim = strchr(p, '\n');
+        if (fim) *fim = '\0';
+        if (*p && *p != '#') {
+            // "<tipo> <local> <funcao> <c1> <c2>": chave = três primeiros campos
+            char* q = p;
+            for (int campos = 0; campos < 3 && q; campos++) {
+                q = strchr(q, ' ');
+                if (q && campos < 2) q++;
+            }
+            unsigned long long c1 = 0, c2 = 0;
+            if (q && sscanf(q + 1, "%llu %llu", &c1, &c2) == 2) {
+                *q = '\0';
+                regs[n++] = {p, c1, c2};
+            }
+        }
+        if (!fim) break;
+        p = fim + 1;
+    }
+    return n;
+}
+
+void gravar(void*) {
+    const char* caminho = getenv("JP_PGO");
+    if (!caminho || !*caminho) caminho = texto(&g_tabela->saida);
+
+    const Ponto* pontos = reinterpret_cast<const Ponto*>(g_tabela + 1);
+    uint32_t n = g_tabela->n;
+
+    char* buffer = nullptr;
+    Registro* antigos = nullptr;
+    size_t n_antigos = 0;
+    if (FILE* f = fopen(caminho, "r")) {
+        n_antigos = ler_existente(f, buffer, antigos);
+        fclose(f);
+    }
+    qsort(antigos, n_antigos, sizeof(Registro), comparar);
+
+    Registro* todos = static_cast<Registro*>(calloc(n_antigos + n + 1, sizeof(Registro)));
+    if (!todos) return;
+    if (n_antigos) memcpy(todos, antigos, n_antigos * sizeof(Registro));
+    size_t total = n_antigos;
+    for (uint32_t i = 0; i < n; i++) {
+        const Ponto& p = pontos[i];
+        if (p.c1 == 0 && p.c2 == 0) continue;
+        Registro chave = {texto(&p.chave), 0, 0};
+        Registro* r = static_cast<Registro*>(
+            bsearch(&chave, todos, n_antigos, sizeof(Registro), comparar));
+        if (r) {
+            r->c1 += p.c1;
+            r->c2 += p.c2;
+        } else {
+            todos[total++] = {chave.chave, p.c1, p.c2};
+        }
+    }
+    qsort(todos, total, sizeof(Registro), comparar);
+
+    FILE* out = fopen(caminho, "w");
+    if (!out) {
+        fprintf(stderr, "[JP PGO] nao foi possivel gravar %s\n", caminho);
+    } else {
+        fprintf(out, "# jpprof 1 — tipo arquivo:linha:ordinal funcao contagem1 contagem2\n");
+        for (size_t i = 0; i < total; i++) {
+            fprintf(out, "%s %llu %llu\n", todos[i].chave,
+                    static_cast<unsigned long long>(todos[i].c1),
+                    static_cast<unsigned long long>(todos[i].c2));
+        }
+        fclose(out);
+    }
+    free(todos);
+    free(antigos);
+    free(buffer);
+}
+
+} // namespace
+
+// =============================================================================
+// ENTRADA — chamada pelo main do programa instrumentado
+// =============================================================================
+
+extern "C" __attribute__((visibility("default")))
+void __jp_pgo_iniciar(void* tabela) {
+    const Cabecalho* t = static_cast<const Cabecalho*>(tabela);
+    if (!t || t->magica != PGO_MAGICA || t->versao != PGO_VERSAO) {
+        fprintf(stderr, "[JP PGO] tabela invalida, perfil nao sera gravado\n");
+        return;
+    }
+    g_tabela = t;
+    __cxa_atexit(gravar, nullptr, nullptr);
+}
@@ -0,0 +1,321 @@
+// dwarf_emitter.hpp
+// Seções DWARF 4 mínimas para o objeto ELF — tabela de linhas .jp e
+// extensão das funções, o suficiente para gdb (break arquivo.jp:N, bt)
+// e perf report/annotate atribuírem endereços a linhas e funções
+//
+//   .debug_abbrev   dois abbrevs: compile_unit e subprogram
+//   .debug_info     uma CU cobrindo todo o .text + um subprogram por função
+//   .debug_line     programa de linhas, uma sequência por seção de código
+//   .debug_aranges  intervalos de endereços da CU
+//   .debug_ranges   só com .text dividido por função: os trechos da CU
+//
+// Endereços e offsets entre seções saem como relocações (R_X86_64_64 e
+// R_X86_64_32): o ld concatena as seções de vários objetos e o linkador
+// embutido aplica as mesmas relocações ao copiar as seções.
+
+#ifndef JPLANG_DWARF_EMITTER_HPP
+#define JPLANG_DWARF_EMITTER_HPP
+
+#include "elf_emitter.hpp"
+#include "../depuracao.hpp"
+
+namespace jplang {
+
+// ============================================================================
+// CONSTANTES DWARF
+// ============================================================================
+
+constexpr uint8_t  DW_TAG_compile_unit  = 0x11;
+constexpr uint8_t  DW_TAG_subprogram    = 0x2E;
+constexpr uint8_t  DW_CHILDREN_no       = 0;
+constexpr uint8_t  DW_CHILDREN_yes      = 1;
+
+constexpr uint8_t  DW_AT_name           = 0x03;
+constexpr uint8_t  DW_AT_stmt_list      = 0x10;
+constexpr uint8_t  DW_AT_low_pc         = 0x11;
+constexpr uint8_t  DW_AT_high_pc        = 0x12;
+constexpr uint8_t  DW_AT_language       = 0x13;
+constexpr uint8_t  DW_AT_comp_dir       = 0x1B;
+constexpr uint8_t  DW_AT_producer       = 0x25;
+constexpr uint8_t  DW_AT_decl_file      = 0x3A;
+constexpr uint8_t  DW_AT_decl_line      = 0x3B;
+constexpr uint8_t  DW_AT_external       = 0x3F;
+constexpr uint8_t  DW_AT_ranges         = 0x55;
+
+constexpr uint8_t  DW_FORM_addr         = 0x01;
+constexpr uint8_t  DW_FORM_data2        = 0x05;
+constexpr uint8_t  DW_FORM_data8        = 0x07;
+constexpr uint8_t  DW_FORM_string       = 0x08;
+constexpr uint8_t  DW_FORM_udata        = 0x0F;
+constexpr uint8_t  DW_FORM_sec_offset   = 0x17;
+constexpr uint8_t  DW_FORM_flag_present = 0x19;
+
+// Não existe código de linguagem para JP; C99 faz o gdb mostrar nomes e
+// linhas sem tentar demangling
+constexpr uint16_t DW_LANG_C99          = 0x000C;
+
+constexpr uint8_t  DW_LNS_copy          = 1;
+constexpr uint8_t  DW_LNS_advance_pc    = 2;
+constexpr uint8_t  DW_LNS_advance_line  = 3;
+constexpr uint8_t  DW_LNS_set_file      = 4;
+constexpr uint8_t  DW_LNE_end_sequence  = 1;
+constexpr uint8_t  DW_LNE_set_address   = 2;
+
+// Parâmetros do programa de linhas (valores usuais do gcc)
+constexpr int8_t   DWARF_LINE_BASE   = -5;
+constexpr uint8_t  DWARF_LINE_RANGE  = 14;
+constexpr uint8_t  DWARF_OPCODE_BASE = 13;
+
+// ============================================================================
+// LEB128
+// ============================================================================
+
+inline void dwarf_uleb(Section& s, uint64_t v) {
+    do {
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        if (v) b |= 0x80;
+        s.emit_u8(b);
+    } while (v);
+}
+
+inline void dwarf_sleb(Section& s, int64_t v) {
+    bool mais = true;
+    while (mais) {
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        if ((v == 0 && !(b & 0x40)) || (v == -1 && (b & 0x40))) mais = false;
+        else b |= 0x80;
+        s.emit_u8(b);
+    }
+}
+
+// ============================================================================
+// EMISSÃO
+// ============================================================================
+
+// Cria as seções de depuração no emitter. Chamar depois de todo o código
+// emitido (usa o tamanho final de .text). Invalida referências a seções.
+// Com info.trechos (split_text_by_function), endereços saem relativos à
+// seção de cada trecho e a CU lista os trechos em .debug_ranges.
+inline void emit_dwarf(ElfEmitter& emitter, size_t text_idx, const InfoDepuracao& info) {
+    if (info.linhas.empty() && info.funcoes.empty()) return;
+
+    std::vector<TrechoDepuracao> trechos = info.trechos;
+    if (trechos.empty()) {
+        trechos.push_back({text_idx, 0, static_cast<uint32_t>(emitter.section(text_idx).size())});
+    }
+    const bool dividido = trechos.size() > 1;
+
+    size_t abbrev_idx = emitter.section_count();
+    emitter.create_section(".debug_abbrev", SHT_PROGBITS, 0, 1);
+    size_t info_idx = emitter.section_count();
+    emitter.create_section(".debug_info", SHT_PROGBITS, 0, 1);
+    size_t line_idx = emitter.section_count();
+    emitter.create_section(".debug_line", SHT_PROGBITS, 0, 1);
+    size_t aranges_idx = emitter.section_count();
+    emitter.create_section(".debug_aranges", SHT_PROGBITS, 0, 1);
+    size_t ranges_idx = 0;
+    if (dividido) {
+        ranges_idx = emitter.section_count();
+        emitter.create_section(".debug_ranges", SHT_PROGBITS, 0, 1);
+    }
+
+    // Offset de .text → endereço na seção do trecho (t) que o contém
+    auto endereco_em = [&](Section& s, const TrechoDepuracao& t, uint64_t offset_text) {
+        s.add_relocation(static_cast<uint32_t>(s.pos()), emitter.section_symbol(t.secao),
+                         R_X86_64_64, static_cast<int64_t>(offset_text - t.inicio));
+        s.emit_u64(0);
+    };
+    auto trecho_de = [&](uint64_t offset_text) -> const TrechoDepuracao& {
+        for (auto& t : trechos) {
+            if (offset_text < t.fim) return t;
+        }
+        return trechos.back();
+    };
+    auto offset_secao = [&](Section& s, size_t alvo) {
+        s.add_relocation(static_cast<uint32_t>(s.pos()), emitter.section_symbol(alvo),
+                         R_X86_64_32, 0);
+        s.emit_u32(0);
+    };
+
+    // ------------------------------------------------------------------
+    // .debug_abbrev
+    // ------------------------------------------------------------------
+    {
+        Section& s = emitter.section(abbrev_idx);
+        const uint8_t abbrevs[] = {
+            1, DW_TAG_compile_unit, DW_CHILDREN_yes,
+                DW_AT_producer,  DW_FORM_string,
+                DW_AT_language,  DW_FORM_data2,
+                DW_AT_name,      DW_FORM_string,
+                DW_AT_comp_dir,  DW_FORM_string,
+                DW_AT_stmt_list, DW_FORM_sec_offset,
+                DW_AT_low_pc,    DW_FORM_addr,
+                dividido ? DW_AT_ranges : DW_AT_high_pc,
+                dividido ? DW_FORM_sec_offset : DW_FORM_data8,
+                0, 0,
+            2, DW_TAG_subprogram, DW_CHILDREN_no,
+                DW_AT_name,      DW_FORM_string,
+                DW_AT_decl_file, DW_FORM_udata,
+                DW_AT_decl_line, DW_FORM_udata,
+                DW_AT_low_pc,    DW_FORM_addr,
+                DW_AT_high_pc,   DW_FORM_data8,
+                DW_AT_external,  DW_FORM_flag_present,
+                0, 0,
+            0
+        };
+        s.emit(abbrevs, sizeof(abbrevs));
+    }
+
+    // ------------------------------------------------------------------
+    // .debug_info
+    // ------------------------------------------------------------------
+    {
+        Section& s = emitter.section(info_idx);
+        s.emit_u32(0);                   // unit_length (corrigido no fim)
+        s.emit_u16(4);                   // versão
+        offset_secao(s, abbrev_idx);     // debug_abbrev_offset
+        s.emit_u8(8);                    // address_size
+
+        dwarf_uleb(s, 1);
+        s.emit_string("JPLang");
+        s.emit_u16(DW_LANG_C99);
+        s.emit_string(info.unidade);
+        s.emit_string(info.diretorio);
+        offset_secao(s, line_idx);
+        if (dividido) {
+            s.emit_u64(0);               // base das entradas de .debug_ranges
+            offset_secao(s, ranges_idx);
+        } else {
+            endereco_em(s, trechos[0], 0);
+            s.emit_u64(trechos[0].fim);
+        }
+
+        for (auto& f : info.funcoes) {
+            dwarf_uleb(s, 2);
+            s.emit_string(f.nome);
+            dwarf_uleb(s, f.arquivo + 1);
+            dwarf_uleb(s, f.linha);
+            endereco_em(s, trecho_de(f.inicio), f.inicio);
+            s.emit_u64(f.fim - f.inicio);
+        }
+        s.emit_u8(0);                    // fim dos filhos da CU
+        s.patch_u32(0, static_cast<uint32_t>(s.size() - 4));
+    }
+
+    // ------------------------------------------------------------------
+    // .debug_line
+    // ------------------------------------------------------------------
+    {
+        Section& s = emitter.section(line_idx);
+        s.emit_u32(0);                   // unit_length
+        s.emit_u16(4);                   // versão
+        size_t header_length_pos = s.pos();
+        s.emit_u32(0);                   // header_length
+        s.emit_u8(1);                    // minimum_instruction_length
+        s.emit_u8(1);                    // maximum_operations_per_instruction
+        s.emit_u8(1);                    // default_is_stmt
+        s.emit_i8(DWARF_LINE_BASE);
+        s.emit_u8(DWARF_LINE_RANGE);
+        s.emit_u8(DWARF_OPCODE_BASE);
+        const uint8_t std_lengths[] = {0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1};
+        s.emit(std_lengths, sizeof(std_lengths));
+        s.emit_u8(0);                    // include_directories (vazio)
+        for (auto& arq : info.arquivos) {
+            s.emit_string(arq);          // caminho absoluto: diretório 0
+            dwarf_uleb(s, 0);
+            dwarf_uleb(s, 0);
+            dwarf_uleb(s, 0);
+        }
+        s.emit_u8(0);
+        s.patch_u32(header_length_pos,
+                    static_cast<uint32_t>(s.size() - header_length_pos - 4));
+
+        // Programa: uma sequência por trecho, começando no início dele
+        size_t proxima = 0;
+        for (auto& t : trechos) {
+            s.emit_u8(0);
+            dwarf_uleb(s, 9);
+            s.emit_u8(DW_LNE_set_address);
+            endereco_em(s, t, t.inicio);
+
+            uint64_t addr = t.inicio;
+            int64_t line = 1;
+            uint32_t file = 1;
+            for (; proxima < info.linhas.size() && info.linhas[proxima].offset < t.fim; proxima++) {
+                auto& l = info.linhas[proxima];
+                if (l.arquivo + 1 != file) {
+                    file = l.arquivo + 1;
+                    s.emit_u8(DW_LNS_set_file);
+                    dwarf_uleb(s, file);
+                }
+                uint64_t addr_delta = l.offset - addr;
+                int64_t line_delta = static_cast<int64_t>(l.linha) - line;
+                uint64_t especial = (line_delta - DWARF_LINE_BASE) +
+                                    DWARF_LINE_RANGE * addr_delta + DWARF_OPCODE_BASE;
+                if (line_delta >= DWARF_LINE_BASE &&
+                    line_delta < DWARF_LINE_BASE + DWARF_LINE_RANGE && especial <= 255) {
+                    s.emit_u8(static_cast<uint8_t>(especial));
+                } else {
+                    if (addr_delta) {
+                        s.emit_u8(DW_LNS_advance_pc);
+                        dwarf_uleb(s, addr_delta);
+                    }
+                    if (line_delta) {
+                        s.emit_u8(DW_LNS_advance_line);
+                        dwarf_sleb(s, line_delta);
+                    }
+                    s.emit_u8(DW_LNS_copy);
+                }
+                addr = l.offset;
+                line = l.linha;
+            }
+            if (t.fim > addr) {
+                s.emit_u8(DW_LNS_advance_pc);
+                dwarf_uleb(s, t.fim - addr);
+            }
+            s.emit_u8(0);
+            dwarf_uleb(s, 1);
+            s.emit_u8(DW_LNE_end_sequence);
+        }
+        s.patch_u32(0, static_cast<uint32_t>(s.size() - 4));
+    }
+
+    // ------------------------------------------------------------------
+    // .debug_aranges
+    // ------------------------------------------------------------------
+    {
+        Section& s = emitter.section(aranges_idx);
+        s.emit_u32(0);                   // unit_length
+        s.emit_u16(2);                   // versão
+        offset_secao(s, info_idx);
+        s.emit_u8(8);                    // address_size
+        s.emit_u8(0);                    // segment_selector_size
+        s.emit_zeros(4);                 // tuplas alinhadas a 16
+        for (auto& t : trechos) {
+            endereco_em(s, t, t.inicio);
+            s.emit_u64(t.fim - t.inicio);
+        }
+        s.emit_u64(0);
+        s.emit_u64(0);
+        s.patch_u32(0, static_cast<uint32_t>(s.size() - 4));
+    }
+
+    // ------------------------------------------------------------------
+    // .debug_ranges (endereços absolutos: a CU tem low_pc 0)
+    // ------------------------------------------------------------------
+    if (dividido) {
+        Section& s = emitter.section(ranges_idx);
+        for (auto& t : trechos) {
+            endereco_em(s, t, t.inicio);
+            endereco_em(s, t, t.fim);
+        }
+        s.emit_u64(0);
+        s.emit_u64(0);
+    }
+}
+
+} // namespace jplang
+
+#endif // JPLANG_DWARF_EMITTER_HPP
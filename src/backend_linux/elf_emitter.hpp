@@ -62,8 +62,10 @@ constexpr uint16_t SHN_UNDEF = 0;
 constexpr uint16_t SHN_ABS   = 0xFFF1;
 
 // Relocation Types (x86-64)
+constexpr uint32_t R_X86_64_64    = 1;     // S + A (endereço absoluto, DWARF)
 constexpr uint32_t R_X86_64_PC32  = 2;     // S + A - P (RIP-relative)
 constexpr uint32_t R_X86_64_PLT32 = 4;     // L + A - P (function call)
+constexpr uint32_t R_X86_64_32    = 10;    // S + A (offset entre seções DWARF)
 
 // Flag interna: IDs com esse bit são referências a seções
 constexpr uint32_t ELF_SECTION_SYM_FLAG = 0x80000000;
@@ -261,6 +263,71 @@ public:
         return ELF_SECTION_SYM_FLAG | static_cast<uint32_t>(section_index);
     }
 
+    // Trecho [begin, end) de uma seção que vira seção própria
+    struct SectionPart {
+        std::string name;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    // Divide a seção em seções novas (mesmo tipo, flags e alinhamento),
+    // levando bytes, relocações e símbolos definidos em cada trecho. A
+    // original fica vazia, então os índices das outras continuam valendo.
+    // Os trechos devem cobrir a seção em ordem e sem buracos. Recusa
+    // (false) se alguma relocação usa o símbolo da própria seção: o addend
+    // pode apontar para qualquer trecho. Invalida referências a seções.
+    bool split_section(size_t index, const std::vector<SectionPart>& parts,
+                       std::vector<size_t>& out_indices) {
+        const uint64_t size = sections_[index].size();
+        if (parts.empty() || parts.front().begin != 0 || parts.back().end != size) return false;
+        for (size_t i = 0; i < parts.size(); i++) {
+            if (parts[i].begin >= parts[i].end) return false;
+            if (i > 0 && parts[i].begin != parts[i - 1].end) return false;
+        }
+        const uint32_t own_sym = section_symbol(index);
+        for (auto& sec : sections_) {
+            for (auto& r : sec.relocations) {
+                if (r.symbol_id == own_sym) return false;
+            }
+        }
+
+        auto part_of = [&](uint64_t offset) {
+            size_t i = 0;
+            while (i + 1 < parts.size() && offset >= parts[i].end) i++;
+            return i;
+        };
+
+        out_indices.clear();
+        for (auto& p : parts) {
+            out_indices.push_back(sections_.size());
+            const Section& orig = sections_[index];
+            Section sec;
+            sec.name = p.name;
+            sec.type = orig.type;
+            sec.flags = orig.flags;
+            sec.alignment = orig.alignment;
+            sec.data.assign(orig.data.begin() + static_cast<std::ptrdiff_t>(p.begin),
+                            orig.data.begin() + static_cast<std::ptrdiff_t>(p.end));
+            sections_.push_back(std::move(sec));
+        }
+
+        Section& orig = sections_[index];
+        for (auto r : orig.relocations) {
+            size_t i = part_of(r.offset);
+            r.offset -= parts[i].begin;
+            sections_[out_indices[i]].relocations.push_back(r);
+        }
+        for (auto& sym : symbols_) {
+            if (sym.section_index != index) continue;
+            size_t i = part_of(sym.value);
+            sym.value -= parts[i].begin;
+            sym.section_index = static_cast<uint16_t>(out_indices[i]);
+        }
+        orig.data.clear();
+        orig.relocations.clear();
+        return true;
+    }
+
     // ------------------------------------------------------------------
     // Símbolos
     // ------------------------------------------------------------------
@@ -303,6 +370,17 @@ public:
         return register_symbol(sym);
     }
 
+    // st_size: extensão da função em bytes (gdb/perf usam para atribuir
+    // endereços à função certa)
+    void set_symbol_size(uint32_t id, uint64_t size) {
+        symbols_[symbol_order_[id]].size = size;
+    }
+
+    // Offset na seção (reordenação de funções em .text, -pgo-usar)
+    void set_symbol_value(uint32_t id, uint64_t value) {
+        symbols_[symbol_order_[id]].value = value;
+    }
+
     uint32_t symbol_index(const std::string& name) const {
         auto it = symbol_index_map_.find(name);
         if (it == symbol_index_map_.end())
@@ -314,6 +392,14 @@ public:
         return symbol_index_map_.count(name) > 0;
     }
 
+    // Símbolos na ordem de registro (índice = ID usado nas relocações);
+    // usado para juntar fragmentos gerados em paralelo
+    size_t symbol_count() const { return symbol_order_.size(); }
+
+    const SymbolInfo& symbol_at(uint32_t index) const {
+        return symbols_[symbol_order_[index]];
+    }
+
     // ------------------------------------------------------------------
     // Serialização ELF64
     // ------------------------------------------------------------------
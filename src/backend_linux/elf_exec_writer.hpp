@@ -0,0 +1,1369 @@
+// elf_exec_writer.hpp
+// Linkador embutido Linux x86-64 — gera executavel ELF direto, sem ld externo
+//
+// Cobre o caso comum: objeto do programa + objetos .o estaticos simples (C)
+// + libc dinamica. Funde as secoes, resolve as relocacoes, monta PLT/GOT,
+// .dynamic, .interp e escreve o binario final.
+//
+// Qualquer coisa fora desse caso (TLS, COMDAT, init_array, simbolos de
+// libstdc++/libgcc, .jpd, tipos de relocacao desconhecidos) faz o writer
+// desistir com um motivo — link_with_ld entao cai no ld externo.
+//
+// Secoes .debug_* sao concatenadas por nome e copiadas para o executavel
+// (nao alocadas), com as relocacoes aplicadas. Se alguma relocacao de
+// depuracao nao for suportada, o executavel sai sem depuracao em vez de
+// falhar o link.
+//
+// Como o --gc-sections do ld: secoes .text.*/.rodata.*/.data.*/.bss.*
+// (uma por funcao, ver split_text_by_function) so entram se alguma secao
+// viva as referencia; as demais secoes alocaveis e a que define main sao
+// as raizes. Depuracao que aponta para secao coletada recebe o valor
+// "tombstone" (0, ou 1 em .debug_ranges para nao encerrar a lista).
+
+#ifndef JPLANG_ELF_EXEC_WRITER_HPP
+#define JPLANG_ELF_EXEC_WRITER_HPP
+
+#include "elf_emitter.hpp"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <unordered_map>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace jplang {
+
+// ============================================================================
+// CONSTANTES ELF64 (executavel)
+// ============================================================================
+
+constexpr uint16_t ET_EXEC = 2;
+constexpr uint16_t ET_DYN  = 3;
+
+constexpr uint32_t SHT_HASH         = 5;
+constexpr uint32_t SHT_DYNAMIC      = 6;
+constexpr uint32_t SHT_NOTE         = 7;
+constexpr uint32_t SHT_REL          = 9;
+constexpr uint32_t SHT_DYNSYM       = 11;
+constexpr uint32_t SHT_INIT_ARRAY   = 14;
+constexpr uint32_t SHT_FINI_ARRAY   = 15;
+constexpr uint32_t SHT_PREINIT_ARRAY = 16;
+constexpr uint32_t SHT_GROUP        = 17;
+constexpr uint32_t SHT_X86_64_UNWIND = 0x70000001;
+
+constexpr uint64_t SHF_TLS = 0x400;
+
+constexpr uint32_t PT_LOAD      = 1;
+constexpr uint32_t PT_DYNAMIC   = 2;
+constexpr uint32_t PT_INTERP    = 3;
+constexpr uint32_t PT_PHDR      = 6;
+constexpr uint32_t PT_GNU_STACK = 0x6474E551;
+
+constexpr uint32_t PF_X = 1;
+constexpr uint32_t PF_W = 2;
+constexpr uint32_t PF_R = 4;
+
+constexpr int64_t DT_NULL    = 0;
+constexpr int64_t DT_NEEDED  = 1;
+constexpr int64_t DT_HASH    = 4;
+constexpr int64_t DT_STRTAB  = 5;
+constexpr int64_t DT_SYMTAB  = 6;
+constexpr int64_t DT_RELA    = 7;
+constexpr int64_t DT_RELASZ  = 8;
+constexpr int64_t DT_RELAENT = 9;
+constexpr int64_t DT_STRSZ   = 10;
+constexpr int64_t DT_SYMENT  = 11;
+constexpr int64_t DT_DEBUG   = 21;
+constexpr int64_t DT_FLAGS   = 30;
+constexpr int64_t DT_FLAGS_1 = 0x6FFFFFFB;
+constexpr uint64_t DF_BIND_NOW = 0x8;
+constexpr uint64_t DF_1_NOW    = 0x1;
+
+constexpr uint8_t STB_WEAK       = 2;
+constexpr uint8_t STT_OBJECT     = 1;
+constexpr uint8_t STT_GNU_IFUNC  = 10;
+constexpr uint16_t SHN_COMMON    = 0xFFF2;
+
+constexpr uint32_t R_X86_64_NONE          = 0;
+constexpr uint32_t R_X86_64_COPY          = 5;
+constexpr uint32_t R_X86_64_GLOB_DAT      = 6;
+constexpr uint32_t R_X86_64_GOTPCREL      = 9;
+constexpr uint32_t R_X86_64_32S           = 11;
+constexpr uint32_t R_X86_64_PC64          = 24;
+constexpr uint32_t R_X86_64_GOTPCRELX     = 41;
+constexpr uint32_t R_X86_64_REX_GOTPCRELX = 42;
+
+#pragma pack(push, 1)
+
+struct Elf64_Phdr {
+    uint32_t p_type;
+    uint32_t p_flags;
+    uint64_t p_offset;
+    uint64_t p_vaddr;
+    uint64_t p_paddr;
+    uint64_t p_filesz;
+    uint64_t p_memsz;
+    uint64_t p_align;
+};
+
+struct Elf64_Dyn {
+    int64_t  d_tag;
+    uint64_t d_val;
+};
+
+#pragma pack(pop)
+
+// ============================================================================
+// LEITURA DE OBJETO .o (ET_REL)
+// ============================================================================
+
+struct ElfObjetoEntrada {
+    std::string path;
+    std::vector<uint8_t> data;
+    const Elf64_Ehdr* ehdr = nullptr;
+    const Elf64_Shdr* shdrs = nullptr;
+    const char* shstrtab = nullptr;
+    const Elf64_Sym* syms = nullptr;
+    size_t sym_count = 0;
+    uint32_t first_global = 0;
+    const char* strtab = nullptr;
+
+    // Por secao: tipo de saida (-1 = descartada, -2 = coletada pelo gc)
+    // e offset dentro dela; secoes de depuracao: indice da secao de saida
+    // (-1 = nenhuma); sec_live: alcancada a partir das raizes
+    std::vector<int> sec_kind;
+    std::vector<uint64_t> sec_off;
+    std::vector<int> sec_debug;
+    std::vector<bool> sec_live;
+
+    uint16_t shnum() const { return ehdr->e_shnum; }
+    const char* sec_name(size_t i) const { return shstrtab + shdrs[i].sh_name; }
+    const char* sym_name(size_t i) const { return strtab + syms[i].st_name; }
+};
+
+// ============================================================================
+// LINKADOR EMBUTIDO
+// ============================================================================
+
+class ElfExecWriter {
+public:
+    // Tipos de secao de saida (ordem de layout)
+    enum Kind { K_RODATA = 0, K_TEXT = 1, K_DATA = 2, K_BSS = 3, K_COUNT = 4 };
+
+    // Indices das secoes no executavel (tabela de cabecalhos de write);
+    // as .debug_* vem depois de SH_DEBUG
+    enum SecaoSaida : uint16_t {
+        SH_INTERP = 1, SH_HASH, SH_DYNSYM, SH_DYNSTR, SH_RELA_DYN, SH_RODATA,
+        SH_PLT, SH_TEXT, SH_DYNAMIC, SH_GOT, SH_DATA, SH_BSS, SH_SYMTAB,
+        SH_STRTAB, SH_SHSTRTAB, SH_DEBUG
+    };
+
+    static constexpr uint64_t BASE_ADDR = 0x400000;
+    static constexpr uint64_t PAGE      = 0x1000;
+    static constexpr int SEC_COLETADA   = -2;
+
+    bool link(const std::vector<std::string>& objs, const std::string& exe_path) {
+        for (auto& p : objs) {
+            if (!load_object(p)) return false;
+        }
+        if (!load_shared_libs()) return false;
+        mark_live_sections();
+        if (!merge_sections()) return false;
+        if (!collect_globals()) return false;
+        if (!scan_relocations()) return false;
+        layout();
+        if (!apply_relocations()) return false;
+        apply_debug_relocations();
+        return write(exe_path);
+    }
+
+    const std::string& motivo() const { return motivo_; }
+
+private:
+    // ------------------------------------------------------------------
+    // Estado
+    // ------------------------------------------------------------------
+
+    struct GlobalDef {
+        int obj = -1;          // -1 = absoluto/COMMON (value ja e endereco final/offset bss)
+        uint16_t shndx = 0;
+        uint64_t value = 0;
+        uint64_t size = 0;
+        uint8_t type = STT_NOTYPE;
+        bool weak = false;
+        bool common = false;
+    };
+
+    // Simbolo importado de biblioteca compartilhada
+    struct Import {
+        std::string name;
+        std::string lib;
+        uint8_t type = STT_FUNC;
+        uint64_t size = 0;
+        bool needs_got = false;
+        bool needs_plt = false;
+        bool needs_copy = false;
+        uint32_t dynsym = 0;
+        uint64_t got_addr = 0;
+        uint64_t plt_addr = 0;
+        uint64_t copy_addr = 0;
+        uint64_t copy_bss_off = 0;
+    };
+
+    struct SharedLib {
+        std::string soname;
+        std::string path;
+    };
+
+    std::vector<ElfObjetoEntrada> objs_;
+    std::unordered_map<std::string, GlobalDef> globals_;
+    std::map<std::string, Import> imports_;   // ordenado: saida deterministica
+    std::vector<std::string> needed_;
+    std::vector<SharedLib> libs_;
+
+    // GOT para simbolos definidos no proprio executavel referenciados via
+    // GOTPCREL: por nome (globais) ou por (objeto, indice) (locais)
+    std::map<std::string, uint64_t> local_got_;
+    std::map<std::pair<size_t, uint32_t>, uint64_t> local_sym_got_;
+
+    // Secoes .debug_* de saida, na ordem em que aparecem nos objetos
+    struct DebugSection {
+        std::string name;
+        std::vector<uint8_t> data;
+    };
+    std::vector<DebugSection> debug_;
+
+    std::vector<uint8_t> kind_data_[K_COUNT];
+    uint64_t kind_align_[K_COUNT] = {1, 16, 8, 8};
+    uint64_t bss_size_ = 0;
+    uint64_t kind_addr_[K_COUNT] = {};
+
+    uint64_t start_addr_ = 0;
+    uint64_t got_addr_ = 0;
+    uint64_t plt_addr_ = 0;
+    size_t got_slots_ = 0;
+    size_t plt_slots_ = 0;
+
+    std::vector<Elf64_Rela> dyn_relocs_;
+    size_t n_rela_ = 0;
+
+    std::string motivo_;
+
+    static constexpr const char* INTERP = "/lib64/ld-linux-x86-64.so.2";
+    static constexpr size_t START_SIZE = 48;   // stub _start (34 bytes + pad)
+    static constexpr size_t PLT_ENTRY  = 8;    // jmp *got(%rip) + pad
+
+    bool fail(const std::string& m) { motivo_ = m; return false; }
+
+    // ------------------------------------------------------------------
+    // Carregamento dos objetos
+    // ------------------------------------------------------------------
+
+    bool load_object(const std::string& path) {
+        ElfObjetoEntrada o;
+        o.path = path;
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        if (!f.is_open()) return fail("nao abriu " + path);
+        std::streamsize n = f.tellg();
+        if (n < static_cast<std::streamsize>(sizeof(Elf64_Ehdr)))
+            return fail("objeto invalido " + path);
+        o.data.resize(static_cast<size_t>(n));
+        f.seekg(0);
+        f.read(reinterpret_cast<char*>(o.data.data()), n);
+
+        o.ehdr = reinterpret_cast<const Elf64_Ehdr*>(o.data.data());
+        if (o.ehdr->e_ident[0] != ELFMAG0 || o.ehdr->e_ident[1] != ELFMAG1 ||
+            o.ehdr->e_ident[2] != ELFMAG2 || o.ehdr->e_ident[3] != ELFMAG3 ||
+            o.ehdr->e_ident[4] != ELFCLASS64 || o.ehdr->e_type != ET_REL ||
+            o.ehdr->e_machine != EM_X86_64)
+            return fail("nao e ELF64 relocavel x86-64: " + path);
+        if (o.ehdr->e_shoff + o.ehdr->e_shnum * sizeof(Elf64_Shdr) > o.data.size())
+            return fail("secoes fora do arquivo: " + path);
+
+        o.shdrs = reinterpret_cast<const Elf64_Shdr*>(o.data.data() + o.ehdr->e_shoff);
+        o.shstrtab = reinterpret_cast<const char*>(
+            o.data.data() + o.shdrs[o.ehdr->e_shstrndx].sh_offset);
+
+        for (size_t i = 0; i < o.shnum(); i++) {
+            const Elf64_Shdr& sh = o.shdrs[i];
+            if (sh.sh_type == SHT_SYMTAB) {
+                o.syms = reinterpret_cast<const Elf64_Sym*>(o.data.data() + sh.sh_offset);
+                o.sym_count = sh.sh_size / sizeof(Elf64_Sym);
+                o.first_global = sh.sh_info;
+                o.strtab = reinterpret_cast<const char*>(
+                    o.data.data() + o.shdrs[sh.sh_link].sh_offset);
+            }
+            if (sh.sh_type == SHT_GROUP) return fail("COMDAT em " + path);
+            if (sh.sh_type == SHT_REL) return fail("SHT_REL em " + path);
+        }
+        if (!o.syms) return fail("sem tabela de simbolos: " + path);
+
+        objs_.push_back(std::move(o));
+        return true;
+    }
+
+    // ------------------------------------------------------------------
+    // Bibliotecas compartilhadas (libc, libm): so dynsym e lido, via mmap
+    // ------------------------------------------------------------------
+
+    static std::string find_shared_lib(const std::string& soname) {
+        static const char* dirs[] = {
+            "/lib/x86_64-linux-gnu", "/usr/lib/x86_64-linux-gnu",
+            "/lib64", "/usr/lib64", "/lib", "/usr/lib"
+        };
+        for (auto* d : dirs) {
+            std::string p = std::string(d) + "/" + soname;
+            struct stat st;
+            if (::stat(p.c_str(), &st) == 0) return p;
+        }
+        return "";
+    }
+
+    bool load_shared_libs() {
+        struct stat st;
+        if (::stat(INTERP, &st) != 0) return fail(std::string("sem ") + INTERP);
+        for (const char* so : {"libc.so.6", "libm.so.6"}) {
+            std::string p = find_shared_lib(so);
+            if (p.empty()) {
+                if (std::string(so) == "libc.so.6") return fail("libc.so.6 nao encontrada");
+                continue;
+            }
+            libs_.push_back({so, p});
+        }
+        return true;
+    }
+
+    // Procura os nomes pendentes na dynsym da biblioteca; preenche imports_
+    bool resolve_in_lib(const SharedLib& lib, std::vector<std::string>& pending) {
+        int fd = ::open(lib.path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0) { ::close(fd); return false; }
+        size_t len = static_cast<size_t>(st.st_size);
+        void* map = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+
+        const uint8_t* base = static_cast<const uint8_t*>(map);
+        auto* eh = reinterpret_cast<const Elf64_Ehdr*>(base);
+        bool ok = len >= sizeof(Elf64_Ehdr) && eh->e_type == ET_DYN &&
+                  eh->e_shoff + eh->e_shnum * sizeof(Elf64_Shdr) <= len;
+        if (ok) {
+            auto* sh = reinterpret_cast<const Elf64_Shdr*>(base + eh->e_shoff);
+            for (size_t i = 0; i < eh->e_shnum; i++) {
+                if (sh[i].sh_type != SHT_DYNSYM) continue;
+                auto* syms = reinterpret_cast<const Elf64_Sym*>(base + sh[i].sh_offset);
+                size_t count = sh[i].sh_size / sizeof(Elf64_Sym);
+                const char* str = reinterpret_cast<const char*>(base + sh[sh[i].sh_link].sh_offset);
+
+                std::unordered_map<std::string, size_t> want;
+                for (size_t k = 0; k < pending.size(); k++) want[pending[k]] = k;
+
+                for (size_t s = 1; s < count && !want.empty(); s++) {
+                    const Elf64_Sym& sym = syms[s];
+                    if (sym.st_shndx == SHN_UNDEF) continue;
+                    uint8_t bind = sym.st_info >> 4;
+                    if (bind != STB_GLOBAL && bind != STB_WEAK) continue;
+                    auto it = want.find(str + sym.st_name);
+                    if (it == want.end()) continue;
+
+                    Import imp;
+                    imp.name = it->first;
+                    imp.lib = lib.soname;
+                    uint8_t t = sym.st_info & 0x0F;
+                    imp.type = (t == STT_OBJECT) ? STT_OBJECT : STT_FUNC;
+                    imp.size = sym.st_size;
+                    imports_[imp.name] = imp;
+                    want.erase(it);
+                }
+
+                std::vector<std::string> rest;
+                for (auto& n : pending) if (want.count(n)) rest.push_back(n);
+                pending.swap(rest);
+                break;
+            }
+        }
+        ::munmap(map, len);
+        return ok;
+    }
+
+    // ------------------------------------------------------------------
+    // Coleta de secoes (--gc-sections)
+    // ------------------------------------------------------------------
+
+    static bool is_gc_candidate(const char* name) {
+        for (const char* prefix : {".text.", ".rodata.", ".data.", ".bss."}) {
+            if (std::strncmp(name, prefix, std::strlen(prefix)) == 0) return true;
+        }
+        return false;
+    }
+
+    void mark_live_sections() {
+        // Onde cada global esta definido (todas as definicoes: weak e forte)
+        std::unordered_map<std::string, std::vector<std::pair<size_t, uint32_t>>> defs;
+        std::vector<std::vector<std::vector<uint32_t>>> relas(objs_.size());
+        std::vector<std::pair<size_t, uint32_t>> pending;
+
+        auto mark = [&](size_t oi, uint32_t shndx) {
+            auto& o = objs_[oi];
+            if (shndx == SHN_UNDEF || shndx >= o.shnum() || o.sec_live[shndx]) return;
+            o.sec_live[shndx] = true;
+            pending.push_back({oi, shndx});
+        };
+
+        for (size_t oi = 0; oi < objs_.size(); oi++) {
+            auto& o = objs_[oi];
+            o.sec_live.assign(o.shnum(), false);
+            relas[oi].resize(o.shnum());
+            for (size_t i = 1; i < o.shnum(); i++) {
+                const Elf64_Shdr& sh = o.shdrs[i];
+                if (sh.sh_type == SHT_RELA && sh.sh_info < o.shnum()) {
+                    relas[oi][sh.sh_info].push_back(static_cast<uint32_t>(i));
+                }
+            }
+            for (size_t s = o.first_global; s < o.sym_count; s++) {
+                uint16_t shndx = o.syms[s].st_shndx;
+                if (shndx != SHN_UNDEF && shndx < o.shnum()) {
+                    defs[o.sym_name(s)].push_back({oi, shndx});
+                }
+            }
+        }
+
+        // Raizes: secoes alocaveis que nao sao candidatas (exceto as que
+        // merge_sections ignora, como .eh_frame) e a definicao de main
+        for (size_t oi = 0; oi < objs_.size(); oi++) {
+            auto& o = objs_[oi];
+            for (size_t i = 1; i < o.shnum(); i++) {
+                const Elf64_Shdr& sh = o.shdrs[i];
+                if (!(sh.sh_flags & SHF_ALLOC) || is_gc_candidate(o.sec_name(i))) continue;
+                if (sh.sh_type == SHT_NOTE || sh.sh_type == SHT_X86_64_UNWIND ||
+                    std::strcmp(o.sec_name(i), ".eh_frame") == 0) continue;
+                mark(oi, static_cast<uint32_t>(i));
+            }
+        }
+        for (auto& [oi, shndx] : defs["main"]) mark(oi, shndx);
+
+        while (!pending.empty()) {
+            auto [oi, shndx] = pending.back();
+            pending.pop_back();
+            auto& o = objs_[oi];
+            for (uint32_t ri : relas[oi][shndx]) {
+                const Elf64_Shdr& sh = o.shdrs[ri];
+                auto* r = reinterpret_cast<const Elf64_Rela*>(o.data.data() + sh.sh_offset);
+                size_t n = sh.sh_size / sizeof(Elf64_Rela);
+                for (size_t k = 0; k < n; k++) {
+                    uint32_t si = static_cast<uint32_t>(r[k].r_info >> 32);
+                    if (si >= o.sym_count) continue;
+                    mark(oi, o.syms[si].st_shndx);
+                    if (si >= o.first_global) {
+                        auto it = defs.find(o.sym_name(si));
+                        if (it == defs.end()) continue;
+                        for (auto& [doi, dsh] : it->second) mark(doi, dsh);
+                    }
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Fusao das secoes alocaveis por tipo de saida
+    // ------------------------------------------------------------------
+
+    bool merge_sections() {
+        for (auto& o : objs_) {
+            o.sec_kind.assign(o.shnum(), -1);
+            o.sec_off.assign(o.shnum(), 0);
+            o.sec_debug.assign(o.shnum(), -1);
+            for (size_t i = 1; i < o.shnum(); i++) {
+                const Elf64_Shdr& sh = o.shdrs[i];
+                if (!(sh.sh_flags & SHF_ALLOC)) {
+                    merge_debug_section(o, i);
+                    continue;
+                }
+                if (sh.sh_flags & SHF_TLS) return fail("TLS em " + o.path);
+
+                std::string name = o.sec_name(i);
+                if (sh.sh_type == SHT_NOTE || sh.sh_type == SHT_X86_64_UNWIND ||
+                    name == ".eh_frame") continue;
+                if (!o.sec_live[i]) {
+                    o.sec_kind[i] = SEC_COLETADA;
+                    continue;
+                }
+                if (sh.sh_type == SHT_INIT_ARRAY || sh.sh_type == SHT_FINI_ARRAY ||
+                    sh.sh_type == SHT_PREINIT_ARRAY) {
+                    if (sh.sh_size == 0) continue;
+                    return fail("construtores estaticos em " + o.path);
+                }
+
+                int kind;
+                if (sh.sh_type == SHT_NOBITS) kind = K_BSS;
+                else if (sh.sh_type != SHT_PROGBITS) return fail("secao " + name + " nao suportada");
+                else if (sh.sh_flags & SHF_EXECINSTR) kind = K_TEXT;
+                else if (sh.sh_flags & SHF_WRITE) kind = K_DATA;
+                else kind = K_RODATA;
+
+                uint64_t al = sh.sh_addralign ? sh.sh_addralign : 1;
+                if (al > kind_align_[kind]) kind_align_[kind] = al;
+
+                if (kind == K_BSS) {
+                    bss_size_ = (bss_size_ + al - 1) & ~(al - 1);
+                    o.sec_off[i] = bss_size_;
+                    bss_size_ += sh.sh_size;
+                } else {
+                    auto& buf = kind_data_[kind];
+                    size_t off = (buf.size() + al - 1) & ~(al - 1);
+                    // Preenche alinhamento de codigo com int3
+                    buf.resize(off, kind == K_TEXT ? 0xCC : 0);
+                    o.sec_off[i] = off;
+                    buf.insert(buf.end(), o.data.begin() + sh.sh_offset,
+                               o.data.begin() + sh.sh_offset + sh.sh_size);
+                }
+                o.sec_kind[i] = kind;
+            }
+        }
+        return true;
+    }
+
+    void merge_debug_section(ElfObjetoEntrada& o, size_t i) {
+        const Elf64_Shdr& sh = o.shdrs[i];
+        std::string name = o.sec_name(i);
+        if (sh.sh_type != SHT_PROGBITS || name.compare(0, 7, ".debug_") != 0) return;
+
+        size_t d = 0;
+        while (d < debug_.size() && debug_[d].name != name) d++;
+        if (d == debug_.size()) debug_.push_back({name, {}});
+        auto& buf = debug_[d].data;
+        o.sec_debug[i] = static_cast<int>(d);
+        o.sec_off[i] = buf.size();
+        buf.insert(buf.end(), o.data.begin() + sh.sh_offset,
+                   o.data.begin() + sh.sh_offset + sh.sh_size);
+    }
+
+    // ------------------------------------------------------------------
+    // Tabela global de simbolos definidos
+    // ------------------------------------------------------------------
+
+    bool collect_globals() {
+        for (size_t oi = 0; oi < objs_.size(); oi++) {
+            auto& o = objs_[oi];
+            for (size_t s = o.first_global; s < o.sym_count; s++) {
+                const Elf64_Sym& sym = o.syms[s];
+                if (sym.st_shndx == SHN_UNDEF) continue;
+                if (sym.st_shndx < o.shnum() && o.sec_kind[sym.st_shndx] == SEC_COLETADA) continue;
+                std::string name = o.sym_name(s);
+                uint8_t bind = sym.st_info >> 4;
+
+                GlobalDef d;
+                d.obj = static_cast<int>(oi);
+                d.shndx = sym.st_shndx;
+                d.value = sym.st_value;
+                d.size = sym.st_size;
+                d.type = sym.st_info & 0x0F;
+                d.weak = (bind == STB_WEAK);
+
+                if (sym.st_shndx == SHN_COMMON) {
+                    uint64_t al = sym.st_value ? sym.st_value : 1;
+                    bss_size_ = (bss_size_ + al - 1) & ~(al - 1);
+                    d.obj = -1;
+                    d.common = true;
+                    d.value = bss_size_;
+                    bss_size_ += sym.st_size;
+                    if (al > kind_align_[K_BSS]) kind_align_[K_BSS] = al;
+                } else if (sym.st_shndx == SHN_ABS) {
+                    d.obj = -1;
+                }
+
+                auto it = globals_.find(name);
+                if (it != globals_.end()) {
+                    if (!it->second.weak && !d.weak)
+                        return fail("simbolo duplicado: " + name);
+                    if (d.weak) continue;   // mantem o primeiro forte
+                }
+                globals_[name] = d;
+            }
+        }
+        if (!globals_.count("main")) return fail("sem main");
+        return true;
+    }
+
+    // ------------------------------------------------------------------
+    // Varredura das relocacoes: descobre imports e GOT/PLT/COPY
+    // ------------------------------------------------------------------
+
+    template <typename Fn>
+    void for_each_rela(Fn fn) {
+        for (size_t oi = 0; oi < objs_.size(); oi++) {
+            auto& o = objs_[oi];
+            for (size_t i = 1; i < o.shnum(); i++) {
+                const Elf64_Shdr& sh = o.shdrs[i];
+                if (sh.sh_type != SHT_RELA) continue;
+                if (sh.sh_info >= o.shnum() || o.sec_kind[sh.sh_info] < 0) continue;
+                auto* r = reinterpret_cast<const Elf64_Rela*>(o.data.data() + sh.sh_offset);
+                size_t n = sh.sh_size / sizeof(Elf64_Rela);
+                for (size_t k = 0; k < n; k++) fn(oi, sh.sh_info, r[k]);
+            }
+        }
+    }
+
+    static bool is_got_reloc(uint32_t t) {
+        return t == R_X86_64_GOTPCREL || t == R_X86_64_GOTPCRELX ||
+               t == R_X86_64_REX_GOTPCRELX;
+    }
+
+    bool scan_relocations() {
+        std::vector<std::string> pending;
+        std::unordered_map<std::string, bool> seen;
+
+        bool ok = true;
+        for_each_rela([&](size_t oi, uint32_t, const Elf64_Rela& r) {
+            if (!ok) return;
+            auto& o = objs_[oi];
+            uint32_t si = static_cast<uint32_t>(r.r_info >> 32);
+            if (si >= o.sym_count) { ok = fail("simbolo invalido em " + o.path); return; }
+            const Elf64_Sym& sym = o.syms[si];
+            if (si < o.first_global || sym.st_shndx != SHN_UNDEF) {
+                if (sym.st_shndx != SHN_ABS && sym.st_shndx != SHN_COMMON &&
+                    sym.st_shndx != SHN_UNDEF && o.sec_kind[sym.st_shndx] < 0) {
+                    ok = fail("referencia a secao descartada em " + o.path);
+                }
+                return;
+            }
+            std::string name = o.sym_name(si);
+            if (name == "_GLOBAL_OFFSET_TABLE_") return;
+            if (globals_.count(name)) return;
+            if (!seen.count(name)) {
+                seen[name] = (sym.st_info >> 4) == STB_WEAK;
+                pending.push_back(name);
+            }
+        });
+        if (!ok) return false;
+
+        // __libc_start_main e sempre necessario pelo _start
+        if (!seen.count("__libc_start_main")) pending.push_back("__libc_start_main");
+
+        for (auto& lib : libs_) {
+            if (pending.empty()) break;
+            size_t before = pending.size();
+            if (!resolve_in_lib(lib, pending)) return fail("nao leu " + lib.path);
+            if (pending.size() != before) needed_.push_back(lib.soname);
+        }
+        for (auto& n : pending) {
+            if (seen.count(n) && seen[n]) continue;   // weak nao resolvido = 0
+            return fail("simbolo indefinido: " + n);
+        }
+        if (needed_.empty() || needed_[0] != "libc.so.6") {
+            // libc sempre primeiro (dona de __libc_start_main)
+            std::vector<std::string> n2 = {"libc.so.6"};
+            for (auto& s : needed_) if (s != "libc.so.6") n2.push_back(s);
+            needed_.swap(n2);
+        }
+
+        // Decidir GOT/PLT/COPY por import
+        for_each_rela([&](size_t oi, uint32_t, const Elf64_Rela& r) {
+            auto& o = objs_[oi];
+            uint32_t si = static_cast<uint32_t>(r.r_info >> 32);
+            uint32_t t = static_cast<uint32_t>(r.r_info & 0xFFFFFFFF);
+            const Elf64_Sym& sym = o.syms[si];
+            if (si < o.first_global || sym.st_shndx != SHN_UNDEF) {
+                if (is_got_reloc(t)) local_sym_got_[{oi, si}] = 0;
+                return;
+            }
+            std::string name = o.sym_name(si);
+            auto it = imports_.find(name);
+            if (it == imports_.end()) {
+                // global definido aqui ou weak indefinido (slot fica 0)
+                if (is_got_reloc(t)) local_got_[name] = 0;
+                return;
+            }
+            Import& imp = it->second;
+            if (is_got_reloc(t)) {
+                imp.needs_got = true;
+            } else if (t == R_X86_64_64) {
+                // relocacao dinamica direta (so em secao gravavel)
+            } else if (imp.type == STT_FUNC) {
+                imp.needs_plt = true;
+                imp.needs_got = true;
+            } else {
+                imp.needs_copy = true;
+            }
+        });
+        imports_["__libc_start_main"].needs_got = true;
+
+        // Espaco de COPY no .bss
+        for (auto& [name, imp] : imports_) {
+            if (!imp.needs_copy) continue;
+            uint64_t al = 16;
+            bss_size_ = (bss_size_ + al - 1) & ~(al - 1);
+            imp.copy_bss_off = bss_size_;
+            bss_size_ += imp.size ? imp.size : 8;
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------
+    // Layout: [ELF hdr|phdrs|.interp|.hash|.dynsym|.dynstr|.rela.dyn|.rodata]
+    //         [.plt|_start|.text]  [.dynamic|.got|.data|.bss]
+    // ------------------------------------------------------------------
+
+    static constexpr size_t PHNUM = 7;
+
+    // Secoes sinteticas
+    std::vector<uint8_t> interp_, hash_, dynsym_, dynstr_, rela_, plt_, dynamic_, got_;
+    std::vector<uint8_t> text_all_;
+    uint64_t off_interp_ = 0, off_hash_ = 0, off_dynsym_ = 0, off_dynstr_ = 0;
+    uint64_t off_rela_ = 0, off_rodata_ = 0, off_plt_ = 0, off_text_ = 0;
+    uint64_t off_dynamic_ = 0, off_got_ = 0, off_data_ = 0;
+    uint64_t seg1_end_ = 0, seg2_off_ = 0, seg2_end_ = 0, seg3_off_ = 0, seg3_end_ = 0;
+    uint64_t bss_addr_ = 0;
+    std::vector<uint32_t> dynsym_names_;  // offsets em dynstr por import
+    std::vector<std::string> dynsym_order_;
+
+    static uint64_t align_up(uint64_t v, uint64_t a) { return (v + a - 1) & ~(a - 1); }
+
+    uint32_t add_dynstr(const std::string& s) {
+        uint32_t off = static_cast<uint32_t>(dynstr_.size());
+        dynstr_.insert(dynstr_.end(), s.begin(), s.end());
+        dynstr_.push_back(0);
+        return off;
+    }
+
+    static uint32_t elf_hash(const char* name) {
+        uint32_t h = 0;
+        while (*name) {
+            h = (h << 4) + static_cast<uint8_t>(*name++);
+            uint32_t g = h & 0xF0000000;
+            if (g) h ^= g >> 24;
+            h &= ~g;
+        }
+        return h;
+    }
+
+    void layout() {
+        // --- dynstr / dynsym (tamanhos) ---
+        dynstr_.push_back(0);
+        std::vector<uint32_t> needed_off;
+        for (auto& n : needed_) needed_off.push_back(add_dynstr(n));
+
+        uint32_t idx = 1;
+        for (auto& [name, imp] : imports_) {
+            imp.dynsym = idx++;
+            dynsym_order_.push_back(name);
+            dynsym_names_.push_back(add_dynstr(name));
+        }
+        size_t nsyms = idx;
+
+        // --- GOT: imports primeiro, depois locais ---
+        got_slots_ = 0;
+        for (auto& [name, imp] : imports_) if (imp.needs_got) got_slots_++;
+        got_slots_ += local_got_.size() + local_sym_got_.size();
+        for (auto& [name, imp] : imports_) if (imp.needs_plt) plt_slots_++;
+
+        // --- rela.dyn: GLOB_DAT + COPY + R_X86_64_64 (contados depois) ---
+        size_t n_r64 = 0;
+        for_each_rela([&](size_t oi, uint32_t, const Elf64_Rela& r) {
+            auto& o = objs_[oi];
+            uint32_t si = static_cast<uint32_t>(r.r_info >> 32);
+            uint32_t t = static_cast<uint32_t>(r.r_info & 0xFFFFFFFF);
+            if (t != R_X86_64_64 || si < o.first_global) return;
+            if (o.syms[si].st_shndx != SHN_UNDEF) return;
+            auto it = imports_.find(o.sym_name(si));
+            if (it != imports_.end() && !it->second.needs_copy) n_r64++;
+        });
+        size_t n_rela = n_r64;
+        for (auto& [name, imp] : imports_) {
+            if (imp.needs_got) n_rela++;
+            if (imp.needs_copy) n_rela++;
+        }
+        n_rela_ = n_rela;
+
+        // --- Segmento 1 (R) ---
+        uint64_t off = sizeof(Elf64_Ehdr) + PHNUM * sizeof(Elf64_Phdr);
+        off_interp_ = off;
+        interp_.assign(INTERP, INTERP + std::strlen(INTERP) + 1);
+        off += interp_.size();
+
+        off = align_up(off, 8);
+        off_hash_ = off;
+        size_t nbucket = nsyms;
+        off += (2 + nbucket + nsyms) * 4;
+
+        off = align_up(off, 8);
+        off_dynsym_ = off;
+        off += nsyms * sizeof(Elf64_Sym);
+
+        off_dynstr_ = off;
+        off += dynstr_.size();
+
+        off = align_up(off, 8);
+        off_rela_ = off;
+        off += n_rela * sizeof(Elf64_Rela);
+
+        off = align_up(off, kind_align_[K_RODATA]);
+        off_rodata_ = off;
+        off += kind_data_[K_RODATA].size();
+        seg1_end_ = off;
+
+        // --- Segmento 2 (RX) ---
+        off = align_up(off, PAGE);
+        seg2_off_ = off;
+        off_plt_ = off;
+        off += plt_slots_ * PLT_ENTRY;
+        off = align_up(off, 16);
+        start_addr_ = BASE_ADDR + off;
+        off += START_SIZE;
+        off = align_up(off, kind_align_[K_TEXT]);
+        off_text_ = off;
+        off += kind_data_[K_TEXT].size();
+        seg2_end_ = off;
+
+        // --- Segmento 3 (RW) ---
+        off = align_up(off, PAGE);
+        seg3_off_ = off;
+        off_dynamic_ = off;
+        size_t n_dyn = needed_.size() + 12;
+        off += n_dyn * sizeof(Elf64_Dyn);
+        off = align_up(off, 8);
+        off_got_ = off;
+        off += got_slots_ * 8;
+        off = align_up(off, kind_align_[K_DATA]);
+        off_data_ = off;
+        off += kind_data_[K_DATA].size();
+        seg3_end_ = off;
+
+        kind_addr_[K_RODATA] = BASE_ADDR + off_rodata_;
+        kind_addr_[K_TEXT]   = BASE_ADDR + off_text_;
+        kind_addr_[K_DATA]   = BASE_ADDR + off_data_;
+        bss_addr_ = align_up(BASE_ADDR + seg3_end_, kind_align_[K_BSS]);
+        kind_addr_[K_BSS] = bss_addr_;
+        got_addr_ = BASE_ADDR + off_got_;
+        plt_addr_ = BASE_ADDR + off_plt_;
+
+        // --- Enderecos dos imports ---
+        size_t gslot = 0, pslot = 0;
+        for (auto& [name, imp] : imports_) {
+            if (imp.needs_got) imp.got_addr = got_addr_ + 8 * gslot++;
+            if (imp.needs_plt) imp.plt_addr = plt_addr_ + PLT_ENTRY * pslot++;
+            if (imp.needs_copy) imp.copy_addr = bss_addr_ + imp.copy_bss_off;
+        }
+        for (auto& [key, addr] : local_got_) addr = got_addr_ + 8 * gslot++;
+        for (auto& [key, addr] : local_sym_got_) addr = got_addr_ + 8 * gslot++;
+
+        // --- dynsym ---
+        dynsym_.assign(nsyms * sizeof(Elf64_Sym), 0);
+        for (size_t i = 0; i < dynsym_order_.size(); i++) {
+            const Import& imp = imports_[dynsym_order_[i]];
+            Elf64_Sym s{};
+            s.st_name = dynsym_names_[i];
+            s.st_info = elf_st_info(STB_GLOBAL, imp.type);
+            if (imp.needs_copy) {
+                s.st_shndx = SH_BSS;
+                s.st_value = imp.copy_addr;
+                s.st_size = imp.size;
+            }
+            std::memcpy(&dynsym_[(i + 1) * sizeof(Elf64_Sym)], &s, sizeof(s));
+        }
+
+        // --- hash (SysV) ---
+        std::vector<uint32_t> h(2 + nbucket + nsyms, 0);
+        h[0] = static_cast<uint32_t>(nbucket);
+        h[1] = static_cast<uint32_t>(nsyms);
+        for (size_t i = 1; i < nsyms; i++) {
+            uint32_t b = elf_hash(dynsym_order_[i - 1].c_str()) % nbucket;
+            h[2 + nbucket + i] = h[2 + b];
+            h[2 + b] = static_cast<uint32_t>(i);
+        }
+        hash_.resize(h.size() * 4);
+        std::memcpy(hash_.data(), h.data(), hash_.size());
+
+        // --- PLT: jmp *[rip+got] ; pad ---
+        for (auto& [name, imp] : imports_) {
+            if (!imp.needs_plt) continue;
+            uint64_t p = imp.plt_addr;
+            int32_t rel = static_cast<int32_t>(imp.got_addr - (p + 6));
+            plt_.push_back(0xFF); plt_.push_back(0x25);
+            for (int b = 0; b < 4; b++) plt_.push_back(static_cast<uint8_t>(rel >> (8 * b)));
+            plt_.push_back(0x66); plt_.push_back(0x90);   // xchg ax,ax (pad)
+        }
+
+        // --- GOT: locais preenchidos agora; imports via GLOB_DAT ---
+        got_.assign(got_slots_ * 8, 0);
+        for (auto& [name, imp] : imports_) {
+            if (!imp.needs_got) continue;
+            Elf64_Rela r{};
+            r.r_offset = imp.got_addr;
+            r.r_info = elf_r_info(imp.dynsym, R_X86_64_GLOB_DAT);
+            dyn_relocs_.push_back(r);
+        }
+        for (auto& [name, imp] : imports_) {
+            if (!imp.needs_copy) continue;
+            Elf64_Rela r{};
+            r.r_offset = imp.copy_addr;
+            r.r_info = elf_r_info(imp.dynsym, R_X86_64_COPY);
+            dyn_relocs_.push_back(r);
+        }
+
+        // --- dynamic ---
+        auto dyn = [&](int64_t tag, uint64_t val) {
+            Elf64_Dyn d{tag, val};
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(&d);
+            dynamic_.insert(dynamic_.end(), p, p + sizeof(d));
+        };
+        for (auto o : needed_off) dyn(DT_NEEDED, o);
+        dyn(DT_HASH,   BASE_ADDR + off_hash_);
+        dyn(DT_STRTAB, BASE_ADDR + off_dynstr_);
+        dyn(DT_SYMTAB, BASE_ADDR + off_dynsym_);
+        dyn(DT_STRSZ,  dynstr_.size());
+        dyn(DT_SYMENT, sizeof(Elf64_Sym));
+        dyn(DT_RELA,   BASE_ADDR + off_rela_);
+        dyn(DT_RELASZ, n_rela * sizeof(Elf64_Rela));
+        dyn(DT_RELAENT, sizeof(Elf64_Rela));
+        dyn(DT_DEBUG,  0);
+        dyn(DT_FLAGS,  DF_BIND_NOW);
+        dyn(DT_FLAGS_1, DF_1_NOW);
+        dyn(DT_NULL,   0);
+    }
+
+    // ------------------------------------------------------------------
+    // Aplicacao das relocacoes
+    // ------------------------------------------------------------------
+
+    uint64_t section_addr(const ElfObjetoEntrada& o, uint16_t shndx) const {
+        return kind_addr_[o.sec_kind[shndx]] + o.sec_off[shndx];
+    }
+
+    uint64_t global_addr(const GlobalDef& d) const {
+        if (d.common) return bss_addr_ + d.value;
+        if (d.obj < 0) return d.value;
+        return section_addr(objs_[d.obj], d.shndx) + d.value;
+    }
+
+    // Endereco final de um simbolo (S). got_slot recebe o slot, se houver.
+    bool symbol_addr(size_t oi, uint32_t si, uint32_t type, uint64_t& S, uint64_t& got_slot) {
+        auto& o = objs_[oi];
+        const Elf64_Sym& sym = o.syms[si];
+        got_slot = 0;
+
+        if (si < o.first_global || sym.st_shndx != SHN_UNDEF) {
+            if (sym.st_shndx == SHN_ABS) S = sym.st_value;
+            else if (sym.st_shndx == SHN_COMMON) S = global_addr(globals_[o.sym_name(si)]);
+            else if (si >= o.first_global) S = global_addr(globals_[o.sym_name(si)]);
+            else S = section_addr(o, sym.st_shndx) + sym.st_value;
+            if (is_got_reloc(type)) got_slot = local_sym_got_[{oi, si}];
+            return true;
+        }
+
+        std::string name = o.sym_name(si);
+        if (name == "_GLOBAL_OFFSET_TABLE_") { S = got_addr_; return true; }
+
+        auto g = globals_.find(name);
+        if (g != globals_.end()) {
+            S = global_addr(g->second);
+            if (is_got_reloc(type)) got_slot = local_got_[name];
+            return true;
+        }
+
+        auto it = imports_.find(name);
+        if (it == imports_.end()) {
+            // weak indefinido: endereco 0
+            S = 0;
+            if (is_got_reloc(type)) got_slot = local_got_[name];
+            return true;
+        }
+        const Import& imp = it->second;
+        got_slot = imp.got_addr;
+        if (imp.needs_copy && imp.type == STT_OBJECT) S = imp.copy_addr;
+        else if (imp.needs_plt) S = imp.plt_addr;
+        else S = 0;
+        return true;
+    }
+
+    bool apply_relocations() {
+        // Slots GOT de simbolos locais: endereco absoluto ja conhecido
+        for (auto& [key, slot] : local_sym_got_) {
+            uint64_t S, unused;
+            symbol_addr(key.first, key.second, R_X86_64_PC32, S, unused);
+            std::memcpy(&got_[slot - got_addr_], &S, 8);
+        }
+        for (auto& [name, slot] : local_got_) {
+            auto g = globals_.find(name);
+            if (g == globals_.end()) continue;
+            uint64_t S = global_addr(g->second);
+            std::memcpy(&got_[slot - got_addr_], &S, 8);
+        }
+
+        bool ok = true;
+        for_each_rela([&](size_t oi, uint32_t target, const Elf64_Rela& r) {
+            if (!ok) return;
+            auto& o = objs_[oi];
+            uint32_t si = static_cast<uint32_t>(r.r_info >> 32);
+            uint32_t t = static_cast<uint32_t>(r.r_info & 0xFFFFFFFF);
+            int kind = o.sec_kind[target];
+            if (kind == K_BSS) { ok = fail("relocacao em .bss"); return; }
+            uint64_t sec_off = o.sec_off[target] + r.r_offset;
+            uint64_t P = kind_addr_[kind] + sec_off;
+            uint8_t* loc = kind_data_[kind].data() + sec_off;
+
+            uint64_t S, G;
+            symbol_addr(oi, si, t, S, G);
+            int64_t A = r.r_addend;
+
+            auto put32 = [&](int64_t v, bool is_signed) {
+                bool fits = is_signed ? (v >= INT32_MIN && v <= INT32_MAX)
+                                      : (v >= 0 && v <= static_cast<int64_t>(UINT32_MAX));
+                if (!fits) { ok = fail("relocacao fora do alcance em " + o.path); return; }
+                uint32_t u = static_cast<uint32_t>(v);
+                std::memcpy(loc, &u, 4);
+            };
+
+            switch (t) {
+                case R_X86_64_NONE: break;
+                case R_X86_64_64: {
+                    bool imported = si >= o.first_global &&
+                                    o.syms[si].st_shndx == SHN_UNDEF &&
+                                    imports_.count(o.sym_name(si)) &&
+                                    !globals_.count(o.sym_name(si));
+                    if (imported) {
+                        const Import& imp = imports_[o.sym_name(si)];
+                        if (imp.needs_copy && imp.type == STT_OBJECT) {
+                            uint64_t v = imp.copy_addr + A;
+                            std::memcpy(loc, &v, 8);
+                            break;
+                        }
+                        if (kind != K_DATA) { ok = fail("R_X86_64_64 dinamico fora de .data"); return; }
+                        Elf64_Rela d{};
+                        d.r_offset = P;
+                        d.r_info = elf_r_info(imp.dynsym, R_X86_64_64);
+                        d.r_addend = A;
+                        dyn_relocs_.push_back(d);
+                        uint64_t z = 0;
+                        std::memcpy(loc, &z, 8);
+                    } else {
+                        uint64_t v = S + A;
+                        std::memcpy(loc, &v, 8);
+                    }
+                    break;
+                }
+                case R_X86_64_PC32:
+                case R_X86_64_PLT32:
+                    put32(static_cast<int64_t>(S + A - P), true);
+                    break;
+                case R_X86_64_GOTPCREL:
+                case R_X86_64_GOTPCRELX:
+                case R_X86_64_REX_GOTPCRELX:
+                    if (!G) { ok = fail("slot GOT ausente"); return; }
+                    put32(static_cast<int64_t>(G + A - P), true);
+                    break;
+                case R_X86_64_32:
+                    put32(static_cast<int64_t>(S + A), false);
+                    break;
+                case R_X86_64_32S:
+                    put32(static_cast<int64_t>(S + A), true);
+                    break;
+                case R_X86_64_PC64: {
+                    uint64_t v = S + A - P;
+                    std::memcpy(loc, &v, 8);
+                    break;
+                }
+                default:
+                    ok = fail("relocacao tipo " + std::to_string(t) + " nao suportada em " + o.path);
+                    return;
+            }
+        });
+        if (!ok) return false;
+
+        // rela.dyn final (tamanho ja reservado no layout)
+        if (dyn_relocs_.size() != n_rela_)
+            return fail("contagem de relocacoes dinamicas divergente");
+        rela_.resize(dyn_relocs_.size() * sizeof(Elf64_Rela));
+        std::memcpy(rela_.data(), dyn_relocs_.data(), rela_.size());
+
+        // _start (entrada):
+        //   xor ebp,ebp ; mov r9,rdx ; pop rsi ; mov rdx,rsp ; and rsp,-16
+        //   push rax ; push rsp ; xor r8d,r8d ; xor ecx,ecx
+        //   lea rdi,[rip+main] ; call [rip+__libc_start_main@GOT] ; hlt
+        uint64_t main_addr = global_addr(globals_["main"]);
+        uint64_t lsm_got = imports_["__libc_start_main"].got_addr;
+        std::vector<uint8_t>& s = start_;
+        s = {0x31, 0xED, 0x49, 0x89, 0xD1, 0x5E, 0x48, 0x89, 0xE2,
+             0x48, 0x83, 0xE4, 0xF0, 0x50, 0x54, 0x45, 0x31, 0xC0, 0x31, 0xC9};
+        auto rip_rel = [&](uint64_t target) {
+            int32_t rel = static_cast<int32_t>(target - (start_addr_ + s.size() + 4));
+            for (int b = 0; b < 4; b++) s.push_back(static_cast<uint8_t>(rel >> (8 * b)));
+        };
+        s.push_back(0x48); s.push_back(0x8D); s.push_back(0x3D); rip_rel(main_addr);
+        s.push_back(0xFF); s.push_back(0x15); rip_rel(lsm_got);
+        s.push_back(0xF4);
+        s.resize(START_SIZE, 0xCC);
+        return true;
+    }
+
+    std::vector<uint8_t> start_;
+
+    // Relocacoes das secoes .debug_*: enderecos finais (R_X86_64_64) e
+    // offsets entre secoes de depuracao ja concatenadas (R_X86_64_32)
+    void apply_debug_relocations() {
+        for (size_t oi = 0; oi < objs_.size(); oi++) {
+            auto& o = objs_[oi];
+            for (size_t i = 1; i < o.shnum(); i++) {
+                const Elf64_Shdr& sh = o.shdrs[i];
+                if (sh.sh_type != SHT_RELA || sh.sh_info >= o.shnum()) continue;
+                int target = o.sec_debug[sh.sh_info];
+                if (target < 0) continue;
+                const uint64_t tombstone = debug_[target].name == ".debug_ranges" ? 1 : 0;
+
+                auto* r = reinterpret_cast<const Elf64_Rela*>(o.data.data() + sh.sh_offset);
+                size_t n = sh.sh_size / sizeof(Elf64_Rela);
+                for (size_t k = 0; k < n; k++) {
+                    uint32_t si = static_cast<uint32_t>(r[k].r_info >> 32);
+                    uint32_t t = static_cast<uint32_t>(r[k].r_info & 0xFFFFFFFF);
+                    if (si >= o.sym_count) { debug_.clear(); return; }
+                    const Elf64_Sym& sym = o.syms[si];
+
+                    uint64_t S, unused;
+                    int64_t A = r[k].r_addend;
+                    bool local_sec = si < o.first_global && sym.st_shndx != SHN_UNDEF &&
+                                     sym.st_shndx < o.shnum();
+                    bool coletada = sym.st_shndx != SHN_UNDEF && sym.st_shndx < o.shnum() &&
+                                    o.sec_kind[sym.st_shndx] == SEC_COLETADA &&
+                                    (local_sec || !globals_.count(o.sym_name(si)));
+                    if (coletada) {
+                        S = tombstone;
+                        A = 0;
+                    } else if (local_sec && o.sec_debug[sym.st_shndx] >= 0) {
+                        S = o.sec_off[sym.st_shndx] + sym.st_value;
+                    } else if (local_sec && o.sec_kind[sym.st_shndx] < 0) {
+                        debug_.clear();   // aponta para secao descartada
+                        return;
+                    } else {
+                        symbol_addr(oi, si, t, S, unused);
+                    }
+
+                    uint64_t off = o.sec_off[sh.sh_info] + r[k].r_offset;
+                    auto& buf = debug_[target].data;
+                    uint64_t v = S + A;
+                    if (t == R_X86_64_64 && off + 8 <= buf.size()) {
+                        std::memcpy(&buf[off], &v, 8);
+                    } else if (t == R_X86_64_32 && off + 4 <= buf.size() && v <= UINT32_MAX) {
+                        uint32_t u = static_cast<uint32_t>(v);
+                        std::memcpy(&buf[off], &u, 4);
+                    } else if (t != R_X86_64_NONE) {
+                        debug_.clear();
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Escrita do executavel
+    // ------------------------------------------------------------------
+
+    struct OutSym { std::string name; uint64_t value; uint64_t size; uint8_t info; uint16_t shndx; };
+
+    uint16_t out_shndx(int kind) const {
+        switch (kind) {
+            case K_RODATA: return SH_RODATA;
+            case K_TEXT:   return SH_TEXT;
+            case K_DATA:   return SH_DATA;
+            default:       return SH_BSS;
+        }
+    }
+
+    bool write(const std::string& path) {
+        // .symtab: _start + globais definidos (util para gdb/perf)
+        std::vector<OutSym> syms;
+        syms.push_back({"_start", start_addr_, START_SIZE, elf_st_info(STB_GLOBAL, STT_FUNC), SH_TEXT});
+        for (auto& [name, d] : globals_) {
+            uint16_t sh = SHN_ABS;
+            if (d.common) sh = SH_BSS;
+            else if (d.obj >= 0) sh = out_shndx(objs_[d.obj].sec_kind[d.shndx]);
+            uint8_t type = d.type == STT_FUNC ? STT_FUNC :
+                           (d.type == STT_OBJECT ? STT_OBJECT : STT_NOTYPE);
+            syms.push_back({name, global_addr(d), d.size,
+                            elf_st_info(d.weak ? STB_WEAK : STB_GLOBAL, type), sh});
+        }
+        std::sort(syms.begin(), syms.end(),
+                  [](const OutSym& a, const OutSym& b) { return a.value < b.value; });
+
+        std::vector<uint8_t> strtab(1, 0), symtab(sizeof(Elf64_Sym), 0);
+        for (auto& s : syms) {
+            Elf64_Sym e{};
+            e.st_name = static_cast<uint32_t>(strtab.size());
+            strtab.insert(strtab.end(), s.name.begin(), s.name.end());
+            strtab.push_back(0);
+            e.st_info = s.info;
+            e.st_shndx = s.shndx;
+            e.st_value = s.value;
+            e.st_size = s.size;
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(&e);
+            symtab.insert(symtab.end(), p, p + sizeof(e));
+        }
+
+        // Montar imagem
+        std::vector<uint8_t> img(seg3_end_, 0);
+        auto put = [&](uint64_t off, const std::vector<uint8_t>& v) {
+            if (!v.empty()) std::memcpy(&img[off], v.data(), v.size());
+        };
+        put(off_interp_, interp_);
+        put(off_hash_, hash_);
+        put(off_dynsym_, dynsym_);
+        put(off_dynstr_, dynstr_);
+        put(off_rela_, rela_);
+        put(off_rodata_, kind_data_[K_RODATA]);
+        put(off_plt_, plt_);
+        put(start_addr_ - BASE_ADDR, start_);
+        put(off_text_, kind_data_[K_TEXT]);
+        put(off_dynamic_, dynamic_);
+        put(off_got_, got_);
+        put(off_data_, kind_data_[K_DATA]);
+
+        // Tabelas nao alocadas no fim
+        uint64_t off_symtab = align_up(img.size(), 8);
+        img.resize(off_symtab, 0);
+        img.insert(img.end(), symtab.begin(), symtab.end());
+        uint64_t off_strtab = img.size();
+        img.insert(img.end(), strtab.begin(), strtab.end());
+        std::vector<uint64_t> off_debug;
+        for (auto& d : debug_) {
+            off_debug.push_back(img.size());
+            img.insert(img.end(), d.data.begin(), d.data.end());
+        }
+
+        std::vector<uint8_t> shstr(1, 0);
+        auto shname = [&](const char* n) {
+            uint32_t o = static_cast<uint32_t>(shstr.size());
+            shstr.insert(shstr.end(), n, n + std::strlen(n) + 1);
+            return o;
+        };
+        uint64_t off_shstr = img.size();
+
+        std::vector<Elf64_Shdr> sh(SH_DEBUG + debug_.size());
+        auto sec = [&](size_t i, const char* n, uint32_t type, uint64_t flags,
+                       uint64_t off, uint64_t size, uint64_t al,
+                       uint32_t link = 0, uint32_t info = 0, uint64_t ent = 0, bool alloc = true) {
+            sh[i].sh_name = shname(n);
+            sh[i].sh_type = type;
+            sh[i].sh_flags = flags;
+            sh[i].sh_addr = alloc ? BASE_ADDR + off : 0;
+            sh[i].sh_offset = off;
+            sh[i].sh_size = size;
+            sh[i].sh_link = link;
+            sh[i].sh_info = info;
+            sh[i].sh_addralign = al;
+            sh[i].sh_entsize = ent;
+        };
+        sec(SH_INTERP, ".interp", SHT_PROGBITS, SHF_ALLOC, off_interp_, interp_.size(), 1);
+        sec(SH_HASH, ".hash", SHT_HASH, SHF_ALLOC, off_hash_, hash_.size(), 8, SH_DYNSYM, 0, 4);
+        sec(SH_DYNSYM, ".dynsym", SHT_DYNSYM, SHF_ALLOC, off_dynsym_, dynsym_.size(), 8, SH_DYNSTR, 1, sizeof(Elf64_Sym));
+        sec(SH_DYNSTR, ".dynstr", SHT_STRTAB, SHF_ALLOC, off_dynstr_, dynstr_.size(), 1);
+        sec(SH_RELA_DYN, ".rela.dyn", SHT_RELA, SHF_ALLOC, off_rela_, rela_.size(), 8, SH_DYNSYM, 0, sizeof(Elf64_Rela));
+        sec(SH_RODATA, ".rodata", SHT_PROGBITS, SHF_ALLOC, off_rodata_, kind_data_[K_RODATA].size(), kind_align_[K_RODATA]);
+        sec(SH_PLT, ".plt", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, off_plt_, plt_.size(), 16);
+        sec(SH_TEXT, ".text", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, start_addr_ - BASE_ADDR,
+            off_text_ + kind_data_[K_TEXT].size() - (start_addr_ - BASE_ADDR), 16);
+        sec(SH_DYNAMIC, ".dynamic", SHT_DYNAMIC, SHF_ALLOC | SHF_WRITE, off_dynamic_, dynamic_.size(), 8, SH_DYNSTR, 0, sizeof(Elf64_Dyn));
+        sec(SH_GOT, ".got", SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, off_got_, got_.size(), 8, 0, 0, 8);
+        sec(SH_DATA, ".data", SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, off_data_, kind_data_[K_DATA].size(), kind_align_[K_DATA]);
+        sec(SH_BSS, ".bss", SHT_NOBITS, SHF_ALLOC | SHF_WRITE, bss_addr_ - BASE_ADDR, bss_size_, kind_align_[K_BSS]);
+        sec(SH_SYMTAB, ".symtab", SHT_SYMTAB, 0, off_symtab, symtab.size(), 8, SH_STRTAB, 1, sizeof(Elf64_Sym), false);
+        sec(SH_STRTAB, ".strtab", SHT_STRTAB, 0, off_strtab, strtab.size(), 1, 0, 0, 0, false);
+        sec(SH_SHSTRTAB, ".shstrtab", SHT_STRTAB, 0, off_shstr, 0, 1, 0, 0, 0, false);
+        for (size_t d = 0; d < debug_.size(); d++) {
+            sec(SH_DEBUG + d, debug_[d].name.c_str(), SHT_PROGBITS, 0, off_debug[d],
+                debug_[d].data.size(), 1, 0, 0, 0, false);
+        }
+        sh[SH_SHSTRTAB].sh_size = shstr.size();
+        // .bss nao ocupa arquivo: offset aponta para o fim do segmento RW
+        sh[SH_BSS].sh_offset = seg3_end_;
+
+        img.insert(img.end(), shstr.begin(), shstr.end());
+        uint64_t off_sh = align_up(img.size(), 8);
+        img.resize(off_sh, 0);
+        const uint8_t* shp = reinterpret_cast<const uint8_t*>(sh.data());
+        img.insert(img.end(), shp, shp + sh.size() * sizeof(Elf64_Shdr));
+
+        // Cabecalho ELF
+        Elf64_Ehdr eh{};
+        eh.e_ident[0] = ELFMAG0; eh.e_ident[1] = ELFMAG1;
+        eh.e_ident[2] = ELFMAG2; eh.e_ident[3] = ELFMAG3;
+        eh.e_ident[4] = ELFCLASS64; eh.e_ident[5] = ELFDATA2LSB;
+        eh.e_ident[6] = EV_CURRENT_ID; eh.e_ident[7] = ELFOSABI_NONE;
+        eh.e_type = ET_EXEC;
+        eh.e_machine = EM_X86_64;
+        eh.e_version = 1;
+        eh.e_entry = start_addr_;
+        eh.e_phoff = sizeof(Elf64_Ehdr);
+        eh.e_shoff = off_sh;
+        eh.e_ehsize = sizeof(Elf64_Ehdr);
+        eh.e_phentsize = sizeof(Elf64_Phdr);
+        eh.e_phnum = PHNUM;
+        eh.e_shentsize = sizeof(Elf64_Shdr);
+        eh.e_shnum = static_cast<uint16_t>(sh.size());
+        eh.e_shstrndx = SH_SHSTRTAB;
+        std::memcpy(img.data(), &eh, sizeof(eh));
+
+        // Program headers
+        uint64_t mem3 = (bss_addr_ + bss_size_) - (BASE_ADDR + seg3_off_);
+        Elf64_Phdr ph[PHNUM] = {};
+        ph[0] = {PT_PHDR, PF_R, sizeof(Elf64_Ehdr), BASE_ADDR + sizeof(Elf64_Ehdr),
+                 BASE_ADDR + sizeof(Elf64_Ehdr), PHNUM * sizeof(Elf64_Phdr),
+                 PHNUM * sizeof(Elf64_Phdr), 8};
+        ph[1] = {PT_INTERP, PF_R, off_interp_, BASE_ADDR + off_interp_, BASE_ADDR + off_interp_,
+                 interp_.size(), interp_.size(), 1};
+        ph[2] = {PT_LOAD, PF_R, 0, BASE_ADDR, BASE_ADDR, seg1_end_, seg1_end_, PAGE};
+        ph[3] = {PT_LOAD, PF_R | PF_X, seg2_off_, BASE_ADDR + seg2_off_, BASE_ADDR + seg2_off_,
+                 seg2_end_ - seg2_off_, seg2_end_ - seg2_off_, PAGE};
+        ph[4] = {PT_LOAD, PF_R | PF_W, seg3_off_, BASE_ADDR + seg3_off_, BASE_ADDR + seg3_off_,
+                 seg3_end_ - seg3_off_, mem3, PAGE};
+        ph[5] = {PT_DYNAMIC, PF_R | PF_W, off_dynamic_, BASE_ADDR + off_dynamic_,
+                 BASE_ADDR + off_dynamic_, dynamic_.size(), dynamic_.size(), 8};
+        ph[6] = {PT_GNU_STACK, PF_R | PF_W, 0, 0, 0, 0, 0, 16};
+        std::memcpy(img.data() + sizeof(Elf64_Ehdr), ph, sizeof(ph));
+
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        std::ofstream f(path, std::ios::binary);
+        if (!f.is_open()) return fail("nao criou " + path);
+        f.write(reinterpret_cast<const char*>(img.data()), static_cast<std::streamsize>(img.size()));
+        f.close();
+        if (!f) return fail("falha ao escrever " + path);
+
+        std::filesystem::permissions(path,
+            std::filesystem::perms::owner_all | std::filesystem::perms::group_read |
+            std::filesystem::perms::group_exec | std::filesystem::perms::others_read |
+            std::filesystem::perms::others_exec, ec);
+        return true;
+    }
+};
+
+// ============================================================================
+// ENTRADA: tenta linkar sem ld. Retorna false (com motivo) se o caso nao
+// e suportado — o chamador deve usar o ld externo.
+// ============================================================================
+
+static bool link_builtin_elf(const std::string& obj_path, const std::string& exe_path,
+                             const std::vector<std::string>& extra_objs,
+                             std::string& motivo) {
+    std::vector<std::string> objs = {obj_path};
+    for (auto& o : extra_objs) objs.push_back(o);
+
+    ElfExecWriter writer;
+    if (!writer.link(objs, exe_path)) {
+        motivo = writer.motivo();
+        return false;
+    }
+    return true;
+}
+
+} // namespace jplang
+
+#endif // JPLANG_ELF_EXEC_WRITER_HPP
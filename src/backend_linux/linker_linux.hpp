@@ -12,6 +12,14 @@
 #include <climits>
 #include <unistd.h>
 #include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <unordered_map>
+#include <sys/stat.h>
+
+#include "elf_exec_writer.hpp"
+#include "../tempos.hpp"
 
 namespace fs = std::filesystem;
 
@@ -21,7 +29,11 @@ namespace jplang {
 // UTILITARIOS
 // ============================================================================
 
+// Numero de processos disparados pelas sondagens (usado por 'jp diagnostico')
+static int g_toolchain_spawns = 0;
+
 static std::string ld_exec_cmd(const std::string& cmd) {
+    g_toolchain_spawns++;
     std::array<char, 256> buffer;
     std::string result;
     FILE* pipe = popen(cmd.c_str(), "r");
@@ -37,6 +49,7 @@ static std::string ld_exec_cmd(const std::string& cmd) {
 }
 
 static bool test_executable(const std::string& exe, const std::string& env_prefix = "") {
+    g_toolchain_spawns++;
     std::string cmd = env_prefix + "\"" + exe + "\" --version > /dev/null 2>&1";
     return std::system(cmd.c_str()) == 0;
 }
@@ -148,6 +161,250 @@ static LinkerInfo find_linker() {
     return info;
 }
 
+// ============================================================================
+// CACHE DA DETECCAO DO TOOLCHAIN
+// ============================================================================
+//
+// As sondagens acima disparam 5-10 processos (cc/gcc -print-file-name,
+// ld --version, which). O resultado fica em <dir do jp>/.jp_toolchain_cache,
+// junto com "carimbos" (mtime) de tudo que pode mudar a resposta: cc, gcc,
+// ld escolhido, ld embutido candidato, diretorios de CRT/libgcc e $PATH.
+// Na proxima execucao basta um stat por carimbo; se algum mudou, sonda de novo.
+
+struct ToolchainInfo {
+    LinkerInfo linker;
+    std::string system_crt_dir;
+    std::string gcc_crt_dir;
+    std::string gcc_lib_dir;
+    bool static_libc = false;
+};
+
+static constexpr const char* TOOLCHAIN_CACHE_NOME = ".jp_toolchain_cache";
+static constexpr int TOOLCHAIN_CACHE_VERSAO = 2;
+
+// Diretorio do executavel do compilador (get_exe_dir do main.cpp); o cache
+// e os carimbos do ld embutido sao resolvidos a partir dele
+static std::string g_toolchain_exe_dir;
+
+static void set_toolchain_exe_dir(const std::string& dir) {
+    g_toolchain_exe_dir = dir;
+}
+
+static std::string toolchain_cache_path() {
+    if (g_toolchain_exe_dir.empty()) return "";
+    return (fs::path(g_toolchain_exe_dir) / TOOLCHAIN_CACHE_NOME).string();
+}
+
+// mtime em nanossegundos como texto; "-" se nao existe
+static std::string toolchain_stamp(const std::string& path) {
+    if (path.empty()) return "-";
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return "-";
+    return std::to_string(static_cast<long long>(st.st_mtim.tv_sec)) + "." +
+           std::to_string(static_cast<long long>(st.st_mtim.tv_nsec));
+}
+
+// Resolve um comando no $PATH sem disparar processo
+static std::string find_in_path(const std::string& name) {
+    const char* env = getenv("PATH");
+    if (!env) return "";
+    std::string path_env = env;
+    size_t start = 0;
+    while (start <= path_env.size()) {
+        size_t end = path_env.find(':', start);
+        if (end == std::string::npos) end = path_env.size();
+        std::string dir = path_env.substr(start, end - start);
+        if (dir.empty()) dir = ".";
+        std::string cand = dir + "/" + name;
+        if (::access(cand.c_str(), X_OK) == 0) return cand;
+        start = end + 1;
+    }
+    return "";
+}
+
+// Arquivos cujo mtime invalida o cache
+static std::vector<std::string> toolchain_stamp_paths(const ToolchainInfo& tc) {
+    std::vector<std::string> paths = {
+        find_in_path("cc"),
+        find_in_path("gcc"),
+        tc.linker.ld_exe,
+        tc.system_crt_dir,
+        tc.gcc_crt_dir,
+        tc.gcc_lib_dir,
+    };
+    if (!g_toolchain_exe_dir.empty()) {
+        paths.push_back((fs::path(g_toolchain_exe_dir) / "src/backend_linux/ld_linker/ld").string());
+    }
+    return paths;
+}
+
+// Sondagem completa (sem cache)
+static ToolchainInfo discover_toolchain() {
+    ToolchainInfo tc;
+    tc.linker = find_linker();
+    // ld embutido achado relativo ao diretorio atual: caminho absoluto, para
+    // o cache valer de qualquer diretorio
+    if (!tc.linker.using_system_ld) {
+        std::error_code ec;
+        tc.linker.ld_exe = fs::absolute(tc.linker.ld_exe, ec).string();
+        tc.linker.ld_dir = fs::absolute(tc.linker.ld_dir, ec).string();
+    }
+    tc.system_crt_dir = find_system_crt_dir();
+    tc.gcc_crt_dir = find_gcc_crt_dir();
+    tc.gcc_lib_dir = find_gcc_lib_dir();
+    // libc.a so importa quando o ld do sistema e usado
+    tc.static_libc = tc.linker.using_system_ld ? has_static_libc(tc.system_crt_dir) : false;
+    return tc;
+}
+
+// `motivo` (opcional) recebe por que o cache nao vale: ausente, versao,
+// $PATH ou o carimbo que mudou
+static bool read_toolchain_cache(const std::string& cache_path, ToolchainInfo& tc,
+                                 std::string* motivo = nullptr) {
+    auto invalido = [&](const std::string& m) {
+        if (motivo) *motivo = m;
+        return false;
+    };
+    std::ifstream in(cache_path);
+    if (!in.is_open()) return invalido("ausente");
+
+    std::unordered_map<std::string, std::string> kv;
+    std::vector<std::pair<std::string, std::string>> stamps;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        std::string key = line.substr(0, eq);
+        std::string val = line.substr(eq + 1);
+        if (key == "carimbo") {
+            size_t bar = val.rfind('|');
+            if (bar == std::string::npos) return invalido("corrompido");
+            stamps.push_back({val.substr(0, bar), val.substr(bar + 1)});
+        } else {
+            kv[key] = val;
+        }
+    }
+
+    if (kv.empty()) return invalido("vazio ou ilegivel");
+    if (kv["versao"] != std::to_string(TOOLCHAIN_CACHE_VERSAO)) return invalido("versao antiga");
+    const char* path_env = getenv("PATH");
+    if (kv["path"] != (path_env ? path_env : "")) return invalido("desatualizado: $PATH mudou");
+
+    tc.linker.ld_exe = kv["ld_exe"];
+    tc.linker.ld_dir = kv["ld_dir"];
+    tc.linker.using_system_ld = kv["using_system_ld"] == "1";
+    tc.system_crt_dir = kv["system_crt_dir"];
+    tc.gcc_crt_dir = kv["gcc_crt_dir"];
+    tc.gcc_lib_dir = kv["gcc_lib_dir"];
+    tc.static_libc = kv["static_libc"] == "1";
+
+    // Revalidar: mesmos arquivos, mesmos mtimes
+    std::vector<std::string> paths = toolchain_stamp_paths(tc);
+    if (paths.size() != stamps.size()) return invalido("desatualizado: outros arquivos");
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (stamps[i].first != paths[i]) return invalido("desatualizado: outros arquivos");
+        if (stamps[i].second != toolchain_stamp(paths[i])) {
+            return invalido("desatualizado: mtime de " + (paths[i].empty() ? "-" : paths[i]));
+        }
+    }
+    return true;
+}
+
+// false se nao deu para gravar (diretorio sem permissao: segue sem cache)
+static bool write_toolchain_cache(const std::string& cache_path, const ToolchainInfo& tc) {
+    std::string tmp = cache_path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(tmp);
+        if (!out.is_open()) return false;
+        const char* path_env = getenv("PATH");
+        out << "versao=" << TOOLCHAIN_CACHE_VERSAO << "\n";
+        out << "path=" << (path_env ? path_env : "") << "\n";
+        out << "ld_exe=" << tc.linker.ld_exe << "\n";
+        out << "ld_dir=" << tc.linker.ld_dir << "\n";
+        out << "using_system_ld=" << (tc.linker.using_system_ld ? 1 : 0) << "\n";
+        out << "system_crt_dir=" << tc.system_crt_dir << "\n";
+        out << "gcc_crt_dir=" << tc.gcc_crt_dir << "\n";
+        out << "gcc_lib_dir=" << tc.gcc_lib_dir << "\n";
+        out << "static_libc=" << (tc.static_libc ? 1 : 0) << "\n";
+        for (auto& p : toolchain_stamp_paths(tc)) {
+            out << "carimbo=" << p << "|" << toolchain_stamp(p) << "\n";
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, cache_path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+// Entrada usada pelo link: cache valido ou sondagem + gravacao
+static ToolchainInfo load_toolchain(bool* from_cache = nullptr) {
+    std::string cache_path = toolchain_cache_path();
+    ToolchainInfo tc;
+    if (!cache_path.empty() && read_toolchain_cache(cache_path, tc)) {
+        if (from_cache) *from_cache = true;
+        return tc;
+    }
+    if (from_cache) *from_cache = false;
+    tc = discover_toolchain();
+    if (!cache_path.empty()) write_toolchain_cache(cache_path, tc);
+    return tc;
+}
+
+// ============================================================================
+// DIAGNOSTICO: jp diagnostico
+// ============================================================================
+
+static int diagnostico_toolchain() {
+    using clock = std::chrono::steady_clock;
+    auto ms = [](clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    // Estado do cache antes desta execucao regravar
+    std::string cache_path = toolchain_cache_path();
+    std::string estado = "-";
+    if (!cache_path.empty()) {
+        ToolchainInfo anterior;
+        std::string motivo;
+        estado = read_toolchain_cache(cache_path, anterior, &motivo) ? "valido" : motivo;
+    }
+
+    int spawns_antes = g_toolchain_spawns;
+    auto t0 = clock::now();
+    ToolchainInfo tc = discover_toolchain();
+    auto t1 = clock::now();
+    int spawns_sem_cache = g_toolchain_spawns - spawns_antes;
+
+    bool gravou = !cache_path.empty() && write_toolchain_cache(cache_path, tc);
+    if (!cache_path.empty() && !gravou) estado += ", nao gravavel";
+
+    ToolchainInfo cached;
+    spawns_antes = g_toolchain_spawns;
+    auto t2 = clock::now();
+    if (gravou) read_toolchain_cache(cache_path, cached);
+    auto t3 = clock::now();
+    int spawns_com_cache = g_toolchain_spawns - spawns_antes;
+
+    std::cout << "Diagnostico do toolchain (Linux)" << std::endl;
+    std::cout << "  ld             : " << tc.linker.ld_exe
+              << (tc.linker.using_system_ld ? " (sistema)" : " (embutido)") << std::endl;
+    std::cout << "  CRT glibc      : " << (tc.system_crt_dir.empty() ? "-" : tc.system_crt_dir) << std::endl;
+    std::cout << "  CRT gcc        : " << (tc.gcc_crt_dir.empty() ? "-" : tc.gcc_crt_dir) << std::endl;
+    std::cout << "  libgcc         : " << (tc.gcc_lib_dir.empty() ? "-" : tc.gcc_lib_dir) << std::endl;
+    std::cout << "  libc.a         : " << (tc.static_libc ? "sim" : "nao") << std::endl;
+    std::cout << "  Cache          : " << (cache_path.empty() ? "-" : cache_path)
+              << " (" << estado << ")" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Sem cache      : " << ms(t1 - t0) << " ms ("
+              << spawns_sem_cache << " processos)" << std::endl;
+    std::cout << "  Com cache      : " << ms(t3 - t2) << " ms ("
+              << spawns_com_cache << " processos)" << std::endl;
+    return 0;
+}
+
 // Helper: CRT do sistema se existir, senao embutido
 static std::string resolve_crt(const std::string& name,
                                 const std::string& system_dir,
@@ -178,6 +435,12 @@ static void add_L(std::string& cmd, const std::string& dir, std::vector<std::str
 // LINKAGEM: .o -> executavel
 //
 // Decisao de modo:
+//   - Sem .jpd e sem libs extras     -> linkador embutido (ElfExecWriter),
+//                                       libc dinamica (o executavel depende
+//                                       da glibc da maquina); se o caso nao
+//                                       for suportado, segue para o ld abaixo
+//   - -estatico (ou JP_LD_EXTERNO=1) -> pula o embutido: ld, estatico
+//                                       quando ha libc.a
 //   - Se tem .jpd (extra_dlls)       -> sempre dinamico
 //   - Se ld embutido funciona        -> estatico com libs embutidas
 //   - Se ld do sistema + libc.a      -> estatico com libs do sistema
@@ -189,28 +452,55 @@ static bool link_with_ld(const std::string& obj_path, const std::string& exe_pat
                           const std::vector<std::string>& extra_libs = {},
                           const std::vector<std::string>& extra_lib_paths = {},
                           const std::vector<std::string>& extra_dlls = {},
-                          bool windowed = false) {
+                          bool windowed = false,
+                          bool estatico = false) {
 
     (void)windowed; // Ignorado no Linux
 
-    LinkerInfo linker = find_linker();
+    // Linkador embutido: evita ld, CRTs e sondagens do toolchain.
+    // -estatico ou JP_LD_EXTERNO=1 forcam o ld externo.
+    const char* ld_externo = getenv("JP_LD_EXTERNO");
+    bool usar_embutido = !estatico && extra_dlls.empty() && extra_libs.empty() &&
+                         !(ld_externo && std::string(ld_externo) == "1");
+    if (usar_embutido) {
+        std::string motivo;
+        if (link_builtin_elf(obj_path, exe_path, extra_objs, motivo)) {
+            return true;
+        }
+        // Caso nao suportado: segue com ld (motivo fica so para depuracao)
+        (void)motivo;
+    }
+
+    Cronometro descoberta;
+    bool do_cache = false;
+    int spawns = g_toolchain_spawns;
+    ToolchainInfo tc = load_toolchain(&do_cache);
+    Tempos::global().fase("descoberta do toolchain", descoberta.ms(),
+                          {{"cache", do_cache ? 1u : 0u},
+                           {"processos", static_cast<uint64_t>(g_toolchain_spawns - spawns)}});
+    const LinkerInfo& linker = tc.linker;
 
     if (!linker.using_system_ld && !fs::exists(linker.ld_exe)) {
         std::cerr << "Erro: ld nao encontrado" << std::endl;
         return false;
     }
 
-    std::string system_crt_dir = find_system_crt_dir();
-    std::string gcc_crt_dir = find_gcc_crt_dir();
-    std::string gcc_lib_dir = find_gcc_lib_dir();
+    const std::string& system_crt_dir = tc.system_crt_dir;
+    const std::string& gcc_crt_dir = tc.gcc_crt_dir;
+    const std::string& gcc_lib_dir = tc.gcc_lib_dir;
 
     bool has_jpd = !extra_dlls.empty();
 
     // Decidir se linkagem sera estatica ou dinamica
     bool force_dynamic = has_jpd;
-    if (!force_dynamic && linker.using_system_ld && !has_static_libc(system_crt_dir)) {
+    if (!force_dynamic && linker.using_system_ld && !tc.static_libc) {
         force_dynamic = true;
     }
+    if (estatico && force_dynamic) {
+        std::cerr << "Aviso: -estatico ignorado ("
+                  << (has_jpd ? "biblioteca .jpd" : "libc.a nao encontrada")
+                  << "): linkando dinamico" << std::endl;
+    }
 
     // Montar comando
     std::string cmd;
@@ -221,6 +511,8 @@ static bool link_with_ld(const std::string& obj_path, const std::string& exe_pat
 
     cmd += "\"" + linker.ld_exe + "\"";
     cmd += " -m elf_x86_64 --hash-style=gnu";
+    // Uma seção .text.<nome> por função: as que ninguém chama saem
+    cmd += " --gc-sections";
 
     if (force_dynamic) {
         // ================================================================
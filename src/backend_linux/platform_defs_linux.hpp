@@ -5,6 +5,9 @@
 #define JPLANG_PLATFORM_DEFS_HPP
 
 #include "elf_emitter.hpp"
+#include "dwarf_emitter.hpp"
+
+#include <algorithm>
 
 namespace jplang {
 
@@ -35,6 +38,16 @@ namespace xmm {
     constexpr uint8_t XMM3 = 3;
     constexpr uint8_t XMM4 = 4;
     constexpr uint8_t XMM5 = 5;
+    constexpr uint8_t XMM6 = 6;
+    constexpr uint8_t XMM7 = 7;
+    constexpr uint8_t XMM8 = 8;
+    constexpr uint8_t XMM9 = 9;
+    constexpr uint8_t XMM10 = 10;
+    constexpr uint8_t XMM11 = 11;
+    constexpr uint8_t XMM12 = 12;
+    constexpr uint8_t XMM13 = 13;
+    constexpr uint8_t XMM14 = 14;
+    constexpr uint8_t XMM15 = 15;
 }
 
 // ============================================================================
@@ -72,6 +85,12 @@ struct PlatformDefs {
     static constexpr uint8_t FLOAT_ARG3 = xmm::XMM2;
     static constexpr uint8_t FLOAT_ARG4 = xmm::XMM3;
 
+    // --- Pilha de registradores XMM das expressões float ---
+    //
+    // System V: XMM0-XMM15 são todos voláteis, a pilha pode usar os 16.
+    //
+    static constexpr uint8_t FLOAT_EXPR_REGS = 16;
+
     // Stack mínima no prólogo (sem shadow space, apenas alinhamento)
     static constexpr int32_t MIN_STACK = 16;
 
@@ -118,6 +137,43 @@ struct PlatformDefs {
         // Seção vazia que indica stack não-executável (evita warning do ld)
         emitter.create_section(".note.GNU-stack", SHT_PROGBITS, 0, 1);
     }
+
+    // --- Uma seção .text.<nome> por função ---
+    // O --gc-sections do linkador (ld ou embutido) descarta as que ninguém
+    // referencia. Bytes antes da primeira função vão com ela; os depois da
+    // última (tabelas, handler) também. Sem divisão (tabela do perfilador
+    // usa offsets de .text), info.trechos fica vazio.
+    static void split_text_by_function(Emitter& emitter, size_t text_idx,
+                                       InfoDepuracao& info) {
+        info.trechos.clear();
+        std::vector<const FuncaoDepuracao*> funcs;
+        for (auto& f : info.funcoes) funcs.push_back(&f);
+        std::stable_sort(funcs.begin(), funcs.end(),
+                         [](auto* a, auto* b) { return a->inicio < b->inicio; });
+
+        uint64_t size = emitter.section(text_idx).size();
+        std::vector<ElfEmitter::SectionPart> parts;
+        for (auto* f : funcs) {
+            if (f->inicio >= size) break;
+            if (!parts.empty() && f->inicio == parts.back().begin) continue;
+            if (!parts.empty()) parts.back().end = f->inicio;
+            parts.push_back({".text." + f->nome, parts.empty() ? 0 : f->inicio, size});
+        }
+        if (parts.size() < 2) return;
+
+        std::vector<size_t> indices;
+        if (!emitter.split_section(text_idx, parts, indices)) return;
+        for (size_t i = 0; i < parts.size(); i++) {
+            info.trechos.push_back({indices[i], static_cast<uint32_t>(parts[i].begin),
+                                    static_cast<uint32_t>(parts[i].end)});
+        }
+    }
+
+    // --- Informações de depuração (DWARF: linhas .jp e funções) ---
+    static void emit_debug_info(Emitter& emitter, size_t text_idx,
+                                const InfoDepuracao& info) {
+        emit_dwarf(emitter, text_idx, info);
+    }
 };
 
 } // namespace jplang
@@ -267,6 +267,10 @@ public:
         return register_symbol(sym);
     }
 
+    // COFF não guarda tamanho de símbolo; a extensão das funções vai nos
+    // dados de unwind/depuração. Existe para a interface comum com o ELF.
+    void set_symbol_size(uint32_t /*id*/, uint64_t /*size*/) {}
+
     uint32_t symbol_index(const std::string& name) const {
         auto it = symbol_index_map_.find(name);
         if (it == symbol_index_map_.end())
@@ -278,6 +282,14 @@ public:
         return symbol_index_map_.count(name) > 0;
     }
 
+    // Símbolos na ordem de registro (índice = ID usado nas relocações);
+    // usado para juntar fragmentos gerados em paralelo
+    size_t symbol_count() const { return symbol_order_.size(); }
+
+    const SymbolInfo& symbol_at(uint32_t index) const {
+        return symbols_[symbol_order_[index]];
+    }
+
     // ------------------------------------------------------------------
     // Serialização
     // ------------------------------------------------------------------
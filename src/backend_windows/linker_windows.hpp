@@ -69,7 +69,10 @@ static bool link_with_ld(const std::string& obj_path, const std::string& exe_pat
                           const std::vector<std::string>& extra_libs = {},
                           const std::vector<std::string>& extra_lib_paths = {},
                           const std::vector<std::string>& extra_dlls = {},
-                          bool windowed = false) {
+                          bool windowed = false,
+                          bool estatico = false) {
+
+    (void)estatico; // -estatico: so Linux (no Windows o .exe ja nao depende de libc dinamica)
 
     // Procurar ld.exe relativo ao diretorio atual
     std::string ld_dir = "src\\backend_windows\\ld_linker";
@@ -183,6 +186,21 @@ static bool link_with_ld(const std::string& obj_path, const std::string& exe_pat
     return true;
 }
 
+// ============================================================================
+// DIAGNOSTICO: jp diagnostico
+// No Windows o ld.exe embutido e usado direto, sem sondagens de toolchain.
+// ============================================================================
+
+// Sem cache de toolchain no Windows (mesma interface do Linux)
+static void set_toolchain_exe_dir(const std::string&) {}
+
+static int diagnostico_toolchain() {
+    std::cout << "Diagnostico do toolchain (Windows)" << std::endl;
+    std::cout << "  ld             : src\\backend_windows\\ld_linker\\ld.exe (embutido)" << std::endl;
+    std::cout << "  Sondagens      : nenhuma (nada a cachear)" << std::endl;
+    return 0;
+}
+
 } // namespace jplang
 
 #endif // JPLANG_LINKER_WINDOWS_HPP
\ No newline at end of file
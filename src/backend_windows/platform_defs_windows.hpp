@@ -5,6 +5,7 @@
 #define JPLANG_PLATFORM_DEFS_HPP
 
 #include "coff_emitter.hpp"
+#include "../depuracao.hpp"
 
 namespace jplang {
 
@@ -35,6 +36,16 @@ namespace xmm {
     constexpr uint8_t XMM3 = 3;
     constexpr uint8_t XMM4 = 4;
     constexpr uint8_t XMM5 = 5;
+    constexpr uint8_t XMM6 = 6;
+    constexpr uint8_t XMM7 = 7;
+    constexpr uint8_t XMM8 = 8;
+    constexpr uint8_t XMM9 = 9;
+    constexpr uint8_t XMM10 = 10;
+    constexpr uint8_t XMM11 = 11;
+    constexpr uint8_t XMM12 = 12;
+    constexpr uint8_t XMM13 = 13;
+    constexpr uint8_t XMM14 = 14;
+    constexpr uint8_t XMM15 = 15;
 }
 
 // ============================================================================
@@ -73,6 +84,13 @@ struct PlatformDefs {
     static constexpr uint8_t FLOAT_ARG3 = xmm::XMM2;
     static constexpr uint8_t FLOAT_ARG4 = xmm::XMM3;
 
+    // --- Pilha de registradores XMM das expressões float ---
+    //
+    // Win64: XMM6-XMM15 são não-voláteis (o prólogo não os salva),
+    // a pilha fica em XMM0-XMM5.
+    //
+    static constexpr uint8_t FLOAT_EXPR_REGS = 6;
+
     // Stack mínima no prólogo (shadow space = 32 bytes)
     static constexpr int32_t MIN_STACK = 32;
 
@@ -126,6 +144,17 @@ struct PlatformDefs {
     static void create_extra_sections(Emitter& /*emitter*/) {
         // Windows não precisa de seções extras (sem .note.GNU-stack)
     }
+
+    // --- Seções por função ---
+    // Ainda não: o objeto COFF continua com um .text só
+    static void split_text_by_function(Emitter& /*emitter*/, size_t /*text_idx*/,
+                                       InfoDepuracao& /*info*/) {}
+
+    // --- Informações de depuração ---
+    // CodeView (.debug$S/.debug$T) ainda não é gerado: o objeto COFF sai
+    // sem tabela de linhas
+    static void emit_debug_info(Emitter& /*emitter*/, size_t /*text_idx*/,
+                                const InfoDepuracao& /*info*/) {}
 };
 
 } // namespace jplang
@@ -0,0 +1,210 @@
+// build_cache.hpp
+// Cache de build incremental — output/.cache
+//
+// Cada `jp build` bem-sucedido grava um manifesto com o hash do conteúdo
+// (FNV-1a 64) de tudo que influencia o executável: fonte, imports .jp
+// transitivos, JSON de idioma, JSONs das bibliotecas, binários .o/.jpd,
+// versão do compilador e flags de build. No build seguinte, se todos os
+// hashes batem e o executável gerado continua igual, codegen e linkagem
+// são pulados.
+
+#ifndef JPLANG_BUILD_CACHE_HPP
+#define JPLANG_BUILD_CACHE_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <cstdint>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace jplang {
+
+// ============================================================================
+// CONFIGURAÇÃO
+// ============================================================================
+
+static const std::string JP_COMPILER_VERSION = "1.0";
+static const std::string BUILD_CACHE_DIR = ".cache";
+
+// ============================================================================
+// HASH DE CONTEÚDO (FNV-1a 64 bits)
+// ============================================================================
+
+static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+static constexpr uint64_t FNV_PRIME  = 1099511628211ull;
+
+static uint64_t fnv1a64(const void* data, size_t len, uint64_t h = FNV_OFFSET) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static std::string hash_hex(uint64_t h) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+    return buf;
+}
+
+// Hash do conteúdo de um arquivo; "" se não existe
+static std::string hash_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return "";
+    uint64_t h = FNV_OFFSET;
+    char buf[65536];
+    while (file) {
+        file.read(buf, sizeof(buf));
+        std::streamsize n = file.gcount();
+        if (n > 0) h = fnv1a64(buf, static_cast<size_t>(n), h);
+    }
+    return hash_hex(h);
+}
+
+// ============================================================================
+// IDENTIDADE DO COMPILADOR
+// Versão + tamanho + mtime do próprio executável: recompilar o jp invalida
+// todos os manifestos sem precisar ler o binário inteiro.
+// ============================================================================
+
+static std::string compiler_identity() {
+    std::string exe;
+    #ifdef _WIN32
+    {
+        char buf[MAX_PATH];
+        DWORD len = GetModuleFileNameA(NULL, buf, MAX_PATH);
+        if (len > 0 && len < MAX_PATH) exe.assign(buf, len);
+    }
+    #else
+    {
+        char buf[4096];
+        ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+        if (len > 0) exe.assign(buf, static_cast<size_t>(len));
+    }
+    #endif
+
+    std::string id = JP_COMPILER_VERSION;
+    std::error_code ec;
+    if (!exe.empty()) {
+        auto size = fs::file_size(exe, ec);
+        if (!ec) id += ":" + std::to_string(size);
+        auto mtime = fs::last_write_time(exe, ec);
+        if (!ec) id += ":" + std::to_string(mtime.time_since_epoch().count());
+    }
+    return id;
+}
+
+// ============================================================================
+// CACHE
+// ============================================================================
+
+class BuildCache {
+public:
+    // out_root: diretório output/; flags: texto que diferencia builds
+    // (ex.: "-w -debug") do mesmo fonte
+    BuildCache(const fs::path& out_root, const std::string& input_path,
+               const std::string& flags)
+        : flags_(flags) {
+        std::error_code ec;
+        std::string abs = fs::weakly_canonical(input_path, ec).string();
+        if (ec) abs = fs::absolute(input_path).string();
+        std::string stem = fs::path(input_path).stem().string();
+        manifest_path_ = out_root / BUILD_CACHE_DIR /
+            (stem + "-" + hash_hex(fnv1a64(abs.data(), abs.size())) + ".manifest");
+        compiler_id_ = compiler_identity();
+    }
+
+    // Verdadeiro se o manifesto existe, todas as dependências têm o mesmo
+    // hash e o executável gravado não mudou
+    bool hit(const fs::path& exe_path) const {
+        std::ifstream in(manifest_path_);
+        if (!in.is_open()) return false;
+
+        bool saw_exe = false;
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) continue;
+            std::string key = line.substr(0, eq);
+            std::string val = line.substr(eq + 1);
+
+            if (key == "compilador") {
+                if (val != compiler_id_) return false;
+            } else if (key == "flags") {
+                if (val != flags_) return false;
+            } else if (key == "dep" || key == "exe") {
+                size_t bar = val.find('|');
+                if (bar == std::string::npos) return false;
+                std::string hash = val.substr(0, bar);
+                std::string path = val.substr(bar + 1);
+                if (key == "exe") {
+                    if (fs::path(path) != exe_path) return false;
+                    saw_exe = true;
+                }
+                if (hash_file(path) != hash) return false;
+            }
+        }
+        return saw_exe;
+    }
+
+    // Grava o manifesto após um build completo
+    void store(const std::vector<std::string>& deps, const fs::path& exe_path) const {
+        std::error_code ec;
+        fs::create_directories(manifest_path_.parent_path(), ec);
+
+        std::ostringstream out;
+        out << "compilador=" << compiler_id_ << "\n";
+        out << "flags=" << flags_ << "\n";
+        std::vector<std::string> seen;
+        for (auto& d : deps) {
+            if (d.empty()) continue;
+            bool dup = false;
+            for (auto& s : seen) { if (s == d) { dup = true; break; } }
+            if (dup) continue;
+            seen.push_back(d);
+            std::string h = hash_file(d);
+            if (h.empty()) return;   // dependência sumiu: não grava cache
+            out << "dep=" << h << "|" << d << "\n";
+        }
+        std::string exe_hash = hash_file(exe_path.string());
+        if (exe_hash.empty()) return;
+        out << "exe=" << exe_hash << "|" << exe_path.string() << "\n";
+
+        fs::path tmp = manifest_path_;
+        tmp += ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary);
+            if (!f.is_open()) return;
+            f << out.str();
+        }
+        fs::rename(tmp, manifest_path_, ec);
+        if (ec) fs::remove(tmp, ec);
+    }
+
+    // Remove o manifesto (build falhou ou foi forçado)
+    void invalidate() const {
+        std::error_code ec;
+        fs::remove(manifest_path_, ec);
+    }
+
+private:
+    fs::path manifest_path_;
+    std::string compiler_id_;
+    std::string flags_;
+};
+
+} // namespace jplang
+
+#endif // JPLANG_BUILD_CACHE_HPP
@@ -16,17 +16,33 @@
 
 #include "../frontend/ast.hpp"
 #include "../frontend/lexer.hpp"  // LangConfig
+#include "../build_cache.hpp"       // hash de conteúdo (cache de módulos)
+#include "../tempos.hpp"            // --tempos
+#include "../depuracao.hpp"         // tabela de linhas (DWARF)
+#include "../pgo.hpp"               // perfil de -pgo-usar
+#include "../tamanho.hpp"           // --tamanho
 
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <deque>
 #include <stdexcept>
 #include <cstring>
 #include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cctype>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <memory>
+#include <map>
+#include <set>
+#include <tuple>
+#include <optional>
 
 namespace jplang {
 
@@ -34,24 +50,6 @@ namespace jplang {
 // INFORMAÇÃO DE VARIÁVEL LOCAL
 // ============================================================================
 
-struct LocalVar {
-    std::string name;
-    int32_t rbp_offset;
-};
-
-// ============================================================================
-// TIPO EM TEMPO DE COMPILAÇÃO (para type tracking simples)
-// ============================================================================
-
-enum class RuntimeType {
-    Int,
-    Float,
-    String,
-    Bool,
-    Null,
-    Unknown
-};
-
 // ============================================================================
 // INFORMAÇÃO DE FUNÇÃO
 // ============================================================================
@@ -59,7 +57,7 @@ enum class RuntimeType {
 struct FuncInfo {
     std::string name;
     uint32_t symbol_index = 0;
-    std::vector<std::string> params;
+    std::vector<Sym> params;
     std::vector<RuntimeType> param_types;
 };
 
@@ -96,6 +94,10 @@ public:
         extra_libs_.clear();
         extra_lib_paths_.clear();
         extra_dll_paths_.clear();
+        manifest_paths_.clear();
+        importacoes_nativas_.clear();
+        alcance_.reset();
+        pilha_sitios_.reset();
 
         // Extrair nome do arquivo fonte para diagnostico
         {
@@ -107,6 +109,11 @@ public:
             if (dot != std::string::npos) src_name = src_name.substr(0, dot) + ".jp";
             set_diag_source_file(src_name);
         }
+        init_depuracao(program);
+        if (perfil_ && !adicionar_objeto_runtime("perfil")) return false;
+        if (contadores_ && !adicionar_objeto_runtime("contadores")) return false;
+        if (pgo_gerar_ && !adicionar_objeto_runtime("pgo")) return false;
+        localizar_jprt();
 
         // Criar seções
         emitter_.create_text_section();   // [0]
@@ -148,37 +155,108 @@ public:
             }, stmt->node);
         }
 
+        Tempos& tempos = Tempos::global();
+
         // Resolver tipos de atributos de classes a partir dos call sites
+        Cronometro fase;
         if constexpr (PlatformDefs::is_windows) {
             resolve_class_attr_types(program);
         } else {
             preanalyze_constructor_calls(program);
         }
+        tempos.fase(PlatformDefs::is_windows ? "resolve_class_attr_types"
+                                             : "preanalyze_constructor_calls",
+                    fase.ms(), {{"classes", declared_classes_.size()}});
 
         // Pré-analisar tipos de retorno das funções do usuário
         // (precisa rodar antes de emit_main para que infer_expr_type funcione)
+        fase = Cronometro();
         preanalyze_func_return_types(program);
+        tempos.fase("preanalyze_func_return_types", fase.ms(),
+                    {{"tipos_de_retorno", func_return_types_.size()}});
+
+        // Declarações que o main alcança (só elas são emitidas e analisadas);
+        // instâncias e listas que não escapam vão para o frame
+        index_modules(program);
+        calcular_alcance(program);
+        calcular_escape(program);
+        indexar_folhas_pgo(program);
 
         // Gerar main
+        fase = Cronometro();
+        size_t main_inicio = text_->pos();
         emit_main_function(program);
+        registrar_tamanho_funcao("main", main_inicio);
+        tempos.fase("emit_main_function", fase.ms(),
+                    {{"bytes", text_->pos() - main_inicio},
+                     {"locais", locals_.size()},
+                     {"temps", count_temps()}});
 
         // Gerar funções e métodos de classe
-        for (auto& stmt : program.statements) {
-            std::visit([&](const auto& node) {
-                using T = std::decay_t<decltype(node)>;
-                if constexpr (std::is_same_v<T, FuncaoStmt>) {
-                    emit_function(node);
-                }
-                else if constexpr (std::is_same_v<T, ClasseStmt>) {
-                    emit_class_methods(node);
-                }
-            }, stmt->node);
+        // (declarações de módulos importados vão para objetos próprios)
+        fase = Cronometro();
+        size_t funcs_inicio = text_->pos();
+        bool modules_ok = true;
+        unsigned threads = parallel_thread_count(program);
+        if (threads > 1) {
+            modules_ok = emit_functions_parallel(program, threads);
         }
+        else {
+            for (auto& stmt : program.statements) {
+                std::visit([&](const auto& node) {
+                    using T = std::decay_t<decltype(node)>;
+                    if constexpr (std::is_same_v<T, FuncaoStmt> ||
+                                  std::is_same_v<T, ClasseStmt>) {
+                        int mod = module_of(node.name);
+                        if (!alcancavel(node)) {
+                            // ninguém chama: nem o corpo nem o módulo
+                        }
+                        else if (mod >= 0) {
+                            if (!emit_module(program, static_cast<size_t>(mod)))
+                                modules_ok = false;
+                        }
+                        else if constexpr (std::is_same_v<T, FuncaoStmt>) {
+                            emit_function(node);
+                        }
+                        else {
+                            emit_class_methods(node);
+                        }
+                    }
+                }, stmt->node);
+            }
+        }
+        if (!modules_ok) return false;
+        if (!relatar_erros_tipo()) return false;
+        descartar_importacoes_sem_uso();
+        ordenar_funcoes_pgo(static_cast<uint32_t>(funcs_inicio));
+        tempos.fase("emit_function (todas)", fase.ms(),
+                    {{"funcoes", tempos_funcoes_.size()},
+                     {"bytes", text_->pos() - funcs_inicio},
+                     {"threads", threads}});
+        tempos.funcoes(tempos_funcoes_);
 
         // Gerar handler de crash (após main e funções, como função separada)
-        emit_crash_handler_func();
+        medir_tamanho("suporte (crash/indice)", [&] {
+            emit_crash_handler_func();
+            emit_erro_indice_func();
+        });
+
+        // Tabela de endereços do perfilador (-perfil), contadores (-contadores)
+        // e pontos de -pgo-gerar
+        emitir_tabela_perfil();
+        emitir_tabela_contadores();
+        emitir_tabela_pgo();
 
-        return emitter_.write(output_path);
+        fechar_tamanho();
+
+        fase = Cronometro();
+        emitir_depuracao();
+        bool written = emitter_.write(output_path);
+        std::error_code ec;
+        auto obj_size = std::filesystem::file_size(output_path, ec);
+        tempos.fase(PlatformDefs::is_windows ? "CoffEmitter::write" : "ElfEmitter::write",
+                    fase.ms(), {{"bytes", ec ? 0 : static_cast<uint64_t>(obj_size)}});
+        return written;
     }
 
     // ======================================================================
@@ -187,9 +265,45 @@ public:
 
     void set_exe_dir(const std::string& dir) { exe_dir_ = dir; }
 
+    // Caminho do .jp principal (nome da unidade nas informações de depuração)
+    void set_source_path(const std::string& path) { source_path_ = path; }
+
     // Ativa modo debug (trace de chamadas FFI)
     void set_debug_mode(bool enabled) { debug_mode_ = enabled; }
 
+    // Liga o perfilador por amostragem (runtime/perfil.o, só Linux)
+    void set_perfil(bool enabled) { perfil_ = enabled; }
+
+    // Liga os contadores por função (runtime/contadores.o, só Linux)
+    void set_contadores(bool enabled) { contadores_ = enabled; }
+
+    // -pgo-gerar: contadores de ramos/laços/chamadas, .jpprof ao sair (Linux)
+    void set_pgo_gerar(bool enabled) { pgo_gerar_ = enabled; }
+
+    // -pgo-usar: layout de blocos e ordem das funções guiados pelo perfil
+    void set_pgo_usar(std::shared_ptr<const PerfilPgo> perfil) { pgo_ = std::move(perfil); }
+
+    // -alvo=nativo: instruções da CPU que compila (FMA em a*b + c)
+    void set_alvo_nativo(bool enabled) { alvo_nativo_ = enabled; }
+
+    // -ieee-estrito: cada operação float arredonda separado (sem FMA)
+    void set_ieee_estrito(bool enabled) { ieee_estrito_ = enabled; }
+
+    // -g: informações de depuração (DWARF) no objeto
+    void set_depuracao(bool enabled) { gerar_depuracao_ = enabled; }
+
+    // -sem-checagem: lista[i] sem checagem de limites
+    void set_sem_checagem(bool enabled) { sem_checagem_ = enabled; }
+
+    // --tamanho: bytes por função/construção, .rodata e relocações
+    void set_tamanho(bool enabled) { tamanho_ = enabled; }
+
+    // Threads para gerar funções em paralelo (0 = automático, 1 = serial)
+    void set_codegen_threads(unsigned n) { codegen_threads_ = n; }
+
+    // Ativa compilação separada de módulos .jp, com cache em `dir`
+    void set_module_cache_dir(const std::string& dir) { module_cache_dir_ = dir; }
+
     // ======================================================================
     // ACESSORES PARA LINKAGEM
     // ======================================================================
@@ -210,6 +324,16 @@ public:
         return extra_dll_paths_;
     }
 
+    // JSONs de bibliotecas lidos por emit_nativo (dependências do build)
+    const std::vector<std::string>& manifest_paths() const {
+        return manifest_paths_;
+    }
+
+    // Relatório de --tamanho (preenchido em compile())
+    const RelatorioTamanho& relatorio_tamanho() const {
+        return tamanho_rel_;
+    }
+
 private:
     // ======================================================================
     // MEMBERS
@@ -223,30 +347,43 @@ private:
     size_t rdata_idx_;
     size_t data_idx_;
 
-    std::vector<LocalVar> locals_;
+    std::unordered_map<Sym, int32_t> locals_;   // nome → offset em RBP
     int32_t local_offset_;
     int32_t stack_reserved_;
+    size_t func_text_start_ = 0;   // início da função em emissão (ver pos_tag)
+
+    // Chamada em cauda (emit_retorna): só em funções e métodos, não no main
+    bool cauda_ativa_ = false;
+    const FuncaoStmt* funcao_atual_ = nullptr;   // função (não método) em emissão
+    size_t corpo_inicio_ = 0;                    // alvo do jmp da recursão em cauda
 
-    std::unordered_map<std::string, FuncInfo> declared_funcs_;
+    std::unordered_map<Sym, FuncInfo> declared_funcs_;
     std::unordered_map<std::string, uint32_t> string_offsets_;
     std::vector<LoopContext> loop_stack_;
-    std::unordered_map<std::string, RuntimeType> var_types_;
-    std::unordered_map<std::string, RuntimeType> func_return_types_;
-    std::unordered_map<std::string, std::vector<RuntimeType>> func_param_types_;
+    AstArena scratch_arena_;       // nós de AST sintetizados durante a emissão
+    std::unordered_map<Sym, RuntimeType> var_types_;
+    std::unordered_map<Sym, RuntimeType> func_return_types_;
+    std::unordered_map<Sym, std::vector<RuntimeType>> func_param_types_;
+    std::vector<TempoFuncao> tempos_funcoes_;   // --tempos, em ordem de emissão
+    uint32_t tipos_epoca_ = 0;     // época das anotações de tipo; 0 = sem cache
+    int stmt_depth_ = 0;
+    std::set<std::tuple<std::string, int, char>> erros_tipo_;   // (arquivo, linha, operador)
     std::vector<std::string> extra_obj_paths_;
     std::vector<std::string> extra_libs_;
     std::vector<std::string> extra_lib_paths_;
     std::vector<std::string> extra_dll_paths_;
+    std::vector<std::string> manifest_paths_;
     std::string base_dir_;
     std::string exe_dir_;
+    std::string source_path_;
     LangConfig lang_config_;
     bool debug_mode_ = false;  // ativado por "depurar"/"debug" no código fonte
-    std::unordered_map<std::string, std::string> var_instance_class_;
+    std::unordered_map<Sym, std::string> var_instance_class_;
 
     // Members de listas (usados por codegen_atribuicao e codegen_listas)
-    std::unordered_set<std::string> var_is_list_;
-    std::unordered_map<std::string, RuntimeType> var_list_elem_type_;
-    std::unordered_map<std::string, std::string> var_list_instance_class_;
+    std::unordered_set<Sym> var_is_list_;
+    std::unordered_map<Sym, RuntimeType> var_list_elem_type_;
+    std::unordered_map<Sym, std::string> var_list_instance_class_;
 
     // Members de classes — definidos em codegen_classe.hpp (incluído inline abaixo)
     // ClassInfo, declared_classes_, current_class_, auto_local_offset_
@@ -296,6 +433,14 @@ private:
         text_->emit_i32(offset);
     }
 
+    // LEA reg, [RBP + offset] — endereço de um bloco no frame
+    void emit_lea_reg_rbp(uint8_t reg, int32_t offset) {
+        emit_rex_w(reg, reg::RBP);
+        text_->emit_u8(0x8D);
+        text_->emit_u8(0x85 | ((reg & 7) << 3));
+        text_->emit_i32(offset);
+    }
+
     void emit_mov_rbp_imm32(int32_t offset, int32_t imm) {
         emit_rex_w(0, reg::RBP);
         text_->emit_u8(0xC7);
@@ -484,6 +629,16 @@ private:
                         PlatformDefs::DEFAULT_CALL_ADDEND);
     }
 
+    // JMP rel32 para símbolo (chamada em cauda): mesma relocation do call
+    void emit_jmp_symbol(uint32_t sym_index) {
+        text_->emit_u8(0xE9);
+        uint32_t reloc_pos = static_cast<uint32_t>(text_->pos());
+        text_->emit_i32(0);
+        emit_relocation(reloc_pos, sym_index,
+                        PlatformDefs::REL_CALL,
+                        PlatformDefs::DEFAULT_CALL_ADDEND);
+    }
+
     // Helper: chama função externa por nome (registra símbolo se necessário)
     void emit_call_extern(const std::string& name) {
         if (!emitter_.has_symbol(name)) {
@@ -542,7 +697,7 @@ private:
     void emit_nop() { text_->emit_u8(0x90); }
 
     // ======================================================================
-    // HELPERS SSE2 — OPERAÇÕES COM DOUBLE (XMM0-XMM5)
+    // HELPERS SSE2 — OPERAÇÕES COM DOUBLE (XMM0-XMM15)
     // ======================================================================
 
     uint32_t add_double_constant(double val) {
@@ -785,21 +940,26 @@ private:
     // VARIÁVEIS LOCAIS
     // ======================================================================
 
-    int32_t alloc_local(const std::string& name) {
-        for (auto& lv : locals_) {
-            if (lv.name == name) return lv.rbp_offset;
-        }
+    // Sufixo para nomes de temporários: posição relativa ao início da função
+    // atual, para o nome não depender de onde a função cai dentro de .text.
+    // Blocos frios (-pgo-usar) têm posições próprias, com prefixo
+    std::string pos_tag() const {
+        if (text_ == &pgo_frio_) return "f" + std::to_string(text_->pos());
+        return std::to_string(text_->pos() - func_text_start_);
+    }
+
+    int32_t alloc_local(Sym name) {
+        auto it = locals_.find(name);
+        if (it != locals_.end()) return it->second;
         local_offset_ -= 8;
-        locals_.push_back({name, local_offset_});
+        locals_.emplace(name, local_offset_);
         return local_offset_;
     }
 
-    int32_t find_local(const std::string& name) {
-        for (auto& lv : locals_) {
-            if (lv.name == name) return lv.rbp_offset;
-        }
-        return alloc_local(name);
-    }
+    int32_t alloc_local(const std::string& name) { return alloc_local(Sym::intern(name)); }
+
+    int32_t find_local(Sym name) { return alloc_local(name); }
+    int32_t find_local(const std::string& name) { return alloc_local(Sym::intern(name)); }
 
     // ======================================================================
     // PRÓLOGO / EPÍLOGO — usa PlatformDefs::MIN_STACK
@@ -826,7 +986,36 @@ private:
     // TYPE INFERENCE
     // ======================================================================
 
+    // Cada Expr guarda o tipo inferido (Expr::tipo), carimbado com a época
+    // corrente. Dentro de um statement a época só muda quando o estado lido
+    // pela inferência muda (tipos_mudaram), então emit_binop, emit_binop_strcat
+    // e emit_expr dos filhos reaproveitam a mesma anotação em vez de repercorrer
+    // a subárvore. Fora de statements (pré-análises, entrada de função) o
+    // estado muda livremente e a época é 0: sem cache.
+    //
+    // As épocas vêm de um contador global, então um fragmento do codegen
+    // paralelo nunca confunde a anotação deixada por outro.
+
+    static uint32_t nova_epoca_tipos() {
+        static std::atomic<uint32_t> contador{0};
+        uint32_t e = ++contador;
+        return e != 0 ? e : ++contador;
+    }
+
+    // Chamar após alterar var_types_, listas, instâncias ou atributos de classe
+    void tipos_mudaram() {
+        if (tipos_epoca_ != 0) tipos_epoca_ = nova_epoca_tipos();
+    }
+
     RuntimeType infer_expr_type(const Expr& expr) {
+        if (tipos_epoca_ != 0 && expr.tipo.epoca == tipos_epoca_)
+            return expr.tipo.tipo;
+        RuntimeType t = infer_node_type(expr);
+        if (tipos_epoca_ != 0) expr.tipo = {tipos_epoca_, t};
+        return t;
+    }
+
+    RuntimeType infer_node_type(const Expr& expr) {
         return std::visit([&](const auto& node) -> RuntimeType {
             using T = std::decay_t<decltype(node)>;
             if constexpr (std::is_same_v<T, NumberLit>)         return RuntimeType::Int;
@@ -842,6 +1031,9 @@ private:
             else if constexpr (std::is_same_v<T, BinOpExpr>) {
                 auto lt = infer_expr_type(*node.left);
                 auto rt = infer_expr_type(*node.right);
+                if (node.op != BinOp::Add &&
+                    (lt == RuntimeType::String || rt == RuntimeType::String))
+                    registrar_erro_tipo(node);
                 if (lt == RuntimeType::Float || rt == RuntimeType::Float)
                     return RuntimeType::Float;
                 if (node.op == BinOp::Div)
@@ -889,6 +1081,27 @@ private:
         }, expr.node);
     }
 
+    // Texto em - * / % não tem emissão (sairia aritmética sobre o ponteiro).
+    // Só vale dentro de statements: nas pré-análises o estado de tipos não é
+    // o do ponto do programa e daria falso positivo.
+    void registrar_erro_tipo(const BinOpExpr& node) {
+        if (tipos_epoca_ == 0) return;
+        static const char ops[] = {'+', '-', '*', '/', '%'};
+        std::string arquivo = arquivo_atual_ < depuracao_.arquivos.size()
+            ? std::filesystem::path(depuracao_.arquivos[arquivo_atual_]).filename().string()
+            : diag_source_file_;
+        erros_tipo_.insert({arquivo, node.line, ops[static_cast<int>(node.op)]});
+    }
+
+    // Imprime os erros de tipo do objeto; false se houve algum
+    bool relatar_erros_tipo() {
+        for (auto& [arquivo, linha, op] : erros_tipo_) {
+            std::cerr << "Erro linha " << linha << " em " << arquivo
+                      << ": operação '" << op << "' com texto" << std::endl;
+        }
+        return erros_tipo_.empty();
+    }
+
     bool is_string_expr(const Expr* expr) {
         return infer_expr_type(*expr) == RuntimeType::String;
     }
@@ -898,7 +1111,11 @@ private:
     // ======================================================================
 
     void emit_stmt(const Stmt& stmt) {
-        std::visit([&](const auto& node) {
+        stmt_depth_++;
+        tipos_epoca_ = nova_epoca_tipos();
+        uint32_t linha_pai = linha_atual_;
+        registrar_linha(stmt_line(stmt));
+        medir_tamanho(nome_instrucao(stmt), [&] { std::visit([&](const auto& node) {
             using T = std::decay_t<decltype(node)>;
             if constexpr (std::is_same_v<T, AssignStmt>)        emit_assign(node);
             else if constexpr (std::is_same_v<T, AttrSetStmt>)  emit_attr_set(node);
@@ -911,11 +1128,13 @@ private:
             else if constexpr (std::is_same_v<T, ContinuarStmt>) emit_continuar();
             else if constexpr (std::is_same_v<T, RetornaStmt>)  emit_retorna(node);
             else if constexpr (std::is_same_v<T, IndexSetStmt>) {
-                if (is_list_var(node.name)) emit_list_index_set(node);
+                if (is_list_var(node.name)) medir_tamanho("lista", [&] { emit_list_index_set(node); });
                 else emit_index_set(node);
             }
             else if constexpr (std::is_same_v<T, ExprStmt>)     emit_expr(*node.expr);
-        }, stmt.node);
+        }, stmt.node); });
+        registrar_linha(linha_pai);
+        tipos_epoca_ = (--stmt_depth_ > 0) ? nova_epoca_tipos() : 0;
     }
 
     // (todos os stubs foram migrados para sub-headers)
@@ -936,12 +1155,37 @@ private:
     #include "codegen_funcoes_nativas.hpp"
     // codegen_diagnostico.hpp: sistema de diagnostico para chamadas FFI (.jpd)
     #include "codegen_diagnostico.hpp"
+    // codegen_depuracao.hpp: tabela de linhas .jp e extensão das funções
+    #include "codegen_depuracao.hpp"
+    #include "codegen_perfil.hpp"
+    #include "codegen_contadores.hpp"
+    #include "codegen_pgo.hpp"
+    // codegen_alcance.hpp: funções/métodos/módulos/bibliotecas que o main não alcança
+    #include "codegen_alcance.hpp"
+    // codegen_escape.hpp: instâncias/listas que não escapam ficam no frame
+    #include "codegen_escape.hpp"
+    // codegen_despacho.hpp: cadeias se/ou_se sobre a mesma variável
+    #include "codegen_despacho.hpp"
+    // codegen_float.hpp: expressões float em registradores XMM, FMA
+    #include "codegen_float.hpp"
+    // codegen_vetor.hpp: laços `para` sobre listas em SSE2/AVX2 (Linux)
+    #include "codegen_vetor.hpp"
+    // codegen_checagem.hpp: limites de lista[i], tirados onde o laço prova i
+    #include "codegen_checagem.hpp"
+    // codegen_jprt.hpp: chamadas para runtime/jprt.o no lugar do código inline
+    #include "codegen_jprt.hpp"
+    // codegen_tamanho.hpp: --tamanho, bytes por função e por construção
+    #include "codegen_tamanho.hpp"
     #include "codegen_listas.hpp"
     #include "codegen_saida.hpp"
     #include "codegen_expr.hpp"
     #include "codegen_atribuicao.hpp"
     #include "codegen_controle.hpp"
     #include "codegen_funcao.hpp"
+    // codegen_modulos.hpp: objetos separados + resumo .jpsum por módulo importado
+    #include "codegen_modulos.hpp"
+    // codegen_paralelo.hpp: fragmentos por função gerados em threads e juntados em ordem
+    #include "codegen_paralelo.hpp"
 };
 
 } // namespace jplang
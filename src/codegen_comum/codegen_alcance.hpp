@@ -0,0 +1,235 @@
+// codegen_alcance.hpp
+// Eliminação de código morto: funções, métodos, módulos e bibliotecas
+// nativas que o main não alcança não são emitidos nem linkados
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// O grafo de chamadas sai da AST, pelo mesmo coletor conservador do
+// codegen paralelo (collect_job_names_*): nomes lidos, chamados ou
+// interpolados e métodos chamados. Partindo do código do topo:
+//
+//   funcao f          alcançável se o nome f aparece em código alcançável
+//   Classe.m          alcançável se "Classe" aparece (construtor Classe.novo(...)
+//                     ou qualquer uso do nome) e algum código alcançável chama
+//                     .m(...) — resolve_object_class só existe durante a
+//                     emissão, então o método é casado pelo nome
+//   módulo separado   o objeto do módulo tem todas as declarações dele: se
+//                     uma é alcançável, todas entram no grafo; se nenhuma,
+//                     o módulo nem é gerado
+//   importar lib      sai da linkagem (.o/.jpd e libs do JSON) se nenhuma
+//                     função dela é alcançável
+//
+// Sobra de nomes (variável com o nome de uma função, método homônimo em
+// outra classe) só mantém código a mais, nunca tira código usado. O que
+// ainda sobrar dentro de objetos (módulos em cache, bibliotecas) fica para
+// o --gc-sections do linkador, com uma seção .text.<nome> por função.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+// Declarações alcançáveis: funções pelo nome, métodos como Classe__metodo.
+// nullptr = emitir tudo (objetos de módulo, ou antes da análise)
+std::shared_ptr<const std::unordered_set<std::string>> alcance_;
+
+// O que cada `importar` de biblioteca nativa acrescentou à linkagem
+struct ImportacaoNativa {
+    std::vector<std::string> funcoes;
+    std::vector<std::string> objetos;
+    std::vector<std::string> dlls;
+    std::vector<std::string> libs;
+};
+std::vector<ImportacaoNativa> importacoes_nativas_;
+
+// Nomes lidos pelo código alcançável (decide as bibliotecas nativas)
+std::unordered_set<Sym> nomes_alcancados_;
+
+// ======================================================================
+// CONSULTA
+// ======================================================================
+
+bool decl_alcancavel(const std::string& nome) const {
+    return !alcance_ || alcance_->count(nome) > 0;
+}
+
+// Declaração do topo: função alcançável, ou classe com algum método alcançável
+bool alcancavel(const FuncaoStmt& node) const {
+    return decl_alcancavel(node.name.str());
+}
+
+bool alcancavel(const ClasseStmt& node) const {
+    if (!alcance_) return true;
+    for (auto& stmt : node.body) {
+        if (auto* m = std::get_if<FuncaoStmt>(&stmt->node)) {
+            if (alcance_->count(node.name + "__" + m->name)) return true;
+        }
+    }
+    return false;
+}
+
+// ======================================================================
+// ANÁLISE — depois de index_modules, antes de emitir o main
+// ======================================================================
+
+void calcular_alcance(const Program& program) {
+    Cronometro fase;
+    struct Decl {
+        std::string chave;       // f ou Classe__metodo
+        Sym nome;                // função, ou classe do método
+        Sym metodo;              // vazio para funções
+        int modulo = -1;         // módulo compilado à parte
+        const StmtList* corpo = nullptr;
+        bool alcancada = false;
+    };
+    std::vector<Decl> decls;
+    std::unordered_map<Sym, std::vector<size_t>> funcoes;         // f → decls
+    std::unordered_map<Sym, std::vector<size_t>> por_classe;      // Classe → métodos
+    std::unordered_map<Sym, std::vector<size_t>> por_metodo;      // m → Classe__m
+    std::vector<std::vector<size_t>> por_modulo(program.modulos.size());
+    FuncJob raiz;
+
+    auto nova_decl = [&](Decl d) {
+        size_t i = decls.size();
+        if (d.modulo >= 0) por_modulo[static_cast<size_t>(d.modulo)].push_back(i);
+        decls.push_back(std::move(d));
+        return i;
+    };
+    for (auto& stmt : program.statements) {
+        std::visit([&](const auto& node) {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, FuncaoStmt>) {
+                Decl d;
+                d.chave = node.name.str();
+                d.nome = node.name;
+                d.modulo = module_of(node.name);
+                d.corpo = &node.body;
+                funcoes[node.name].push_back(nova_decl(std::move(d)));
+            }
+            else if constexpr (std::is_same_v<T, ClasseStmt>) {
+                int mod = module_of(node.name);
+                for (auto& s : node.body) {
+                    auto* m = std::get_if<FuncaoStmt>(&s->node);
+                    if (!m) continue;
+                    Decl d;
+                    d.chave = node.name + "__" + m->name;
+                    d.nome = node.name;
+                    d.metodo = m->name;
+                    d.modulo = mod;
+                    d.corpo = &m->body;
+                    size_t i = nova_decl(std::move(d));
+                    por_classe[node.name].push_back(i);
+                    por_metodo[m->name].push_back(i);
+                }
+            }
+            else if constexpr (!std::is_same_v<T, NativoStmt>) {
+                collect_job_names_stmt(*stmt, raiz);
+            }
+        }, stmt->node);
+    }
+
+    // Lista de trabalho: só o corpo de uma declaração alcançada é coletado,
+    // e cada nome novo só acorda as declarações com esse nome
+    std::unordered_set<Sym> nomes;
+    std::unordered_set<Sym> metodos;
+    std::vector<bool> modulo_alcancado(program.modulos.size(), false);
+    std::vector<size_t> fila;
+    auto alcancar = [&](size_t i) {
+        if (decls[i].alcancada) return;
+        decls[i].alcancada = true;
+        fila.push_back(i);
+    };
+    auto usar = [&](const FuncJob& uso) {
+        for (Sym n : uso.names) {
+            if (!nomes.insert(n).second) continue;
+            if (auto it = funcoes.find(n); it != funcoes.end()) {
+                for (size_t i : it->second) alcancar(i);
+            }
+            if (auto it = por_classe.find(n); it != por_classe.end()) {
+                for (size_t i : it->second) {
+                    if (metodos.count(decls[i].metodo)) alcancar(i);
+                }
+            }
+        }
+        for (Sym m : uso.methods) {
+            if (!metodos.insert(m).second) continue;
+            if (auto it = por_metodo.find(m); it != por_metodo.end()) {
+                for (size_t i : it->second) {
+                    if (nomes.count(decls[i].nome)) alcancar(i);
+                }
+            }
+        }
+    };
+
+    usar(raiz);
+    FuncJob uso;
+    while (!fila.empty()) {
+        size_t i = fila.back();
+        fila.pop_back();
+        int mod = decls[i].modulo;
+        if (mod >= 0 && !modulo_alcancado[static_cast<size_t>(mod)]) {
+            modulo_alcancado[static_cast<size_t>(mod)] = true;
+            for (size_t j : por_modulo[static_cast<size_t>(mod)]) alcancar(j);
+        }
+        uso.names.clear();
+        uso.methods.clear();
+        collect_job_names_stmts(*decls[i].corpo, uso);
+        usar(uso);
+    }
+
+    auto alcance = std::make_shared<std::unordered_set<std::string>>();
+    size_t descartadas = 0;
+    for (auto& d : decls) {
+        if (d.alcancada) alcance->insert(d.chave);
+        else descartadas++;
+    }
+    alcance_ = std::move(alcance);
+    nomes_alcancados_ = std::move(nomes);
+
+    Tempos::global().fase("calcular_alcance", fase.ms(),
+                          {{"declaracoes", decls.size()}, {"descartadas", descartadas}});
+}
+
+// ======================================================================
+// BIBLIOTECAS NATIVAS — no fim de compile()
+// ======================================================================
+
+void descartar_importacoes_sem_uso() {
+    std::unordered_set<std::string> manter;
+    std::unordered_set<std::string> tirar;
+    for (auto& imp : importacoes_nativas_) {
+        bool usada = imp.funcoes.empty();   // JSON sem funções: não arriscar
+        for (auto& f : imp.funcoes) {
+            if (nomes_alcancados_.count(Sym::intern(f))) { usada = true; break; }
+        }
+        auto& destino = usada ? manter : tirar;
+        for (auto* lista : {&imp.objetos, &imp.dlls, &imp.libs}) {
+            destino.insert(lista->begin(), lista->end());
+        }
+    }
+    auto filtrar = [&](std::vector<std::string>& caminhos) {
+        caminhos.erase(std::remove_if(caminhos.begin(), caminhos.end(),
+                                      [&](const std::string& c) {
+                                          return tirar.count(c) && !manter.count(c);
+                                      }),
+                       caminhos.end());
+    };
+    filtrar(extra_obj_paths_);
+    filtrar(extra_dll_paths_);
+    filtrar(extra_libs_);
+}
+
+// ======================================================================
+// SEÇÕES POR FUNÇÃO — antes de emitir_depuracao
+// ======================================================================
+
+// .text.<nome> por função (Linux), só nos objetos de módulo: o que o main
+// não usa dentro de um módulo em cache sai no --gc-sections do linkador.
+// O objeto principal fica com um .text só — calcular_alcance já tirou o
+// que não é alcançável, e milhares de seções custavam tamanho do objeto
+// e tempo de escrita sem nada para coletar.
+void separar_funcoes() {
+    PlatformDefs::split_text_by_function(emitter_, text_idx_, depuracao_);
+    text_  = &emitter_.section(text_idx_);
+    rdata_ = &emitter_.section(rdata_idx_);
+    data_  = &emitter_.section(data_idx_);
+}
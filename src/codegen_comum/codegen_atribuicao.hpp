@@ -22,12 +22,14 @@ void emit_assign(const AssignStmt& node) {
         } else {
             // Linux: registrar classe e continuar fluxo normal
             var_instance_class_[node.name] = class_name;
+            tipos_mudaram();
         }
     }
 
     // Inferir tipo
     RuntimeType type = infer_expr_type(*node.value);
     var_types_[node.name] = type;
+    tipos_mudaram();
 
     // Detectar lista literal: var = [...]
     if (std::holds_alternative<ListLitExpr>(node.value->node)) {
@@ -47,6 +49,7 @@ void emit_assign(const AssignStmt& node) {
             return;
         } else {
             var_is_list_.insert(node.name);
+            tipos_mudaram();
             if (!list_node.elements.empty()) {
                 var_list_elem_type_[node.name] = infer_expr_type(*list_node.elements[0]);
                 // Detectar se elementos são chamadas de construtor
@@ -63,6 +66,7 @@ void emit_assign(const AssignStmt& node) {
             } else {
                 var_list_elem_type_[node.name] = RuntimeType::Unknown;
             }
+            tipos_mudaram();
             // Linux: continua pro emit_expr abaixo
         }
     }
@@ -107,13 +111,13 @@ void emit_assign(const AssignStmt& node) {
 void emit_index_set(const IndexSetStmt& node) {
     // Avaliar o valor → salvar temporariamente
     emit_expr(*node.value);
-    std::string val_tmp = "__idxset_val_" + std::to_string(text_->pos());
+    std::string val_tmp = "__idxset_val_" + pos_tag();
     int32_t val_off = alloc_local(val_tmp);
     emit_mov_rbp_reg(val_off, reg::RAX);
 
     // Avaliar o índice → salvar temporariamente
     emit_expr(*node.index);
-    std::string idx_tmp = "__idxset_idx_" + std::to_string(text_->pos());
+    std::string idx_tmp = "__idxset_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx_tmp);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
@@ -0,0 +1,279 @@
+// codegen_checagem.hpp
+// Checagem de limites em lista[i] e lista[i] = v, e eliminação da checagem
+// em laços que já provam o índice
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Com o header da lista em RCX e o índice em RAX, a checagem é
+//
+//   cmp rax, [rcx+8]        ; tamanho, no mesmo lugar nas duas plataformas
+//   jae erro                ; sem sinal: índice negativo também cai aqui
+//
+// O `erro` fica num bloco frio depois do epílogo da função (emit_desvio_frio,
+// os mesmos blocos do -pgo-usar em codegen_pgo.hpp) e chama __jp_erro_indice(indice, tamanho,
+// linha, arquivo), emitida uma vez no objeto principal como o crash handler:
+// imprime o diagnóstico pelo stderr e sai com exit(1).
+//
+// Sem checagem quando o índice é a variável de um
+//
+//   para i em intervalo(a, lista.tamanho()):    a literal >= 0, passo > 0
+//
+// e o corpo não pode encolher a lista: nenhuma atribuição a `lista` ou a
+// `i`, nenhum .remover() (em qualquer lista, pode ser a mesma por outro
+// nome), nenhuma chamada de função/método do usuário e nenhuma lista
+// passada a uma chamada. O tamanho lido antes do laço vale a volta inteira.
+//
+//   -sem-checagem   tira todas as checagens (acesso fora da lista volta a
+//                   ser memória qualquer)
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool sem_checagem_ = false;
+
+// (lista, variável do para) cujo índice o laço em emissão já prova
+std::vector<std::pair<Sym, Sym>> indices_provados_;
+
+// ======================================================================
+// PROVA — para i em intervalo(a, lista.tamanho())
+// ======================================================================
+
+bool checagem_expr_estavel(const Expr& expr) const {
+    if (auto* call = std::get_if<ChamadaExpr>(&expr.node)) {
+        if (declared_funcs_.count(call->name)) return false;
+        for (auto& a : call->args) {
+            auto* v = std::get_if<VarExpr>(&a->node);
+            if (v && is_list_var(v->name)) return false;
+        }
+    }
+    if (auto* m = std::get_if<MetodoChamadaExpr>(&expr.node)) {
+        auto* v = std::get_if<VarExpr>(&m->object->node);
+        if (!v || !is_list_var(v->name) || !metodo_de_lista(m->method)) return false;
+        if (m->method == "remover") return false;
+    }
+    bool estavel = true;
+    filhos_expr(expr, [&](const Expr& filho) {
+        if (estavel) estavel = checagem_expr_estavel(filho);
+    });
+    return estavel;
+}
+
+bool checagem_corpo_estavel(const StmtList& corpo, Sym var, Sym lista) const {
+    auto expr_ok = [&](const ExprPtr& e) { return !e || checagem_expr_estavel(*e); };
+    for (auto& stmt : corpo) {
+        bool ok = std::visit([&](const auto& node) -> bool {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, AssignStmt>) {
+                return node.name != var && node.name != lista && expr_ok(node.value);
+            }
+            else if constexpr (std::is_same_v<T, IndexSetStmt>) {
+                return expr_ok(node.index) && expr_ok(node.value);
+            }
+            else if constexpr (std::is_same_v<T, AttrSetStmt>) {
+                return expr_ok(node.object) && expr_ok(node.value);
+            }
+            else if constexpr (std::is_same_v<T, SaidaStmt> || std::is_same_v<T, RetornaStmt>) {
+                return expr_ok(node.value);
+            }
+            else if constexpr (std::is_same_v<T, ExprStmt>) {
+                return expr_ok(node.expr);
+            }
+            else if constexpr (std::is_same_v<T, IfStmt>) {
+                for (auto& br : node.branches) {
+                    if (!expr_ok(br.condition) || !checagem_corpo_estavel(br.body, var, lista))
+                        return false;
+                }
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, RepetirStmt>) {
+                return expr_ok(node.count) && checagem_corpo_estavel(node.body, var, lista);
+            }
+            else if constexpr (std::is_same_v<T, EnquantoStmt>) {
+                return expr_ok(node.condition) && checagem_corpo_estavel(node.body, var, lista);
+            }
+            else if constexpr (std::is_same_v<T, ParaStmt>) {
+                return node.var != var && node.var != lista &&
+                       expr_ok(node.start) && expr_ok(node.end) && expr_ok(node.step) &&
+                       checagem_corpo_estavel(node.body, var, lista);
+            }
+            else if constexpr (std::is_same_v<T, PararStmt> || std::is_same_v<T, ContinuarStmt>) {
+                return true;
+            }
+            else {
+                return false;
+            }
+        }, stmt->node);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Empilha o par (lista, i) se o laço prova o índice; devolve o tamanho
+// anterior da pilha para emit_para restaurar depois do corpo
+size_t provar_indices_para(const ParaStmt& node) {
+    size_t antes = indices_provados_.size();
+    if (sem_checagem_) return antes;
+    auto* inicio = std::get_if<NumberLit>(&node.start->node);
+    if (!inicio || inicio->value < 0) return antes;
+    if (node.step) {
+        auto* passo = std::get_if<NumberLit>(&node.step->node);
+        if (!passo || passo->value <= 0) return antes;
+    }
+    auto* fim = std::get_if<MetodoChamadaExpr>(&node.end->node);
+    if (!fim || fim->method != "tamanho" || !fim->args.empty()) return antes;
+    auto* lista = std::get_if<VarExpr>(&fim->object->node);
+    if (!lista || !is_list_var(lista->name) || lista->name == node.var) return antes;
+    if (!checagem_corpo_estavel(node.body, node.var, lista->name)) return antes;
+    indices_provados_.emplace_back(lista->name, node.var);
+    return antes;
+}
+
+bool indice_provado(Sym lista, const Expr& indice) const {
+    auto* v = std::get_if<VarExpr>(&indice.node);
+    if (!v) return false;
+    for (auto& p : indices_provados_) {
+        if (p.first == lista && p.second == v->name) return true;
+    }
+    return false;
+}
+
+// ======================================================================
+// CHECAGEM — header em RCX, índice em RAX (os dois continuam intactos)
+// ======================================================================
+
+void emit_checar_indice(Sym lista, const Expr& indice, int linha) {
+    if (sem_checagem_ || indice_provado(lista, indice)) return;
+    medir_tamanho("checagem", [&] { emit_cmp_indice(linha); });
+}
+
+// cmp com o tamanho; fora da faixa → bloco frio com __jp_erro_indice
+void emit_cmp_indice(int linha) {
+    // cmp rax, [rcx+8]
+    emit_rex_w(reg::RAX, reg::RCX);
+    text_->emit_u8(0x3B);
+    text_->emit_u8(0x41);
+    text_->emit_u8(0x08);
+
+    std::string arquivo = arquivo_atual_ < depuracao_.arquivos.size()
+        ? std::filesystem::path(depuracao_.arquivos[arquivo_atual_]).filename().string()
+        : diag_source_file_;
+
+    emit_desvio_frio(CC_AE, [&] {
+        // ARG2 = [rcx+8] antes de ARG1 = rax (no Windows ARG1 é o próprio RCX)
+        emit_rex_w(PlatformDefs::ARG2, reg::RCX);
+        text_->emit_u8(0x8B);
+        text_->emit_u8(static_cast<uint8_t>(0x40 | ((PlatformDefs::ARG2 & 7) << 3) | 0x01));
+        text_->emit_u8(0x08);
+        emit_mov_reg_reg(PlatformDefs::ARG1, reg::RAX);
+        emit_mov_reg_imm32(PlatformDefs::ARG3, linha);
+        emit_load_string(PlatformDefs::ARG4, arquivo);
+        emit_call_extern("__jp_erro_indice");
+    });
+}
+
+// ======================================================================
+// __jp_erro_indice(indice, tamanho, linha, arquivo) — após o main
+// ======================================================================
+
+// Modelo de diag_msg → formato do fprintf: '%' do texto escapado, cada
+// {chave} trocada pelo especificador; `ordem` recebe os argumentos na
+// ordem em que aparecem (a tradução pode inverter os campos)
+static std::string diag_formato(std::string modelo,
+                                const std::vector<std::pair<std::string, std::string>>& campos,
+                                int primeiro, std::vector<int>& ordem) {
+    std::string escapado;
+    for (char c : modelo) {
+        if (c == '%') escapado += '%';
+        escapado += c;
+    }
+    std::vector<std::pair<size_t, int>> achados;
+    for (size_t i = 0; i < campos.size(); i++) {
+        size_t pos = escapado.find("{" + campos[i].first + "}");
+        if (pos != std::string::npos) achados.push_back({pos, primeiro + static_cast<int>(i)});
+    }
+    std::sort(achados.begin(), achados.end());
+    for (auto& a : achados) ordem.push_back(a.second);
+    for (auto& c : campos) escapado = diag_replace(escapado, c.first, c.second);
+    return escapado;
+}
+
+void emit_erro_indice_func() {
+    if (sem_checagem_) return;
+
+    uint32_t func_offset = static_cast<uint32_t>(text_->pos());
+    func_text_start_ = func_offset;
+    uint32_t func_sym = emitter_.add_global_symbol("__jp_erro_indice", text_idx_,
+                                                   func_offset, true);
+
+    std::vector<int> ordem;
+    std::string fmt = "\n" + diag_msg("header", "[JP DIAGNOSTICO]") + " ";
+    fmt += diag_formato(diag_msg("indice_fora", "Indice {indice} fora da lista (tamanho {tamanho})"),
+                        {{"indice", "%lld"}, {"tamanho", "%lld"}}, 0, ordem);
+    fmt += "\n  ";
+    fmt += diag_formato(diag_msg("linha_arquivo", "Linha {num} em {arquivo}"),
+                        {{"num", "%lld"}, {"arquivo", "%s"}}, 2, ordem);
+    fmt += "\n\n";
+
+    // Frame: argumentos em [rbp-8..-32]; no Windows o 5º e o 6º argumento
+    // do fprintf vão em [rsp+32] e [rsp+40] (= [rbp-64] e [rbp-56])
+    emit_push(reg::RBP);
+    emit_mov_reg_reg(reg::RBP, reg::RSP);
+    emit_sub_rsp_imm32(96);
+    // and rsp, -16: a chamada pode vir do meio de uma expressão, com um
+    // operando empilhado (rsp fora do alinhamento de 16)
+    emit_rex_w(0, reg::RSP);
+    text_->emit_u8(0x83);
+    text_->emit_u8(0xE4);
+    text_->emit_u8(0xF0);
+    const uint8_t entrada[] = {PlatformDefs::ARG1, PlatformDefs::ARG2,
+                               PlatformDefs::ARG3, PlatformDefs::ARG4};
+    for (int i = 0; i < 4; i++) emit_mov_rbp_reg(-8 * (i + 1), entrada[i]);
+
+    // fflush(NULL): o que saida() já escreveu aparece antes do diagnóstico
+    emit_xor_reg_reg(PlatformDefs::ARG1, PlatformDefs::ARG1);
+    emit_call_extern("fflush");
+
+    if constexpr (PlatformDefs::is_windows) {
+        emit_mov_reg_imm32(reg::RCX, 2);
+        emit_call_extern("__acrt_iob_func");
+        emit_mov_reg_reg(reg::RCX, reg::RAX);
+        emit_load_string(reg::RDX, fmt);
+        const uint8_t livres[] = {reg::R8, reg::R9};
+        for (size_t k = 0; k < ordem.size(); k++) {
+            int32_t origem = -8 * (ordem[k] + 1);
+            if (k < 2) {
+                emit_mov_reg_rbp(livres[k], origem);
+            } else {
+                emit_mov_reg_rbp(reg::RAX, origem);
+                emit_mov_rbp_reg(-64 + 8 * static_cast<int32_t>(k - 2), reg::RAX);
+            }
+        }
+        emit_call_extern("fprintf");
+    } else {
+        if (!emitter_.has_symbol("stderr")) {
+            emitter_.add_extern_symbol("stderr");
+        }
+        emit_lea_rip_symbol(reg::RAX, emitter_.symbol_index("stderr"));
+        emit_rex_w(reg::RDI, reg::RAX);
+        text_->emit_u8(0x8B); text_->emit_u8(0x38);     // mov rdi, [rax]
+        emit_load_string(reg::RSI, fmt);
+        const uint8_t livres[] = {reg::RDX, reg::RCX, reg::R8, reg::R9};
+        for (size_t k = 0; k < ordem.size(); k++) {
+            emit_mov_reg_rbp(livres[k], -8 * (ordem[k] + 1));
+        }
+        emit_xor_reg_reg(reg::RAX, reg::RAX);
+        emit_call_extern("fprintf");
+    }
+
+    emit_mov_reg_imm32(PlatformDefs::ARG1, 1);
+    emit_call_extern("exit");
+
+    // Epilogo (inalcancavel)
+    emit_mov_reg_reg(reg::RSP, reg::RBP);
+    emit_pop(reg::RBP);
+    emit_ret();
+
+    arquivo_atual_ = 0;
+    registrar_funcao(func_sym, "__jp_erro_indice", func_offset, 0);
+}
@@ -47,7 +47,7 @@ struct ClassInfo {
 // DADOS DE CLASSE (membros da classe Codegen)
 // ======================================================================
 
-std::unordered_map<std::string, ClassInfo> declared_classes_;
+std::unordered_map<Sym, ClassInfo> declared_classes_;
 ClassInfo* current_class_ = nullptr;
 int32_t auto_local_offset_ = 0;
 
@@ -140,6 +140,7 @@ void resolve_class_attr_from_method_call(const MetodoChamadaExpr& mc) {
                         if (attr.name == mapping.attr_name &&
                             attr.type == RuntimeType::Unknown) {
                             attr.type = arg_type;
+                            tipos_mudaram();
                         }
                     }
                 }
@@ -222,8 +223,8 @@ void preanalyze_expr_for_constructors(const Expr& expr) {
 }
 
 void propagate_constructor_types(ClassInfo& cls, const std::string& method_name,
-                                  const std::vector<std::unique_ptr<Expr>>& args) {
-    std::string method_sym = cls.name + "__" + method_name;
+                                  const std::vector<ExprPtr>& args) {
+    Sym method_sym = Sym::intern(cls.name + "__" + method_name);
     auto fit = declared_funcs_.find(method_sym);
     if (fit == declared_funcs_.end()) return;
 
@@ -238,6 +239,7 @@ void propagate_constructor_types(ClassInfo& cls, const std::string& method_name,
     for (size_t i = 0; i < arg_types.size(); i++) {
         if (fit->second.param_types[i + 1] == RuntimeType::Unknown) {
             fit->second.param_types[i + 1] = arg_types[i];
+            tipos_mudaram();
         }
     }
 
@@ -247,6 +249,7 @@ void propagate_constructor_types(ClassInfo& cls, const std::string& method_name,
             for (auto& attr : cls.attrs) {
                 if (attr.name == param_name && attr.type == RuntimeType::Unknown) {
                     attr.type = arg_types[i];
+                    tipos_mudaram();
                 }
             }
         }
@@ -268,7 +271,7 @@ void preregister_class(const ClasseStmt& node) {
         std::visit([&](const auto& s) {
             using T = std::decay_t<decltype(s)>;
             if constexpr (std::is_same_v<T, FuncaoStmt>) {
-                std::string method_sym = node.name + "__" + s.name;
+                Sym method_sym = Sym::intern(node.name + "__" + s.name);
                 cls.method_names.push_back(s.name);
                 #ifdef _WIN32
                 declared_funcs_[method_sym] = {};
@@ -384,7 +387,7 @@ void emit_class_methods(const ClasseStmt& node) {
         std::visit([&](const auto& s) {
             using T = std::decay_t<decltype(s)>;
             if constexpr (std::is_same_v<T, FuncaoStmt>) {
-                emit_method(cls, s);
+                if (decl_alcancavel(cls.name + "__" + s.name)) emit_method(cls, s);
             }
         }, stmt->node);
     }
@@ -396,11 +399,14 @@ void emit_class_methods(const ClasseStmt& node) {
 // ======================================================================
 
 void emit_method(ClassInfo& cls, const FuncaoStmt& func) {
-    std::string method_sym = cls.name + "__" + func.name;
+    Cronometro cronometro;
+    Sym method_sym = Sym::intern(cls.name + "__" + func.name);
 
     uint32_t func_offset = static_cast<uint32_t>(text_->pos());
+    func_text_start_ = func_offset;
     uint32_t func_sym_idx = emitter_.add_global_symbol(method_sym, text_idx_,
                                                         func_offset, true);
+    entrar_funcao_depuracao(cls.name, static_cast<uint32_t>(func.line));
 
     FuncInfo finfo;
     finfo.name = method_sym;
@@ -428,7 +434,8 @@ void emit_method(ClassInfo& cls, const FuncaoStmt& func) {
 
     int32_t estimated_locals = count_locals(func.body) +
                                static_cast<int32_t>(func.params.size()) + 20;
-    int32_t local_bytes = estimated_locals * 8 + PlatformDefs::MIN_STACK;
+    int32_t local_bytes = estimated_locals * 8 + PlatformDefs::MIN_STACK +
+                          reservar_blocos_pilha(func.body);
     emit_prologue(local_bytes);
 
     // Salvar ponteiro "auto" (ARG1) como variável local
@@ -458,15 +465,25 @@ void emit_method(ClassInfo& cls, const FuncaoStmt& func) {
     }
 
     current_class_ = &cls;
+    emit_contador_entrar(method_sym);
+    pgo_entrar_funcao(method_sym, static_cast<uint32_t>(func.line));
 
+    cauda_ativa_ = true;
     for (auto& s : func.body) {
         emit_stmt(*s);
     }
+    cauda_ativa_ = false;
 
     emit_xor_reg_reg(reg::RAX, reg::RAX);
+    emit_contador_sair();
     emit_epilogue();
+    fim_contador();
+    pgo_anexar_frio();
 
     current_class_ = nullptr;
+    registrar_funcao(func_sym_idx, method_sym, func_offset, static_cast<uint32_t>(func.line));
+    record_func_time(method_sym, cronometro, func_offset);
+    registrar_tamanho_funcao(method_sym, func_offset);
 }
 
 // ======================================================================
@@ -480,6 +497,7 @@ void emit_attr_set(const AttrSetStmt& node) {
     int32_t attr_off = current_class_->find_attr_offset(node.attr);
     if (attr_off < 0) {
         attr_off = current_class_->register_attr(node.attr);
+        tipos_mudaram();
     }
 
     RuntimeType type = infer_expr_type(*node.value);
@@ -489,11 +507,12 @@ void emit_attr_set(const AttrSetStmt& node) {
             break;
         }
     }
+    tipos_mudaram();
 
     emit_expr(*node.value);
 
     if (type == RuntimeType::Float) {
-        std::string tmp = "__attrset_tmp_" + std::to_string(text_->pos());
+        std::string tmp = "__attrset_tmp_" + pos_tag();
         int32_t tmp_off = alloc_local(tmp);
         emit_movsd_rbp_xmm(tmp_off, xmm::XMM0);
 
@@ -564,7 +583,7 @@ int32_t resolve_attr_offset(const AttrGetExpr& node, RuntimeType& out_type) {
 
     std::string class_name = resolve_object_class(*node.object);
     if (!class_name.empty()) {
-        auto cit = declared_classes_.find(class_name);
+        auto cit = declared_classes_.find(Sym::intern(class_name));
         if (cit != declared_classes_.end()) {
             int32_t off = cit->second.find_attr_offset(node.attr);
             out_type = cit->second.get_attr_type(node.attr);
@@ -625,7 +644,8 @@ void emit_metodo_chamada(const MetodoChamadaExpr& node) {
         return;
     }
 
-    std::string method_sym = class_name + "__" + node.method;
+    Sym method_sym = Sym::intern(class_name + "__" + node.method);
+    emit_pgo_contar(pgo_ponto("chamada", static_cast<uint32_t>(node.line)), 0);
 
     constexpr size_t MAX_REG_ARGS = PlatformDefs::is_windows ? 4 : 6;
     const uint8_t call_regs[] = {
@@ -644,7 +664,7 @@ void emit_metodo_chamada(const MetodoChamadaExpr& node) {
 
         emit_expr(*node.args[i]);
         std::string tmp = "__marg_" + std::to_string(i) + "_" +
-                          std::to_string(text_->pos());
+                          pos_tag();
         int32_t off = alloc_local(tmp);
         if (type == RuntimeType::Float) {
             emit_movsd_rbp_xmm(off, xmm::XMM0);
@@ -661,13 +681,14 @@ void emit_metodo_chamada(const MetodoChamadaExpr& node) {
             }
             if (fit->second.param_types[slot] == RuntimeType::Unknown) {
                 fit->second.param_types[slot] = type;
+                tipos_mudaram();
             }
         }
     }
 
     // Avaliar objeto → ponteiro da instância → salvar
     emit_expr(*node.object);
-    std::string auto_tmp = "__mobj_" + std::to_string(text_->pos());
+    std::string auto_tmp = "__mobj_" + pos_tag();
     int32_t auto_tmp_off = alloc_local(auto_tmp);
     emit_mov_rbp_reg(auto_tmp_off, reg::RAX);
 
@@ -740,29 +761,41 @@ void emit_metodo_chamada(const MetodoChamadaExpr& node) {
 
 // ======================================================================
 // CHAMADA ESTÁTICA: Classe.metodo(args) — construtores
-// Aloca instância com malloc, chama método com instância como auto
+// Aloca instância com malloc (ou no frame, se não escapa), chama método
+// com instância como auto
 // ======================================================================
 
 void emit_static_method_call(const std::string& class_name,
                               const std::string& method_name,
                               const MetodoChamadaExpr& node) {
-    auto cit = declared_classes_.find(class_name);
+    auto cit = declared_classes_.find(Sym::intern(class_name));
     if (cit == declared_classes_.end()) {
         emit_mov_reg_imm32(reg::RAX, 0);
         return;
     }
 
     ClassInfo& cls = cit->second;
-    std::string method_sym = class_name + "__" + method_name;
+    Sym method_sym = Sym::intern(class_name + "__" + method_name);
 
     // malloc(instance_size)
     int32_t alloc_size = cls.instance_size;
     if (alloc_size < 8) alloc_size = 8;
-    emit_mov_reg_imm32(PlatformDefs::ARG1, alloc_size);
-    emit_call_symbol(emitter_.symbol_index("malloc"));
+    auto* bloco = bloco_pilha(&node);
+    if (bloco && bloco->second >= alloc_size) {
+        // Não escapa (codegen_escape.hpp): bloco zerado no frame, como
+        // a memória nova do malloc
+        emit_xor_reg_reg(reg::RAX, reg::RAX);
+        for (int32_t i = 0; i < alloc_size; i += 8) {
+            emit_mov_rbp_reg(bloco->first + i, reg::RAX);
+        }
+        emit_lea_reg_rbp(reg::RAX, bloco->first);
+    } else {
+        emit_mov_reg_imm32(PlatformDefs::ARG1, alloc_size);
+        emit_call_symbol(emitter_.symbol_index("malloc"));
+    }
 
     // RAX = ponteiro da instância
-    std::string inst_tmp = "__inst_" + std::to_string(text_->pos());
+    std::string inst_tmp = "__inst_" + pos_tag();
     int32_t inst_off = alloc_local(inst_tmp);
     emit_mov_rbp_reg(inst_off, reg::RAX);
 
@@ -783,7 +816,7 @@ void emit_static_method_call(const std::string& class_name,
 
         emit_expr(*node.args[i]);
         std::string tmp = "__sarg_" + std::to_string(i) + "_" +
-                          std::to_string(text_->pos());
+                          pos_tag();
         int32_t off = alloc_local(tmp);
         if (type == RuntimeType::Float) {
             emit_movsd_rbp_xmm(off, xmm::XMM0);
@@ -800,6 +833,7 @@ void emit_static_method_call(const std::string& class_name,
             }
             if (fit->second.param_types[slot] == RuntimeType::Unknown) {
                 fit->second.param_types[slot] = type;
+                tipos_mudaram();
             }
         }
     }
@@ -907,7 +941,7 @@ bool is_constructor_call(const AssignStmt& node,
 }
 
 // Helper para obter classe de instâncias em listas
-std::string get_list_instance_class(const std::string& var_name) {
+std::string get_list_instance_class(Sym var_name) {
     auto it = var_list_instance_class_.find(var_name);
     if (it != var_list_instance_class_.end()) return it->second;
     return "";
@@ -0,0 +1,131 @@
+// codegen_contadores.hpp
+// Contadores determinísticos por função (`jp build -contadores`, Linux) —
+// ganchos de entrada/saída e tabela de contadores em .data
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Cada função, método e o main chamam __jp_cont_entrar(&contador) depois
+// de salvar os parâmetros e __jp_cont_sair() antes de cada epílogo; o
+// runtime (runtime/contadores.cpp) mede os ciclos com rdtsc e imprime o
+// relatório na saída. Sem a flag nada disso é emitido.
+//
+// O contador de cada função é o símbolo "__jp_contador.<simbolo>": as
+// funções (inclusive as geradas em paralelo) só o referenciam, e o objeto
+// principal define todos juntos no fim, depois do cabeçalho
+// __jp_contadores:
+//
+//   cabeçalho  magica "JPCT", versao, n, reservado            (u32)
+//   n × { chamadas, inclusivo, exclusivo (u64),
+//         profundidade (u32), nome (i32, PC32 → string em .rodata) }
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool contadores_ = false;
+std::string contador_atual_;      // símbolo do contador da função em emissão
+
+static constexpr uint32_t CONT_MAGICA = 0x5443504A;   // "JPCT"
+static constexpr uint32_t CONT_VERSAO = 1;
+static constexpr const char* CONT_PREFIXO = "__jp_contador.";
+
+// ======================================================================
+// GANCHOS
+// ======================================================================
+
+// main: registra a tabela (relatório no atexit) antes do próprio gancho
+void emit_contadores_iniciar() {
+    if (!contadores_) return;
+    if (!emitter_.has_symbol("__jp_contadores")) {
+        emitter_.add_extern_symbol("__jp_contadores");
+    }
+    emit_lea_rip_symbol(PlatformDefs::ARG1, emitter_.symbol_index("__jp_contadores"));
+    emit_call_extern("__jp_cont_iniciar");
+}
+
+// Depois do prólogo e da cópia dos parâmetros (registradores livres)
+void emit_contador_entrar(const std::string& simbolo) {
+    if (!contadores_) return;
+    contador_atual_ = CONT_PREFIXO + simbolo;
+    uint32_t sym = emitter_.add_extern_symbol(contador_atual_);
+    emit_lea_rip_symbol(PlatformDefs::ARG1, sym);
+    emit_call_extern("__jp_cont_entrar");
+}
+
+// Antes de cada epílogo: preserva o retorno (RAX e XMM0); a pilha continua
+// alinhada em 16 (push + sub 8)
+void emit_contador_sair() {
+    if (contador_atual_.empty()) return;
+    emit_push(reg::RAX);
+    emit_sub_rsp_imm32(8);
+    text_->emit_u8(0xF2); text_->emit_u8(0x0F); text_->emit_u8(0x11);   // movsd [rsp], xmm0
+    text_->emit_u8(0x04); text_->emit_u8(0x24);
+    emit_call_extern("__jp_cont_sair");
+    text_->emit_u8(0xF2); text_->emit_u8(0x0F); text_->emit_u8(0x10);   // movsd xmm0, [rsp]
+    text_->emit_u8(0x04); text_->emit_u8(0x24);
+    emit_add_rsp_imm32(8);
+    emit_pop(reg::RAX);
+}
+
+void fim_contador() {
+    contador_atual_.clear();
+}
+
+// ======================================================================
+// TABELA
+// ======================================================================
+
+// "Classe__metodo" → "Classe.metodo"
+std::string nome_contador(const std::string& simbolo) const {
+    size_t sep = simbolo.find("__");
+    if (sep != std::string::npos && sep > 0 &&
+        declared_classes_.count(Sym::intern(simbolo.substr(0, sep)))) {
+        return simbolo.substr(0, sep) + "." + simbolo.substr(sep + 2);
+    }
+    return simbolo;
+}
+
+// Chamado depois de todas as funções. Só existe no Linux: main.cpp
+// recusa -contadores no Windows.
+void emitir_tabela_contadores() {
+    if (!contadores_) return;
+#ifndef _WIN32
+    // Contadores referenciados, na ordem de registro dos símbolos
+    std::vector<std::string> simbolos;
+    for (uint32_t i = 0; i < emitter_.symbol_count(); i++) {
+        const std::string& nome = emitter_.symbol_at(i).name;
+        if (nome.compare(0, std::strlen(CONT_PREFIXO), CONT_PREFIXO) == 0) {
+            simbolos.push_back(nome);
+        }
+    }
+
+    std::unordered_map<std::string, const FuncaoDepuracao*> origem;
+    for (auto& f : depuracao_.funcoes) origem[f.nome] = &f;
+
+    data_->align(8);
+    emitter_.add_global_symbol("__jp_contadores", data_idx_,
+                               static_cast<uint32_t>(data_->pos()));
+    data_->emit_u32(CONT_MAGICA);
+    data_->emit_u32(CONT_VERSAO);
+    data_->emit_u32(static_cast<uint32_t>(simbolos.size()));
+    data_->emit_u32(0);
+
+    for (auto& s : simbolos) {
+        std::string funcao = s.substr(std::strlen(CONT_PREFIXO));
+        std::string rotulo = nome_contador(funcao);
+        auto it = origem.find(funcao);
+        if (it != origem.end() && it->second->arquivo < depuracao_.arquivos.size()) {
+            rotulo += " (" + std::filesystem::path(depuracao_.arquivos[it->second->arquivo])
+                                 .filename().string() +
+                      ":" + std::to_string(it->second->linha) + ")";
+        }
+        uint32_t str_off = add_string(rotulo);
+
+        emitter_.add_global_symbol(s, data_idx_, static_cast<uint32_t>(data_->pos()));
+        data_->emit_zeros(3 * 8 + 4);
+        data_->add_relocation(static_cast<uint32_t>(data_->pos()),
+                              emitter_.section_symbol(rdata_idx_), R_X86_64_PC32, str_off);
+        data_->emit_u32(0);
+    }
+#endif
+}
@@ -7,15 +7,34 @@
 // ======================================================================
 
 void emit_if(const IfStmt& node) {
+    if (emit_if_despacho(node)) return;   // cadeia v == literal (codegen_despacho)
+
     std::vector<size_t> end_patches;
+    std::vector<size_t> frios;      // ramos frios (-pgo-usar), voltam para o fim
 
     for (size_t i = 0; i < node.branches.size(); i++) {
         auto& branch = node.branches[i];
 
         if (branch.condition) {
+            std::string ponto = pgo_ponto("se", expr_line(*branch.condition));
+            emit_pgo_contar(ponto, 0);
             emit_expr(*branch.condition);
             emit_test_reg_reg(reg::RAX, reg::RAX);
+
+            if (pgo_ramo_frio(ponto, branch.body)) {
+                // Quase nunca verdadeiro: corpo depois do epílogo, o caminho
+                // quente cai direto no próximo ramo
+                frios.push_back(pgo_abrir_frio());
+                emit_pgo_contar(ponto, 1);
+                for (auto& stmt : branch.body) {
+                    emit_stmt(*stmt);
+                }
+                pgo_fechar_frio();
+                continue;
+            }
+
             size_t skip_patch = emit_je_rel32();
+            emit_pgo_contar(ponto, 1);
 
             for (auto& stmt : branch.body) {
                 emit_stmt(*stmt);
@@ -35,6 +54,9 @@ void emit_if(const IfStmt& node) {
     for (auto& ep : end_patches) {
         patch_jump(ep);
     }
+    for (size_t b : frios) {
+        pgo_blocos_[b].alvo = text_->pos();
+    }
 }
 
 // ======================================================================
@@ -42,6 +64,11 @@ void emit_if(const IfStmt& node) {
 // ======================================================================
 
 void emit_enquanto(const EnquantoStmt& node) {
+    std::string ponto = pgo_ponto("laco", static_cast<uint32_t>(node.line));
+    emit_pgo_contar(ponto, 0);
+    // Laço quente (-pgo-usar): teste repetido no fim, sem jmp por iteração
+    bool rodar = pgo_laco_quente(ponto) && condicao_repetivel(*node.condition);
+
     LoopContext ctx;
     ctx.loop_start = text_->pos();
     loop_stack_.push_back(ctx);
@@ -51,16 +78,26 @@ void emit_enquanto(const EnquantoStmt& node) {
     emit_expr(*node.condition);
     emit_test_reg_reg(reg::RAX, reg::RAX);
     size_t exit_patch = emit_je_rel32();
+    size_t body_top = text_->pos();
+    emit_pgo_contar(ponto, 1);
 
     for (auto& stmt : node.body) {
         emit_stmt(*stmt);
     }
 
-    // Jump de volta pro topo
-    text_->emit_u8(0xE9);
-    int32_t back_offset = static_cast<int32_t>(loop_top) -
-                          static_cast<int32_t>(text_->pos() + 4);
-    text_->emit_i32(back_offset);
+    if (rodar) {
+        emit_expr(*node.condition);
+        emit_test_reg_reg(reg::RAX, reg::RAX);
+        size_t back = emit_jne_rel32();
+        text_->patch_i32(back, static_cast<int32_t>(body_top) -
+                               static_cast<int32_t>(back + 4));
+    } else {
+        // Jump de volta pro topo
+        text_->emit_u8(0xE9);
+        int32_t back_offset = static_cast<int32_t>(loop_top) -
+                              static_cast<int32_t>(text_->pos() + 4);
+        text_->emit_i32(back_offset);
+    }
 
     patch_jump(exit_patch);
 
@@ -81,7 +118,7 @@ void emit_enquanto(const EnquantoStmt& node) {
 void emit_repetir(const RepetirStmt& node) {
     emit_expr(*node.count);
 
-    std::string counter_name = "__repetir_" + std::to_string(text_->pos());
+    std::string counter_name = "__repetir_" + pos_tag();
     int32_t counter_off = alloc_local(counter_name);
     emit_mov_rbp_reg(counter_off, reg::RAX);
 
@@ -135,13 +172,14 @@ void emit_para(const ParaStmt& node) {
 
     // Registrar tipo da variável do loop como Int
     var_types_[node.var] = RuntimeType::Int;
+    tipos_mudaram();
 
     emit_expr(*node.end);
-    std::string end_name = "__para_end_" + std::to_string(text_->pos());
+    std::string end_name = "__para_end_" + pos_tag();
     int32_t end_off = alloc_local(end_name);
     emit_mov_rbp_reg(end_off, reg::RAX);
 
-    std::string step_name = "__para_step_" + std::to_string(text_->pos());
+    std::string step_name = "__para_step_" + pos_tag();
     int32_t step_off;
     if (node.step) {
         emit_expr(*node.step);
@@ -152,6 +190,14 @@ void emit_para(const ParaStmt& node) {
         emit_mov_rbp_imm32(step_off, 1);
     }
 
+    // c[i] = a[i] op b[i]...: voltas de 2/4 elementos antes (codegen_vetor)
+    emit_para_vetor(node, var_off, end_off);
+
+    std::string ponto = pgo_ponto("laco", static_cast<uint32_t>(node.line));
+    emit_pgo_contar(ponto, 0);
+    // Laço quente (-pgo-usar): comparação repetida depois do incremento
+    bool rodar = pgo_laco_quente(ponto);
+
     LoopContext ctx;
     ctx.loop_start = text_->pos();
     loop_stack_.push_back(ctx);
@@ -162,10 +208,15 @@ void emit_para(const ParaStmt& node) {
     emit_mov_reg_rbp(reg::RCX, end_off);
     emit_cmp_reg_reg(reg::RAX, reg::RCX);
     size_t exit_patch = emit_jge_rel32();
+    size_t body_top = text_->pos();
+    emit_pgo_contar(ponto, 1);
 
+    // lista[i] sem checagem de limites quando o laço prova i (codegen_checagem)
+    size_t provados = provar_indices_para(node);
     for (auto& stmt : node.body) {
         emit_stmt(*stmt);
     }
+    indices_provados_.resize(provados);
 
     // Incrementar: var += step
     emit_mov_reg_rbp(reg::RAX, var_off);
@@ -173,11 +224,19 @@ void emit_para(const ParaStmt& node) {
     emit_add_reg_reg(reg::RAX, reg::RCX);
     emit_mov_rbp_reg(var_off, reg::RAX);
 
-    // Jump back
-    text_->emit_u8(0xE9);
-    int32_t back_offset = static_cast<int32_t>(loop_top) -
-                          static_cast<int32_t>(text_->pos() + 4);
-    text_->emit_i32(back_offset);
+    if (rodar) {
+        emit_mov_reg_rbp(reg::RCX, end_off);
+        emit_cmp_reg_reg(reg::RAX, reg::RCX);
+        size_t back = emit_jcc_rel32(CC_L);
+        text_->patch_i32(back, static_cast<int32_t>(body_top) -
+                               static_cast<int32_t>(back + 4));
+    } else {
+        // Jump back
+        text_->emit_u8(0xE9);
+        int32_t back_offset = static_cast<int32_t>(loop_top) -
+                              static_cast<int32_t>(text_->pos() + 4);
+        text_->emit_i32(back_offset);
+    }
 
     patch_jump(exit_patch);
 
@@ -0,0 +1,110 @@
+// codegen_depuracao.hpp
+// Tabela de linhas e extensão das funções para as informações de
+// depuração do objeto (DWARF no Linux, ver backend_linux/dwarf_emitter.hpp)
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Cada statement registra o offset em .text onde o código dele começa e a
+// sua linha; quando um statement aninhado termina, a linha do pai volta a
+// valer (incremento do para, salto de volta do enquanto, epílogo da
+// função). Cada função registra o intervalo [inicio, fim) e o st_size do
+// símbolo. Declarações vindas de `importar "x.jp"` apontam para o arquivo
+// do módulo, mesmo quando emitidas no objeto principal.
+//
+// A tabela é sempre montada (o -perfil e a checagem de limites usam); as
+// seções .debug_* só vão para o objeto com -g, porque custam ~12% do
+// objeto e tempo de escrita em todo build.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+InfoDepuracao depuracao_;
+bool gerar_depuracao_ = false;    // -g: seções .debug_* no objeto
+uint32_t arquivo_atual_ = 0;      // índice em depuracao_.arquivos
+uint32_t linha_atual_ = 0;
+std::unordered_map<std::string, uint32_t> arquivo_decl_;   // decl → arquivo
+
+// ======================================================================
+// INICIALIZAÇÃO
+// ======================================================================
+
+void init_depuracao(const Program& program) {
+    std::error_code ec;
+    depuracao_ = InfoDepuracao{};
+    depuracao_.diretorio = std::filesystem::current_path(ec).string();
+
+    std::filesystem::path fonte = source_path_.empty() ? diag_source_file_ : source_path_;
+    std::filesystem::path abs = std::filesystem::absolute(fonte, ec);
+    depuracao_.unidade = (ec ? fonte : abs.lexically_normal()).string();
+    depuracao_.arquivo(depuracao_.unidade);
+
+    arquivo_decl_.clear();
+    for (auto& mod : program.modulos) {
+        uint32_t arq = depuracao_.arquivo(mod.caminho);
+        for (auto& f : mod.funcoes) arquivo_decl_[f] = arq;
+        for (auto& c : mod.classes) arquivo_decl_[c] = arq;
+    }
+    arquivo_atual_ = 0;
+    linha_atual_ = 0;
+}
+
+// Objetos auxiliares (módulos, fragmentos) usam a mesma tabela de arquivos
+void seed_depuracao(const Codegen& parent) {
+    depuracao_.unidade = parent.depuracao_.unidade;
+    depuracao_.diretorio = parent.depuracao_.diretorio;
+    depuracao_.arquivos = parent.depuracao_.arquivos;
+    arquivo_decl_ = parent.arquivo_decl_;
+    gerar_depuracao_ = parent.gerar_depuracao_;
+}
+
+// ======================================================================
+// REGISTRO
+// ======================================================================
+
+static uint32_t stmt_line(const Stmt& stmt) {
+    return std::visit([](const auto& node) {
+        return node.line > 0 ? static_cast<uint32_t>(node.line) : 0u;
+    }, stmt.node);
+}
+
+// Início de uma função/método: arquivo da declaração + linha do cabeçalho
+void entrar_funcao_depuracao(const std::string& decl, uint32_t linha) {
+    auto it = arquivo_decl_.find(decl);
+    arquivo_atual_ = (it != arquivo_decl_.end()) ? it->second : 0;
+    registrar_linha(linha);
+}
+
+void registrar_linha(uint32_t linha) {
+    linha_atual_ = linha;
+    depuracao_.linha(static_cast<uint32_t>(text_->pos()), arquivo_atual_, linha);
+}
+
+// Fim de uma função: extensão no símbolo (st_size) e no subprogram
+void registrar_funcao(uint32_t sym, const std::string& nome,
+                      uint32_t inicio, uint32_t linha) {
+    uint32_t fim = static_cast<uint32_t>(text_->pos());
+    emitter_.set_symbol_size(sym, fim - inicio);
+    depuracao_.funcoes.push_back({nome, inicio, fim, arquivo_atual_, linha});
+}
+
+// Fragmento do codegen paralelo: offsets relativos ao início dele
+void merge_depuracao(const Codegen& frag, uint32_t base) {
+    for (auto& l : frag.depuracao_.linhas) {
+        depuracao_.linha(base + l.offset, l.arquivo, l.linha);
+    }
+    for (auto f : frag.depuracao_.funcoes) {
+        f.inicio += base;
+        f.fim += base;
+        depuracao_.funcoes.push_back(std::move(f));
+    }
+}
+
+// Último passo antes de write(): cria as seções de depuração
+void emitir_depuracao() {
+    if (!gerar_depuracao_) return;
+    PlatformDefs::emit_debug_info(emitter_, text_idx_, depuracao_);
+    text_  = &emitter_.section(text_idx_);
+    rdata_ = &emitter_.section(rdata_idx_);
+    data_  = &emitter_.section(data_idx_);
+}
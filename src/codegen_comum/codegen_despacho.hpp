@@ -0,0 +1,325 @@
+// codegen_despacho.hpp
+// Despacho de cadeias se/ou_se: tabela de saltos, árvore de comparações e
+// pré-switch de strings por tamanho + hash
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Vale quando todos os ramos com condição comparam a mesma variável com
+// literais distintos do mesmo tipo (`v == 3`, `"sair" == v`), com
+// DESPACHO_MINIMO ramos ou mais e senao opcional no fim:
+//
+//   inteiros densos   tabela de int32 em .rodata (lea rip-relative pelo
+//                     emit_lea_rip_reloc), faixa checada antes; cada
+//                     entrada = destino - âncora, e a âncora é um
+//                     lea rcx, [rip+0] na própria função (sem relocation)
+//   inteiros esparsos árvore balanceada de cmp/je/jl, O(log n)
+//   strings           FNV-1a de 32 bits calculado junto com o tamanho numa
+//                     passada; árvore sobre o hash e, no ramo achado,
+//                     tamanho igual + strcmp confirmam
+//
+// A variável é lida uma vez só (as condições não têm efeitos). Com -pgo-*
+// a cadeia fica como está: os pontos "se" de cada ramo são contados um a um.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+// Tabelas de saltos em .rodata: offset → bytes (o merge do codegen
+// paralelo copia junto com o pool de strings/constantes)
+std::map<uint32_t, uint32_t> tabelas_rdata_;
+
+size_t add_tabela_rdata(size_t bytes) {
+    rdata_->align(4);
+    uint32_t offset = static_cast<uint32_t>(rdata_->pos());
+    for (size_t i = 0; i < bytes; i++) rdata_->emit_u8(0);
+    tabelas_rdata_[offset] = static_cast<uint32_t>(bytes);
+    return offset;
+}
+
+// ======================================================================
+// RECONHECIMENTO
+// ======================================================================
+
+static constexpr size_t DESPACHO_MINIMO = 4;
+static constexpr int64_t DESPACHO_FAIXA_MAX = 4096;
+static constexpr uint32_t FNV_BASE = 2166136261u;
+static constexpr uint32_t FNV_PRIMO = 16777619u;
+
+struct CasoDespacho {
+    int64_t chave;          // valor do literal, ou hash da string
+    size_t ramo;
+    const std::string* texto = nullptr;
+};
+
+static uint32_t hash_despacho(const std::string& s) {
+    uint32_t h = FNV_BASE;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= FNV_PRIMO;
+    }
+    return h;
+}
+
+// Inteiro literal, inclusive negativo (o parser gera 0 - n)
+static bool inteiro_literal(const Expr& e, int64_t& valor) {
+    if (auto* num = std::get_if<NumberLit>(&e.node)) {
+        valor = num->value;
+        return true;
+    }
+    auto* bin = std::get_if<BinOpExpr>(&e.node);
+    if (!bin || bin->op != BinOp::Sub) return false;
+    auto* zero = std::get_if<NumberLit>(&bin->left->node);
+    auto* num = std::get_if<NumberLit>(&bin->right->node);
+    if (!zero || zero->value != 0 || !num) return false;
+    valor = -static_cast<int64_t>(num->value);
+    return true;
+}
+
+// `v == literal` ou `literal == v`: devolve o literal e preenche a variável
+static const Expr* literal_de_caso(const Expr& cond, Sym& var) {
+    auto* cmp = std::get_if<CmpOpExpr>(&cond.node);
+    if (!cmp || cmp->op != CmpOp::Eq) return nullptr;
+    auto* vl = std::get_if<VarExpr>(&cmp->left->node);
+    auto* vr = std::get_if<VarExpr>(&cmp->right->node);
+    if (vl && !vr) { var = vl->name; return cmp->right.get(); }
+    if (vr && !vl) { var = vr->name; return cmp->left.get(); }
+    return nullptr;
+}
+
+// Casos da cadeia (ordem dos ramos); false se não serve para despacho
+static bool coletar_casos(const IfStmt& node, Sym& var, bool& texto,
+                          std::vector<CasoDespacho>& casos) {
+    bool primeiro = true;
+    for (size_t i = 0; i < node.branches.size(); i++) {
+        auto& br = node.branches[i];
+        if (!br.condition) break;   // senao
+        Sym v;
+        const Expr* lit = literal_de_caso(*br.condition, v);
+        if (!lit) return false;
+        int64_t valor = 0;
+        bool inteiro = inteiro_literal(*lit, valor);
+        auto* str = std::get_if<StringLit>(&lit->node);
+        if (!inteiro && !str) return false;
+        if (primeiro) {
+            var = v;
+            texto = str != nullptr;
+            primeiro = false;
+        }
+        if (v != var || texto != (str != nullptr)) return false;
+        CasoDespacho c;
+        c.ramo = i;
+        if (inteiro) {
+            c.chave = valor;
+        } else {
+            c.chave = hash_despacho(str->value);
+            c.texto = &str->value;
+        }
+        casos.push_back(c);
+    }
+    if (casos.size() < DESPACHO_MINIMO) return false;
+
+    // Valores (hashes) repetidos: a cadeia sequencial decide
+    std::vector<int64_t> chaves;
+    for (auto& c : casos) chaves.push_back(c.chave);
+    std::sort(chaves.begin(), chaves.end());
+    return std::adjacent_find(chaves.begin(), chaves.end()) == chaves.end();
+}
+
+// Para count_locals: o despacho de strings usa dois temporários
+static bool despacho_candidato(const IfStmt& node) {
+    Sym var;
+    bool texto = false;
+    std::vector<CasoDespacho> casos;
+    return coletar_casos(node, var, texto, casos);
+}
+
+// ======================================================================
+// EMISSÃO
+// ======================================================================
+
+bool emit_if_despacho(const IfStmt& node) {
+    if (pgo_ativo()) return false;
+    Sym var;
+    bool texto = false;
+    std::vector<CasoDespacho> casos;
+    if (!coletar_casos(node, var, texto, casos)) return false;
+
+    Expr var_expr(VarExpr{var, 0});
+    RuntimeType tipo = infer_expr_type(var_expr);
+    if (texto ? tipo != RuntimeType::String
+              : (tipo == RuntimeType::Float || tipo == RuntimeType::String ||
+                 tipo == RuntimeType::Null)) {
+        return false;
+    }
+
+    std::sort(casos.begin(), casos.end(),
+              [](const CasoDespacho& a, const CasoDespacho& b) { return a.chave < b.chave; });
+
+    // Saltos a resolver: (posição do rel32, ramo) e os que vão para o padrão
+    std::vector<std::pair<size_t, size_t>> para_ramo;
+    std::vector<size_t> para_padrao;
+    size_t tabela = 0, ancora = 0;
+    std::vector<size_t> slots;      // ramo por slot da tabela (SIZE_MAX = padrão)
+
+    emit_expr(var_expr);
+
+    if (texto) {
+        emit_despacho_texto(casos, para_ramo, para_padrao);
+    } else {
+        int64_t minimo = casos.front().chave;
+        int64_t faixa = casos.back().chave - minimo + 1;
+        bool densa = faixa <= DESPACHO_FAIXA_MAX &&
+                     faixa <= static_cast<int64_t>(3 * casos.size());
+        if (densa) {
+            slots.assign(static_cast<size_t>(faixa), SIZE_MAX);
+            for (auto& c : casos) slots[static_cast<size_t>(c.chave - minimo)] = c.ramo;
+            emit_despacho_tabela(minimo, faixa, tabela, ancora, para_padrao);
+        } else {
+            emit_arvore_despacho(casos, 0, casos.size(), true, para_ramo, para_padrao);
+            for (auto& pr : para_ramo) pr.second = casos[pr.second].ramo;
+        }
+    }
+
+    // Corpos na ordem dos ramos; o padrão é o senao (ou o fim)
+    std::vector<size_t> inicio(node.branches.size(), 0);
+    std::vector<size_t> end_patches;
+    for (size_t i = 0; i < node.branches.size(); i++) {
+        if (!node.branches[i].condition) break;
+        inicio[i] = text_->pos();
+        for (auto& stmt : node.branches[i].body) {
+            emit_stmt(*stmt);
+        }
+        end_patches.push_back(emit_jmp_rel32());
+    }
+    size_t padrao = text_->pos();
+    auto& ultimo = node.branches.back();
+    if (!ultimo.condition) {
+        for (auto& stmt : ultimo.body) {
+            emit_stmt(*stmt);
+        }
+    }
+    for (auto& ep : end_patches) {
+        patch_jump(ep);
+    }
+
+    auto ligar = [&](size_t p, size_t destino) {
+        text_->patch_i32(p, static_cast<int32_t>(destino) - static_cast<int32_t>(p + 4));
+    };
+    for (auto& [p, ramo] : para_ramo) ligar(p, inicio[ramo]);
+    for (size_t p : para_padrao) ligar(p, padrao);
+    for (size_t s = 0; s < slots.size(); s++) {
+        size_t destino = slots[s] == SIZE_MAX ? padrao : inicio[slots[s]];
+        rdata_->patch_i32(tabela + s * 4,
+                          static_cast<int32_t>(destino) - static_cast<int32_t>(ancora));
+    }
+    return true;
+}
+
+// RAX = valor; faixa checada, depois jmp [âncora + tabela[valor - mínimo]]
+void emit_despacho_tabela(int64_t minimo, int64_t faixa, size_t& tabela,
+                          size_t& ancora, std::vector<size_t>& para_padrao) {
+    if (minimo != 0) {
+        emit_mov_reg_imm32(reg::RCX, static_cast<int32_t>(minimo));
+        emit_sub_reg_reg(reg::RAX, reg::RCX);
+    }
+    emit_cmp_reg_imm32(reg::RAX, static_cast<int32_t>(faixa - 1));
+    para_padrao.push_back(emit_jcc_rel32(CC_A));   // sem sinal: abaixo do mínimo também
+
+    tabela = add_tabela_rdata(static_cast<size_t>(faixa) * 4);
+    emit_lea_rip_reloc(reg::RCX, rdata_idx_, static_cast<uint32_t>(tabela));
+    emit_rex_w(reg::RAX, reg::RCX);
+    text_->emit_u8(0x63);
+    text_->emit_u8(0x04);
+    text_->emit_u8(0x81);               // MOVSXD RAX, [RCX + RAX*4]
+    emit_rex_w(reg::RCX, 0);
+    text_->emit_u8(0x8D);
+    text_->emit_u8(0x0D);
+    text_->emit_i32(0);                 // LEA RCX, [RIP+0] — âncora
+    ancora = text_->pos();
+    emit_add_reg_reg(reg::RAX, reg::RCX);
+    text_->emit_u8(0xFF);
+    text_->emit_u8(0xE0);               // JMP RAX
+}
+
+// Árvore balanceada sobre casos[ini, fim) ordenados; RAX (EAX se !com_sinal)
+// comparado com cada chave. Até 3 casos: comparações em sequência.
+// Os saltos achados vão em para_caso com o índice em `casos`
+void emit_arvore_despacho(const std::vector<CasoDespacho>& casos, size_t ini, size_t fim,
+                          bool com_sinal, std::vector<std::pair<size_t, size_t>>& para_caso,
+                          std::vector<size_t>& para_padrao) {
+    auto comparar = [&](int64_t chave) {
+        if (com_sinal) emit_rex_w(0, reg::RAX);
+        text_->emit_u8(0x3D);           // CMP RAX/EAX, imm32
+        text_->emit_i32(static_cast<int32_t>(static_cast<uint32_t>(chave)));
+    };
+    if (fim - ini <= 3) {
+        for (size_t i = ini; i < fim; i++) {
+            comparar(casos[i].chave);
+            para_caso.push_back({emit_je_rel32(), i});
+        }
+        para_padrao.push_back(emit_jmp_rel32());
+        return;
+    }
+    size_t meio = ini + (fim - ini) / 2;
+    comparar(casos[meio].chave);
+    para_caso.push_back({emit_je_rel32(), meio});
+    size_t esquerda = emit_jcc_rel32(com_sinal ? CC_L : CC_B);
+    emit_arvore_despacho(casos, meio + 1, fim, com_sinal, para_caso, para_padrao);
+    patch_jump(esquerda);
+    emit_arvore_despacho(casos, ini, meio, com_sinal, para_caso, para_padrao);
+}
+
+// RAX = string: hash e tamanho numa passada, árvore sobre o hash e, por
+// caso, confirmação (tamanho + strcmp) antes do salto para o corpo
+void emit_despacho_texto(const std::vector<CasoDespacho>& casos,
+                         std::vector<std::pair<size_t, size_t>>& para_ramo,
+                         std::vector<size_t>& para_padrao) {
+    int32_t str_off = alloc_local("__desp_str_" + pos_tag());
+    emit_mov_rbp_reg(str_off, reg::RAX);
+    emit_mov_reg_reg(reg::RCX, reg::RAX);
+    text_->emit_u8(0xB8);
+    text_->emit_i32(static_cast<int32_t>(FNV_BASE));    // MOV EAX, base
+    text_->emit_u8(0x31);
+    text_->emit_u8(0xD2);                                // XOR EDX, EDX
+
+    size_t laco = text_->pos();
+    text_->emit_u8(0x44); text_->emit_u8(0x0F); text_->emit_u8(0xB6);
+    text_->emit_u8(0x04); text_->emit_u8(0x11);          // MOVZX R8D, BYTE [RCX+RDX]
+    text_->emit_u8(0x45); text_->emit_u8(0x85); text_->emit_u8(0xC0);   // TEST R8D, R8D
+    size_t fim_laco = emit_je_rel32();
+    text_->emit_u8(0x44); text_->emit_u8(0x31); text_->emit_u8(0xC0);   // XOR EAX, R8D
+    text_->emit_u8(0x69); text_->emit_u8(0xC0);
+    text_->emit_i32(static_cast<int32_t>(FNV_PRIMO));   // IMUL EAX, EAX, primo
+    emit_rex_w(0, reg::RDX);
+    text_->emit_u8(0xFF);
+    text_->emit_u8(0xC2);                                // INC RDX
+    text_->emit_u8(0xE9);
+    text_->emit_i32(static_cast<int32_t>(laco) - static_cast<int32_t>(text_->pos() + 4));
+    patch_jump(fim_laco);
+
+    int32_t len_off = alloc_local("__desp_len_" + pos_tag());
+    emit_mov_rbp_reg(len_off, reg::RDX);
+
+    // Hash (EAX) → índice do caso em `casos`; confirmação resolve o ramo
+    std::vector<std::pair<size_t, size_t>> para_caso;
+    emit_arvore_despacho(casos, 0, casos.size(), false, para_caso, para_padrao);
+
+    std::vector<size_t> confirmar(casos.size());
+    for (size_t i = 0; i < casos.size(); i++) {
+        confirmar[i] = text_->pos();
+        const std::string& lit = *casos[i].texto;
+        emit_mov_reg_rbp(reg::RAX, len_off);
+        emit_cmp_reg_imm32(reg::RAX, static_cast<int32_t>(lit.size()));
+        para_padrao.push_back(emit_jne_rel32());
+        emit_mov_reg_rbp(PlatformDefs::ARG1, str_off);
+        emit_load_string(PlatformDefs::ARG2, lit);
+        emit_call_extern("strcmp");
+        text_->emit_u8(0x85);
+        text_->emit_u8(0xC0);                            // TEST EAX, EAX
+        para_padrao.push_back(emit_jne_rel32());
+        para_ramo.push_back({emit_jmp_rel32(), casos[i].ramo});
+    }
+    for (auto& [p, i] : para_caso) {
+        text_->patch_i32(p, static_cast<int32_t>(confirmar[i]) - static_cast<int32_t>(p + 4));
+    }
+}
@@ -109,8 +109,9 @@ void emit_crash_handler_func() {
     diag_handler_emitted_ = true;
 
     uint32_t handler_offset = static_cast<uint32_t>(text_->pos());
-    emitter_.add_global_symbol("__jp_crash_handler", text_idx_,
-                               handler_offset, true);
+    func_text_start_ = handler_offset;
+    uint32_t handler_sym = emitter_.add_global_symbol("__jp_crash_handler", text_idx_,
+                                                      handler_offset, true);
 
     // Frame proprio
     emit_push(reg::RBP);
@@ -143,6 +144,9 @@ void emit_crash_handler_func() {
     emit_mov_reg_reg(reg::RSP, reg::RBP);
     emit_pop(reg::RBP);
     emit_ret();
+
+    arquivo_atual_ = 0;
+    registrar_funcao(handler_sym, "__jp_crash_handler", handler_offset, 0);
 }
 
 // ======================================================================
@@ -247,7 +251,7 @@ void emit_diag_pre_ffi(const std::string& func_name, int line,
 void emit_diag_pos_ffi(const std::string& func_name, int line,
                        RuntimeType ret_type) {
     // Salvar retorno
-    std::string ret_tmp = "__diag_ret_" + std::to_string(text_->pos());
+    std::string ret_tmp = "__diag_ret_" + pos_tag();
     int32_t ret_off = alloc_local(ret_tmp);
     if (ret_type == RuntimeType::Float) {
         emit_movsd_rbp_xmm(ret_off, xmm::XMM0);
@@ -333,7 +337,7 @@ void emit_diag_pos_ffi(const std::string& func_name, int line,
 // QUERY HELPERS
 // ======================================================================
 
-bool is_extern_jpd_func(const std::string& func_name) const {
+bool is_extern_jpd_func(Sym func_name) const {
     return func_param_types_.count(func_name) > 0;
 }
 
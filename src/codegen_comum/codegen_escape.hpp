@@ -0,0 +1,509 @@
+// codegen_escape.hpp
+// Análise de escape: instâncias e literais de lista que não saem da função
+// vão para o frame em vez do malloc
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Sítio de alocação = chamada Classe.m(...) (emit_static_method_call) ou
+// literal [..] (emit_list_literal_linux). O sítio fica na pilha se o valor
+// só aparece em contextos que não guardam o ponteiro:
+//
+//   seguros     objeto de obj.attr, obj.m(...) e lista[i]; saida e
+//               interpolação; comparações; condições e limites de laço;
+//               statement de expressão; argumento de função/método do
+//               usuário cujo parâmetro não escapa
+//   escapam     retorna; valor de atribuição (alias), de auto.attr = e de
+//               lista[i] =; elemento de literal; .adicionar(...);
+//               aritmética/concat/lógica; argumento de nativa ou de
+//               função desconhecida
+//
+// `v = sítio` vale se a variável v não escapa em nenhum uso da função. O
+// escape dos parâmetros (auto = parâmetro 0 dos métodos) é um ponto fixo
+// otimista sobre as funções e métodos alcançáveis (roda depois de
+// calcular_alcance); obj.m(...) sem classe conhecida é casado pelo nome
+// com todos os métodos m, por um resumo de m (o slot é seguro se for em
+// todos). `retorna auto` só não escapa quando o método é chamado como
+// construtor.
+//
+// O ponto fixo é por lista de trabalho: cada corpo anota as declarações
+// cujo escape consultou, e quando o escape de uma muda só quem a consultou
+// volta para a fila. O resumo de m entra na fila como os corpos: depende
+// dos métodos m e é refeito quando um deles muda. Os sítios de cada corpo
+// saem da última análise dele, que já viu o estado final de tudo que
+// consultou.
+//
+// Cada sítio tem um bloco fixo no frame, reservado antes do prólogo
+// (reservar_blocos_pilha). Num laço o bloco é reaproveitado a cada
+// volta: o valor anterior só é alcançável pela própria variável, e por
+// isso `v = Classe.m(v...)` continua no heap. A lista na pilha tem os
+// dados logo após o cabeçalho; o primeiro .adicionar que estoura a
+// capacidade copia os dados para o heap (emit_list_adicionar_linux).
+// Objetos de módulo (null) alocam tudo no heap; no Windows só instâncias
+// vão para a pilha (as listas usam outro layout).
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+// Sítios (ponteiros de MetodoChamadaExpr/ListLitExpr) que podem ir para o frame.
+// nullptr = tudo no heap (objetos de módulo, ou antes da análise)
+std::shared_ptr<const std::unordered_set<const void*>> pilha_sitios_;
+
+// Blocos reservados no frame da função em emissão: sítio → {offset, bytes}
+std::unordered_map<const void*, std::pair<int32_t, int32_t>> blocos_pilha_;
+
+static constexpr size_t  PILHA_LISTA_MAX_ELEMENTOS = 32;
+static constexpr int32_t PILHA_OBJETO_MAX_BYTES = 256;
+
+// ======================================================================
+// ANÁLISE — depois de calcular_alcance, antes de emitir o main
+// ======================================================================
+
+struct EscapeDecl {
+    size_t id = 0;                       // posição em AnaliseEscape::ordem
+    const StmtList* corpo = nullptr;     // nullptr = resumo de obj.m(...)
+    const std::vector<Sym>* params = nullptr;
+    bool metodo = false;
+    std::vector<bool> escapa;            // por parâmetro; [0] = auto nos métodos
+    bool auto_escapa_construtor = false; // sem contar `retorna auto`
+    std::vector<size_t> chamadores;      // corpos que consultaram este escape
+    std::vector<const void*> sitios;     // da última análise do corpo
+    std::vector<size_t> membros;         // resumo: os métodos m de cada classe
+    bool analisada = false;
+    bool na_fila = false;
+};
+
+struct AnaliseEscape {
+    std::unordered_map<std::string, EscapeDecl> decls;                 // f ou Classe__m
+    std::vector<EscapeDecl*> ordem;                                    // ordem do fonte
+    std::deque<EscapeDecl> resumos;
+    std::unordered_map<Sym, const EscapeDecl*> metodos;                // m → resumo de m
+    std::unordered_set<Sym> classes;
+};
+
+struct EscapeCorpo {
+    std::unordered_set<Sym> escapam;     // variáveis (e parâmetros) que escapam
+    bool auto_escapa = false;
+    bool auto_retornado = false;
+    std::vector<std::pair<const void*, Sym>> atribuidos;   // v = sítio
+    std::vector<const void*> diretos;                      // sítio em contexto seguro
+    std::vector<size_t> consultadas;                       // ids de EscapeDecl
+};
+
+static bool metodo_de_lista(Sym nome) {
+    return nome == "adicionar" || nome == "remover" ||
+           nome == "tamanho" || nome == "exibir";
+}
+
+// Filhos diretos de uma expressão
+template <typename F>
+static void filhos_expr(const Expr& expr, F&& f) {
+    std::visit([&](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, BinOpExpr> || std::is_same_v<T, CmpOpExpr> ||
+                      std::is_same_v<T, LogicOpExpr> || std::is_same_v<T, ConcatExpr>) {
+            f(*node.left);
+            f(*node.right);
+        }
+        else if constexpr (std::is_same_v<T, StringInterp>) {
+            for (auto& p : node.parts) if (p.expr) f(*p.expr);
+        }
+        else if constexpr (std::is_same_v<T, ChamadaExpr>) {
+            for (auto& a : node.args) f(*a);
+        }
+        else if constexpr (std::is_same_v<T, MetodoChamadaExpr>) {
+            f(*node.object);
+            for (auto& a : node.args) f(*a);
+        }
+        else if constexpr (std::is_same_v<T, AttrGetExpr>) {
+            f(*node.object);
+        }
+        else if constexpr (std::is_same_v<T, IndexGetExpr>) {
+            f(*node.object);
+            f(*node.index);
+        }
+        else if constexpr (std::is_same_v<T, ListLitExpr>) {
+            for (auto& e : node.elements) f(*e);
+        }
+    }, expr.node);
+}
+
+static bool menciona_var(const Expr& expr, Sym nome) {
+    if (auto* v = std::get_if<VarExpr>(&expr.node)) return v->name == nome;
+    if (auto* s = std::get_if<StringInterp>(&expr.node)) {
+        for (auto& p : s->parts) {
+            if (p.is_var && !p.expr && p.value == nome.str()) return true;
+        }
+    }
+    bool achou = false;
+    filhos_expr(expr, [&](const Expr& filho) {
+        if (!achou) achou = menciona_var(filho, nome);
+    });
+    return achou;
+}
+
+void escape_sitio(const void* sitio, const Expr& expr, bool seguro,
+                  const Sym* destino, EscapeCorpo& c) {
+    if (seguro) {
+        c.diretos.push_back(sitio);
+    } else if (destino && !menciona_var(expr, *destino)) {
+        c.atribuidos.push_back({sitio, *destino});
+    }
+}
+
+// Parâmetro `slot` de `d` (declaração ou resumo) não escapa
+static bool parametro_seguro(const EscapeDecl* d, size_t slot) {
+    return d && slot < d->escapa.size() && !d->escapa[slot];
+}
+
+static void consultar(const EscapeDecl* d, EscapeCorpo& c) {
+    if (d) c.consultadas.push_back(d->id);
+}
+
+void escape_expr(const Expr& expr, bool seguro, const AnaliseEscape& a,
+                 EscapeCorpo& c, const Sym* destino = nullptr) {
+    std::visit([&](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, VarExpr>) {
+            if (!seguro) c.escapam.insert(node.name);
+        }
+        else if constexpr (std::is_same_v<T, AutoExpr>) {
+            if (!seguro) c.auto_escapa = true;
+        }
+        else if constexpr (std::is_same_v<T, BinOpExpr> || std::is_same_v<T, LogicOpExpr> ||
+                           std::is_same_v<T, ConcatExpr>) {
+            escape_expr(*node.left, false, a, c);
+            escape_expr(*node.right, false, a, c);
+        }
+        else if constexpr (std::is_same_v<T, CmpOpExpr>) {
+            escape_expr(*node.left, true, a, c);
+            escape_expr(*node.right, true, a, c);
+        }
+        else if constexpr (std::is_same_v<T, StringInterp> ||
+                           std::is_same_v<T, AttrGetExpr> ||
+                           std::is_same_v<T, IndexGetExpr>) {
+            filhos_expr(expr, [&](const Expr& f) { escape_expr(f, true, a, c); });
+        }
+        else if constexpr (std::is_same_v<T, ListLitExpr>) {
+            for (auto& e : node.elements) escape_expr(*e, false, a, c);
+            if constexpr (!PlatformDefs::is_windows) {
+                if (node.elements.size() <= PILHA_LISTA_MAX_ELEMENTOS) {
+                    escape_sitio(&node, expr, seguro, destino, c);
+                }
+            }
+        }
+        else if constexpr (std::is_same_v<T, ChamadaExpr>) {
+            auto it = a.decls.find(node.name.str());
+            bool do_usuario = it != a.decls.end() && !it->second.metodo;
+            if (do_usuario) c.consultadas.push_back(it->second.id);
+            for (size_t i = 0; i < node.args.size(); i++) {
+                bool ok = do_usuario && i < it->second.escapa.size() &&
+                          !it->second.escapa[i];
+                escape_expr(*node.args[i], ok, a, c);
+            }
+        }
+        else if constexpr (std::is_same_v<T, MetodoChamadaExpr>) {
+            auto* cls = std::get_if<VarExpr>(&node.object->node);
+            if (cls && a.classes.count(cls->name)) {
+                // Classe.m(...): aloca a instância
+                auto it = a.decls.find(cls->name + "__" + node.method);
+                const EscapeDecl* construtor = it != a.decls.end() ? &it->second : nullptr;
+                consultar(construtor, c);
+                for (size_t i = 0; i < node.args.size(); i++) {
+                    escape_expr(*node.args[i], parametro_seguro(construtor, i + 1), a, c);
+                }
+                if (construtor && !construtor->auto_escapa_construtor) {
+                    escape_sitio(&node, expr, seguro, destino, c);
+                }
+                return;
+            }
+            auto it = a.metodos.find(node.method);
+            const EscapeDecl* metodos = it != a.metodos.end() ? it->second : nullptr;
+            consultar(metodos, c);
+            bool lista = metodo_de_lista(node.method);
+            bool recebe = lista ? (!metodos || parametro_seguro(metodos, 0))
+                                : parametro_seguro(metodos, 0);
+            escape_expr(*node.object, recebe, a, c);
+            for (size_t i = 0; i < node.args.size(); i++) {
+                bool ok = !lista && parametro_seguro(metodos, i + 1);
+                escape_expr(*node.args[i], ok, a, c);
+            }
+        }
+    }, expr.node);
+}
+
+void escape_stmt(const Stmt& stmt, const AnaliseEscape& a, EscapeCorpo& c) {
+    std::visit([&](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, AssignStmt>) {
+            escape_expr(*node.value, false, a, c, &node.name);
+        }
+        else if constexpr (std::is_same_v<T, AttrSetStmt>) {
+            escape_expr(*node.object, true, a, c);
+            escape_expr(*node.value, false, a, c);
+        }
+        else if constexpr (std::is_same_v<T, IndexSetStmt>) {
+            escape_expr(*node.index, true, a, c);
+            escape_expr(*node.value, false, a, c);
+        }
+        else if constexpr (std::is_same_v<T, SaidaStmt>) {
+            if (node.value) escape_expr(*node.value, true, a, c);
+        }
+        else if constexpr (std::is_same_v<T, ExprStmt>) {
+            escape_expr(*node.expr, true, a, c);
+        }
+        else if constexpr (std::is_same_v<T, IfStmt>) {
+            for (auto& br : node.branches) {
+                if (br.condition) escape_expr(*br.condition, true, a, c);
+                escape_stmts(br.body, a, c);
+            }
+        }
+        else if constexpr (std::is_same_v<T, RepetirStmt>) {
+            escape_expr(*node.count, true, a, c);
+            escape_stmts(node.body, a, c);
+        }
+        else if constexpr (std::is_same_v<T, EnquantoStmt>) {
+            escape_expr(*node.condition, true, a, c);
+            escape_stmts(node.body, a, c);
+        }
+        else if constexpr (std::is_same_v<T, ParaStmt>) {
+            escape_expr(*node.start, true, a, c);
+            escape_expr(*node.end, true, a, c);
+            if (node.step) escape_expr(*node.step, true, a, c);
+            escape_stmts(node.body, a, c);
+        }
+        else if constexpr (std::is_same_v<T, RetornaStmt>) {
+            if (!node.value) return;
+            if (std::holds_alternative<AutoExpr>(node.value->node)) {
+                c.auto_retornado = true;
+            } else {
+                escape_expr(*node.value, false, a, c);
+            }
+        }
+    }, stmt.node);
+}
+
+void escape_stmts(const StmtList& stmts, const AnaliseEscape& a, EscapeCorpo& c) {
+    for (auto& stmt : stmts) escape_stmt(*stmt, a, c);
+}
+
+// Sítios de um corpo que ficam na pilha (com o estado atual dos parâmetros)
+static void coletar_sitios(const EscapeCorpo& c, std::vector<const void*>& sitios) {
+    sitios.insert(sitios.end(), c.diretos.begin(), c.diretos.end());
+    for (auto& [sitio, var] : c.atribuidos) {
+        if (!c.escapam.count(var)) sitios.push_back(sitio);
+    }
+}
+
+EscapeDecl& nova_decl_escape(AnaliseEscape& a, const std::string& chave,
+                             const FuncaoStmt& f, bool metodo) {
+    EscapeDecl& d = a.decls[chave];
+    d.id = a.ordem.size();
+    d.corpo = &f.body;
+    d.params = &f.params;
+    d.metodo = metodo;
+    d.escapa.assign(f.params.size() + (metodo ? 1 : 0), false);
+    a.ordem.push_back(&d);
+    return d;
+}
+
+// Resumo de m: o slot escapa se escapa em algum método m (ou se algum
+// não tem o slot)
+static std::vector<bool> resumo_metodos(const AnaliseEscape& a, const EscapeDecl& r) {
+    size_t n = SIZE_MAX;
+    for (size_t id : r.membros) n = std::min(n, a.ordem[id]->escapa.size());
+    std::vector<bool> escapa(n, false);
+    for (size_t id : r.membros) {
+        for (size_t i = 0; i < n; i++) {
+            if (a.ordem[id]->escapa[i]) escapa[i] = true;
+        }
+    }
+    return escapa;
+}
+
+// Depois de calcular_alcance: só as declarações alcançáveis entram
+void calcular_escape(const Program& program) {
+    Cronometro fase;
+    AnaliseEscape a;
+    std::vector<const Stmt*> topo;
+    std::unordered_map<Sym, std::vector<size_t>> por_nome;   // m → ids dos métodos m
+
+    for (auto& stmt : program.statements) {
+        if (auto* f = std::get_if<FuncaoStmt>(&stmt->node)) {
+            if (alcancavel(*f)) nova_decl_escape(a, f->name.str(), *f, false);
+        }
+        else if (auto* cls = std::get_if<ClasseStmt>(&stmt->node)) {
+            a.classes.insert(cls->name);
+            for (auto& s : cls->body) {
+                auto* m = std::get_if<FuncaoStmt>(&s->node);
+                if (!m) continue;
+                std::string chave = cls->name + "__" + m->name;
+                if (!decl_alcancavel(chave)) continue;
+                por_nome[m->name].push_back(nova_decl_escape(a, chave, *m, true).id);
+            }
+        }
+        else if (!std::holds_alternative<NativoStmt>(stmt->node)) {
+            topo.push_back(stmt.get());
+        }
+    }
+
+    std::deque<EscapeDecl*> fila(a.ordem.begin(), a.ordem.end());
+    for (auto* d : a.ordem) d->na_fila = true;
+    for (auto& [nome, membros] : por_nome) {
+        EscapeDecl& r = a.resumos.emplace_back();
+        r.id = a.ordem.size();
+        r.membros = std::move(membros);
+        r.escapa = resumo_metodos(a, r);
+        for (size_t id : r.membros) a.ordem[id]->chamadores.push_back(r.id);
+        a.ordem.push_back(&r);
+        a.metodos[nome] = &r;
+    }
+
+    // Ponto fixo: escapes só crescem; quando o de uma declaração muda, os
+    // corpos (e resumos) que o consultaram voltam para a fila
+    size_t analises = 0;
+    while (!fila.empty()) {
+        EscapeDecl& d = *fila.front();
+        fila.pop_front();
+        d.na_fila = false;
+        std::vector<bool> escapa;
+        bool auto_escapa = false;
+        if (!d.corpo) {
+            escapa = resumo_metodos(a, d);
+        } else {
+            analises++;
+            EscapeCorpo c;
+            escape_stmts(*d.corpo, a, c);
+            if (!d.analisada) {
+                // As consultas de um corpo não dependem do estado: basta a primeira
+                d.analisada = true;
+                std::sort(c.consultadas.begin(), c.consultadas.end());
+                c.consultadas.erase(std::unique(c.consultadas.begin(), c.consultadas.end()),
+                                    c.consultadas.end());
+                for (size_t id : c.consultadas) a.ordem[id]->chamadores.push_back(d.id);
+            }
+            d.sitios.clear();
+            coletar_sitios(c, d.sitios);
+
+            size_t base = d.metodo ? 1 : 0;
+            escapa.assign(d.escapa.size(), false);
+            if (d.metodo) escapa[0] = c.auto_escapa || c.auto_retornado;
+            for (size_t i = 0; i < d.params->size(); i++) {
+                escapa[i + base] = c.escapam.count((*d.params)[i]) > 0;
+            }
+            auto_escapa = c.auto_escapa;
+        }
+        if (escapa == d.escapa && auto_escapa == d.auto_escapa_construtor) continue;
+        d.escapa = std::move(escapa);
+        d.auto_escapa_construtor = auto_escapa;
+        for (size_t id : d.chamadores) {
+            EscapeDecl* ch = a.ordem[id];
+            if (!ch->na_fila) {
+                ch->na_fila = true;
+                fila.push_back(ch);
+            }
+        }
+    }
+
+    auto sitios = std::make_shared<std::unordered_set<const void*>>();
+    for (auto* d : a.ordem) sitios->insert(d->sitios.begin(), d->sitios.end());
+    EscapeCorpo principal;
+    for (auto* stmt : topo) escape_stmt(*stmt, a, principal);
+    std::vector<const void*> do_topo;
+    coletar_sitios(principal, do_topo);
+    sitios->insert(do_topo.begin(), do_topo.end());
+
+    Tempos::global().fase("calcular_escape", fase.ms(),
+                          {{"declaracoes", a.decls.size()}, {"analises", analises},
+                           {"sitios_pilha", sitios->size()}});
+    pilha_sitios_ = std::move(sitios);
+}
+
+// ======================================================================
+// BLOCOS NO FRAME — antes do prólogo de cada função
+// ======================================================================
+
+// Reserva o topo do frame para os sítios do corpo; devolve os bytes, que
+// entram no local_bytes do prólogo. Os temporários ficam abaixo dos blocos
+int32_t reservar_blocos_pilha(const StmtList& corpo) {
+    blocos_pilha_.clear();
+    if (!pilha_sitios_ || pilha_sitios_->empty()) return 0;
+    int32_t total = 0;
+    for (auto& stmt : corpo) reservar_blocos_stmt(*stmt, total);
+    local_offset_ -= total;
+    return total;
+}
+
+void reservar_bloco(const void* sitio, int32_t bytes, int32_t& total) {
+    if (blocos_pilha_.count(sitio)) return;
+    total += bytes;
+    blocos_pilha_[sitio] = {-total, bytes};
+}
+
+void reservar_blocos_expr(const Expr& expr, int32_t& total) {
+    filhos_expr(expr, [&](const Expr& f) { reservar_blocos_expr(f, total); });
+    if (auto* mc = std::get_if<MetodoChamadaExpr>(&expr.node)) {
+        if (!pilha_sitios_->count(mc)) return;
+        auto& cls = std::get<VarExpr>(mc->object->node);
+        auto cit = declared_classes_.find(cls.name);
+        if (cit == declared_classes_.end()) return;
+        int32_t bytes = std::max(cit->second.instance_size, 8);
+        if (bytes <= PILHA_OBJETO_MAX_BYTES) reservar_bloco(mc, bytes, total);
+    }
+    else if (auto* lista = std::get_if<ListLitExpr>(&expr.node)) {
+        if (!pilha_sitios_->count(lista)) return;
+        int32_t cap = list_literal_cap(lista->elements.size());
+        reservar_bloco(lista, LIST_STRUCT_SIZE + cap * 8, total);
+    }
+}
+
+void reservar_blocos_stmt(const Stmt& stmt, int32_t& total) {
+    auto expr = [&](const ExprPtr& e) { if (e) reservar_blocos_expr(*e, total); };
+    auto corpo = [&](const StmtList& body) {
+        for (auto& s : body) reservar_blocos_stmt(*s, total);
+    };
+    std::visit([&](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, AssignStmt> || std::is_same_v<T, SaidaStmt> ||
+                      std::is_same_v<T, RetornaStmt>) {
+            expr(node.value);
+        }
+        else if constexpr (std::is_same_v<T, AttrSetStmt>) {
+            expr(node.object);
+            expr(node.value);
+        }
+        else if constexpr (std::is_same_v<T, IndexSetStmt>) {
+            expr(node.index);
+            expr(node.value);
+        }
+        else if constexpr (std::is_same_v<T, ExprStmt>) {
+            expr(node.expr);
+        }
+        else if constexpr (std::is_same_v<T, IfStmt>) {
+            for (auto& br : node.branches) {
+                expr(br.condition);
+                corpo(br.body);
+            }
+        }
+        else if constexpr (std::is_same_v<T, RepetirStmt>) {
+            expr(node.count);
+            corpo(node.body);
+        }
+        else if constexpr (std::is_same_v<T, EnquantoStmt>) {
+            expr(node.condition);
+            corpo(node.body);
+        }
+        else if constexpr (std::is_same_v<T, ParaStmt>) {
+            expr(node.start);
+            expr(node.end);
+            expr(node.step);
+            corpo(node.body);
+        }
+    }, stmt.node);
+}
+
+// Bloco do sítio no frame atual, ou nullptr (heap)
+const std::pair<int32_t, int32_t>* bloco_pilha(const void* sitio) const {
+    auto it = blocos_pilha_.find(sitio);
+    return it != blocos_pilha_.end() ? &it->second : nullptr;
+}
@@ -56,55 +56,7 @@ void emit_expr(const Expr& expr) {
             emit_chamada(node);
         }
         else if constexpr (std::is_same_v<T, ConcatExpr>) {
-            // Concatenação de strings: left .. right
-            // Emitir como BinOpExpr(Add) com strings
-            emit_expr(*node.left);
-            std::string cl_tmp = "__concat_l_" + std::to_string(text_->pos());
-            int32_t cl_off = alloc_local(cl_tmp);
-            emit_mov_rbp_reg(cl_off, reg::RAX);
-
-            emit_expr(*node.right);
-            std::string cr_tmp = "__concat_r_" + std::to_string(text_->pos());
-            int32_t cr_off = alloc_local(cr_tmp);
-            emit_mov_rbp_reg(cr_off, reg::RAX);
-
-            // strlen(left)
-            emit_mov_reg_rbp(PlatformDefs::ARG1, cl_off);
-            emit_call_extern("strlen");
-            std::string clen1 = "__concat_len1_" + std::to_string(text_->pos());
-            int32_t clen1_off = alloc_local(clen1);
-            emit_mov_rbp_reg(clen1_off, reg::RAX);
-
-            // strlen(right)
-            emit_mov_reg_rbp(PlatformDefs::ARG1, cr_off);
-            emit_call_extern("strlen");
-            std::string clen2 = "__concat_len2_" + std::to_string(text_->pos());
-            int32_t clen2_off = alloc_local(clen2);
-            emit_mov_rbp_reg(clen2_off, reg::RAX);
-
-            // malloc(len1 + len2 + 1)
-            emit_mov_reg_rbp(reg::RAX, clen1_off);
-            emit_mov_reg_rbp(reg::RCX, clen2_off);
-            emit_add_reg_reg(reg::RAX, reg::RCX);
-            emit_rex_w(0, reg::RAX);
-            text_->emit_u8(0x83);
-            text_->emit_u8(0xC0);
-            text_->emit_u8(0x01);
-            emit_mov_reg_reg(PlatformDefs::ARG1, reg::RAX);
-            emit_call_extern("malloc");
-            std::string cbuf = "__concat_buf_" + std::to_string(text_->pos());
-            int32_t cbuf_off = alloc_local(cbuf);
-            emit_mov_rbp_reg(cbuf_off, reg::RAX);
-
-            // strcpy + strcat
-            emit_mov_reg_rbp(PlatformDefs::ARG1, cbuf_off);
-            emit_mov_reg_rbp(PlatformDefs::ARG2, cl_off);
-            emit_call_extern("strcpy");
-            emit_mov_reg_rbp(PlatformDefs::ARG1, cbuf_off);
-            emit_mov_reg_rbp(PlatformDefs::ARG2, cr_off);
-            emit_call_extern("strcat");
-
-            emit_mov_reg_rbp(reg::RAX, cbuf_off);
+            medir_tamanho("concatenacao", [&] { emit_concat(node); });
         }
         else if constexpr (std::is_same_v<T, MetodoChamadaExpr>) {
             // Verificar se é chamada estática de construtor: Classe.metodo(args)
@@ -116,13 +68,15 @@ void emit_expr(const Expr& expr) {
                 }
                 // Verificar se é método de lista
                 if (is_list_var(var.name)) {
-                    if constexpr (PlatformDefs::is_windows) {
-                        if (!emit_list_method(node)) {
-                            emit_metodo_chamada(node);
+                    medir_tamanho("lista", [&] {
+                        if constexpr (PlatformDefs::is_windows) {
+                            if (!emit_list_method(node)) {
+                                emit_metodo_chamada(node);
+                            }
+                        } else {
+                            emit_list_method(var.name, node.method, node.args);
                         }
-                    } else {
-                        emit_list_method(var.name, node.method, node.args);
-                    }
+                    });
                     return;
                 }
             }
@@ -136,13 +90,13 @@ void emit_expr(const Expr& expr) {
             emit_auto_expr();
         }
         else if constexpr (std::is_same_v<T, ListLitExpr>) {
-            emit_list_literal(node);
+            medir_tamanho("lista", [&] { emit_list_literal(node); });
         }
         else if constexpr (std::is_same_v<T, IndexGetExpr>) {
             if (std::holds_alternative<VarExpr>(node.object->node)) {
                 auto& var = std::get<VarExpr>(node.object->node);
                 if (is_list_var(var.name)) {
-                    emit_list_index_get(node, var.name);
+                    medir_tamanho("lista", [&] { emit_list_index_get(node, var.name); });
                     return;
                 }
             }
@@ -176,7 +130,7 @@ void emit_expr_as_float(const Expr& expr) {
 void emit_index_get(const IndexGetExpr& node) {
     // Avaliar o objeto (ponteiro base) → salvar
     emit_expr(*node.object);
-    std::string base_tmp = "__idxget_base_" + std::to_string(text_->pos());
+    std::string base_tmp = "__idxget_base_" + pos_tag();
     int32_t base_off = alloc_local(base_tmp);
     emit_mov_rbp_reg(base_off, reg::RAX);
 
@@ -203,9 +157,12 @@ void emit_binop(const BinOpExpr& node) {
     bool is_float = (lt == RuntimeType::Float || rt == RuntimeType::Float);
     bool is_string = (lt == RuntimeType::String || rt == RuntimeType::String);
 
+    // Nem sempre o nó inteiro passa por infer_expr_type (retorna a % 2)
+    if (node.op != BinOp::Add && is_string) registrar_erro_tipo(node);
+
     // Concatenação de strings: "abc" + "def" ou var_str + var_str
     if (node.op == BinOp::Add && is_string) {
-        emit_binop_strcat(node);
+        medir_tamanho("concatenacao", [&] { emit_binop_strcat(node); });
         return;
     }
 
@@ -258,12 +215,76 @@ void emit_binop_int(const BinOpExpr& node) {
 // Resultado: ponteiro para nova string em RAX
 // ======================================================================
 
+// Concatenação de strings: left .. right (ConcatExpr)
+void emit_concat(const ConcatExpr& node) {
+    emit_expr(*node.left);
+    std::string cl_tmp = "__concat_l_" + pos_tag();
+    int32_t cl_off = alloc_local(cl_tmp);
+    emit_mov_rbp_reg(cl_off, reg::RAX);
+
+    emit_expr(*node.right);
+    std::string cr_tmp = "__concat_r_" + pos_tag();
+    int32_t cr_off = alloc_local(cr_tmp);
+    emit_mov_rbp_reg(cr_off, reg::RAX);
+
+    if (usar_jprt()) {
+        emit_jprt_concat(cl_off, cr_off);
+        return;
+    }
+
+    // strlen(left)
+    emit_mov_reg_rbp(PlatformDefs::ARG1, cl_off);
+    emit_call_extern("strlen");
+    std::string clen1 = "__concat_len1_" + pos_tag();
+    int32_t clen1_off = alloc_local(clen1);
+    emit_mov_rbp_reg(clen1_off, reg::RAX);
+
+    // strlen(right)
+    emit_mov_reg_rbp(PlatformDefs::ARG1, cr_off);
+    emit_call_extern("strlen");
+    std::string clen2 = "__concat_len2_" + pos_tag();
+    int32_t clen2_off = alloc_local(clen2);
+    emit_mov_rbp_reg(clen2_off, reg::RAX);
+
+    // malloc(len1 + len2 + 1)
+    emit_mov_reg_rbp(reg::RAX, clen1_off);
+    emit_mov_reg_rbp(reg::RCX, clen2_off);
+    emit_add_reg_reg(reg::RAX, reg::RCX);
+    emit_rex_w(0, reg::RAX);
+    text_->emit_u8(0x83);
+    text_->emit_u8(0xC0);
+    text_->emit_u8(0x01);
+    emit_mov_reg_reg(PlatformDefs::ARG1, reg::RAX);
+    emit_call_extern("malloc");
+    std::string cbuf = "__concat_buf_" + pos_tag();
+    int32_t cbuf_off = alloc_local(cbuf);
+    emit_mov_rbp_reg(cbuf_off, reg::RAX);
+
+    // strcpy + strcat
+    emit_mov_reg_rbp(PlatformDefs::ARG1, cbuf_off);
+    emit_mov_reg_rbp(PlatformDefs::ARG2, cl_off);
+    emit_call_extern("strcpy");
+    emit_mov_reg_rbp(PlatformDefs::ARG1, cbuf_off);
+    emit_mov_reg_rbp(PlatformDefs::ARG2, cr_off);
+    emit_call_extern("strcat");
+
+    emit_mov_reg_rbp(reg::RAX, cbuf_off);
+}
+
 // Converte valor em RAX (int/bool) para string via sprintf
 // Resultado: ponteiro para string em RAX
 void emit_int_to_string_inplace(int32_t val_off, int32_t& out_off) {
     // Aloca buffer de 32 bytes para o número convertido
-    std::string buf_name = "__itoa_buf_" + std::to_string(text_->pos());
+    std::string buf_name = "__itoa_buf_" + pos_tag();
     int32_t buf_off = alloc_local(buf_name);
+    out_off = buf_off;
+
+    if (usar_jprt()) {
+        emit_mov_reg_rbp(reg::RAX, val_off);
+        emit_jprt_texto(RuntimeType::Int);
+        emit_mov_rbp_reg(buf_off, reg::RAX);
+        return;
+    }
 
     // malloc(32)
     emit_mov_reg_imm32(PlatformDefs::ARG1, 32);
@@ -275,14 +296,20 @@ void emit_int_to_string_inplace(int32_t val_off, int32_t& out_off) {
     emit_load_string(PlatformDefs::ARG2, "%lld");
     emit_mov_reg_rbp(PlatformDefs::ARG3, val_off);
     emit_call_extern("sprintf");
-
-    out_off = buf_off;
 }
 
 // Converte valor float em XMM0 para string via sprintf
 void emit_float_to_string_inplace(int32_t val_off, int32_t& out_off) {
-    std::string buf_name = "__ftoa_buf_" + std::to_string(text_->pos());
+    std::string buf_name = "__ftoa_buf_" + pos_tag();
     int32_t buf_off = alloc_local(buf_name);
+    out_off = buf_off;
+
+    if (usar_jprt()) {
+        emit_movsd_xmm_rbp(xmm::XMM0, val_off);
+        emit_jprt_texto(RuntimeType::Float);
+        emit_mov_rbp_reg(buf_off, reg::RAX);
+        return;
+    }
 
     // malloc(64)
     emit_mov_reg_imm32(PlatformDefs::ARG1, 64);
@@ -302,8 +329,6 @@ void emit_float_to_string_inplace(int32_t val_off, int32_t& out_off) {
         emit_movsd_xmm_rbp(xmm::XMM0, val_off);
     }
     emit_call_extern("sprintf");
-
-    out_off = buf_off;
 }
 
 void emit_binop_strcat(const BinOpExpr& node) {
@@ -312,7 +337,7 @@ void emit_binop_strcat(const BinOpExpr& node) {
 
     // 1. Avaliar left → salvar em temp
     emit_expr(*node.left);
-    std::string left_tmp = "__strcat_l_" + std::to_string(text_->pos());
+    std::string left_tmp = "__strcat_l_" + pos_tag();
     int32_t left_off = alloc_local(left_tmp);
     if (lt == RuntimeType::Float) {
         emit_movsd_rbp_xmm(left_off, xmm::XMM0);
@@ -322,7 +347,7 @@ void emit_binop_strcat(const BinOpExpr& node) {
 
     // 2. Avaliar right → salvar em temp
     emit_expr(*node.right);
-    std::string right_tmp = "__strcat_r_" + std::to_string(text_->pos());
+    std::string right_tmp = "__strcat_r_" + pos_tag();
     int32_t right_off = alloc_local(right_tmp);
     if (rt == RuntimeType::Float) {
         emit_movsd_rbp_xmm(right_off, xmm::XMM0);
@@ -352,17 +377,22 @@ void emit_binop_strcat(const BinOpExpr& node) {
         right_off = conv_off;
     }
 
+    if (usar_jprt()) {
+        emit_jprt_concat(left_off, right_off);
+        return;
+    }
+
     // 5. strlen(left) → salvar
     emit_mov_reg_rbp(PlatformDefs::ARG1, left_off);
     emit_call_extern("strlen");
-    std::string len1_tmp = "__strcat_len1_" + std::to_string(text_->pos());
+    std::string len1_tmp = "__strcat_len1_" + pos_tag();
     int32_t len1_off = alloc_local(len1_tmp);
     emit_mov_rbp_reg(len1_off, reg::RAX);
 
     // 6. strlen(right) → salvar
     emit_mov_reg_rbp(PlatformDefs::ARG1, right_off);
     emit_call_extern("strlen");
-    std::string len2_tmp = "__strcat_len2_" + std::to_string(text_->pos());
+    std::string len2_tmp = "__strcat_len2_" + pos_tag();
     int32_t len2_off = alloc_local(len2_tmp);
     emit_mov_rbp_reg(len2_off, reg::RAX);
 
@@ -377,7 +407,7 @@ void emit_binop_strcat(const BinOpExpr& node) {
     text_->emit_u8(0x01);
     emit_mov_reg_reg(PlatformDefs::ARG1, reg::RAX);
     emit_call_extern("malloc");
-    std::string buf_tmp = "__strcat_buf_" + std::to_string(text_->pos());
+    std::string buf_tmp = "__strcat_buf_" + pos_tag();
     int32_t buf_off = alloc_local(buf_tmp);
     emit_mov_rbp_reg(buf_off, reg::RAX);
 
@@ -398,9 +428,13 @@ void emit_binop_strcat(const BinOpExpr& node) {
 void emit_binop_float(const BinOpExpr& node, RuntimeType lt, RuntimeType rt) {
     (void)lt; (void)rt;
 
+    // Folhas simples e + - * /: pilha de registradores (codegen_float)
+    if (emit_float_pilha(node)) return;
+    if (emit_float_fma_temporarios(node)) return;
+
     // Avaliar left → salvar na stack (seguro pra operações aninhadas)
     emit_expr_as_float(*node.left);
-    std::string left_tmp = "__binop_fl_" + std::to_string(text_->pos());
+    std::string left_tmp = "__binop_fl_" + pos_tag();
     int32_t left_off = alloc_local(left_tmp);
     emit_movsd_rbp_xmm(left_off, xmm::XMM0);
 
@@ -458,7 +492,7 @@ void emit_cmpop(const CmpOpExpr& node) {
         // Comparação com nulo: sempre usa inteiro (nulo = 0)
         emit_cmpop_int(node);
     } else if (is_string) {
-        emit_cmpop_string(node);
+        if (!emit_cmpop_string_literal(node)) emit_cmpop_string(node);
     } else if (is_float) {
         emit_cmpop_float(node);
     } else {
@@ -476,7 +510,7 @@ void emit_cmpop(const CmpOpExpr& node) {
 void emit_cmpop_string(const CmpOpExpr& node) {
     // Avaliar left → salvar em temporário
     emit_expr(*node.left);
-    std::string tmp = "__strcmp_left_" + std::to_string(text_->pos());
+    std::string tmp = "__strcmp_left_" + pos_tag();
     int32_t tmp_off = alloc_local(tmp);
     emit_mov_rbp_reg(tmp_off, reg::RAX);
 
@@ -487,8 +521,14 @@ void emit_cmpop_string(const CmpOpExpr& node) {
     // Carregar left → ARG1
     emit_mov_reg_rbp(PlatformDefs::ARG1, tmp_off);
 
+    // Mesmo ponteiro (literais iguais são um só no .rodata): 0 sem chamar
+    emit_xor_reg_reg(reg::RAX, reg::RAX);
+    emit_cmp_reg_reg(PlatformDefs::ARG1, PlatformDefs::ARG2);
+    size_t mesmo = emit_je_rel32();
+
     // Chamar strcmp
     emit_call_extern("strcmp");
+    patch_jump(mesmo);
 
     // RAX = resultado do strcmp — comparar com 0
     emit_cmp_reg_imm32(reg::RAX, 0);
@@ -498,6 +538,110 @@ void emit_cmpop_string(const CmpOpExpr& node) {
     emit_movzx_reg64_reg8(reg::RAX, reg::RAX);
 }
 
+// ======================================================================
+// IGUALDADE COM LITERAL STRING (== / !=), SEM strcmp NO CAMINHO COMUM
+//
+// Ponteiro igual ao do literal → igual; primeiro byte diferente → diferente.
+// Literal + terminador até 16 bytes: uma ou duas leituras de 8 bytes
+// comparadas com imediatos (o byte 0 do terminador confere o tamanho).
+// Mais longo: memcmp de tamanho + 1. As leituras largas só acontecem se
+// não cruzam o fim da página do primeiro byte; senão, strcmp.
+// ======================================================================
+
+bool emit_cmpop_string_literal(const CmpOpExpr& node) {
+    if (node.op != CmpOp::Eq && node.op != CmpOp::Ne) return false;
+    auto* lit = std::get_if<StringLit>(&node.right->node);
+    const Expr* outro = node.left.get();
+    if (!lit) {
+        lit = std::get_if<StringLit>(&node.left->node);
+        outro = node.right.get();
+    }
+    if (!lit || std::holds_alternative<StringLit>(outro->node)) return false;
+
+    const std::string& s = lit->value;
+    size_t bytes = s.size() + 1;                 // com o terminador
+    std::vector<size_t> para_igual, para_diferente, para_lento;
+
+    emit_expr(*outro);                           // RAX = string
+    emit_load_string(reg::RCX, s);
+    emit_cmp_reg_reg(reg::RAX, reg::RCX);
+    para_igual.push_back(emit_je_rel32());
+
+    text_->emit_u8(0x0F);
+    text_->emit_u8(0xB6);
+    text_->emit_u8(0x10);                        // MOVZX EDX, BYTE [RAX]
+    text_->emit_u8(0x80);
+    text_->emit_u8(0xFA);
+    text_->emit_u8(static_cast<uint8_t>(s.empty() ? 0 : s[0]));   // CMP DL, imm8
+    para_diferente.push_back(emit_jne_rel32());
+
+    if (!s.empty()) {
+        // Leitura larga dentro da página: (RAX & 0xFFF) <= 4096 - largura
+        size_t largura = bytes <= 8 ? 8 : bytes <= 16 ? 16 : bytes;
+        if (largura <= 4096) {
+            text_->emit_u8(0x89);
+            text_->emit_u8(0xC2);                // MOV EDX, EAX
+            text_->emit_u8(0x81);
+            text_->emit_u8(0xE2);
+            text_->emit_i32(0xFFF);              // AND EDX, 0xFFF
+            text_->emit_u8(0x81);
+            text_->emit_u8(0xFA);
+            text_->emit_i32(static_cast<int32_t>(4096 - largura));   // CMP EDX, imm32
+            para_lento.push_back(emit_jcc_rel32(CC_A));
+        } else {
+            para_lento.push_back(emit_jmp_rel32());
+        }
+
+        if (largura <= 16) {
+            for (size_t ini = 0; ini < bytes; ini += 8) {
+                size_t n = std::min<size_t>(8, bytes - ini);
+                uint64_t valor = 0;
+                std::memcpy(&valor, s.c_str() + ini, n);
+                text_->emit_u8(0x48);
+                text_->emit_u8(0x8B);
+                text_->emit_u8(0x50);
+                text_->emit_u8(static_cast<uint8_t>(ini));   // MOV RDX, [RAX+ini]
+                if (n < 8) {
+                    emit_mov_reg_imm64(reg::RCX, (uint64_t(1) << (8 * n)) - 1);
+                    text_->emit_u8(0x48);
+                    text_->emit_u8(0x21);
+                    text_->emit_u8(0xCA);        // AND RDX, RCX
+                }
+                emit_mov_reg_imm64(reg::RCX, valor);
+                emit_cmp_reg_reg(reg::RDX, reg::RCX);
+                para_diferente.push_back(emit_jne_rel32());
+            }
+            para_igual.push_back(emit_jmp_rel32());
+        } else if (largura <= 4096) {
+            emit_mov_reg_reg(PlatformDefs::ARG1, reg::RAX);
+            emit_load_string(PlatformDefs::ARG2, s);
+            emit_mov_reg_imm32(PlatformDefs::ARG3, static_cast<int32_t>(bytes));
+            emit_call_extern("memcmp");
+            emit_test_reg_reg(reg::RAX, reg::RAX);
+            para_diferente.push_back(emit_jne_rel32());
+            para_igual.push_back(emit_jmp_rel32());
+        }
+
+        // Perto do fim da página: strcmp
+        for (size_t p : para_lento) patch_jump(p);
+        emit_mov_reg_reg(PlatformDefs::ARG1, reg::RAX);
+        emit_load_string(PlatformDefs::ARG2, s);
+        emit_call_extern("strcmp");
+        text_->emit_u8(0x85);
+        text_->emit_u8(0xC0);                    // TEST EAX, EAX
+        para_diferente.push_back(emit_jne_rel32());
+    }
+
+    // Vazio: o primeiro byte (0) já decidiu
+    for (size_t p : para_igual) patch_jump(p);
+    emit_mov_reg_imm32(reg::RAX, node.op == CmpOp::Eq ? 1 : 0);
+    size_t fim = emit_jmp_rel32();
+    for (size_t p : para_diferente) patch_jump(p);
+    emit_mov_reg_imm32(reg::RAX, node.op == CmpOp::Eq ? 0 : 1);
+    patch_jump(fim);
+    return true;
+}
+
 void emit_cmpop_int(const CmpOpExpr& node) {
     emit_expr(*node.left);
     emit_push(reg::RAX);
@@ -594,25 +738,10 @@ void emit_chamada(const ChamadaExpr& node) {
         if (emit_native_call(node)) return;
     }
 
-    // Registradores de argumento da plataforma
-    constexpr size_t MAX_REG_ARGS = PlatformDefs::is_windows ? 4 : 6;
-
-    const uint8_t arg_regs[] = {
-        PlatformDefs::ARG1, PlatformDefs::ARG2,
-        PlatformDefs::ARG3, PlatformDefs::ARG4,
-        // ARG5 e ARG6 só existem no Linux (System V tem 6 regs)
-        PlatformDefs::is_linux ? PlatformDefs::ARG5 : uint8_t(0),
-        PlatformDefs::is_linux ? PlatformDefs::ARG6 : uint8_t(0),
-    };
-
-    const uint8_t arg_xmms[] = {
-        PlatformDefs::FLOAT_ARG1, PlatformDefs::FLOAT_ARG2,
-        PlatformDefs::FLOAT_ARG3, PlatformDefs::FLOAT_ARG4,
-    };
-
-    // Avaliar args e salvar em temporários
-    std::vector<int32_t> arg_offsets;
-    std::vector<RuntimeType> arg_types;
+    // -pgo-usar: chamada quente de função folha vai no lugar
+    std::string ponto = pgo_ponto("chamada", static_cast<uint32_t>(node.line));
+    emit_pgo_contar(ponto, 0);
+    if (emit_pgo_inline(node, ponto)) return;
 
     // Buscar tipos de parâmetros declarados no JSON (funções externas)
     std::vector<RuntimeType>* extern_param_types = nullptr;
@@ -623,6 +752,68 @@ void emit_chamada(const ChamadaExpr& node) {
         }
     }
 
+    // Avaliar args e salvar em temporários
+    std::vector<int32_t> arg_offsets;
+    std::vector<RuntimeType> arg_types;
+    avaliar_args_chamada(node, extern_param_types, arg_offsets, arg_types);
+
+    // Funções externas (.jpd) recebem tudo como int64_t — decimais vão
+    // como bits de double nos registradores inteiros (GPR), não nos XMM.
+    // Funções internas do usuário e do sistema usam a ABI normal da plataforma.
+    bool is_extern_jpd = (extern_param_types != nullptr);
+
+    // === DIAGNOSTICO PRE-CHAMADA FFI ===
+    // Deve ser emitido ANTES de carregar args nos registradores,
+    // pois o fprintf interno destrói RCX, RDX, R8, R9.
+    // Os args já estão salvos nos temporários (arg_offsets), então é seguro.
+    if (is_extern_jpd) {
+        medir_tamanho("diagnostico_ffi", [&] {
+            emit_diag_pre_ffi(node.name, node.line, diag_source_file());
+        });
+    }
+
+    // Carregar args nos registradores
+    carregar_args_chamada(arg_offsets, arg_types, is_extern_jpd);
+
+    // System V variádica: AL = 0
+    if constexpr (PlatformDefs::VARIADIC_NEEDS_AL) {
+        emit_xor_reg_reg(reg::RAX, reg::RAX);
+    }
+
+    emit_call_symbol(simbolo_chamada(node.name));
+
+    // === DIAGNOSTICO POS-CHAMADA FFI ===
+    if (is_extern_jpd) {
+        auto diag_ret_it = func_return_types_.find(node.name);
+        RuntimeType diag_ret_type = (diag_ret_it != func_return_types_.end())
+                                    ? diag_ret_it->second : RuntimeType::Unknown;
+        medir_tamanho("diagnostico_ffi", [&] {
+            emit_diag_pos_ffi(node.name, node.line, diag_ret_type);
+        });
+    }
+
+    // Se a função externa retorna decimal, o valor está em RAX como bits de double.
+    // Mover pra XMM0 pra que o resto do codegen trate como float.
+    auto ret_it = func_return_types_.find(node.name);
+    if (ret_it != func_return_types_.end() && ret_it->second == RuntimeType::Float) {
+        // MOVQ XMM0, RAX (mover bits raw, sem converter)
+        emit_movq_xmm_gpr(xmm::XMM0, reg::RAX);
+    }
+}
+
+// Resolver símbolo da função chamada
+uint32_t simbolo_chamada(Sym name) {
+    if (emitter_.has_symbol(name)) {
+        return emitter_.symbol_index(name);
+    }
+    return emitter_.add_extern_symbol(name);
+}
+
+// Avalia os args da chamada em temporários (tipos registrados na FuncInfo)
+void avaliar_args_chamada(const ChamadaExpr& node,
+                          const std::vector<RuntimeType>* extern_param_types,
+                          std::vector<int32_t>& arg_offsets,
+                          std::vector<RuntimeType>& arg_types) {
     for (size_t i = 0; i < node.args.size(); i++) {
         RuntimeType type = infer_expr_type(*node.args[i]);
 
@@ -634,6 +825,7 @@ void emit_chamada(const ChamadaExpr& node) {
             }
             if (fit->second.param_types[i] == RuntimeType::Unknown) {
                 fit->second.param_types[i] = type;
+                tipos_mudaram();
             }
         }
 
@@ -659,7 +851,7 @@ void emit_chamada(const ChamadaExpr& node) {
         arg_types.push_back(type);
 
         std::string temp = "__arg_" + std::to_string(i) + "_" +
-                           std::to_string(text_->pos());
+                           pos_tag();
         int32_t off = alloc_local(temp);
 
         if (type == RuntimeType::Float) {
@@ -669,22 +861,29 @@ void emit_chamada(const ChamadaExpr& node) {
         }
         arg_offsets.push_back(off);
     }
+}
 
-    // Funções externas (.jpd) recebem tudo como int64_t — decimais vão
-    // como bits de double nos registradores inteiros (GPR), não nos XMM.
-    // Funções internas do usuário e do sistema usam a ABI normal da plataforma.
-    bool is_extern_jpd = (extern_param_types != nullptr);
+// Carrega os temporários nos registradores de argumento (e na pilha)
+void carregar_args_chamada(const std::vector<int32_t>& arg_offsets,
+                           const std::vector<RuntimeType>& arg_types,
+                           bool is_extern_jpd) {
+    // Registradores de argumento da plataforma
+    constexpr size_t MAX_REG_ARGS = PlatformDefs::is_windows ? 4 : 6;
 
-    // === DIAGNOSTICO PRE-CHAMADA FFI ===
-    // Deve ser emitido ANTES de carregar args nos registradores,
-    // pois o fprintf interno destrói RCX, RDX, R8, R9.
-    // Os args já estão salvos nos temporários (arg_offsets), então é seguro.
-    if (is_extern_jpd) {
-        emit_diag_pre_ffi(node.name, node.line, diag_source_file());
-    }
+    const uint8_t arg_regs[] = {
+        PlatformDefs::ARG1, PlatformDefs::ARG2,
+        PlatformDefs::ARG3, PlatformDefs::ARG4,
+        // ARG5 e ARG6 só existem no Linux (System V tem 6 regs)
+        PlatformDefs::is_linux ? PlatformDefs::ARG5 : uint8_t(0),
+        PlatformDefs::is_linux ? PlatformDefs::ARG6 : uint8_t(0),
+    };
 
-    // Carregar args nos registradores
-    for (size_t i = 0; i < node.args.size(); i++) {
+    const uint8_t arg_xmms[] = {
+        PlatformDefs::FLOAT_ARG1, PlatformDefs::FLOAT_ARG2,
+        PlatformDefs::FLOAT_ARG3, PlatformDefs::FLOAT_ARG4,
+    };
+
+    for (size_t i = 0; i < arg_offsets.size(); i++) {
         if (i < MAX_REG_ARGS) {
             if (arg_types[i] == RuntimeType::Float) {
                 if (is_extern_jpd) {
@@ -737,37 +936,6 @@ void emit_chamada(const ChamadaExpr& node) {
             }
         }
     }
-
-    // System V variádica: AL = 0
-    if constexpr (PlatformDefs::VARIADIC_NEEDS_AL) {
-        emit_xor_reg_reg(reg::RAX, reg::RAX);
-    }
-
-    // Resolver símbolo e chamar
-    uint32_t sym_idx;
-    if (emitter_.has_symbol(node.name)) {
-        sym_idx = emitter_.symbol_index(node.name);
-    } else {
-        sym_idx = emitter_.add_extern_symbol(node.name);
-    }
-
-    emit_call_symbol(sym_idx);
-
-    // === DIAGNOSTICO POS-CHAMADA FFI ===
-    if (is_extern_jpd) {
-        auto diag_ret_it = func_return_types_.find(node.name);
-        RuntimeType diag_ret_type = (diag_ret_it != func_return_types_.end())
-                                    ? diag_ret_it->second : RuntimeType::Unknown;
-        emit_diag_pos_ffi(node.name, node.line, diag_ret_type);
-    }
-
-    // Se a função externa retorna decimal, o valor está em RAX como bits de double.
-    // Mover pra XMM0 pra que o resto do codegen trate como float.
-    auto ret_it = func_return_types_.find(node.name);
-    if (ret_it != func_return_types_.end() && ret_it->second == RuntimeType::Float) {
-        // MOVQ XMM0, RAX (mover bits raw, sem converter)
-        emit_movq_xmm_gpr(xmm::XMM0, reg::RAX);
-    }
 }
 
 // ======================================================================
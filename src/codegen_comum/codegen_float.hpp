@@ -0,0 +1,227 @@
+// codegen_float.hpp
+// Expressões float em pilha de registradores XMM e contração a*b+c em FMA
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// emit_binop_float guarda o operando esquerdo num temporário do frame e o
+// recarrega depois do direito. Quando a árvore inteira é de folhas simples
+// (literais e variáveis) e operações + - * /, ela vai direto para
+// registradores: cada nó avalia no topo da pilha (XMM0 na raiz) e usa os
+// de cima para o filho que vem depois; o filho que precisa de mais
+// registradores (número de Ershov) é avaliado primeiro. Os registradores
+// livres vêm de PlatformDefs::FLOAT_EXPR_REGS; árvore que não cabe, ou com
+// chamadas, % e subexpressões inteiras, fica no caminho com temporários.
+//
+//   -alvo=nativo    usa o que a CPU que compila tem: com FMA, a*b + c,
+//                   a*b - c e c - a*b viram vfmadd/vfmsub/vfnmadd231sd
+//                   (um arredondamento só, como o -ffp-contract=fast do gcc),
+//                   dentro ou fora da pilha
+//   -ieee-estrito   cada operação arredonda separado, sem contração
+//                   (resultado igual bit a bit ao de sem -alvo=nativo)
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool alvo_nativo_ = false;
+bool ieee_estrito_ = false;
+
+static bool cpu_tem_fma() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+bool fma_ativo() const {
+    return alvo_nativo_ && !ieee_estrito_ && cpu_tem_fma();
+}
+
+// ======================================================================
+// RECONHECIMENTO
+// ======================================================================
+
+// Folha carregada direto num registrador qualquer: mesmo valor que
+// emit_expr_as_float daria (variável não-float passa por cvtsi2sd)
+bool float_folha(const Expr& e) {
+    return std::holds_alternative<FloatLit>(e.node) ||
+           std::holds_alternative<NumberLit>(e.node) ||
+           std::holds_alternative<VarExpr>(e.node);
+}
+
+// Nó que emit_binop mandaria para emit_binop_float, sem %
+const BinOpExpr* float_no(const Expr& e) {
+    auto* bin = std::get_if<BinOpExpr>(&e.node);
+    if (!bin) return nullptr;
+    RuntimeType lt = infer_expr_type(*bin->left);
+    RuntimeType rt = infer_expr_type(*bin->right);
+    if (lt == RuntimeType::String || rt == RuntimeType::String) return nullptr;
+    bool is_float = lt == RuntimeType::Float || rt == RuntimeType::Float;
+    if (!is_float && bin->op != BinOp::Div) return nullptr;
+    return bin;
+}
+
+// a*b ± c / c - a*b
+struct FmaForma {
+    const BinOpExpr* prod;
+    const Expr* c;
+    uint8_t opcode;     // B9 vfmadd231sd, BB vfmsub231sd, BD vfnmadd231sd
+};
+
+std::optional<FmaForma> float_fma(const BinOpExpr& bin) {
+    if (!fma_ativo() || (bin.op != BinOp::Add && bin.op != BinOp::Sub)) return std::nullopt;
+    auto produto = [&](const Expr& e) {
+        const BinOpExpr* p = float_no(e);
+        return p && p->op == BinOp::Mul ? p : nullptr;
+    };
+    if (auto* p = produto(*bin.left)) {
+        return FmaForma{p, bin.right.get(), static_cast<uint8_t>(bin.op == BinOp::Add ? 0xB9 : 0xBB)};
+    }
+    if (auto* p = produto(*bin.right)) {
+        return FmaForma{p, bin.left.get(), static_cast<uint8_t>(bin.op == BinOp::Add ? 0xB9 : 0xBD)};
+    }
+    return std::nullopt;
+}
+
+// Registradores que a subárvore precisa (0 = não vai para a pilha)
+int float_regs(const Expr& e) {
+    if (float_folha(e)) return 1;
+    const BinOpExpr* bin = float_no(e);
+    return bin ? float_regs(*bin) : 0;
+}
+
+int float_regs(const BinOpExpr& bin) {
+    if (bin.op == BinOp::Mod) return 0;
+    if (auto fma = float_fma(bin)) {
+        int c = float_regs(*fma->c);
+        int a = float_regs(*fma->prod->left);
+        int b = float_regs(*fma->prod->right);
+        if (!c || !a || !b) return 0;
+        return std::max({c, a + 1, b + 2});
+    }
+    int l = float_regs(*bin.left);
+    int r = float_regs(*bin.right);
+    if (!l || !r) return 0;
+    return l == r ? l + 1 : std::max(l, r);
+}
+
+// ======================================================================
+// EMISSÃO
+// ======================================================================
+
+// Árvore inteira em registradores, resultado em XMM0; false = não cabe
+bool emit_float_pilha(const BinOpExpr& node) {
+    int regs = float_regs(node);
+    if (regs == 0 || regs > PlatformDefs::FLOAT_EXPR_REGS) return false;
+    emit_float_em(node, xmm::XMM0);
+    return true;
+}
+
+// Contração fora da pilha (chamadas, listas...): os operandos passam por
+// temporários na ordem do fonte; mesma regra de float_fma que a pilha e o
+// vetorizador usam, então o mesmo a*b+c arredonda igual em todo lugar
+bool emit_float_fma_temporarios(const BinOpExpr& node) {
+    auto fma = float_fma(node);
+    if (!fma) return false;
+    bool produto_antes = fma->prod == std::get_if<BinOpExpr>(&node.left->node);
+    std::string tag = pos_tag();
+    int32_t t1 = alloc_local("__fma_t1_" + tag);
+    int32_t t2 = alloc_local("__fma_t2_" + tag);
+    if (produto_antes) {
+        emit_expr_as_float(*fma->prod->left);
+        emit_movsd_rbp_xmm(t1, xmm::XMM0);
+        emit_expr_as_float(*fma->prod->right);
+        emit_movsd_rbp_xmm(t2, xmm::XMM0);
+        emit_expr_as_float(*fma->c);
+    } else {
+        emit_expr_as_float(*fma->c);
+        emit_movsd_rbp_xmm(t1, xmm::XMM0);
+        emit_expr_as_float(*fma->prod->left);
+        emit_movsd_rbp_xmm(t2, xmm::XMM0);
+        emit_expr_as_float(*fma->prod->right);
+        emit_movsd_xmm_xmm(xmm::XMM2, xmm::XMM0);
+        emit_movsd_xmm_rbp(xmm::XMM0, t1);
+        emit_movsd_xmm_rbp(xmm::XMM1, t2);
+    }
+    if (produto_antes) {
+        emit_movsd_xmm_rbp(xmm::XMM1, t1);
+        emit_movsd_xmm_rbp(xmm::XMM2, t2);
+    }
+    emit_vfma231sd(fma->opcode, xmm::XMM0, xmm::XMM1, xmm::XMM2);
+    return true;
+}
+
+void emit_float_folha(const Expr& e, uint8_t t) {
+    if (auto* f = std::get_if<FloatLit>(&e.node)) {
+        emit_load_double_imm(t, f->value);
+    } else if (auto* n = std::get_if<NumberLit>(&e.node)) {
+        emit_load_double_imm(t, static_cast<double>(n->value));
+    } else {
+        auto& var = std::get<VarExpr>(e.node);
+        int32_t offset = find_local(var.name);
+        auto it = var_types_.find(var.name);
+        if (it != var_types_.end() && it->second == RuntimeType::Float) {
+            emit_movsd_xmm_rbp(t, offset);
+        } else {
+            emit_mov_reg_rbp(reg::RAX, offset);
+            emit_cvtsi2sd(t, reg::RAX);
+        }
+    }
+}
+
+// Valor de `e` em XMM<t>; XMM0..XMM<t-1> ficam intactos
+void emit_float_em(const Expr& e, uint8_t t) {
+    if (float_folha(e)) {
+        emit_float_folha(e, t);
+    } else {
+        emit_float_em(*float_no(e), t);
+    }
+}
+
+void emit_float_em(const BinOpExpr& bin, uint8_t t) {
+    uint8_t u = static_cast<uint8_t>(t + 1);
+
+    if (auto fma = float_fma(bin)) {
+        emit_float_em(*fma->c, t);
+        emit_float_em(*fma->prod->left, u);
+        emit_float_em(*fma->prod->right, static_cast<uint8_t>(t + 2));
+        emit_vfma231sd(fma->opcode, t, u, static_cast<uint8_t>(t + 2));
+        return;
+    }
+
+    if (float_regs(*bin.left) >= float_regs(*bin.right)) {
+        emit_float_em(*bin.left, t);
+        emit_float_em(*bin.right, u);
+        emit_float_op(bin.op, t, u);
+        return;
+    }
+    emit_float_em(*bin.right, t);
+    emit_float_em(*bin.left, u);
+    if (bin.op == BinOp::Add || bin.op == BinOp::Mul) {
+        emit_float_op(bin.op, t, u);
+    } else {
+        emit_float_op(bin.op, u, t);
+        emit_movsd_xmm_xmm(t, u);
+    }
+}
+
+void emit_float_op(BinOp op, uint8_t dst, uint8_t src) {
+    switch (op) {
+        case BinOp::Add: emit_addsd(dst, src); break;
+        case BinOp::Sub: emit_subsd(dst, src); break;
+        case BinOp::Mul: emit_mulsd(dst, src); break;
+        case BinOp::Div: emit_divsd(dst, src); break;
+        case BinOp::Mod: break;     // fora da pilha (float_regs)
+    }
+}
+
+// VFM*231SD dst, src2, src3 — VEX.LIG.66.0F38.W1 op /r
+void emit_vfma231sd(uint8_t opcode, uint8_t dst, uint8_t src2, uint8_t src3) {
+    text_->emit_u8(0xC4);
+    text_->emit_u8(static_cast<uint8_t>(((dst >= 8) ? 0x00 : 0x80) | 0x40 |
+                                        ((src3 >= 8) ? 0x00 : 0x20) | 0x02));
+    text_->emit_u8(static_cast<uint8_t>(0x80 | ((~src2 & 0x0F) << 3) | 0x01));
+    text_->emit_u8(opcode);
+    text_->emit_u8(static_cast<uint8_t>(0xC0 | ((dst & 7) << 3) | (src3 & 7)));
+}
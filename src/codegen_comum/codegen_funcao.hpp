@@ -221,9 +221,12 @@ void preanalyze_func_return_types(const Program& program) {
 
 void emit_main_function(const Program& program) {
     uint32_t main_offset = static_cast<uint32_t>(text_->pos());
+    func_text_start_ = main_offset;
     uint32_t main_sym = emitter_.add_global_symbol("main", text_idx_,
                                                      main_offset, true);
-    (void)main_sym;
+    // Prólogo na linha 1; o epílogo fica com o último statement do topo
+    entrar_funcao_depuracao("main", 1);
+    linha_atual_ = 0;
 
     locals_.clear();
     local_offset_ = 0;
@@ -232,7 +235,8 @@ void emit_main_function(const Program& program) {
     int32_t estimated_locals = count_locals(program.statements) + 32;
     // +24 para temporários do sistema de diagnóstico (handler de crash)
     estimated_locals += 24;
-    int32_t local_bytes = estimated_locals * 8 + PlatformDefs::MIN_STACK;
+    int32_t local_bytes = estimated_locals * 8 + PlatformDefs::MIN_STACK +
+                          reservar_blocos_pilha(program.statements);
     emit_prologue(local_bytes);
 
 #ifdef _WIN32
@@ -245,9 +249,9 @@ void emit_main_function(const Program& program) {
     //   int __wgetmainargs(int* argc, wchar_t*** argv, wchar_t*** env, int doWild, void* si)
     int32_t wargc_off = alloc_local("__jp_wargc");
     int32_t wargv_off = alloc_local("__jp_wargv");
-    std::string wenv_tmp = "__jp_wenv_" + std::to_string(text_->pos());
+    std::string wenv_tmp = "__jp_wenv_" + pos_tag();
     int32_t wenv_off = alloc_local(wenv_tmp);
-    std::string si_tmp = "__jp_si_" + std::to_string(text_->pos());
+    std::string si_tmp = "__jp_si_" + pos_tag();
     int32_t si_off = alloc_local(si_tmp);
     emit_mov_rbp_imm32(si_off, 0);
 
@@ -304,7 +308,7 @@ void emit_main_function(const Program& program) {
     emit_mov_rbp_reg(argv_off, reg::RAX);
 
     // Loop de conversão: para cada i, converter wargv[i] de UTF-16 → UTF-8
-    std::string li = "__jp_argi_" + std::to_string(text_->pos());
+    std::string li = "__jp_argi_" + pos_tag();
     int32_t i_off = alloc_local(li);
     emit_mov_rbp_imm32(i_off, 0);
 
@@ -323,7 +327,7 @@ void emit_main_function(const Program& program) {
     text_->emit_u8(0x8B);
     text_->emit_u8(0x04);
     text_->emit_u8(0xC8);
-    std::string ws = "__jp_wstr_" + std::to_string(text_->pos());
+    std::string ws = "__jp_wstr_" + pos_tag();
     int32_t wstr_off = alloc_local(ws);
     emit_mov_rbp_reg(wstr_off, reg::RAX);
 
@@ -344,12 +348,12 @@ void emit_main_function(const Program& program) {
     emit_call_symbol(emitter_.symbol_index("WideCharToMultiByte"));
 
     // RAX = tamanho, salvar e malloc
-    std::string sz = "__jp_sz_" + std::to_string(text_->pos());
+    std::string sz = "__jp_sz_" + pos_tag();
     int32_t sz_off = alloc_local(sz);
     emit_mov_rbp_reg(sz_off, reg::RAX);
     emit_mov_reg_reg(reg::RCX, reg::RAX);
     emit_call_symbol(emitter_.symbol_index("malloc"));
-    std::string bf = "__jp_buf_" + std::to_string(text_->pos());
+    std::string bf = "__jp_buf_" + pos_tag();
     int32_t buf_off = alloc_local(bf);
     emit_mov_rbp_reg(buf_off, reg::RAX);
 
@@ -421,6 +425,17 @@ void emit_main_function(const Program& program) {
     // Registrar handler de diagnostico (captura crashes em FFI)
     emit_diag_register_handler();
 
+    // Perfilador (-perfil): arma o SIGPROF antes do primeiro statement
+    emit_perfil_iniciar();
+
+    // Contadores (-contadores): tabela registrada, depois o gancho do main
+    emit_contadores_iniciar();
+    emit_contador_entrar("main");
+
+    // PGO (-pgo-gerar): tabela registrada, depois o ponto de entrada do main
+    emit_pgo_iniciar();
+    pgo_entrar_funcao("main", 1);
+
     // Emitir statements (pular declarações de função/classe/nativo)
     for (auto& stmt : program.statements) {
         bool is_func_or_class = std::visit([](const auto& node) -> bool {
@@ -441,7 +456,12 @@ void emit_main_function(const Program& program) {
     emit_call_symbol(emitter_.symbol_index("exit"));
 #endif
     emit_xor_reg_reg(reg::RAX, reg::RAX);
+    emit_contador_sair();
     emit_epilogue();
+    fim_contador();
+    pgo_anexar_frio();
+
+    registrar_funcao(main_sym, "main", main_offset, 1);
 }
 
 // ======================================================================
@@ -449,9 +469,12 @@ void emit_main_function(const Program& program) {
 // ======================================================================
 
 void emit_function(const FuncaoStmt& func) {
+    Cronometro cronometro;
     uint32_t func_offset = static_cast<uint32_t>(text_->pos());
+    func_text_start_ = func_offset;
     uint32_t func_sym = emitter_.add_global_symbol(func.name, text_idx_,
                                                     func_offset, true);
+    entrar_funcao_depuracao(func.name, static_cast<uint32_t>(func.line));
 
     FuncInfo info;
     info.name = func.name;
@@ -479,7 +502,8 @@ void emit_function(const FuncaoStmt& func) {
 
     int32_t estimated_locals = count_locals(func.body) +
                                static_cast<int32_t>(func.params.size()) + 16;
-    int32_t local_bytes = estimated_locals * 8 + PlatformDefs::MIN_STACK;
+    int32_t local_bytes = estimated_locals * 8 + PlatformDefs::MIN_STACK +
+                          reservar_blocos_pilha(func.body);
     emit_prologue(local_bytes);
 
     // Salvar parâmetros dos registradores em variáveis locais
@@ -510,13 +534,47 @@ void emit_function(const FuncaoStmt& func) {
         }
     }
 
+    emit_contador_entrar(func.name);
+    pgo_entrar_funcao(func.name, static_cast<uint32_t>(func.line));
+
+    cauda_ativa_ = true;
+    funcao_atual_ = &func;
+    corpo_inicio_ = text_->pos();
     for (auto& stmt : func.body) {
         emit_stmt(*stmt);
     }
+    cauda_ativa_ = false;
+    funcao_atual_ = nullptr;
 
     // Retorno padrão: 0
     emit_xor_reg_reg(reg::RAX, reg::RAX);
+    emit_contador_sair();
     emit_epilogue();
+    fim_contador();
+    pgo_anexar_frio();
+
+    registrar_funcao(func_sym, func.name, func_offset, static_cast<uint32_t>(func.line));
+    record_func_time(func.name, cronometro, func_offset);
+    registrar_tamanho_funcao(func.name, func_offset);
+}
+
+// ======================================================================
+// --tempos: estatística da função recém-emitida
+// ======================================================================
+
+uint64_t count_temps() const {
+    uint64_t n = 0;
+    for (auto& [name, off] : locals_) {
+        if (name.str().compare(0, 2, "__") == 0) n++;
+    }
+    return n;
+}
+
+void record_func_time(const std::string& name, const Cronometro& cronometro,
+                      uint32_t func_offset) {
+    if (!Tempos::global().ativo()) return;
+    tempos_funcoes_.push_back({name, cronometro.ms(), text_->pos() - func_offset,
+                               locals_.size(), count_temps()});
 }
 
 // ======================================================================
@@ -555,6 +613,7 @@ int32_t count_locals(const StmtList& stmts) {
                 count += count_locals(node.body);
             }
             else if constexpr (std::is_same_v<T, IfStmt>) {
+                if (despacho_candidato(node)) count += 2;
                 for (auto& br : node.branches)
                     count += count_locals(br.body);
             }
@@ -622,9 +681,68 @@ int32_t count_expr_temps(const Expr& expr) {
 
 void emit_retorna(const RetornaStmt& node) {
     if (node.value) {
+        if (auto* call = std::get_if<ChamadaExpr>(&node.value->node)) {
+            if (emit_chamada_cauda(*call)) return;
+        }
         emit_expr(*node.value);
     } else {
         emit_xor_reg_reg(reg::RAX, reg::RAX);
     }
+    emit_contador_sair();
     emit_epilogue();
-}
\ No newline at end of file
+}
+
+// ======================================================================
+// CHAMADA EM CAUDA: retorna f(args)
+//
+//   f = a própria função   args vão para os parâmetros e jmp para o início
+//                          do corpo: a recursão vira laço, a pilha não cresce
+//   f = outra função       args nos registradores, epílogo e jmp f: f
+//                          devolve direto para quem nos chamou
+//
+// Continua chamada normal: com -contadores (entrada/saída por chamada),
+// no main, com blocos na pilha (codegen_escape.hpp: um arg pode apontar
+// para o frame), com args na pilha na chamada a outra função (o frame de
+// quem nos chamou não tem espaço para eles) e, na recursão, dentro de
+// bloco frio do -pgo-usar (o início do corpo fica em .text)
+// ======================================================================
+
+bool emit_chamada_cauda(const ChamadaExpr& node) {
+    if (!cauda_ativa_ || contadores_ || !blocos_pilha_.empty()) return false;
+    if (is_native_func(node.name) || func_param_types_.count(node.name)) return false;
+    if (!declared_funcs_.count(node.name)) return false;
+
+    constexpr size_t MAX_REG_ARGS = PlatformDefs::is_windows ? 4 : 6;
+    bool propria = funcao_atual_ && node.name == funcao_atual_->name &&
+                   node.args.size() == funcao_atual_->params.size() &&
+                   text_ != &pgo_frio_;
+    if (!propria && node.args.size() > MAX_REG_ARGS) return false;
+
+    emit_pgo_contar(pgo_ponto("chamada", static_cast<uint32_t>(node.line)), 0);
+
+    // Todos os args avaliados antes de sobrescrever qualquer parâmetro
+    std::vector<int32_t> arg_offsets;
+    std::vector<RuntimeType> arg_types;
+    avaliar_args_chamada(node, nullptr, arg_offsets, arg_types);
+
+    if (propria) {
+        for (size_t i = 0; i < arg_offsets.size(); i++) {
+            emit_mov_reg_rbp(reg::RAX, arg_offsets[i]);
+            emit_mov_rbp_reg(find_local(funcao_atual_->params[i]), reg::RAX);
+        }
+        text_->emit_u8(0xE9);
+        text_->emit_i32(static_cast<int32_t>(corpo_inicio_) -
+                        static_cast<int32_t>(text_->pos() + 4));
+        return true;
+    }
+
+    carregar_args_chamada(arg_offsets, arg_types, false);
+    if constexpr (PlatformDefs::VARIADIC_NEEDS_AL) {
+        emit_xor_reg_reg(reg::RAX, reg::RAX);
+    }
+    uint32_t sym_idx = simbolo_chamada(node.name);
+    emit_mov_reg_reg(reg::RSP, reg::RBP);
+    emit_pop(reg::RBP);
+    emit_jmp_symbol(sym_idx);
+    return true;
+}
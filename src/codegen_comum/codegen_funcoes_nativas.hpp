@@ -85,7 +85,7 @@ RuntimeType get_native_return_type(const std::string& name) const {
 // ======================================================================
 
 void validate_native_call(const std::string& name,
-                          const std::vector<std::unique_ptr<Expr>>& args) {
+                          const std::vector<ExprPtr>& args) {
     auto* info = get_native_func(name);
     if (!info) return;
 
@@ -189,7 +189,7 @@ void emit_native_entrada(const ChamadaExpr& node) {
     emit_mov_reg_imm32(PlatformDefs::ARG1, 1024);
     emit_call_symbol(emitter_.symbol_index("malloc"));
 
-    std::string buf_tmp = "__entrada_buf_" + std::to_string(text_->pos());
+    std::string buf_tmp = "__entrada_buf_" + pos_tag();
     int32_t buf_off = alloc_local(buf_tmp);
     emit_mov_rbp_reg(buf_off, reg::RAX);
 
@@ -381,19 +381,25 @@ void emit_native_texto(const ChamadaExpr& node) {
     RuntimeType type = infer_expr_type(*node.args[0]);
     emit_expr(*node.args[0]);
 
+    // Inteiro/decimal: __jp_texto_int/__jp_texto_float (codegen_jprt)
+    if (usar_jprt() && type != RuntimeType::String && type != RuntimeType::Bool) {
+        emit_jprt_texto(type);
+        return;
+    }
+
     switch (type) {
         case RuntimeType::String:
             break;
 
         case RuntimeType::Int: {
-            std::string tmp = "__texto_tmp_" + std::to_string(text_->pos());
+            std::string tmp = "__texto_tmp_" + pos_tag();
             int32_t tmp_off = alloc_local(tmp);
             emit_mov_rbp_reg(tmp_off, reg::RAX);
 
             emit_mov_reg_imm32(PlatformDefs::ARG1, 64);
             emit_call_symbol(emitter_.symbol_index("malloc"));
 
-            std::string buf_tmp = "__texto_buf_" + std::to_string(text_->pos());
+            std::string buf_tmp = "__texto_buf_" + pos_tag();
             int32_t buf_off = alloc_local(buf_tmp);
             emit_mov_rbp_reg(buf_off, reg::RAX);
 
@@ -415,14 +421,14 @@ void emit_native_texto(const ChamadaExpr& node) {
         }
 
         case RuntimeType::Float: {
-            std::string tmp = "__texto_ftmp_" + std::to_string(text_->pos());
+            std::string tmp = "__texto_ftmp_" + pos_tag();
             int32_t tmp_off = alloc_local(tmp);
             emit_movsd_rbp_xmm(tmp_off, xmm::XMM0);
 
             emit_mov_reg_imm32(PlatformDefs::ARG1, 64);
             emit_call_symbol(emitter_.symbol_index("malloc"));
 
-            std::string buf_tmp = "__texto_fbuf_" + std::to_string(text_->pos());
+            std::string buf_tmp = "__texto_fbuf_" + pos_tag();
             int32_t buf_off = alloc_local(buf_tmp);
             emit_mov_rbp_reg(buf_off, reg::RAX);
 
@@ -458,14 +464,14 @@ void emit_native_texto(const ChamadaExpr& node) {
 
         case RuntimeType::Unknown:
         default: {
-            std::string tmp = "__texto_utmp_" + std::to_string(text_->pos());
+            std::string tmp = "__texto_utmp_" + pos_tag();
             int32_t tmp_off = alloc_local(tmp);
             emit_mov_rbp_reg(tmp_off, reg::RAX);
 
             emit_mov_reg_imm32(PlatformDefs::ARG1, 64);
             emit_call_symbol(emitter_.symbol_index("malloc"));
 
-            std::string buf_tmp = "__texto_ubuf_" + std::to_string(text_->pos());
+            std::string buf_tmp = "__texto_ubuf_" + pos_tag();
             int32_t buf_off = alloc_local(buf_tmp);
             emit_mov_rbp_reg(buf_off, reg::RAX);
 
@@ -547,7 +553,7 @@ void emit_native_args(const ChamadaExpr& node) {
 
     emit_expr(*node.args[0]);
 
-    std::string idx_tmp = "__args_idx_" + std::to_string(text_->pos());
+    std::string idx_tmp = "__args_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx_tmp);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
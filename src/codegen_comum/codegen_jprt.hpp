@@ -0,0 +1,132 @@
+// codegen_jprt.hpp
+// Chamadas para o runtime de suporte runtime/jprt.o (Linux) no lugar do
+// código expandido em cada uso
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Com runtime/jprt.o encontrado (ao lado do jp ou no diretório atual), o
+// objeto entra na linkagem e:
+//
+//   .adicionar(v)        caminho quente inline (tamanho < capacidade: grava
+//                        e incrementa); sem capacidade, bloco frio que chama
+//                        __jp_lista_crescer
+//   .remover(i)          __jp_lista_remover(lista, i)
+//   .exibir(), saida(l)  __jp_lista_exibir(lista, tipo do elemento)
+//   texto(v), a + b      __jp_texto_int / __jp_texto_float / __jp_concat
+//
+// Sem o objeto (ou no Windows, com listas de 16 bytes por elemento) tudo
+// continua inline como antes. Os módulos compilados à parte herdam a
+// escolha (seed_type_state) e a assinatura do cache inclui ela.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool jprt_ = false;
+
+bool usar_jprt() const { return !PlatformDefs::is_windows && jprt_; }
+
+// Início de compile(): runtime/jprt.o na linkagem, se existir
+void localizar_jprt() {
+    jprt_ = false;
+    if constexpr (!PlatformDefs::is_windows) {
+        std::string caminho = localizar_objeto_runtime("jprt");
+        if (caminho.empty()) return;
+        extra_obj_paths_.push_back(caminho);
+        jprt_ = true;
+    }
+}
+
+// ======================================================================
+// LISTAS
+// ======================================================================
+
+void emit_jprt_adicionar(Sym var_name, const Expr& value_expr) {
+    RuntimeType etype = get_list_elem_type(var_name);
+    emit_expr(value_expr);
+    if (etype == RuntimeType::Float) {
+        emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
+    }
+    std::string val_tmp = "__ladd_val_" + pos_tag();
+    int32_t val_off = alloc_local(val_tmp);
+    emit_mov_rbp_reg(val_off, reg::RAX);
+
+    // RAX = header, RCX = tamanho
+    int32_t list_off = find_local(var_name);
+    auto carregar = [&] {
+        emit_mov_reg_rbp(reg::RAX, list_off);
+        emit_rex_w(reg::RCX, reg::RAX);
+        text_->emit_u8(0x8B);
+        text_->emit_u8(0x48);
+        text_->emit_i8(LIST_OFF_COUNT);
+    };
+    carregar();
+
+    // cmp rcx, [rax+16]: sem capacidade → __jp_lista_crescer(header)
+    emit_rex_w(reg::RCX, reg::RAX);
+    text_->emit_u8(0x3B);
+    text_->emit_u8(0x48);
+    text_->emit_i8(LIST_OFF_CAP);
+    emit_desvio_frio(CC_GE, [&] {
+        emit_mov_reg_reg(reg::RDI, reg::RAX);
+        emit_call_extern("__jp_lista_crescer");
+        carregar();
+    });
+
+    // dados[tamanho] = valor; tamanho++
+    emit_rex_w(reg::RDX, reg::RAX);
+    text_->emit_u8(0x8B);
+    text_->emit_u8(0x10);                 // MOV RDX, [RAX]
+    emit_mov_reg_rbp(reg::RSI, val_off);
+    emit_rex_w(reg::RSI, reg::RDX);
+    text_->emit_u8(0x89);
+    text_->emit_u8(0x34);
+    text_->emit_u8(0xCA);                 // MOV [RDX + RCX*8], RSI
+    emit_rex_w(0, reg::RCX);
+    text_->emit_u8(0xFF);
+    text_->emit_u8(0xC1);                 // INC RCX
+    emit_rex_w(reg::RCX, reg::RAX);
+    text_->emit_u8(0x89);
+    text_->emit_u8(0x48);
+    text_->emit_i8(LIST_OFF_COUNT);       // MOV [RAX+8], RCX
+}
+
+void emit_jprt_remover(Sym var_name, const Expr& index_expr) {
+    emit_expr(index_expr);
+    emit_mov_reg_reg(reg::RSI, reg::RAX);
+    emit_mov_reg_rbp(reg::RDI, find_local(var_name));
+    emit_call_extern("__jp_lista_remover");
+}
+
+void emit_jprt_exibir(Sym var_name) {
+    int32_t tipo = 0;                     // inteiros e booleanos: "%d"
+    switch (get_list_elem_type(var_name)) {
+        case RuntimeType::Float:  tipo = 1; break;
+        case RuntimeType::String: tipo = 2; break;
+        default: break;
+    }
+    emit_mov_reg_rbp(reg::RDI, find_local(var_name));
+    emit_mov_reg_imm32(reg::RSI, tipo);
+    emit_call_extern("__jp_lista_exibir");
+}
+
+// ======================================================================
+// TEXTO
+// ======================================================================
+
+// Valor em RAX (inteiro) ou XMM0 (decimal) → texto novo em RAX
+void emit_jprt_texto(RuntimeType tipo) {
+    if (tipo == RuntimeType::Float) {
+        emit_call_extern("__jp_texto_float");
+    } else {
+        emit_mov_reg_reg(reg::RDI, reg::RAX);
+        emit_call_extern("__jp_texto_int");
+    }
+}
+
+// Textos nos temporários a_off e b_off → a + b novo em RAX
+void emit_jprt_concat(int32_t a_off, int32_t b_off) {
+    emit_mov_reg_rbp(reg::RDI, a_off);
+    emit_mov_reg_rbp(reg::RSI, b_off);
+    emit_call_extern("__jp_concat");
+}
@@ -36,21 +36,26 @@ static constexpr int32_t LIST_OFF_CAP = 16;
 static constexpr int32_t LIST_STRUCT_SIZE = 24;
 static constexpr int32_t LIST_INITIAL_CAP = 8;
 
+// Capacidade inicial de um literal: dobro dos elementos (ou LIST_INITIAL_CAP)
+static int32_t list_literal_cap(size_t count) {
+    return (count > 0) ? static_cast<int32_t>(count * 2) : LIST_INITIAL_CAP;
+}
+
 // ======================================================================
 // HELPERS: detecta se variável é lista, tipo dos elementos
 // ======================================================================
 
-bool is_list_var(const std::string& name) const {
+bool is_list_var(Sym name) const {
     return var_is_list_.count(name) > 0;
 }
 
-RuntimeType get_list_elem_type(const std::string& name) const {
+RuntimeType get_list_elem_type(Sym name) const {
     auto it = var_list_elem_type_.find(name);
     if (it != var_list_elem_type_.end()) return it->second;
     return RuntimeType::Unknown;
 }
 
-std::string get_list_instance_class(const std::string& name) const {
+std::string get_list_instance_class(Sym name) const {
     auto it = var_list_instance_class_.find(name);
     if (it != var_list_instance_class_.end()) return it->second;
     return "";
@@ -104,7 +109,7 @@ void emit_list_literal_windows(const ListLitExpr& node) {
     emit_mov_reg_imm32(PlatformDefs::ARG1, 24);
     emit_call_symbol(emitter_.symbol_index("malloc"));
 
-    std::string hdr = "__list_hdr_" + std::to_string(text_->pos());
+    std::string hdr = "__list_hdr_" + pos_tag();
     int32_t hdr_off = alloc_local(hdr);
     emit_mov_rbp_reg(hdr_off, reg::RAX);
 
@@ -125,7 +130,7 @@ void emit_list_literal_windows(const ListLitExpr& node) {
     emit_mov_reg_imm32(PlatformDefs::ARG1, static_cast<int32_t>(capacity * 16));
     emit_call_symbol(emitter_.symbol_index("malloc"));
 
-    std::string dat = "__list_dat_" + std::to_string(text_->pos());
+    std::string dat = "__list_dat_" + pos_tag();
     int32_t dat_off = alloc_local(dat);
     emit_mov_rbp_reg(dat_off, reg::RAX);
 
@@ -141,7 +146,7 @@ void emit_list_literal_windows(const ListLitExpr& node) {
         RuntimeType etype = infer_expr_type(*node.elements[i]);
         emit_expr(*node.elements[i]);
 
-        std::string val_tmp = "__list_val_" + std::to_string(text_->pos());
+        std::string val_tmp = "__list_val_" + pos_tag();
         int32_t val_off = alloc_local(val_tmp);
         if (etype == RuntimeType::Float) {
             emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
@@ -182,26 +187,38 @@ void emit_list_literal_windows(const ListLitExpr& node) {
 // --- Linux: valores diretos (8 bytes/elem) ---
 void emit_list_literal_linux(const ListLitExpr& node) {
     size_t count = node.elements.size();
-    int32_t cap = (count > 0) ? static_cast<int32_t>(count * 2) : LIST_INITIAL_CAP;
+    int32_t cap = list_literal_cap(count);
 
     RuntimeType elem_type = RuntimeType::Unknown;
     if (!node.elements.empty()) {
         elem_type = infer_expr_type(*node.elements[0]);
     }
 
+    // Não escapa (codegen_escape.hpp): struct e dados no frame, com os
+    // dados logo após a struct
+    auto* bloco = bloco_pilha(&node);
+
     // malloc(24) para a struct da lista
-    emit_mov_reg_imm32(reg::RDI, LIST_STRUCT_SIZE);
-    emit_call_extern("malloc");
+    if (bloco) {
+        emit_lea_reg_rbp(reg::RAX, bloco->first);
+    } else {
+        emit_mov_reg_imm32(reg::RDI, LIST_STRUCT_SIZE);
+        emit_call_extern("malloc");
+    }
 
-    std::string struct_tmp = "__list_struct_" + std::to_string(text_->pos());
+    std::string struct_tmp = "__list_struct_" + pos_tag();
     int32_t struct_off = alloc_local(struct_tmp);
     emit_mov_rbp_reg(struct_off, reg::RAX);
 
     // malloc(cap * 8) para o array de dados
-    emit_mov_reg_imm32(reg::RDI, cap * 8);
-    emit_call_extern("malloc");
+    if (bloco) {
+        emit_lea_reg_rbp(reg::RAX, bloco->first + LIST_STRUCT_SIZE);
+    } else {
+        emit_mov_reg_imm32(reg::RDI, cap * 8);
+        emit_call_extern("malloc");
+    }
 
-    std::string data_tmp = "__list_data_" + std::to_string(text_->pos());
+    std::string data_tmp = "__list_data_" + pos_tag();
     int32_t data_off = alloc_local(data_tmp);
     emit_mov_rbp_reg(data_off, reg::RAX);
 
@@ -236,7 +253,7 @@ void emit_list_literal_linux(const ListLitExpr& node) {
             emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
         }
 
-        std::string val_tmp = "__lelem_" + std::to_string(i) + "_" + std::to_string(text_->pos());
+        std::string val_tmp = "__lelem_" + std::to_string(i) + "_" + pos_tag();
         int32_t val_off = alloc_local(val_tmp);
         emit_mov_rbp_reg(val_off, reg::RAX);
 
@@ -266,28 +283,29 @@ void emit_list_literal_linux(const ListLitExpr& node) {
 // Chamado pelo codegen_expr.hpp quando is_list_var() == true
 // ======================================================================
 
-void emit_list_index_get(const IndexGetExpr& node, const std::string& list_name) {
+void emit_list_index_get(const IndexGetExpr& node, Sym list_name) {
     if constexpr (PlatformDefs::is_windows) {
-        emit_list_index_get_windows(node);
+        emit_list_index_get_windows(node, list_name);
     } else {
         emit_list_index_get_linux(node, list_name);
     }
 }
 
 // Windows: tagged values (16 bytes/elem), tipo em [elem+0], valor em [elem+8]
-void emit_list_index_get_windows(const IndexGetExpr& node) {
+void emit_list_index_get_windows(const IndexGetExpr& node, Sym list_name) {
     emit_expr(*node.object);
-    std::string lst = "__idx_lst_" + std::to_string(text_->pos());
+    std::string lst = "__idx_lst_" + pos_tag();
     int32_t lst_off = alloc_local(lst);
     emit_mov_rbp_reg(lst_off, reg::RAX);
 
     emit_expr(*node.index);
-    std::string idx = "__idx_i_" + std::to_string(text_->pos());
+    std::string idx = "__idx_i_" + pos_tag();
     int32_t idx_off = alloc_local(idx);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
     // dados = header->dados ([header+16])
     emit_mov_reg_rbp(reg::RCX, lst_off);
+    emit_checar_indice(list_name, *node.index, node.line);
     emit_rex_w(reg::RCX, reg::RCX);
     text_->emit_u8(0x8B); // mov rcx, [rcx+16]
     text_->emit_u8(0x49);
@@ -321,28 +339,26 @@ void emit_list_index_get_windows(const IndexGetExpr& node) {
 }
 
 // Linux: valores diretos (8 bytes/elem)
-void emit_list_index_get_linux(const IndexGetExpr& node, const std::string& list_name) {
+void emit_list_index_get_linux(const IndexGetExpr& node, Sym list_name) {
     emit_expr(*node.object);
-    std::string base_tmp = "__lidxget_base_" + std::to_string(text_->pos());
+    std::string base_tmp = "__lidxget_base_" + pos_tag();
     int32_t base_off = alloc_local(base_tmp);
     emit_mov_rbp_reg(base_off, reg::RAX);
 
     emit_expr(*node.index);
-    std::string idx_tmp = "__lidxget_idx_" + std::to_string(text_->pos());
+    std::string idx_tmp = "__lidxget_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx_tmp);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
-    // Carregar struct ptr → RCX
+    // Carregar struct ptr → RCX, índice → RAX
     emit_mov_reg_rbp(reg::RCX, base_off);
+    emit_checar_indice(list_name, *node.index, node.line);
 
     // Carregar data ptr: RCX = [RCX + 0] (struct->data)
     emit_rex_w(reg::RCX, reg::RCX);
     text_->emit_u8(0x8B);
     text_->emit_u8(0x09); // MOV RCX, [RCX]
 
-    // Carregar índice → RAX
-    emit_mov_reg_rbp(reg::RAX, idx_off);
-
     // MOV RAX, [RCX + RAX*8]
     emit_rex_w(reg::RAX, reg::RCX);
     text_->emit_u8(0x8B);
@@ -373,20 +389,24 @@ void emit_list_index_set_windows(const IndexSetStmt& node) {
     int32_t lst_off = find_local(node.name);
 
     emit_expr(*node.index);
-    std::string idx = "__iset_idx_" + std::to_string(text_->pos());
+    std::string idx = "__iset_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
     RuntimeType vtype = infer_expr_type(*node.value);
     emit_expr(*node.value);
 
-    std::string val = "__iset_val_" + std::to_string(text_->pos());
+    std::string val = "__iset_val_" + pos_tag();
     int32_t val_off = alloc_local(val);
     if (vtype == RuntimeType::Float) {
         emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
     }
     emit_mov_rbp_reg(val_off, reg::RAX);
 
+    emit_mov_reg_rbp(reg::RCX, lst_off);
+    emit_mov_reg_rbp(reg::RAX, idx_off);
+    emit_checar_indice(node.name, *node.index, node.line);
+
     // dados = header->dados
     emit_mov_reg_rbp(reg::RAX, lst_off);
     emit_rex_w(reg::RAX, reg::RAX);
@@ -431,25 +451,24 @@ void emit_list_index_set_linux(const IndexSetStmt& node) {
     if (etype == RuntimeType::Float) {
         emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
     }
-    std::string val_tmp = "__lidxset_val_" + std::to_string(text_->pos());
+    std::string val_tmp = "__lidxset_val_" + pos_tag();
     int32_t val_off = alloc_local(val_tmp);
     emit_mov_rbp_reg(val_off, reg::RAX);
 
     emit_expr(*node.index);
-    std::string idx_tmp = "__lidxset_idx_" + std::to_string(text_->pos());
+    std::string idx_tmp = "__lidxset_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx_tmp);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
     int32_t list_off = find_local(node.name);
     emit_mov_reg_rbp(reg::RCX, list_off);
+    emit_checar_indice(node.name, *node.index, node.line);
 
     // RCX = struct->data
     emit_rex_w(reg::RCX, reg::RCX);
     text_->emit_u8(0x8B);
     text_->emit_u8(0x09); // MOV RCX, [RCX]
 
-    emit_mov_reg_rbp(reg::RAX, idx_off);
-
     // LEA RCX, [RCX + RAX*8]
     emit_rex_w(reg::RCX, reg::RCX);
     text_->emit_u8(0x8D);
@@ -510,8 +529,8 @@ bool emit_list_method(const MetodoChamadaExpr& node) {
 }
 
 // Assinatura Linux: recebe nome, método e args separados
-bool emit_list_method(const std::string& var_name, const std::string& method,
-                      const std::vector<std::unique_ptr<Expr>>& args) {
+bool emit_list_method(Sym var_name, const std::string& method,
+                      const std::vector<ExprPtr>& args) {
     if (method == "exibir") {
         emit_list_exibir(var_name);
         return true;
@@ -578,7 +597,7 @@ void emit_list_adicionar_windows(const std::string& name, const MetodoChamadaExp
     RuntimeType vtype = infer_expr_type(*node.args[0]);
     emit_expr(*node.args[0]);
 
-    std::string val = "__ladd_val_" + std::to_string(text_->pos());
+    std::string val = "__ladd_val_" + pos_tag();
     int32_t val_off = alloc_local(val);
     if (vtype == RuntimeType::Float) {
         emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
@@ -587,7 +606,7 @@ void emit_list_adicionar_windows(const std::string& name, const MetodoChamadaExp
 
     // header
     emit_mov_reg_rbp(reg::RAX, lst_off);
-    std::string hdr = "__ladd_hdr_" + std::to_string(text_->pos());
+    std::string hdr = "__ladd_hdr_" + pos_tag();
     int32_t hdr_off = alloc_local(hdr);
     emit_mov_rbp_reg(hdr_off, reg::RAX);
 
@@ -596,7 +615,7 @@ void emit_list_adicionar_windows(const std::string& name, const MetodoChamadaExp
     text_->emit_u8(0x8B);
     text_->emit_u8(0x48);
     text_->emit_u8(0x08);
-    std::string sz = "__ladd_sz_" + std::to_string(text_->pos());
+    std::string sz = "__ladd_sz_" + pos_tag();
     int32_t sz_off = alloc_local(sz);
     emit_mov_rbp_reg(sz_off, reg::RCX);
 
@@ -615,7 +634,7 @@ void emit_list_adicionar_windows(const std::string& name, const MetodoChamadaExp
     text_->emit_u8(0xD1);
     text_->emit_u8(0xE2);
 
-    std::string nc = "__ladd_nc_" + std::to_string(text_->pos());
+    std::string nc = "__ladd_nc_" + pos_tag();
     int32_t nc_off = alloc_local(nc);
     emit_mov_rbp_reg(nc_off, reg::RDX);
 
@@ -701,20 +720,24 @@ void emit_list_adicionar_windows(const std::string& name, const MetodoChamadaExp
 // .adicionar(valor) — Linux (8 bytes/elem)
 // ======================================================================
 
-void emit_list_adicionar_linux(const std::string& var_name, const Expr& value_expr) {
+void emit_list_adicionar_linux(Sym var_name, const Expr& value_expr) {
+    if (usar_jprt()) {
+        emit_jprt_adicionar(var_name, value_expr);
+        return;
+    }
     RuntimeType etype = get_list_elem_type(var_name);
 
     emit_expr(value_expr);
     if (etype == RuntimeType::Float) {
         emit_movq_gpr_xmm(reg::RAX, xmm::XMM0);
     }
-    std::string val_tmp = "__ladd_val_" + std::to_string(text_->pos());
+    std::string val_tmp = "__ladd_val_" + pos_tag();
     int32_t val_off = alloc_local(val_tmp);
     emit_mov_rbp_reg(val_off, reg::RAX);
 
     int32_t list_off = find_local(var_name);
     emit_mov_reg_rbp(reg::RAX, list_off);
-    std::string sp_tmp = "__ladd_sp_" + std::to_string(text_->pos());
+    std::string sp_tmp = "__ladd_sp_" + pos_tag();
     int32_t sp_off = alloc_local(sp_tmp);
     emit_mov_rbp_reg(sp_off, reg::RAX);
 
@@ -751,7 +774,36 @@ void emit_list_adicionar_linux(const std::string& var_name, const Expr& value_ex
     text_->emit_u8(0xE6);
     text_->emit_u8(0x04);
 
+    // Dados logo após a struct = lista no frame (codegen_escape.hpp):
+    // malloc + memcpy em vez de realloc
+    emit_rex_w(reg::RDX, reg::RAX);
+    text_->emit_u8(0x8D);
+    text_->emit_u8(0x50);
+    text_->emit_i8(LIST_STRUCT_SIZE); // LEA RDX, [RAX+24]
+    emit_cmp_reg_reg(reg::RDI, reg::RDX);
+    size_t no_heap = emit_jne_rel32();
+
+    emit_mov_reg_reg(reg::RDI, reg::RSI);
+    emit_call_extern("malloc");
+    emit_mov_reg_rbp(reg::RCX, sp_off);
+    emit_mov_reg_reg(reg::RDI, reg::RAX);
+    emit_rex_w(reg::RSI, reg::RCX);
+    text_->emit_u8(0x8B);
+    text_->emit_u8(0x31); // MOV RSI, [RCX]
+    emit_rex_w(reg::RDX, reg::RCX);
+    text_->emit_u8(0x8B);
+    text_->emit_u8(0x51);
+    text_->emit_i8(LIST_OFF_COUNT); // MOV RDX, [RCX+8]
+    emit_rex_w(0, reg::RDX);
+    text_->emit_u8(0xC1);
+    text_->emit_u8(0xE2);
+    text_->emit_u8(0x03); // SHL RDX, 3
+    emit_call_extern("memcpy");
+    size_t copied = emit_jmp_rel32();
+
+    patch_jump(no_heap);
     emit_call_extern("realloc");
+    patch_jump(copied);
 
     // Atualizar struct: data = RAX
     emit_mov_reg_rbp(reg::RCX, sp_off);
@@ -824,13 +876,13 @@ void emit_list_remover_windows(const std::string& name, const MetodoChamadaExpr&
     int32_t lst_off = find_local(name);
 
     emit_expr(*node.args[0]);
-    std::string idx = "__lrem_idx_" + std::to_string(text_->pos());
+    std::string idx = "__lrem_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
     // header
     emit_mov_reg_rbp(reg::RAX, lst_off);
-    std::string hdr = "__lrem_hdr_" + std::to_string(text_->pos());
+    std::string hdr = "__lrem_hdr_" + pos_tag();
     int32_t hdr_off = alloc_local(hdr);
     emit_mov_rbp_reg(hdr_off, reg::RAX);
 
@@ -839,7 +891,7 @@ void emit_list_remover_windows(const std::string& name, const MetodoChamadaExpr&
     text_->emit_u8(0x8B);
     text_->emit_u8(0x48);
     text_->emit_u8(0x08);
-    std::string sz = "__lrem_sz_" + std::to_string(text_->pos());
+    std::string sz = "__lrem_sz_" + pos_tag();
     int32_t sz_off = alloc_local(sz);
     emit_mov_rbp_reg(sz_off, reg::RCX);
 
@@ -849,7 +901,7 @@ void emit_list_remover_windows(const std::string& name, const MetodoChamadaExpr&
     text_->emit_u8(0x8B);
     text_->emit_u8(0x40);
     text_->emit_u8(0x10);
-    std::string dat = "__lrem_dat_" + std::to_string(text_->pos());
+    std::string dat = "__lrem_dat_" + pos_tag();
     int32_t dat_off = alloc_local(dat);
     emit_mov_rbp_reg(dat_off, reg::RAX);
 
@@ -903,15 +955,19 @@ void emit_list_remover_windows(const std::string& name, const MetodoChamadaExpr&
 // .remover(indice) — Linux (8 bytes/elem, memmove com stride 8)
 // ======================================================================
 
-void emit_list_remover_linux(const std::string& var_name, const Expr& index_expr) {
+void emit_list_remover_linux(Sym var_name, const Expr& index_expr) {
+    if (usar_jprt()) {
+        emit_jprt_remover(var_name, index_expr);
+        return;
+    }
     emit_expr(index_expr);
-    std::string idx_tmp = "__lrem_idx_" + std::to_string(text_->pos());
+    std::string idx_tmp = "__lrem_idx_" + pos_tag();
     int32_t idx_off = alloc_local(idx_tmp);
     emit_mov_rbp_reg(idx_off, reg::RAX);
 
     int32_t list_off = find_local(var_name);
     emit_mov_reg_rbp(reg::RAX, list_off);
-    std::string sp_tmp = "__lrem_sp_" + std::to_string(text_->pos());
+    std::string sp_tmp = "__lrem_sp_" + pos_tag();
     int32_t sp_off = alloc_local(sp_tmp);
     emit_mov_rbp_reg(sp_off, reg::RAX);
 
@@ -927,7 +983,7 @@ void emit_list_remover_linux(const std::string& var_name, const Expr& index_expr
     text_->emit_u8(0x10);
 
     // Salvar data
-    std::string data_tmp = "__lrem_data_" + std::to_string(text_->pos());
+    std::string data_tmp = "__lrem_data_" + pos_tag();
     int32_t data_off = alloc_local(data_tmp);
     emit_mov_rbp_reg(data_off, reg::RDX);
 
@@ -941,7 +997,7 @@ void emit_list_remover_linux(const std::string& var_name, const Expr& index_expr
     text_->emit_u8(0xE0);
     text_->emit_u8(0x03); // SHL RAX, 3
 
-    std::string ib_tmp = "__lrem_ib_" + std::to_string(text_->pos());
+    std::string ib_tmp = "__lrem_ib_" + pos_tag();
     int32_t ib_off = alloc_local(ib_tmp);
     emit_mov_rbp_reg(ib_off, reg::RAX);
 
@@ -997,7 +1053,7 @@ void emit_list_remover_linux(const std::string& var_name, const Expr& index_expr
 // .exibir() — imprime todos os elementos: [elem1, elem2, ...]
 // ======================================================================
 
-void emit_list_exibir(const std::string& name) {
+void emit_list_exibir(Sym name) {
     if constexpr (PlatformDefs::is_windows) {
         emit_list_exibir_windows(name);
     } else {
@@ -1016,7 +1072,7 @@ void emit_list_exibir_windows(const std::string& name) {
 
     // header
     emit_mov_reg_rbp(reg::RAX, lst_off);
-    std::string hdr = "__lexb_hdr_" + std::to_string(text_->pos());
+    std::string hdr = "__lexb_hdr_" + pos_tag();
     int32_t hdr_off = alloc_local(hdr);
     emit_mov_rbp_reg(hdr_off, reg::RAX);
 
@@ -1025,7 +1081,7 @@ void emit_list_exibir_windows(const std::string& name) {
     text_->emit_u8(0x8B);
     text_->emit_u8(0x48);
     text_->emit_u8(0x08);
-    std::string sz = "__lexb_sz_" + std::to_string(text_->pos());
+    std::string sz = "__lexb_sz_" + pos_tag();
     int32_t sz_off = alloc_local(sz);
     emit_mov_rbp_reg(sz_off, reg::RCX);
 
@@ -1035,12 +1091,12 @@ void emit_list_exibir_windows(const std::string& name) {
     text_->emit_u8(0x8B);
     text_->emit_u8(0x40);
     text_->emit_u8(0x10);
-    std::string dat = "__lexb_dat_" + std::to_string(text_->pos());
+    std::string dat = "__lexb_dat_" + pos_tag();
     int32_t dat_off = alloc_local(dat);
     emit_mov_rbp_reg(dat_off, reg::RAX);
 
     // i = 0
-    std::string li = "__lexb_i_" + std::to_string(text_->pos());
+    std::string li = "__lexb_i_" + pos_tag();
     int32_t i_off = alloc_local(li);
     emit_mov_rbp_imm32(i_off, 0);
 
@@ -1070,7 +1126,7 @@ void emit_list_exibir_windows(const std::string& name) {
     emit_mov_reg_rbp(reg::RCX, dat_off);
     emit_add_reg_reg(reg::RAX, reg::RCX);
 
-    std::string ep = "__lexb_ep_" + std::to_string(text_->pos());
+    std::string ep = "__lexb_ep_" + pos_tag();
     int32_t ep_off = alloc_local(ep);
     emit_mov_rbp_reg(ep_off, reg::RAX);
 
@@ -1174,7 +1230,11 @@ void emit_list_exibir_windows(const std::string& name) {
 }
 
 // --- Linux: tipo estático, 8 bytes/elem ---
-void emit_list_exibir_linux(const std::string& var_name) {
+void emit_list_exibir_linux(Sym var_name) {
+    if (usar_jprt()) {
+        emit_jprt_exibir(var_name);
+        return;
+    }
     RuntimeType etype = get_list_elem_type(var_name);
 
     int32_t list_off = find_local(var_name);
@@ -1186,7 +1246,7 @@ void emit_list_exibir_linux(const std::string& var_name) {
 
     // Carregar struct
     emit_mov_reg_rbp(reg::RAX, list_off);
-    std::string sp_tmp = "__lexib_sp_" + std::to_string(text_->pos());
+    std::string sp_tmp = "__lexib_sp_" + pos_tag();
     int32_t sp_off = alloc_local(sp_tmp);
     emit_mov_rbp_reg(sp_off, reg::RAX);
 
@@ -1195,7 +1255,7 @@ void emit_list_exibir_linux(const std::string& var_name) {
     text_->emit_u8(0x8B);
     text_->emit_u8(0x48);
     text_->emit_i8(LIST_OFF_COUNT);
-    std::string cnt_tmp = "__lexib_cnt_" + std::to_string(text_->pos());
+    std::string cnt_tmp = "__lexib_cnt_" + pos_tag();
     int32_t cnt_off = alloc_local(cnt_tmp);
     emit_mov_rbp_reg(cnt_off, reg::RCX);
 
@@ -1203,12 +1263,12 @@ void emit_list_exibir_linux(const std::string& var_name) {
     emit_rex_w(reg::RDX, reg::RAX);
     text_->emit_u8(0x8B);
     text_->emit_u8(0x10);
-    std::string data_tmp = "__lexib_data_" + std::to_string(text_->pos());
+    std::string data_tmp = "__lexib_data_" + pos_tag();
     int32_t data_off = alloc_local(data_tmp);
     emit_mov_rbp_reg(data_off, reg::RDX);
 
     // Loop: i = 0
-    std::string i_tmp = "__lexib_i_" + std::to_string(text_->pos());
+    std::string i_tmp = "__lexib_i_" + pos_tag();
     int32_t i_off = alloc_local(i_tmp);
     emit_mov_reg_imm32(reg::RAX, 0);
     emit_mov_rbp_reg(i_off, reg::RAX);
@@ -1294,7 +1354,7 @@ bool emit_saida_list(const Expr& expr) {
     return true;
 }
 
-void emit_saida_list(const std::string& var_name, bool newline) {
+void emit_saida_list(Sym var_name, bool newline) {
     emit_list_exibir(var_name);
     (void)newline; // exibir já imprime \n
 }
\ No newline at end of file
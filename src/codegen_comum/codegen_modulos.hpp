@@ -0,0 +1,402 @@
+// codegen_modulos.hpp
+// Compilação separada de módulos importados (importar "arquivo.jp")
+//
+// Cada módulo puro (só funcao/classe/importar no topo) vira um objeto
+// próprio em output/.cache/modulos/, acompanhado de um resumo .jpsum com
+// o que o importador precisa saber sem reemitir o código: parâmetros e
+// tipos das funções/métodos exportados, tipos de retorno e o layout das
+// classes (atributos, offsets, tipos, tamanho da instância).
+//
+// Os tipos em JPLang são inferidos a partir dos call sites do programa
+// inteiro, então o objeto de um módulo é especializado: a chave do cache
+// inclui o hash do fonte do módulo e uma assinatura do estado de tipos do
+// codegen no momento em que o módulo seria emitido. Mesmo fonte + mesmos
+// tipos de entrada → mesmo objeto, reaproveitado entre builds.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+std::string module_cache_dir_;                            // vazio = desligado
+std::unordered_map<std::string, size_t> decl_module_;     // decl → índice em modulos
+std::vector<bool> module_done_;
+
+static constexpr const char* MODULE_SUMMARY_VERSION = "1";
+
+// ======================================================================
+// REGISTRO: quais declarações vêm de módulos compiláveis à parte
+// ======================================================================
+
+void index_modules(const Program& program) {
+    decl_module_.clear();
+    module_done_.assign(program.modulos.size(), false);
+    if (module_cache_dir_.empty()) return;
+
+    for (size_t i = 0; i < program.modulos.size(); i++) {
+        auto& mod = program.modulos[i];
+        if (!mod.puro) continue;
+        for (auto& f : mod.funcoes) decl_module_[f] = i;
+        for (auto& c : mod.classes) decl_module_[c] = i;
+    }
+}
+
+// Índice do módulo dono da declaração, ou -1 (emitir no objeto principal)
+int module_of(const std::string& decl_name) const {
+    auto it = decl_module_.find(decl_name);
+    if (it == decl_module_.end()) return -1;
+    return static_cast<int>(it->second);
+}
+
+// ======================================================================
+// ASSINATURA DO ESTADO DE TIPOS
+// Tudo que a emissão de uma função consulta além do próprio corpo.
+// Ordenado para ser determinístico.
+// ======================================================================
+
+static std::string type_code(RuntimeType t) {
+    return std::to_string(static_cast<int>(t));
+}
+
+static RuntimeType type_from_code(const std::string& s) {
+    if (s.empty() || s == "-") return RuntimeType::Unknown;
+    int v = std::atoi(s.c_str());
+    if (v < 0 || v > static_cast<int>(RuntimeType::Unknown)) return RuntimeType::Unknown;
+    return static_cast<RuntimeType>(v);
+}
+
+static std::string join_types(const std::vector<RuntimeType>& types) {
+    std::string out;
+    for (size_t i = 0; i < types.size(); i++) {
+        if (i) out += ",";
+        out += type_code(types[i]);
+    }
+    return out;
+}
+
+template <typename Name>
+static std::string join_names(const std::vector<Name>& names) {
+    std::string out;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (i) out += ",";
+        out += names[i];
+    }
+    return out;
+}
+
+static std::vector<std::string> split_list(const std::string& s) {
+    std::vector<std::string> out;
+    if (s.empty()) return out;
+    size_t start = 0;
+    while (true) {
+        size_t comma = s.find(',', start);
+        out.push_back(s.substr(start, comma - start));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return out;
+}
+
+template <typename Map, typename Fn>
+static void for_each_sorted(const Map& m, Fn fn) {
+    // Ordem pelo texto do nome (não pelo ID do Sym), estável entre builds
+    std::vector<typename Map::key_type> keys;
+    keys.reserve(m.size());
+    for (auto& kv : m) keys.push_back(kv.first);
+    std::sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) {
+        return static_cast<const std::string&>(a) < static_cast<const std::string&>(b);
+    });
+    for (auto& k : keys) fn(k, m.at(k));
+}
+
+std::string module_state_signature() const {
+    std::ostringstream sig;
+    sig << "debug=" << debug_mode_ << "\n";
+    sig << "fma=" << fma_ativo() << " avx2=" << vet_avx()
+        << " checagem=" << !sem_checagem_ << " jprt=" << usar_jprt()
+        << " g=" << gerar_depuracao_ << "\n";
+    sig << "arquivo=" << diag_source_file_ << "\n";
+    for_each_sorted(declared_funcs_, [&](const std::string& k, const FuncInfo& f) {
+        sig << "f:" << k << "|" << join_names(f.params) << "|"
+            << join_types(f.param_types) << "\n";
+    });
+    for_each_sorted(func_return_types_, [&](const std::string& k, RuntimeType t) {
+        sig << "r:" << k << "|" << type_code(t) << "\n";
+    });
+    for_each_sorted(func_param_types_, [&](const std::string& k,
+                                           const std::vector<RuntimeType>& v) {
+        sig << "p:" << k << "|" << join_types(v) << "\n";
+    });
+    for_each_sorted(declared_classes_, [&](const std::string& k, const ClassInfo& c) {
+        sig << "c:" << k << "|" << c.instance_size << "|" << join_names(c.method_names);
+        for (auto& a : c.attrs) {
+            sig << "|" << a.name << ":" << a.offset << ":" << type_code(a.type);
+        }
+        sig << "\n";
+    });
+    for_each_sorted(class_attr_param_map_, [&](const std::string& k,
+                                               const AttrParamMapping& m) {
+        sig << "m:" << k << "|" << m.param_index << "\n";
+    });
+    for_each_sorted(var_instance_class_, [&](const std::string& k, const std::string& v) {
+        sig << "vi:" << k << "|" << v << "\n";
+    });
+    for_each_sorted(var_list_instance_class_, [&](const std::string& k,
+                                                  const std::string& v) {
+        sig << "vli:" << k << "|" << v << "\n";
+    });
+    for_each_sorted(var_list_elem_type_, [&](const std::string& k, RuntimeType t) {
+        sig << "vle:" << k << "|" << type_code(t) << "\n";
+    });
+    std::vector<std::string> lists(var_is_list_.begin(), var_is_list_.end());
+    std::sort(lists.begin(), lists.end());
+    for (auto& l : lists) sig << "vl:" << l << "\n";
+    return sig.str();
+}
+
+// ======================================================================
+// RESUMO DO MÓDULO (.jpsum)
+//   versao=1
+//   funcao=nome|p1,p2|t1,t2|retorno      (inclui Classe__metodo)
+//   classe=Nome|tamanho|m1,m2
+//   atributo=Nome|attr|offset|tipo
+// ======================================================================
+
+void module_func_names(const ModuloFonte& mod, std::vector<std::string>& out) const {
+    for (auto& f : mod.funcoes) out.push_back(f);
+    for (auto& c : mod.classes) {
+        auto cit = declared_classes_.find(Sym::intern(c));
+        if (cit == declared_classes_.end()) continue;
+        for (auto& m : cit->second.method_names) out.push_back(c + "__" + m);
+    }
+}
+
+bool write_module_summary(const ModuloFonte& mod, const std::string& path) const {
+    std::ostringstream out;
+    out << "versao=" << MODULE_SUMMARY_VERSION << "\n";
+
+    std::vector<std::string> funcs;
+    module_func_names(mod, funcs);
+    for (auto& name : funcs) {
+        Sym sym = Sym::intern(name);
+        auto fit = declared_funcs_.find(sym);
+        if (fit == declared_funcs_.end()) continue;
+        auto rit = func_return_types_.find(sym);
+        out << "funcao=" << name << "|" << join_names(fit->second.params) << "|"
+            << join_types(fit->second.param_types) << "|"
+            << (rit != func_return_types_.end() ? type_code(rit->second) : "-") << "\n";
+    }
+    for (auto& c : mod.classes) {
+        auto cit = declared_classes_.find(Sym::intern(c));
+        if (cit == declared_classes_.end()) continue;
+        auto& cls = cit->second;
+        out << "classe=" << c << "|" << cls.instance_size << "|"
+            << join_names(cls.method_names) << "\n";
+        for (auto& a : cls.attrs) {
+            out << "atributo=" << c << "|" << a.name << "|" << a.offset << "|"
+                << type_code(a.type) << "\n";
+        }
+    }
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary);
+        if (!f.is_open()) return false;
+        f << out.str();
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+// Lê o resumo e aplica ao estado do importador; false se ausente ou inválido
+bool apply_module_summary(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) return false;
+
+    std::unordered_map<std::string, FuncInfo> funcs;
+    std::unordered_map<std::string, RuntimeType> rets;
+    std::unordered_map<std::string, ClassInfo> classes;
+    bool version_ok = false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        std::string key = line.substr(0, eq);
+        std::vector<std::string> f;
+        {
+            std::string val = line.substr(eq + 1);
+            size_t start = 0;
+            while (true) {
+                size_t bar = val.find('|', start);
+                f.push_back(val.substr(start, bar - start));
+                if (bar == std::string::npos) break;
+                start = bar + 1;
+            }
+        }
+
+        if (key == "versao") {
+            version_ok = (f[0] == MODULE_SUMMARY_VERSION);
+        } else if (key == "funcao" && f.size() == 4) {
+            FuncInfo fi;
+            fi.name = f[0];
+            for (auto& p : split_list(f[1])) fi.params.push_back(Sym::intern(p));
+            for (auto& t : split_list(f[2])) fi.param_types.push_back(type_from_code(t));
+            funcs[f[0]] = fi;
+            if (f[3] != "-") rets[f[0]] = type_from_code(f[3]);
+        } else if (key == "classe" && f.size() == 3) {
+            ClassInfo cls;
+            cls.name = f[0];
+            cls.instance_size = std::atoi(f[1].c_str());
+            cls.method_names = split_list(f[2]);
+            classes[f[0]] = cls;
+        } else if (key == "atributo" && f.size() == 4) {
+            auto cit = classes.find(f[0]);
+            if (cit == classes.end()) return false;
+            cit->second.attrs.push_back({f[1], std::atoi(f[2].c_str()),
+                                         type_from_code(f[3])});
+        } else {
+            return false;
+        }
+    }
+    if (!version_ok) return false;
+
+    for (auto& [name, fi] : funcs) {
+        Sym sym = Sym::intern(name);
+        auto prev = declared_funcs_.find(sym);
+        if (prev != declared_funcs_.end()) fi.symbol_index = prev->second.symbol_index;
+        declared_funcs_[sym] = fi;
+    }
+    for (auto& [name, t] : rets) func_return_types_[Sym::intern(name)] = t;
+    for (auto& [name, cls] : classes) declared_classes_[Sym::intern(name)] = cls;
+    return true;
+}
+
+// ======================================================================
+// EMISSÃO DO OBJETO DO MÓDULO
+// Roda numa instância nova de Codegen, semeada com o estado de tipos do
+// importador; só as funções e métodos do módulo são emitidos.
+// ======================================================================
+
+void seed_type_state(const Codegen& parent) {
+    base_dir_ = parent.base_dir_;
+    exe_dir_ = parent.exe_dir_;
+    lang_config_ = parent.lang_config_;
+    debug_mode_ = parent.debug_mode_;
+    contadores_ = parent.contadores_;
+    alvo_nativo_ = parent.alvo_nativo_;
+    ieee_estrito_ = parent.ieee_estrito_;
+    sem_checagem_ = parent.sem_checagem_;
+    jprt_ = parent.jprt_;
+    tamanho_ = parent.tamanho_;
+    pgo_gerar_ = parent.pgo_gerar_;
+    pgo_ = parent.pgo_;
+    pgo_folhas_ = parent.pgo_folhas_;
+    diag_source_file_ = parent.diag_source_file_;
+    declared_funcs_ = parent.declared_funcs_;
+    func_return_types_ = parent.func_return_types_;
+    func_param_types_ = parent.func_param_types_;
+    declared_classes_ = parent.declared_classes_;
+    class_attr_param_map_ = parent.class_attr_param_map_;
+    var_instance_class_ = parent.var_instance_class_;
+    var_is_list_ = parent.var_is_list_;
+    var_list_elem_type_ = parent.var_list_elem_type_;
+    var_list_instance_class_ = parent.var_list_instance_class_;
+    seed_depuracao(parent);
+}
+
+// Seções e externos padrão de um objeto auxiliar (mesma ordem de compile())
+void setup_object_sections() {
+    emitter_.create_text_section();
+    emitter_.create_rdata_section();
+    emitter_.create_data_section();
+    PlatformDefs::create_extra_sections(emitter_);
+
+    text_idx_  = 0;
+    rdata_idx_ = 1;
+    data_idx_  = 2;
+    text_  = &emitter_.section(text_idx_);
+    rdata_ = &emitter_.section(rdata_idx_);
+    data_  = &emitter_.section(data_idx_);
+
+    PlatformDefs::add_common_externs(emitter_);
+    PlatformDefs::add_platform_externs(emitter_);
+    init_native_funcs();
+}
+
+bool emit_module_object(const Program& program, const ModuloFonte& mod,
+                        const std::string& obj_path) {
+    setup_object_sections();
+    depuracao_.unidade = mod.caminho;
+
+    std::unordered_set<std::string> own;
+    for (auto& f : mod.funcoes) own.insert(f);
+    for (auto& c : mod.classes) own.insert(c);
+
+    for (auto& stmt : program.statements) {
+        std::visit([&](const auto& node) {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, FuncaoStmt>) {
+                if (own.count(node.name)) emit_function(node);
+            }
+            else if constexpr (std::is_same_v<T, ClasseStmt>) {
+                if (own.count(node.name)) emit_class_methods(node);
+            }
+        }, stmt->node);
+    }
+
+    if (!relatar_erros_tipo()) return false;
+    separar_funcoes();
+    emitir_depuracao();
+    return emitter_.write(obj_path);
+}
+
+// ======================================================================
+// PONTO DE ENTRADA: chamado no lugar de emit_function/emit_class_methods
+// para a primeira declaração de cada módulo
+// ======================================================================
+
+bool emit_module(const Program& program, size_t index) {
+    if (module_done_[index]) return true;
+    module_done_[index] = true;
+
+    const ModuloFonte& mod = program.modulos[index];
+    std::string src_hash = hash_file(mod.caminho);
+    if (src_hash.empty()) {
+        std::cerr << "Erro: Não foi possível ler o módulo '" << mod.caminho << "'" << std::endl;
+        return false;
+    }
+
+    std::string sig = compiler_identity() + "\n" + src_hash + "\n" + module_state_signature();
+    std::string key = hash_hex(fnv1a64(sig.data(), sig.size()));
+    std::string stem = std::filesystem::path(mod.caminho).stem().string();
+    std::filesystem::path base = std::filesystem::path(module_cache_dir_) / (stem + "-" + key);
+
+    std::string obj_path = base.string() + (PlatformDefs::is_windows ? ".obj" : ".o");
+    std::string sum_path = base.string() + ".jpsum";
+
+    std::error_code ec;
+    if (!std::filesystem::exists(obj_path, ec) || !apply_module_summary(sum_path)) {
+        std::filesystem::create_directories(module_cache_dir_, ec);
+
+        Codegen sub;
+        sub.seed_type_state(*this);
+        if (!sub.emit_module_object(program, mod, obj_path)) {
+            std::cerr << "Erro: Falha ao gerar objeto do módulo '" << mod.caminho << "'" << std::endl;
+            return false;
+        }
+        if (!sub.write_module_summary(mod, sum_path) || !apply_module_summary(sum_path)) {
+            std::cerr << "Erro: Falha ao gravar resumo do módulo '" << mod.caminho << "'" << std::endl;
+            return false;
+        }
+        tempos_funcoes_.insert(tempos_funcoes_.end(),
+                               sub.tempos_funcoes_.begin(), sub.tempos_funcoes_.end());
+    }
+
+    extra_obj_paths_.push_back(obj_path);
+    return true;
+}
@@ -94,6 +94,7 @@ void emit_nativo(const NativoStmt& node) {
     std::string json_content((std::istreambuf_iterator<char>(json_file)),
                               std::istreambuf_iterator<char>());
     json_file.close();
+    manifest_paths_.push_back(json_path);
 
     // Determinar tipo de linkagem
     bool is_dynamic;
@@ -119,8 +120,11 @@ void emit_nativo(const NativoStmt& node) {
         }
     }
 
-    // Registrar para linkagem
+    // Registrar para linkagem (e lembrar o que esta importação trouxe,
+    // para descartar_importacoes_sem_uso)
+    ImportacaoNativa imp;
     if (is_dynamic) {
+        imp.dlls.push_back(bin_path);
         extra_dll_paths_.push_back(bin_path);
 
         // Linux: registrar diretório para busca em runtime (-rpath)
@@ -142,10 +146,54 @@ void emit_nativo(const NativoStmt& node) {
         }
     } else {
         extra_obj_paths_.push_back(bin_path);
+        imp.objetos.push_back(bin_path);
     }
 
-    // Parsear funções e libs do JSON
-    parse_lib_json(json_content, lib_dir);
+    // Parsear funções e libs do JSON (libs coletadas à parte: uma lib já
+    // pedida por outra importação também é desta)
+    std::vector<std::string> funcoes;
+    std::vector<std::string> libs_antes = std::move(extra_libs_);
+    extra_libs_.clear();
+    parse_lib_json(json_content, lib_dir, &funcoes);
+    imp.libs = extra_libs_;
+    for (auto& l : imp.libs) {
+        if (std::find(libs_antes.begin(), libs_antes.end(), l) == libs_antes.end()) {
+            libs_antes.push_back(l);
+        }
+    }
+    extra_libs_ = std::move(libs_antes);
+    imp.funcoes = funcoes;
+    importacoes_nativas_.push_back(std::move(imp));
+
+    // Perfilador: nomes das funções estáticas (as .jpd saem do dladdr)
+    if (!is_dynamic) {
+        for (auto& f : funcoes) nativa_estatica_[f] = lib_name;
+    }
+}
+
+// ======================================================================
+// OBJETOS DO RUNTIME (runtime/<nome>.o — perfilador, contadores, jprt)
+// Procurados ao lado do jp e depois relativos ao diretório atual
+// ======================================================================
+
+std::string localizar_objeto_runtime(const std::string& nome) const {
+    std::string rel = "runtime/" + nome + ".o";
+    for (auto& base : {exe_dir_, std::string(".")}) {
+        if (base.empty()) continue;
+        std::string caminho = base + "/" + rel;
+        if (std::filesystem::exists(caminho)) return caminho;
+    }
+    return "";
+}
+
+bool adicionar_objeto_runtime(const std::string& nome) {
+    std::string caminho = localizar_objeto_runtime(nome);
+    if (caminho.empty()) {
+        std::cerr << "Erro: objeto do runtime nao encontrado (runtime/" << nome << ".o)" << std::endl;
+        return false;
+    }
+    extra_obj_paths_.push_back(caminho);
+    return true;
 }
 
 // ======================================================================
@@ -165,7 +213,8 @@ bool parse_lib_json_tipo(const std::string& json) {
 // PARSER JSON SIMPLES (sem dependências)
 // ======================================================================
 
-void parse_lib_json(const std::string& json, const std::string& lib_dir = "") {
+void parse_lib_json(const std::string& json, const std::string& lib_dir = "",
+                    std::vector<std::string>* funcoes = nullptr) {
     size_t pos = 0;
     while (pos < json.size()) {
         size_t nome_key = json.find("\"nome\"", pos);
@@ -185,7 +234,8 @@ void parse_lib_json(const std::string& json, const std::string& lib_dir = "") {
             emitter_.add_extern_symbol(func_name);
         }
 
-        func_return_types_[func_name] = ret_type;
+        func_return_types_[Sym::intern(func_name)] = ret_type;
+        if (funcoes) funcoes->push_back(func_name);
 
         // Parsear campo "params": ["inteiro", "decimal", ...]
         size_t params_key = json.find("\"params\"", nome_key);
@@ -219,7 +269,7 @@ void parse_lib_json(const std::string& json, const std::string& lib_dir = "") {
                         p++;
                     }
                 }
-                func_param_types_[func_name] = param_types;
+                func_param_types_[Sym::intern(func_name)] = param_types;
             }
         }
 
@@ -0,0 +1,522 @@
+// codegen_paralelo.hpp
+// Geração de código paralela por função — resultado idêntico byte a byte
+// ao modo serial
+//
+// As declarações do topo (funções e classes inteiras) são divididas em
+// lotes contíguos. Cada lote é emitido, em série e na ordem do fonte, por
+// uma instância própria de Codegen num fragmento isolado (.text/.rodata,
+// símbolos e relocações locais), a partir de uma cópia do estado de
+// tipos. Os fragmentos são juntados na ordem do fonte: o .text é
+// concatenado, símbolos e relocações são remapeados e as strings/
+// constantes de cada fragmento passam pelo pool global na mesma ordem em
+// que o modo serial as registraria.
+//
+// A emissão serial tem efeitos colaterais entre funções (tipos de
+// parâmetros vindos de call sites, tipos de atributos, variáveis de
+// lista/instância). Cada fragmento registra o que mudou; um lote
+// posterior que lê um nome alterado por um anterior é descartado e
+// regerado com o estado atualizado antes de ser juntado. A especulação
+// fica limitada a uma janela de `threads` lotes, então o pior caso
+// (todo lote depende do anterior) custa o mesmo tempo que o modo serial.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+unsigned codegen_threads_ = 0;                      // 0 = automático, 1 = serial
+static constexpr size_t PARALLEL_MIN_JOBS = 8;      // abaixo disso, serial
+static constexpr size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+
+// Lote de declarações do topo, emitidas em série num mesmo fragmento
+struct FuncJob {
+    std::vector<const Stmt*> decls;           // FuncaoStmt ou ClasseStmt
+    std::unordered_set<Sym> names;            // identificadores lidos/escritos
+    std::unordered_set<Sym> methods;          // métodos chamados ou definidos
+    bool uses_objects = false;                // acessa atributos/métodos
+};
+
+struct StateDelta {
+    std::vector<std::pair<Sym, FuncInfo>> funcs;
+    std::vector<std::pair<Sym, ClassInfo>> classes;
+    std::vector<std::pair<Sym, std::string>> instance_class;
+    std::vector<std::pair<Sym, std::string>> list_instance_class;
+    std::vector<std::pair<Sym, RuntimeType>> list_elem_type;
+    std::vector<Sym> lists;
+    std::vector<std::string> keys;            // "f:nome", "c:Classe", "v:var"
+};
+
+// ======================================================================
+// DECISÃO: serial ou paralelo
+// ======================================================================
+
+unsigned parallel_thread_count(const Program& program) const {
+    unsigned threads = codegen_threads_;
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads <= 1) return 1;
+
+    size_t jobs = 0;
+    for (auto& stmt : program.statements) {
+        if (std::holds_alternative<FuncaoStmt>(stmt->node) ||
+            std::holds_alternative<ClasseStmt>(stmt->node)) {
+            jobs++;
+        }
+    }
+    if (jobs < PARALLEL_MIN_JOBS) return 1;
+    return threads;
+}
+
+// ======================================================================
+// CONJUNTO DE LEITURA DE UMA FUNÇÃO (conservador, a partir da AST)
+// ======================================================================
+
+static void collect_interp_names(const std::string& text, FuncJob& job) {
+    std::string cur;
+    for (char c : text) {
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+            (static_cast<unsigned char>(c) & 0x80)) {
+            cur += c;
+        } else if (!cur.empty()) {
+            job.names.insert(Sym::intern(cur));
+            cur.clear();
+        }
+    }
+    if (!cur.empty()) job.names.insert(Sym::intern(cur));
+}
+
+static void collect_job_names_expr(const Expr& expr, FuncJob& job) {
+    std::visit([&](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, VarExpr>) {
+            job.names.insert(node.name);
+        }
+        else if constexpr (std::is_same_v<T, StringInterp>) {
+            for (auto& part : node.parts) {
+                if (!part.is_var) continue;
+                collect_interp_names(part.value, job);
+                if (part.expr) collect_job_names_expr(*part.expr, job);
+            }
+        }
+        else if constexpr (std::is_same_v<T, BinOpExpr> ||
+                           std::is_same_v<T, CmpOpExpr> ||
+                           std::is_same_v<T, LogicOpExpr> ||
+                           std::is_same_v<T, ConcatExpr>) {
+            collect_job_names_expr(*node.left, job);
+            collect_job_names_expr(*node.right, job);
+        }
+        else if constexpr (std::is_same_v<T, ChamadaExpr>) {
+            job.names.insert(node.name);
+            for (auto& a : node.args) collect_job_names_expr(*a, job);
+        }
+        else if constexpr (std::is_same_v<T, AttrGetExpr>) {
+            job.uses_objects = true;
+            job.names.insert(node.attr);
+            collect_job_names_expr(*node.object, job);
+        }
+        else if constexpr (std::is_same_v<T, MetodoChamadaExpr>) {
+            job.uses_objects = true;
+            job.methods.insert(node.method);
+            collect_job_names_expr(*node.object, job);
+            for (auto& a : node.args) collect_job_names_expr(*a, job);
+        }
+        else if constexpr (std::is_same_v<T, AutoExpr>) {
+            job.uses_objects = true;
+        }
+        else if constexpr (std::is_same_v<T, ListLitExpr>) {
+            for (auto& e : node.elements) collect_job_names_expr(*e, job);
+        }
+        else if constexpr (std::is_same_v<T, IndexGetExpr>) {
+            collect_job_names_expr(*node.object, job);
+            collect_job_names_expr(*node.index, job);
+        }
+    }, expr.node);
+}
+
+static void collect_job_names_stmt(const Stmt& stmt, FuncJob& job) {
+    std::visit([&](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, AssignStmt>) {
+            job.names.insert(node.name);
+            collect_job_names_expr(*node.value, job);
+        }
+        else if constexpr (std::is_same_v<T, AttrSetStmt>) {
+            job.uses_objects = true;
+            job.names.insert(node.attr);
+            collect_job_names_expr(*node.object, job);
+            collect_job_names_expr(*node.value, job);
+        }
+        else if constexpr (std::is_same_v<T, SaidaStmt>) {
+            if (node.value) collect_job_names_expr(*node.value, job);
+        }
+        else if constexpr (std::is_same_v<T, IfStmt>) {
+            for (auto& br : node.branches) {
+                if (br.condition) collect_job_names_expr(*br.condition, job);
+                collect_job_names_stmts(br.body, job);
+            }
+        }
+        else if constexpr (std::is_same_v<T, RepetirStmt>) {
+            collect_job_names_expr(*node.count, job);
+            collect_job_names_stmts(node.body, job);
+        }
+        else if constexpr (std::is_same_v<T, EnquantoStmt>) {
+            collect_job_names_expr(*node.condition, job);
+            collect_job_names_stmts(node.body, job);
+        }
+        else if constexpr (std::is_same_v<T, ParaStmt>) {
+            job.names.insert(node.var);
+            collect_job_names_expr(*node.start, job);
+            collect_job_names_expr(*node.end, job);
+            if (node.step) collect_job_names_expr(*node.step, job);
+            collect_job_names_stmts(node.body, job);
+        }
+        else if constexpr (std::is_same_v<T, RetornaStmt>) {
+            if (node.value) collect_job_names_expr(*node.value, job);
+        }
+        else if constexpr (std::is_same_v<T, FuncaoStmt>) {
+            // Método dentro de classe
+            job.methods.insert(node.name);
+            for (auto& p : node.params) job.names.insert(p);
+            collect_job_names_stmts(node.body, job);
+        }
+        else if constexpr (std::is_same_v<T, ExprStmt>) {
+            collect_job_names_expr(*node.expr, job);
+        }
+        else if constexpr (std::is_same_v<T, IndexSetStmt>) {
+            job.names.insert(node.name);
+            collect_job_names_expr(*node.index, job);
+            collect_job_names_expr(*node.value, job);
+        }
+    }, stmt.node);
+}
+
+static void collect_job_names_stmts(const StmtList& stmts, FuncJob& job) {
+    for (auto& stmt : stmts) collect_job_names_stmt(*stmt, job);
+}
+
+static void add_job_decl(FuncJob& job, const Stmt& stmt) {
+    job.decls.push_back(&stmt);
+    if (auto* func = std::get_if<FuncaoStmt>(&stmt.node)) {
+        job.names.insert(func->name);
+        for (auto& p : func->params) job.names.insert(p);
+        collect_job_names_stmts(func->body, job);
+    } else if (auto* cls = std::get_if<ClasseStmt>(&stmt.node)) {
+        job.names.insert(cls->name);
+        job.uses_objects = true;
+        collect_job_names_stmts(cls->body, job);
+    }
+}
+
+// Divide as declarações em lotes contíguos de tamanho parecido
+static std::vector<FuncJob> make_jobs(const std::vector<const Stmt*>& decls,
+                                      unsigned threads) {
+    size_t count = std::min(decls.size(),
+                            static_cast<size_t>(threads) * PARALLEL_CHUNKS_PER_THREAD);
+    std::vector<FuncJob> jobs(count);
+    for (size_t i = 0; i < decls.size(); i++) {
+        add_job_decl(jobs[i * count / decls.size()], *decls[i]);
+    }
+    return jobs;
+}
+
+// O job lê o estado identificado por `key`?
+static bool job_reads(const FuncJob& job, const std::string& key) {
+    std::string name = key.substr(2);
+    if (job.names.count(Sym::intern(name))) return true;
+    if (key[0] == 'c') return job.uses_objects;
+    if (key[0] == 'f') {
+        // Classe__metodo: depende de quem chama ou define o método
+        for (size_t p = name.find("__"); p != std::string::npos;
+             p = name.find("__", p + 1)) {
+            if (job.methods.count(Sym::intern(name.substr(p + 2)))) return true;
+        }
+    }
+    return false;
+}
+
+// ======================================================================
+// DELTA DE ESTADO: o que o fragmento mudou em relação ao pai
+// ======================================================================
+
+static bool same_class(const ClassInfo& a, const ClassInfo& b) {
+    if (a.instance_size != b.instance_size) return false;
+    if (a.method_names != b.method_names) return false;
+    if (a.attrs.size() != b.attrs.size()) return false;
+    for (size_t i = 0; i < a.attrs.size(); i++) {
+        if (a.attrs[i].name != b.attrs[i].name ||
+            a.attrs[i].offset != b.attrs[i].offset ||
+            a.attrs[i].type != b.attrs[i].type) return false;
+    }
+    return true;
+}
+
+template <typename Map, typename Vec>
+static void diff_map(const Map& child, const Map& parent, Vec& out,
+                     std::vector<std::string>& keys) {
+    for (auto& [k, v] : child) {
+        auto it = parent.find(k);
+        if (it != parent.end() && it->second == v) continue;
+        out.push_back({k, v});
+        keys.push_back("v:" + k);
+    }
+}
+
+StateDelta state_delta_from(const Codegen& parent) const {
+    StateDelta d;
+    for (auto& [k, v] : declared_funcs_) {
+        auto it = parent.declared_funcs_.find(k);
+        bool types_changed = (it == parent.declared_funcs_.end() ||
+                              it->second.param_types != v.param_types);
+        if (!types_changed && it->second.params == v.params) continue;
+        d.funcs.push_back({k, v});
+        if (types_changed) d.keys.push_back("f:" + k);
+    }
+    for (auto& [k, v] : declared_classes_) {
+        auto it = parent.declared_classes_.find(k);
+        if (it != parent.declared_classes_.end() && same_class(it->second, v)) continue;
+        d.classes.push_back({k, v});
+        d.keys.push_back("c:" + k);
+    }
+    diff_map(var_instance_class_, parent.var_instance_class_, d.instance_class, d.keys);
+    diff_map(var_list_instance_class_, parent.var_list_instance_class_,
+             d.list_instance_class, d.keys);
+    diff_map(var_list_elem_type_, parent.var_list_elem_type_, d.list_elem_type, d.keys);
+    for (auto& l : var_is_list_) {
+        if (parent.var_is_list_.count(l)) continue;
+        d.lists.push_back(l);
+        d.keys.push_back("v:" + l);
+    }
+    return d;
+}
+
+void apply_state_delta(const StateDelta& d, const std::vector<uint32_t>& sym_map) {
+    for (auto& [k, v] : d.funcs) {
+        FuncInfo fi = v;
+        auto prev = declared_funcs_.find(k);
+        if (fi.symbol_index < sym_map.size()) {
+            fi.symbol_index = sym_map[fi.symbol_index];
+        } else if (prev != declared_funcs_.end()) {
+            fi.symbol_index = prev->second.symbol_index;
+        }
+        declared_funcs_[k] = fi;
+    }
+    for (auto& [k, v] : d.classes) declared_classes_[k] = v;
+    for (auto& [k, v] : d.instance_class) var_instance_class_[k] = v;
+    for (auto& [k, v] : d.list_instance_class) var_list_instance_class_[k] = v;
+    for (auto& [k, v] : d.list_elem_type) var_list_elem_type_[k] = v;
+    for (auto& l : d.lists) var_is_list_.insert(l);
+}
+
+// ======================================================================
+// JUNÇÃO DE UM FRAGMENTO NO OBJETO PRINCIPAL
+// Devolve o mapa símbolo do fragmento → símbolo do objeto principal
+// ======================================================================
+
+std::vector<uint32_t> merge_fragment(Codegen& frag) {
+    uint32_t base = static_cast<uint32_t>(text_->pos());
+
+    // 1) Pool de strings/constantes, na ordem em que o fragmento registrou
+    std::vector<std::pair<uint32_t, const std::string*>> entries;
+    // (tabelas de saltos entram com chave nula)
+    for (auto& [key, off] : frag.string_offsets_) entries.push_back({off, &key});
+    for (auto& [off, bytes] : frag.tabelas_rdata_) entries.push_back({off, nullptr});
+    std::sort(entries.begin(), entries.end());
+
+    const auto& fr = frag.rdata_->data;
+    std::unordered_map<uint32_t, uint32_t> rdata_map;
+    for (auto& [off, key] : entries) {
+        if (!key) {
+            uint32_t bytes = frag.tabelas_rdata_.at(off);
+            size_t novo = add_tabela_rdata(bytes);
+            std::memcpy(&rdata_->data[novo], &fr[off], bytes);
+            rdata_map[off] = static_cast<uint32_t>(novo);
+            continue;
+        }
+        bool is_string = off + key->size() < fr.size() &&
+                         std::memcmp(&fr[off], key->data(), key->size()) == 0 &&
+                         fr[off + key->size()] == 0;
+        if (is_string) {
+            rdata_map[off] = add_string(*key);
+        } else {
+            double val;
+            std::memcpy(&val, &fr[off], 8);
+            rdata_map[off] = add_double_constant(val);
+        }
+    }
+
+    // 2) Símbolos, na ordem de registro do fragmento
+    std::vector<uint32_t> sym_map(frag.emitter_.symbol_count());
+    for (uint32_t i = 0; i < sym_map.size(); i++) {
+        auto& s = frag.emitter_.symbol_at(i);
+        #ifdef _WIN32
+        bool defined = s.section_number != IMAGE_SYM_UNDEFINED;
+        bool is_func = s.type == IMAGE_SYM_DTYPE_FUNCTION;
+        #else
+        bool defined = s.section_index != SymbolInfo::UNDEF;
+        bool is_func = s.type == STT_FUNC;
+        #endif
+        sym_map[i] = defined
+            ? emitter_.add_global_symbol(s.name, text_idx_,
+                                         base + static_cast<uint32_t>(s.value), is_func)
+            : emitter_.add_extern_symbol(s.name);
+        #ifndef _WIN32
+        if (defined) emitter_.set_symbol_size(sym_map[i], s.size);
+        #endif
+    }
+
+    // 3) Código e relocações
+    text_->emit(frag.text_->data);
+
+    const uint32_t section_flag = frag.emitter_.section_symbol(0);
+    const uint32_t rdata_sym = frag.emitter_.section_symbol(frag.rdata_idx_);
+    for (auto r : frag.text_->relocations) {
+        #ifdef _WIN32
+        // COFF: offset na seção vai no imm32 do próprio código
+        if (r.symbol_table_index == rdata_sym) {
+            int32_t local;
+            std::memcpy(&local, &frag.text_->data[r.virtual_address], 4);
+            text_->patch_i32(base + r.virtual_address,
+                             static_cast<int32_t>(rdata_map.at(static_cast<uint32_t>(local))));
+        } else if (!(r.symbol_table_index & section_flag)) {
+            r.symbol_table_index = sym_map[r.symbol_table_index];
+        }
+        r.virtual_address += base;
+        #else
+        if (r.symbol_id == rdata_sym) {
+            uint32_t local = static_cast<uint32_t>(r.addend - PlatformDefs::DEFAULT_RIP_ADDEND);
+            r.addend = static_cast<int64_t>(rdata_map.at(local)) + PlatformDefs::DEFAULT_RIP_ADDEND;
+        } else if (!(r.symbol_id & section_flag)) {
+            r.symbol_id = sym_map[r.symbol_id];
+        }
+        r.offset += base;
+        #endif
+        text_->relocations.push_back(r);
+    }
+
+    merge_depuracao(frag, base);
+    erros_tipo_.insert(frag.erros_tipo_.begin(), frag.erros_tipo_.end());
+    tempos_funcoes_.insert(tempos_funcoes_.end(),
+                           frag.tempos_funcoes_.begin(), frag.tempos_funcoes_.end());
+    juntar_tamanho(frag);
+    return sym_map;
+}
+
+// ======================================================================
+// GERAÇÃO DE UM FRAGMENTO (roda numa thread de trabalho; só lê o pai)
+// ======================================================================
+
+void emit_fragment(const Codegen& parent, const FuncJob& job) {
+    seed_type_state(parent);
+    alcance_ = parent.alcance_;
+    pilha_sitios_ = parent.pilha_sitios_;
+    setup_object_sections();
+    for (auto* stmt : job.decls) {
+        if (auto* func = std::get_if<FuncaoStmt>(&stmt->node)) {
+            emit_function(*func);
+        } else {
+            emit_class_methods(std::get<ClasseStmt>(stmt->node));
+        }
+    }
+}
+
+// ======================================================================
+// RESOLUÇÃO DE UM TRECHO DE JOBS
+// Rodada: (re)gera em paralelo os fragmentos inválidos da janela com o
+// estado atual, depois junta em ordem enquanto seguem válidos. O
+// primeiro pendente é sempre válido, então cada rodada avança.
+// ======================================================================
+
+void resolve_jobs(const std::vector<const Stmt*>& decls, unsigned threads) {
+    if (decls.empty()) return;
+    std::vector<FuncJob> jobs = make_jobs(decls, threads);
+
+    struct Fragment {
+        std::unique_ptr<Codegen> cg;
+        StateDelta delta;
+        size_t version = 0;
+    };
+    std::vector<Fragment> frags(jobs.size());
+    std::vector<std::vector<std::string>> changes;   // chaves por job aceito
+
+    auto still_valid = [&](size_t i) {
+        if (!frags[i].cg) return false;
+        for (size_t v = frags[i].version; v < changes.size(); v++) {
+            for (auto& key : changes[v]) {
+                if (job_reads(jobs[i], key)) return false;
+            }
+        }
+        return true;
+    };
+
+    size_t next = 0;
+    while (next < jobs.size()) {
+        std::vector<size_t> todo;
+        size_t window_end = std::min(jobs.size(), next + threads);
+        for (size_t i = next; i < window_end; i++) {
+            if (!still_valid(i)) todo.push_back(i);
+        }
+
+        size_t version = changes.size();
+        std::atomic<size_t> cursor{0};
+        std::exception_ptr failure;
+        std::mutex failure_mutex;
+        auto worker = [&]() {
+            for (size_t t = cursor++; t < todo.size(); t = cursor++) {
+                size_t i = todo[t];
+                try {
+                    auto cg = std::make_unique<Codegen>();
+                    cg->emit_fragment(*this, jobs[i]);
+                    frags[i].delta = cg->state_delta_from(*this);
+                    frags[i].cg = std::move(cg);
+                    frags[i].version = version;
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(failure_mutex);
+                    if (!failure) failure = std::current_exception();
+                }
+            }
+        };
+        unsigned n = static_cast<unsigned>(std::min<size_t>(threads, todo.size()));
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < n; t++) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+        if (failure) std::rethrow_exception(failure);
+
+        while (next < jobs.size() && still_valid(next)) {
+            std::vector<uint32_t> sym_map = merge_fragment(*frags[next].cg);
+            apply_state_delta(frags[next].delta, sym_map);
+            changes.push_back(std::move(frags[next].delta.keys));
+            frags[next].cg.reset();
+            next++;
+        }
+    }
+}
+
+// ======================================================================
+// PONTO DE ENTRADA: substitui o laço serial de emit_function/
+// emit_class_methods em compile()
+// ======================================================================
+
+bool emit_functions_parallel(const Program& program, unsigned threads) {
+    std::vector<const Stmt*> decls;
+    bool ok = true;
+    for (auto& stmt : program.statements) {
+        std::visit([&](const auto& node) {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, FuncaoStmt> ||
+                          std::is_same_v<T, ClasseStmt>) {
+                int mod = module_of(node.name);
+                if (!alcancavel(node)) {
+                    // ninguém chama: fora dos lotes
+                } else if (mod >= 0) {
+                    // Módulo separado é barreira: aplica o resumo em ordem
+                    resolve_jobs(decls, threads);
+                    decls.clear();
+                    if (!emit_module(program, static_cast<size_t>(mod))) ok = false;
+                } else {
+                    decls.push_back(stmt.get());
+                }
+            }
+        }, stmt->node);
+    }
+    resolve_jobs(decls, threads);
+    return ok;
+}
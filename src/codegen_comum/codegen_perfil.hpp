@@ -0,0 +1,129 @@
+// codegen_perfil.hpp
+// Perfilador por amostragem (`jp build -perfil`, Linux) — tabela de
+// endereços em .rodata e chamada de inicialização no main
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// O runtime (runtime/perfil.cpp → runtime/perfil.o) arma SIGPROF, segue a
+// cadeia de RBP e, na saída, usa esta tabela para trocar endereços por
+// "funcao (arquivo.jp:linha)". Layout (u32, offsets de string relativos
+// ao início da tabela):
+//
+//   cabeçalho   magica "JPPF", versao, text (PC32 → .text+0), tamanho_text,
+//               n_funcoes, n_linhas, n_nativas, reservado
+//   funcoes     {inicio, fim, nome, arquivo}   ordenadas por inicio
+//   linhas      {offset, linha}                offsets crescentes
+//   nativas     {endereco (PC32), nome, biblioteca}
+//   strings     terminadas em \0
+//
+// Nativas = funções de bibliotecas estáticas chamadas pelo programa; as
+// .jpd são resolvidas em runtime com dladdr.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool perfil_ = false;
+std::unordered_map<std::string, std::string> nativa_estatica_;   // função → biblioteca
+
+static constexpr uint32_t PERFIL_MAGICA = 0x4650504A;   // "JPPF"
+static constexpr uint32_t PERFIL_VERSAO = 1;
+
+// ======================================================================
+// INICIALIZAÇÃO — no main, depois do prólogo
+// ======================================================================
+
+void emit_perfil_iniciar() {
+    if (!perfil_) return;
+
+    // Tabela é definida no fim da compilação (emitir_tabela_perfil)
+    if (!emitter_.has_symbol("__jp_perfil_tabela")) {
+        emitter_.add_extern_symbol("__jp_perfil_tabela");
+    }
+    emit_lea_rip_symbol(PlatformDefs::ARG1, emitter_.symbol_index("__jp_perfil_tabela"));
+    emit_call_extern("__jp_perfil_iniciar");
+}
+
+// ======================================================================
+// TABELA
+// ======================================================================
+
+// Chamado depois de todas as funções (extensões e linhas já registradas).
+// Só existe no Linux: main.cpp recusa -perfil no Windows.
+void emitir_tabela_perfil() {
+    if (!perfil_) return;
+#ifndef _WIN32
+    auto reloc_pc32 = [&](uint32_t sym) {
+        rdata_->add_relocation(static_cast<uint32_t>(rdata_->pos()), sym, R_X86_64_PC32, 0);
+        rdata_->emit_u32(0);
+    };
+
+    std::vector<FuncaoDepuracao> funcoes = depuracao_.funcoes;
+    std::sort(funcoes.begin(), funcoes.end(),
+              [](const FuncaoDepuracao& a, const FuncaoDepuracao& b) {
+                  return a.inicio < b.inicio;
+              });
+
+    // Só nativas estáticas com alguma chamada em .text (as outras podem
+    // nem existir no .o, e a relocação quebraria o link)
+    std::unordered_set<uint32_t> chamados;
+    for (auto& r : text_->relocations) chamados.insert(r.symbol_id);
+    std::vector<std::pair<std::string, std::string>> nativas;
+    for (auto& [nome, lib] : nativa_estatica_) {
+        if (emitter_.has_symbol(nome) && chamados.count(emitter_.symbol_index(nome))) {
+            nativas.push_back({nome, lib});
+        }
+    }
+    std::sort(nativas.begin(), nativas.end());
+
+    // Strings depois das entradas, deduplicadas
+    uint32_t base_strings = 32 + 16 * static_cast<uint32_t>(funcoes.size()) +
+                            8 * static_cast<uint32_t>(depuracao_.linhas.size()) +
+                            12 * static_cast<uint32_t>(nativas.size());
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> string_off;
+    auto texto = [&](const std::string& s) {
+        auto it = string_off.find(s);
+        if (it != string_off.end()) return it->second;
+        uint32_t off = base_strings + static_cast<uint32_t>(strings.size());
+        strings += s;
+        strings.push_back('\0');
+        string_off[s] = off;
+        return off;
+    };
+    std::vector<uint32_t> arquivos;
+    for (auto& a : depuracao_.arquivos) {
+        arquivos.push_back(texto(std::filesystem::path(a).filename().string()));
+    }
+
+    rdata_->align(8);
+    uint32_t tabela = static_cast<uint32_t>(rdata_->pos());
+    emitter_.add_global_symbol("__jp_perfil_tabela", rdata_idx_, tabela);
+
+    rdata_->emit_u32(PERFIL_MAGICA);
+    rdata_->emit_u32(PERFIL_VERSAO);
+    reloc_pc32(emitter_.section_symbol(text_idx_));
+    rdata_->emit_u32(static_cast<uint32_t>(text_->pos()));
+    rdata_->emit_u32(static_cast<uint32_t>(funcoes.size()));
+    rdata_->emit_u32(static_cast<uint32_t>(depuracao_.linhas.size()));
+    rdata_->emit_u32(static_cast<uint32_t>(nativas.size()));
+    rdata_->emit_u32(0);
+
+    for (auto& f : funcoes) {
+        rdata_->emit_u32(f.inicio);
+        rdata_->emit_u32(f.fim);
+        rdata_->emit_u32(texto(f.nome));
+        rdata_->emit_u32(f.arquivo < arquivos.size() ? arquivos[f.arquivo] : texto("?"));
+    }
+    for (auto& l : depuracao_.linhas) {
+        rdata_->emit_u32(l.offset);
+        rdata_->emit_u32(l.linha);
+    }
+    for (auto& [nome, lib] : nativas) {
+        reloc_pc32(emitter_.symbol_index(nome));
+        rdata_->emit_u32(texto(nome));
+        rdata_->emit_u32(texto(lib));
+    }
+    rdata_->emit(reinterpret_cast<const uint8_t*>(strings.data()), strings.size());
+#endif
+}
@@ -0,0 +1,485 @@
+// codegen_pgo.hpp
+// Otimização guiada por perfil — `jp build -pgo-gerar` instrumenta,
+// `jp build -pgo-usar arquivo.jpprof` usa as contagens (formato em src/pgo.hpp)
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Pontos contados (chave = tipo, arquivo, linha, ordinal na linha, função):
+//   funcao   entrada da função/método/main
+//   se       cada ramo com condição: [avaliado, verdadeiro]
+//   laco     enquanto/para: [entradas, iterações]
+//   chamada  cada chamada de função ou método
+//
+// -pgo-gerar: cada ponto é um `inc qword [rip+contador]` (flags mortas em
+// todos os pontos); os contadores são símbolos "__jp_pgo.<chave>" que o
+// objeto principal define no fim, como os de -contadores, e o runtime
+// (runtime/pgo.cpp) grava a tabela no .jpprof ao sair.
+//
+// -pgo-usar:
+//   - ramo `se` quase nunca verdadeiro: o corpo é emitido numa seção
+//     fria e anexado depois do epílogo da função; o caminho quente segue
+//     sem salto tomado
+//   - laço quente: teste repetido no fim (salto para trás condicional),
+//     uma comparação e nenhum jmp por iteração
+//   - funções ordenadas em .text por número de entradas (quentes juntas,
+//     logo depois do main)
+//   - chamada quente de uma função folha pequena (`retorna expr` só com
+//     os parâmetros, literais e + - * % comparações e/ou; args e retorno
+//     inteiros ou lógicos): os args vão para temporários e a expressão é
+//     emitida no lugar, sem call
+// Chamadas de método e `retorna f(...)` (cauda) são contadas mas não
+// entram no inline.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool pgo_gerar_ = false;
+std::shared_ptr<const PerfilPgo> pgo_;            // perfil de -pgo-usar
+std::string pgo_funcao_;                          // símbolo da função em emissão
+std::unordered_map<std::string, uint32_t> pgo_ordinais_;   // "tipo:linha" → próximo
+
+// Blocos frios da função em emissão: corpo em pgo_frio_, anexado no fim
+struct BlocoFrio {
+    size_t desvio;      // jcc em .text que entra no bloco
+    size_t inicio;      // início do bloco em pgo_frio_
+    size_t volta;       // jmp no fim do bloco (em pgo_frio_)
+    size_t alvo;        // para onde o jmp volta, em .text
+};
+Section pgo_frio_{};
+std::vector<BlocoFrio> pgo_blocos_;
+std::vector<LinhaDepuracao> pgo_linhas_frio_;
+Section* pgo_principal_ = nullptr;
+
+static constexpr uint32_t PGO_MAGICA = 0x4750504A;    // "JPPG"
+static constexpr uint32_t PGO_VERSAO = 1;
+static constexpr const char* PGO_PREFIXO = "__jp_pgo.";
+static constexpr uint64_t PGO_MINIMO = 100;           // contagens para decidir
+static constexpr uint64_t PGO_FRIO = 50;              // verdadeiro < 1/50 → frio
+static constexpr int PGO_INLINE_NOS = 16;             // nós da expressão da folha
+
+// Funções `retorna expr` de um statement só (candidatas ao inline) e as
+// cópias das expressões emitidas no lugar (vivem até o fim da emissão:
+// as anotações de tipo são por endereço do nó)
+std::shared_ptr<const std::unordered_map<Sym, const FuncaoStmt*>> pgo_folhas_;
+AstArena pgo_arena_;
+std::vector<ExprPtr> pgo_inlinados_;
+
+// ======================================================================
+// PONTOS E CONTADORES
+// ======================================================================
+
+bool pgo_ativo() const { return pgo_gerar_ || pgo_; }
+
+static uint32_t expr_line(const Expr& expr) {
+    return std::visit([](const auto& node) {
+        return node.line > 0 ? static_cast<uint32_t>(node.line) : 0u;
+    }, expr.node);
+}
+
+// Chave do próximo ponto `tipo` na linha (vazia sem -pgo-*)
+std::string pgo_ponto(const char* tipo, uint32_t linha) {
+    if (!pgo_ativo()) return {};
+    uint32_t ordinal = pgo_ordinais_[std::string(tipo) + ":" + std::to_string(linha)]++;
+    std::string arquivo = arquivo_atual_ < depuracao_.arquivos.size()
+        ? std::filesystem::path(depuracao_.arquivos[arquivo_atual_]).filename().string()
+        : "?";
+    return PerfilPgo::chave(tipo, arquivo, linha, ordinal, pgo_funcao_);
+}
+
+// inc qword [rip + contador + 8*indice]
+void emit_pgo_contar(const std::string& ponto, int indice) {
+    if (!pgo_gerar_ || ponto.empty()) return;
+    std::string simbolo = PGO_PREFIXO + ponto;
+    std::replace(simbolo.begin(), simbolo.end(), ' ', '/');
+    uint32_t sym = emitter_.add_extern_symbol(simbolo);
+
+    text_->emit_u8(0x48);
+    text_->emit_u8(0xFF);
+    text_->emit_u8(0x05);
+    uint32_t reloc_pos = static_cast<uint32_t>(text_->pos());
+    #ifdef _WIN32
+    text_->emit_i32(8 * indice);
+    emit_relocation(reloc_pos, sym, PlatformDefs::REL_RIP, 0);
+    #else
+    text_->emit_i32(0);
+    emit_relocation(reloc_pos, sym, PlatformDefs::REL_RIP,
+                    PlatformDefs::DEFAULT_RIP_ADDEND + 8 * indice);
+    #endif
+}
+
+// Início de função/método/main (depois de salvar os parâmetros)
+void pgo_entrar_funcao(const std::string& simbolo, uint32_t linha) {
+    if (!pgo_ativo()) return;
+    pgo_funcao_ = simbolo;
+    pgo_ordinais_.clear();
+    emit_pgo_contar(pgo_ponto("funcao", linha), 0);
+}
+
+// main: registra a tabela (gravação do .jpprof no atexit)
+void emit_pgo_iniciar() {
+    if (!pgo_gerar_) return;
+    if (!emitter_.has_symbol("__jp_pgo")) {
+        emitter_.add_extern_symbol("__jp_pgo");
+    }
+    emit_lea_rip_symbol(PlatformDefs::ARG1, emitter_.symbol_index("__jp_pgo"));
+    emit_call_extern("__jp_pgo_iniciar");
+}
+
+// ======================================================================
+// DECISÕES (-pgo-usar)
+// ======================================================================
+
+const std::pair<uint64_t, uint64_t>* pgo_contagem(const std::string& ponto) const {
+    return (pgo_ && !ponto.empty()) ? pgo_->ponto(ponto) : nullptr;
+}
+
+static bool tem_parar_continuar(const StmtList& stmts) {
+    for (auto& stmt : stmts) {
+        bool achou = std::visit([](const auto& node) -> bool {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, PararStmt> ||
+                          std::is_same_v<T, ContinuarStmt>) {
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, IfStmt>) {
+                for (auto& br : node.branches) {
+                    if (tem_parar_continuar(br.body)) return true;
+                }
+                return false;
+            }
+            else if constexpr (std::is_same_v<T, RepetirStmt> ||
+                               std::is_same_v<T, EnquantoStmt> ||
+                               std::is_same_v<T, ParaStmt>) {
+                return tem_parar_continuar(node.body);
+            }
+            else {
+                return false;
+            }
+        }, stmt->node);
+        if (achou) return true;
+    }
+    return false;
+}
+
+// Ramo quase nunca verdadeiro. Fica no lugar se já estamos num bloco frio
+// ou se o corpo tem parar/continuar (os patches do laço são de .text)
+bool pgo_ramo_frio(const std::string& ponto, const StmtList& corpo) const {
+    auto* c = pgo_contagem(ponto);
+    if (!c || c->first < PGO_MINIMO || c->second * PGO_FRIO >= c->first) return false;
+    return text_ != &pgo_frio_ && !tem_parar_continuar(corpo);
+}
+
+bool pgo_laco_quente(const std::string& ponto) const {
+    auto* c = pgo_contagem(ponto);
+    return c && c->second >= PGO_MINIMO && c->second >= 2 * c->first;
+}
+
+// Condição que pode ser emitida duas vezes (sem chamadas nem efeitos)
+static bool condicao_repetivel(const Expr& expr) {
+    return std::visit([](const auto& node) -> bool {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, NumberLit> || std::is_same_v<T, FloatLit> ||
+                      std::is_same_v<T, BoolLit> || std::is_same_v<T, VarExpr>) {
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, BinOpExpr> || std::is_same_v<T, CmpOpExpr> ||
+                           std::is_same_v<T, LogicOpExpr>) {
+            return condicao_repetivel(*node.left) && condicao_repetivel(*node.right);
+        }
+        else {
+            return false;
+        }
+    }, expr.node);
+}
+
+// ======================================================================
+// INLINE DE FOLHAS QUENTES (-pgo-usar)
+// ======================================================================
+
+void indexar_folhas_pgo(const Program& program) {
+    if (!pgo_) return;
+    auto folhas = std::make_shared<std::unordered_map<Sym, const FuncaoStmt*>>();
+    for (auto& stmt : program.statements) {
+        auto* f = std::get_if<FuncaoStmt>(&stmt->node);
+        if (!f || f->body.size() != 1) continue;
+        auto* ret = std::get_if<RetornaStmt>(&f->body[0]->node);
+        if (ret && ret->value) (*folhas)[f->name] = f;
+    }
+    pgo_folhas_ = std::move(folhas);
+}
+
+// Cópia da expressão com os parâmetros trocados pelos temporários, ou
+// nullptr se tem algo fora de literais, parâmetros e operadores (ou passa
+// de PGO_INLINE_NOS nós)
+ExprPtr pgo_clonar(const Expr& expr, const std::unordered_map<Sym, Sym>& nomes, int& nos) {
+    if (--nos < 0) return nullptr;
+    return std::visit([&](const auto& node) -> ExprPtr {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, NumberLit> || std::is_same_v<T, FloatLit> ||
+                      std::is_same_v<T, BoolLit>) {
+            return pgo_arena_.make<Expr>(node);
+        }
+        else if constexpr (std::is_same_v<T, VarExpr>) {
+            auto it = nomes.find(node.name);
+            if (it == nomes.end()) return nullptr;
+            return pgo_arena_.make<Expr>(VarExpr{it->second, node.line});
+        }
+        else if constexpr (std::is_same_v<T, BinOpExpr> || std::is_same_v<T, CmpOpExpr> ||
+                           std::is_same_v<T, LogicOpExpr>) {
+            ExprPtr l = pgo_clonar(*node.left, nomes, nos);
+            if (!l) return nullptr;
+            ExprPtr r = pgo_clonar(*node.right, nomes, nos);
+            if (!r) return nullptr;
+            return pgo_arena_.make<Expr>(T{node.op, std::move(l), std::move(r), node.line});
+        }
+        else {
+            return nullptr;
+        }
+    }, expr.node);
+}
+
+// Chamada quente de folha: args em temporários, expressão no lugar. Só
+// com os tipos com que a função é compilada (param_types) e o mesmo tipo
+// de retorno, para dar o mesmo valor que a chamada. Decimais ficam de
+// fora: o retorno decimal de função do usuário não passa pela chamada
+// do mesmo jeito que a expressão deixa em XMM0
+static bool tipo_inline(RuntimeType t) {
+    return t == RuntimeType::Int || t == RuntimeType::Bool;
+}
+
+bool emit_pgo_inline(const ChamadaExpr& node, const std::string& ponto) {
+    auto* c = pgo_contagem(ponto);
+    if (!c || c->first < PGO_MINIMO || !pgo_folhas_) return false;
+    auto fit = pgo_folhas_->find(node.name);
+    auto dit = declared_funcs_.find(node.name);
+    auto rit = func_return_types_.find(node.name);
+    if (fit == pgo_folhas_->end() || dit == declared_funcs_.end() ||
+        rit == func_return_types_.end() || !tipo_inline(rit->second)) return false;
+    const FuncaoStmt& folha = *fit->second;
+    if (node.args.size() != folha.params.size()) return false;
+
+    std::vector<RuntimeType> tipos;
+    auto& param_types = dit->second.param_types;
+    if (param_types.size() < node.args.size()) {
+        param_types.resize(node.args.size(), RuntimeType::Unknown);
+    }
+    for (size_t i = 0; i < node.args.size(); i++) {
+        RuntimeType t = infer_expr_type(*node.args[i]);
+        if (!tipo_inline(t)) return false;
+        if (param_types[i] == RuntimeType::Unknown) {
+            param_types[i] = t;      // o que avaliar_args_chamada registraria
+            tipos_mudaram();
+        }
+        if (param_types[i] != t) return false;
+        tipos.push_back(t);
+    }
+
+    std::string tag = "__inl_" + pos_tag() + "_";
+    std::unordered_map<Sym, Sym> nomes;
+    for (size_t i = 0; i < folha.params.size(); i++) {
+        Sym temp = Sym::intern(tag + folha.params[i].str());
+        nomes[folha.params[i]] = temp;
+        var_types_[temp] = tipos[i];
+    }
+    tipos_mudaram();
+    int nos = PGO_INLINE_NOS;
+    auto& ret = std::get<RetornaStmt>(folha.body[0]->node);
+    ExprPtr corpo = pgo_clonar(*ret.value, nomes, nos);
+    if (!corpo || infer_expr_type(*corpo) != rit->second) return false;
+
+    for (size_t i = 0; i < node.args.size(); i++) {
+        emit_expr(*node.args[i]);
+        emit_mov_rbp_reg(alloc_local(nomes[folha.params[i]]), reg::RAX);
+    }
+    emit_expr(*corpo);
+    pgo_inlinados_.push_back(std::move(corpo));
+    return true;
+}
+
+// ======================================================================
+// BLOCOS FRIOS
+// ======================================================================
+
+// Depois de `test rax, rax`: desvia para o bloco se verdadeiro e passa a
+// emitir em pgo_frio_ (linhas de depuração também vão para o bloco).
+// `cc` escolhe outra condição (o erro de índice de codegen_checagem usa jae)
+size_t pgo_abrir_frio(uint8_t cc = CC_NE) {
+    BlocoFrio b{};
+    b.desvio = emit_jcc_rel32(cc);
+    pgo_principal_ = text_;
+    text_ = &pgo_frio_;
+    std::swap(depuracao_.linhas, pgo_linhas_frio_);
+    b.inicio = text_->pos();
+    pgo_blocos_.push_back(b);
+    return pgo_blocos_.size() - 1;
+}
+
+void pgo_fechar_frio() {
+    pgo_blocos_.back().volta = emit_jmp_rel32();
+    std::swap(depuracao_.linhas, pgo_linhas_frio_);
+    text_ = pgo_principal_;
+}
+
+// Desvio raro: jcc `cc` para o código de `corpo`, que volta para logo
+// depois. Vai para um bloco frio; se já estamos num, fica no lugar,
+// pulado pela condição inversa (cc ^ 1)
+template <typename F>
+void emit_desvio_frio(uint8_t cc, F&& corpo) {
+    if (text_ == &pgo_frio_) {
+        size_t pula = emit_jcc_rel32(static_cast<uint8_t>(cc ^ 1));
+        corpo();
+        patch_jump(pula);
+        return;
+    }
+    pgo_abrir_frio(cc);
+    corpo();
+    pgo_fechar_frio();
+    pgo_blocos_.back().alvo = text_->pos();
+}
+
+// Fim da função: blocos frios depois do epílogo, saltos resolvidos
+void pgo_anexar_frio() {
+    if (pgo_blocos_.empty()) return;
+    size_t base = text_->pos();
+    text_->emit(pgo_frio_.data);
+    for (auto r : pgo_frio_.relocations) {
+        #ifdef _WIN32
+        r.virtual_address += static_cast<uint32_t>(base);
+        #else
+        r.offset += base;
+        #endif
+        text_->relocations.push_back(r);
+    }
+    for (auto& l : pgo_linhas_frio_) {
+        depuracao_.linha(static_cast<uint32_t>(base + l.offset), l.arquivo, l.linha);
+    }
+    for (auto& b : pgo_blocos_) {
+        text_->patch_i32(b.desvio, static_cast<int32_t>(base + b.inicio) -
+                                   static_cast<int32_t>(b.desvio + 4));
+        text_->patch_i32(base + b.volta, static_cast<int32_t>(b.alvo) -
+                                         static_cast<int32_t>(base + b.volta + 4));
+    }
+    pgo_frio_.data.clear();
+    pgo_frio_.relocations.clear();
+    pgo_blocos_.clear();
+    pgo_linhas_frio_.clear();
+}
+
+// ======================================================================
+// ORDEM DAS FUNÇÕES (-pgo-usar)
+// ======================================================================
+
+// Chamado logo depois de emitir as funções, antes de qualquer tabela que
+// guarde offsets de .text. Cada função (com os blocos frios dela) anda
+// inteira: saltos internos são relativos e chamadas passam por símbolo.
+void ordenar_funcoes_pgo(uint32_t inicio) {
+    if (!pgo_) return;
+#ifndef _WIN32
+    struct Trecho {
+        uint32_t inicio, fim;
+        uint64_t entradas;
+        uint32_t novo;
+    };
+    uint32_t fim = static_cast<uint32_t>(text_->pos());
+    std::vector<Trecho> trechos;
+    for (auto& f : depuracao_.funcoes) {
+        if (f.inicio >= inicio) trechos.push_back({f.inicio, f.fim, pgo_->entradas(f.nome), 0});
+    }
+    std::sort(trechos.begin(), trechos.end(),
+              [](const Trecho& a, const Trecho& b) { return a.inicio < b.inicio; });
+    if (trechos.empty() || trechos[0].inicio != inicio) return;
+    for (size_t i = 0; i < trechos.size(); i++) {
+        uint32_t proximo = i + 1 < trechos.size() ? trechos[i + 1].inicio : fim;
+        if (trechos[i].fim > proximo) return;
+        trechos[i].fim = proximo;    // padding entre funções vai junto
+    }
+
+    std::vector<size_t> ordem(trechos.size());
+    for (size_t i = 0; i < ordem.size(); i++) ordem[i] = i;
+    std::stable_sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) {
+        return trechos[a].entradas > trechos[b].entradas;
+    });
+    if (std::is_sorted(ordem.begin(), ordem.end())) return;
+
+    std::vector<uint8_t> dados(text_->data.begin(), text_->data.begin() + inicio);
+    for (size_t i : ordem) {
+        trechos[i].novo = static_cast<uint32_t>(dados.size());
+        dados.insert(dados.end(), text_->data.begin() + trechos[i].inicio,
+                     text_->data.begin() + trechos[i].fim);
+    }
+    text_->data = std::move(dados);
+
+    auto mover = [&](uint64_t off) -> uint64_t {
+        if (off < inicio || off >= fim) return off;
+        auto it = std::upper_bound(trechos.begin(), trechos.end(), off,
+                                   [](uint64_t o, const Trecho& t) { return o < t.inicio; });
+        --it;
+        return off - it->inicio + it->novo;
+    };
+
+    for (auto& r : text_->relocations) r.offset = mover(r.offset);
+    for (uint32_t i = 0; i < emitter_.symbol_count(); i++) {
+        auto& s = emitter_.symbol_at(i);
+        if (s.section_index == text_idx_ && s.type != STT_SECTION) {
+            emitter_.set_symbol_value(i, mover(s.value));
+        }
+    }
+    for (auto& l : depuracao_.linhas) l.offset = static_cast<uint32_t>(mover(l.offset));
+    std::stable_sort(depuracao_.linhas.begin(), depuracao_.linhas.end(),
+                     [](const LinhaDepuracao& a, const LinhaDepuracao& b) {
+                         return a.offset < b.offset;
+                     });
+    for (auto& f : depuracao_.funcoes) {
+        uint32_t tamanho = f.fim - f.inicio;
+        f.inicio = static_cast<uint32_t>(mover(f.inicio));
+        f.fim = f.inicio + tamanho;
+    }
+#else
+    (void)inicio;
+#endif
+}
+
+// ======================================================================
+// TABELA (-pgo-gerar)
+// ======================================================================
+
+// Chamado depois de todas as funções. Só existe no Linux: main.cpp
+// recusa -pgo-gerar no Windows.
+void emitir_tabela_pgo() {
+    if (!pgo_gerar_) return;
+#ifndef _WIN32
+    std::vector<std::string> simbolos;
+    for (uint32_t i = 0; i < emitter_.symbol_count(); i++) {
+        const std::string& nome = emitter_.symbol_at(i).name;
+        if (nome.compare(0, std::strlen(PGO_PREFIXO), PGO_PREFIXO) == 0) {
+            simbolos.push_back(nome);
+        }
+    }
+
+    std::filesystem::path fonte = source_path_.empty() ? diag_source_file_ : source_path_;
+    uint32_t saida = add_string(fonte.stem().string() + ".jpprof");
+
+    data_->align(8);
+    emitter_.add_global_symbol("__jp_pgo", data_idx_, static_cast<uint32_t>(data_->pos()));
+    data_->emit_u32(PGO_MAGICA);
+    data_->emit_u32(PGO_VERSAO);
+    data_->emit_u32(static_cast<uint32_t>(simbolos.size()));
+    data_->add_relocation(static_cast<uint32_t>(data_->pos()),
+                          emitter_.section_symbol(rdata_idx_), R_X86_64_PC32, saida);
+    data_->emit_u32(0);
+
+    for (auto& s : simbolos) {
+        std::string chave = s.substr(std::strlen(PGO_PREFIXO));
+        std::replace(chave.begin(), chave.end(), '/', ' ');
+        uint32_t str_off = add_string(chave);
+
+        emitter_.add_global_symbol(s, data_idx_, static_cast<uint32_t>(data_->pos()));
+        data_->emit_zeros(2 * 8);
+        data_->add_relocation(static_cast<uint32_t>(data_->pos()),
+                              emitter_.section_symbol(rdata_idx_), R_X86_64_PC32, str_off);
+        data_->emit_u32(0);
+        data_->emit_u32(0);
+    }
+#endif
+}
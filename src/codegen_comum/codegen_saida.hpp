@@ -269,9 +269,9 @@ void emit_saida_interp_var(const std::string& name) {
             }
         } else {
             // var.attr — variável que contém instância
-            auto vit = var_instance_class_.find(obj_name);
+            auto vit = var_instance_class_.find(Sym::intern(obj_name));
             if (vit != var_instance_class_.end()) {
-                auto cit = declared_classes_.find(vit->second);
+                auto cit = declared_classes_.find(Sym::intern(vit->second));
                 if (cit != declared_classes_.end()) {
                     attr_type = cit->second.get_attr_type(attr_name);
                     int32_t attr_off = cit->second.find_attr_offset(attr_name);
@@ -298,19 +298,19 @@ void emit_saida_interp_var(const std::string& name) {
 
             // Suporte a encadeamento: obj.sub.attr (múltiplos pontos)
             // Construir expressão AttrGetExpr em tempo de compilação
-            ExprPtr object_expr = std::make_unique<Expr>(VarExpr{obj_name, 0});
+            ExprPtr object_expr = scratch_arena_.make<Expr>(VarExpr{Sym::intern(obj_name), 0});
             size_t next_dot = attr_name.find('.');
             while (next_dot != std::string::npos) {
                 std::string current_attr = attr_name.substr(0, next_dot);
-                object_expr = std::make_unique<Expr>(AttrGetExpr{
-                    std::move(object_expr), current_attr, 0
+                object_expr = scratch_arena_.make<Expr>(AttrGetExpr{
+                    std::move(object_expr), Sym::intern(current_attr), 0
                 });
                 attr_name = attr_name.substr(next_dot + 1);
                 next_dot = attr_name.find('.');
             }
 
             Expr attr_expr(AttrGetExpr{
-                std::move(object_expr), attr_name, 0
+                std::move(object_expr), Sym::intern(attr_name), 0
             });
 
             RuntimeType type = infer_expr_type(attr_expr);
@@ -324,7 +324,7 @@ void emit_saida_interp_var(const std::string& name) {
         emit_saida_value(RuntimeType::Int);
     } else {
         // Variável simples por nome
-        auto it = var_types_.find(name);
+        auto it = var_types_.find(Sym::intern(name));
         RuntimeType type = (it != var_types_.end()) ? it->second : RuntimeType::Unknown;
         int32_t offset = find_local(name);
         if (type == RuntimeType::Float) {
@@ -0,0 +1,131 @@
+// codegen_tamanho.hpp
+// --tamanho: bytes de .text por função e por construção, .rodata e relocações
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Cada instrução (emit_stmt) e algumas construções dentro de expressões
+// (operações de lista, concatenação, diagnóstico FFI, checagem de limites)
+// são medidas pela posição do código antes e depois da emissão. A conta é
+// exclusiva: os bytes de uma medição aninhada saem da de fora, então a
+// soma por construção fecha com o .text. O bloco frio (codegen_pgo) é um
+// buffer à parte até o fim da função, e entra na medição de quem o abriu.
+//
+// No codegen paralelo cada fragmento mede o seu; entra no relatório quando
+// ele é juntado (mesmo caminho de tempos_funcoes_). .rodata e relocações
+// são lidas do objeto final, antes de separar_funcoes.
+
+// ======================================================================
+// ESTADO
+// ======================================================================
+
+bool tamanho_ = false;
+RelatorioTamanho tamanho_rel_;
+std::vector<uint64_t> tamanho_filhos_;   // bytes das medições aninhadas, por nível
+
+// ======================================================================
+// MEDIÇÃO
+// ======================================================================
+
+// Bytes emitidos até agora, contando o bloco frio ainda não anexado
+uint64_t bytes_emitidos() const {
+    const Section* principal = text_ == &pgo_frio_ ? pgo_principal_ : text_;
+    return principal->pos() + pgo_frio_.pos();
+}
+
+template <typename F>
+void medir_tamanho(const char* construcao, F&& corpo) {
+    if (!tamanho_) {
+        corpo();
+        return;
+    }
+    uint64_t inicio = bytes_emitidos();
+    tamanho_filhos_.push_back(0);
+    corpo();
+    uint64_t bytes = bytes_emitidos() - inicio;
+    tamanho_rel_.construcoes[construcao] += bytes - tamanho_filhos_.back();
+    tamanho_filhos_.pop_back();
+    if (!tamanho_filhos_.empty()) tamanho_filhos_.back() += bytes;
+}
+
+static const char* nome_instrucao(const Stmt& stmt) {
+    return std::visit([](const auto& node) -> const char* {
+        using T = std::decay_t<decltype(node)>;
+        if constexpr (std::is_same_v<T, AssignStmt>)        return "atribuicao";
+        else if constexpr (std::is_same_v<T, AttrSetStmt>)  return "auto.atributo =";
+        else if constexpr (std::is_same_v<T, SaidaStmt>)    return "saida";
+        else if constexpr (std::is_same_v<T, IfStmt>)       return "se";
+        else if constexpr (std::is_same_v<T, EnquantoStmt>) return "enquanto";
+        else if constexpr (std::is_same_v<T, RepetirStmt>)  return "repetir";
+        else if constexpr (std::is_same_v<T, ParaStmt>)     return "para";
+        else if constexpr (std::is_same_v<T, PararStmt> ||
+                           std::is_same_v<T, ContinuarStmt>) return "parar/continuar";
+        else if constexpr (std::is_same_v<T, RetornaStmt>)  return "retorna";
+        else if constexpr (std::is_same_v<T, IndexSetStmt>) return "indice =";
+        else if constexpr (std::is_same_v<T, ExprStmt>)     return "expressao";
+        else                                                return "outras instrucoes";
+    }, stmt.node);
+}
+
+void registrar_tamanho_funcao(const std::string& nome, size_t inicio) {
+    if (!tamanho_) return;
+    tamanho_rel_.funcoes.push_back({nome, text_->pos() - inicio});
+}
+
+// Fragmento do codegen paralelo: funções e construções (o .rodata dele
+// é reinserido no do pai, que conta no fim)
+void juntar_tamanho(const Codegen& frag) {
+    if (!tamanho_) return;
+    tamanho_rel_.funcoes.insert(tamanho_rel_.funcoes.end(),
+                                frag.tamanho_rel_.funcoes.begin(),
+                                frag.tamanho_rel_.funcoes.end());
+    for (auto& [nome, bytes] : frag.tamanho_rel_.construcoes) {
+        tamanho_rel_.construcoes[nome] += bytes;
+    }
+}
+
+// ======================================================================
+// FIM DA EMISSÃO: .text, .rodata e relocações do objeto
+// ======================================================================
+
+static std::string nome_relocacao(uint32_t tipo) {
+    #ifdef _WIN32
+    switch (tipo) {
+        case IMAGE_REL_AMD64_ADDR64:   return "ADDR64";
+        case IMAGE_REL_AMD64_ADDR32:   return "ADDR32";
+        case IMAGE_REL_AMD64_ADDR32NB: return "ADDR32NB";
+        case IMAGE_REL_AMD64_REL32:    return "REL32";
+        default: break;
+    }
+    #else
+    switch (tipo) {
+        case R_X86_64_64:    return "R_X86_64_64";
+        case R_X86_64_PC32:  return "R_X86_64_PC32";
+        case R_X86_64_PLT32: return "R_X86_64_PLT32";
+        case R_X86_64_32:    return "R_X86_64_32";
+        default: break;
+    }
+    #endif
+    return "tipo_" + std::to_string(tipo);
+}
+
+void fechar_tamanho() {
+    if (!tamanho_) return;
+    tamanho_rel_.texto = text_->pos();
+    tamanho_rel_.rodata = rdata_->pos();
+
+    // Entradas de string_offsets_: literal de texto (bytes + NUL na seção)
+    // ou constante double (chave "__dbl_<bits>")
+    const auto& dados = rdata_->data;
+    for (auto& [chave, off] : string_offsets_) {
+        bool texto = off + chave.size() < dados.size() &&
+                     std::memcmp(&dados[off], chave.data(), chave.size()) == 0 &&
+                     dados[off + chave.size()] == 0;
+        if (texto) tamanho_rel_.rodata_textos += chave.size() + 1;
+        else       tamanho_rel_.rodata_doubles += 8;
+    }
+    for (auto& [off, bytes] : tabelas_rdata_) tamanho_rel_.rodata_tabelas += bytes;
+
+    for (const Section* s : {text_, rdata_, data_}) {
+        for (auto& r : s->relocations) tamanho_rel_.relocacoes[nome_relocacao(r.type)]++;
+    }
+}
@@ -0,0 +1,401 @@
+// codegen_vetor.hpp
+// Vetorização de laços `para` elemento a elemento sobre listas (Linux)
+//
+// Incluido inline dentro da classe Codegen (mesmo padrao dos outros codegen_*.hpp).
+//
+// Vale para `para i em intervalo(a, b):` (passo 1) cujo corpo só tem
+// atribuições `c[i] = expr`, alguma lendo x[i], com expr feita de:
+//
+//   x[i]                  listas do mesmo tipo de elemento (Int ou Float)
+//   literal, variável     escalar que o laço não muda (não o próprio i)
+//   + -                   inteiros (não há mul de 64 bits no SSE2/AVX2)
+//   + - * /               floats, mesmos nós que iriam para emit_binop_float
+//
+// No Linux os elementos são valores diretos de 8 bytes, contíguos em
+// header->dados, e o corpo não chama nada: os ponteiros de dados ficam em
+// registradores e cada volta processa 2 elementos com SSE2 ou, com
+// -alvo=nativo numa CPU com AVX2, 4 (ymm, e vfmadd quando o escalar
+// também contrairia). O que sobra cai no laço escalar de sempre, que
+// continua do i onde o vetor parou.
+//
+// Antes do laço vetorial, checagens em tempo de execução mandam tudo para
+// o escalar: início negativo, alguma lista com menos que `fim` elementos,
+// ou uma lista escrita cujos dados começam a menos de uma volta de outra
+// (os elementos de uma volta não podem depender uns dos outros).
+// Com -pgo-* o laço fica escalar (contagem exata das voltas).
+
+// ======================================================================
+// RECONHECIMENTO
+// ======================================================================
+
+static constexpr uint8_t VET_BASES[] = {
+    reg::RDX, reg::RSI, reg::RDI, reg::R8, reg::R9, reg::R10, reg::R11
+};
+static constexpr uint8_t VET_XMM = 16;
+
+static bool cpu_tem_avx2() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+struct LacoVetor {
+    Sym var;
+    RuntimeType tipo = RuntimeType::Unknown;
+    std::vector<Sym> listas;                     // índice → VET_BASES
+    std::vector<Sym> escritas;
+    std::vector<const Expr*> invariantes;        // folhas escalares, de XMM15 para baixo
+    bool fma = false;
+};
+
+bool vet_avx() const { return alvo_nativo_ && cpu_tem_avx2(); }
+
+int vet_lista(LacoVetor& lv, Sym nome) {
+    for (size_t i = 0; i < lv.listas.size(); i++) {
+        if (lv.listas[i] == nome) return static_cast<int>(i);
+    }
+    if (lv.listas.size() == std::size(VET_BASES)) return -1;
+    lv.listas.push_back(nome);
+    return static_cast<int>(lv.listas.size() - 1);
+}
+
+// x[i] com x lista do tipo do laço
+bool vet_elemento(LacoVetor& lv, const Expr& e) {
+    auto* ig = std::get_if<IndexGetExpr>(&e.node);
+    if (!ig) return false;
+    auto* lista = std::get_if<VarExpr>(&ig->object->node);
+    auto* idx = std::get_if<VarExpr>(&ig->index->node);
+    if (!lista || !idx || idx->name != lv.var) return false;
+    if (!is_list_var(lista->name) || get_list_elem_type(lista->name) != lv.tipo) return false;
+    return vet_lista(lv, lista->name) >= 0;
+}
+
+bool vet_invariante(LacoVetor& lv, const Expr& e) {
+    if (auto* v = std::get_if<VarExpr>(&e.node)) {
+        if (v->name == lv.var || is_list_var(v->name)) return false;
+        RuntimeType t = infer_expr_type(e);
+        bool ok = t == RuntimeType::Int ||
+                  (lv.tipo == RuntimeType::Float && t == RuntimeType::Float);
+        if (!ok) return false;
+    } else if (std::holds_alternative<FloatLit>(e.node)) {
+        if (lv.tipo != RuntimeType::Float) return false;
+    } else if (!std::holds_alternative<NumberLit>(e.node)) {
+        return false;
+    }
+    lv.invariantes.push_back(&e);
+    return true;
+}
+
+// Confere a subárvore e registra listas e invariantes
+bool vet_expr(LacoVetor& lv, const Expr& e) {
+    if (vet_elemento(lv, e) || vet_invariante(lv, e)) return true;
+    auto* bin = std::get_if<BinOpExpr>(&e.node);
+    if (!bin) return false;
+    if (lv.tipo == RuntimeType::Float) {
+        if (bin->op == BinOp::Mod || float_no(e) != bin) return false;
+        if (auto fma = float_fma(*bin)) {
+            lv.fma = true;
+            return vet_expr(lv, *fma->c) && vet_expr(lv, *fma->prod->left) &&
+                   vet_expr(lv, *fma->prod->right);
+        }
+    } else {
+        if (bin->op != BinOp::Add && bin->op != BinOp::Sub) return false;
+        if (infer_expr_type(e) != RuntimeType::Int) return false;
+    }
+    return vet_expr(lv, *bin->left) && vet_expr(lv, *bin->right);
+}
+
+// Registradores de temporários (número de Ershov) de uma subárvore já conferida
+int vet_regs(const LacoVetor& lv, const Expr& e) {
+    auto* bin = std::get_if<BinOpExpr>(&e.node);
+    if (!bin) return 1;
+    if (lv.tipo == RuntimeType::Float) {
+        if (auto fma = float_fma(*bin)) {
+            return std::max({vet_regs(lv, *fma->c), vet_regs(lv, *fma->prod->left) + 1,
+                             vet_regs(lv, *fma->prod->right) + 2});
+        }
+    }
+    int l = vet_regs(lv, *bin->left);
+    int r = vet_regs(lv, *bin->right);
+    return l == r ? l + 1 : std::max(l, r);
+}
+
+// Algum x[var] na árvore de + - * /
+static bool le_elemento(const Expr& e, Sym var) {
+    if (auto* ig = std::get_if<IndexGetExpr>(&e.node)) {
+        auto* idx = std::get_if<VarExpr>(&ig->index->node);
+        return idx && idx->name == var;
+    }
+    auto* bin = std::get_if<BinOpExpr>(&e.node);
+    return bin && (le_elemento(*bin->left, var) || le_elemento(*bin->right, var));
+}
+
+// Filtro só de sintaxe, antes de qualquer consulta de tipo: passo 1 e
+// corpo feito só de `x[i] = ...` com o próprio i, lendo algum y[i]. A
+// grande maioria dos `para` sai aqui, sem montar LacoVetor
+static bool laco_candidato_vetor(const ParaStmt& node) {
+    if (node.body.empty()) return false;
+    if (node.step) {
+        auto* passo = std::get_if<NumberLit>(&node.step->node);
+        if (!passo || passo->value != 1) return false;
+    }
+    bool le_lista = false;
+    for (auto& stmt : node.body) {
+        auto* set = std::get_if<IndexSetStmt>(&stmt->node);
+        if (!set) return false;
+        auto* idx = std::get_if<VarExpr>(&set->index->node);
+        if (!idx || idx->name != node.var) return false;
+        le_lista = le_lista || le_elemento(*set->value, node.var);
+    }
+    return le_lista;
+}
+
+bool analisar_laco_vetor(const ParaStmt& node, LacoVetor& lv, int& temps) {
+    lv.var = node.var;
+    temps = 0;
+    for (auto& stmt : node.body) {
+        auto* set = std::get_if<IndexSetStmt>(&stmt->node);
+        if (!set || !is_list_var(set->name)) return false;
+        auto* idx = std::get_if<VarExpr>(&set->index->node);
+        if (!idx || idx->name != node.var) return false;
+        RuntimeType t = get_list_elem_type(set->name);
+        if (t != RuntimeType::Int && t != RuntimeType::Float) return false;
+        if (lv.tipo == RuntimeType::Unknown) lv.tipo = t;
+        if (t != lv.tipo || infer_expr_type(*set->value) != t) return false;
+        if (vet_lista(lv, set->name) < 0) return false;
+        if (std::find(lv.escritas.begin(), lv.escritas.end(), set->name) == lv.escritas.end()) {
+            lv.escritas.push_back(set->name);
+        }
+        if (!vet_expr(lv, *set->value)) return false;
+        temps = std::max(temps, vet_regs(lv, *set->value));
+    }
+    // FMA só existe junto com AVX; sem AVX2 o vetor não contrairia como o escalar
+    if (lv.fma && !vet_avx()) return false;
+    return temps + static_cast<int>(lv.invariantes.size()) <= VET_XMM;
+}
+
+// ======================================================================
+// INSTRUÇÕES PACKED — SSE2 (66 0F op) ou VEX.256.66 (AVX2)
+// ======================================================================
+
+// mapa 1 = 0F, 2 = 0F38; nds < 0 = sem segundo operando
+void emit_vet_prefixo(uint8_t mapa, bool w, uint8_t r, int nds, uint8_t b, uint8_t op) {
+    if (vet_avx()) {
+        text_->emit_u8(0xC4);
+        text_->emit_u8(static_cast<uint8_t>(((r >= 8) ? 0x00 : 0x80) | 0x40 |
+                                            ((b >= 8) ? 0x00 : 0x20) | mapa));
+        uint8_t v = nds < 0 ? 0 : static_cast<uint8_t>(nds);   // vvvv = 1111
+        text_->emit_u8(static_cast<uint8_t>((w ? 0x80 : 0x00) | ((~v & 0x0F) << 3) | 0x04 | 0x01));
+    } else {
+        text_->emit_u8(0x66);
+        uint8_t rex = static_cast<uint8_t>(0x40 | (w ? 0x08 : 0) | ((r >= 8) ? 0x04 : 0) | ((b >= 8) ? 0x01 : 0));
+        if (rex != 0x40) text_->emit_u8(rex);
+        text_->emit_u8(0x0F);
+        if (mapa == 2) text_->emit_u8(0x38);
+    }
+    text_->emit_u8(op);
+}
+
+// dst = dst op src (addpd 58, subpd 5C, mulpd 59, divpd 5E, paddq D4, psubq FB)
+void emit_vet_op(uint8_t op, uint8_t dst, uint8_t src) {
+    emit_vet_prefixo(1, false, dst, dst, src, op);
+    text_->emit_u8(static_cast<uint8_t>(0xC0 | ((dst & 7) << 3) | (src & 7)));
+}
+
+void emit_vet_mov(uint8_t dst, uint8_t src) {
+    emit_vet_prefixo(1, false, dst, -1, src, 0x28);   // MOVAPD
+    text_->emit_u8(static_cast<uint8_t>(0xC0 | ((dst & 7) << 3) | (src & 7)));
+}
+
+// MOVUPD x, [base + RAX*8] (0x10) / MOVUPD [base + RAX*8], x (0x11)
+void emit_vet_mem(uint8_t op, uint8_t x, uint8_t base) {
+    emit_vet_prefixo(1, false, x, -1, base, op);
+    text_->emit_u8(static_cast<uint8_t>(0x04 | ((x & 7) << 3)));
+    text_->emit_u8(static_cast<uint8_t>(0xC0 | (base & 7)));
+}
+
+// Escalar no lane 0 de x → todos os lanes
+void emit_vet_broadcast(uint8_t x, bool inteiro) {
+    if (vet_avx()) {
+        emit_vet_prefixo(2, false, x, -1, x, inteiro ? 0x59 : 0x19);   // VPBROADCASTQ / VBROADCASTSD
+    } else {
+        emit_vet_prefixo(1, false, x, x, x, inteiro ? 0x6C : 0x14);    // PUNPCKLQDQ / UNPCKLPD
+    }
+    text_->emit_u8(static_cast<uint8_t>(0xC0 | ((x & 7) << 3) | (x & 7)));
+}
+
+// VFM*231PD ymm — mesmos opcodes dos SD menos 1
+void emit_vet_fma(uint8_t opcode_sd, uint8_t dst, uint8_t src2, uint8_t src3) {
+    emit_vet_prefixo(2, true, dst, src2, src3, static_cast<uint8_t>(opcode_sd - 1));
+    text_->emit_u8(static_cast<uint8_t>(0xC0 | ((dst & 7) << 3) | (src3 & 7)));
+}
+
+// ======================================================================
+// EMISSÃO
+// ======================================================================
+
+uint8_t vet_base(const LacoVetor& lv, Sym nome) const {
+    auto it = std::find(lv.listas.begin(), lv.listas.end(), nome);
+    return VET_BASES[it - lv.listas.begin()];
+}
+
+uint8_t vet_registrador_invariante(const LacoVetor& lv, const Expr& e) const {
+    auto it = std::find(lv.invariantes.begin(), lv.invariantes.end(), &e);
+    return static_cast<uint8_t>(VET_XMM - 1 - (it - lv.invariantes.begin()));
+}
+
+// Valor de `e` (todos os lanes) em x<t>
+void emit_vet_expr(const LacoVetor& lv, const Expr& e, uint8_t t) {
+    if (auto* ig = std::get_if<IndexGetExpr>(&e.node)) {
+        emit_vet_mem(0x10, t, vet_base(lv, std::get<VarExpr>(ig->object->node).name));
+        return;
+    }
+    auto* bin = std::get_if<BinOpExpr>(&e.node);
+    if (!bin) {
+        emit_vet_mov(t, vet_registrador_invariante(lv, e));
+        return;
+    }
+    uint8_t u = static_cast<uint8_t>(t + 1);
+    if (lv.tipo == RuntimeType::Float) {
+        if (auto fma = float_fma(*bin)) {
+            emit_vet_expr(lv, *fma->c, t);
+            emit_vet_expr(lv, *fma->prod->left, u);
+            emit_vet_expr(lv, *fma->prod->right, static_cast<uint8_t>(t + 2));
+            emit_vet_fma(fma->opcode, t, u, static_cast<uint8_t>(t + 2));
+            return;
+        }
+    }
+    uint8_t op = 0;
+    bool comuta = bin->op == BinOp::Add || bin->op == BinOp::Mul;
+    if (lv.tipo == RuntimeType::Int) {
+        op = bin->op == BinOp::Add ? 0xD4 : 0xFB;
+    } else {
+        switch (bin->op) {
+            case BinOp::Add: op = 0x58; break;
+            case BinOp::Sub: op = 0x5C; break;
+            case BinOp::Mul: op = 0x59; break;
+            case BinOp::Div: op = 0x5E; break;
+            case BinOp::Mod: break;     // recusado na análise
+        }
+    }
+    if (vet_regs(lv, *bin->left) >= vet_regs(lv, *bin->right)) {
+        emit_vet_expr(lv, *bin->left, t);
+        emit_vet_expr(lv, *bin->right, u);
+        emit_vet_op(op, t, u);
+    } else {
+        emit_vet_expr(lv, *bin->right, t);
+        emit_vet_expr(lv, *bin->left, u);
+        if (comuta) {
+            emit_vet_op(op, t, u);
+        } else {
+            emit_vet_op(op, u, t);
+            emit_vet_mov(t, u);
+        }
+    }
+}
+
+// Antes do laço escalar de emit_para: i e fim já nos slots do frame
+void emit_para_vetor(const ParaStmt& node, int32_t var_off, int32_t end_off) {
+    if constexpr (PlatformDefs::is_windows) {
+        return;     // listas com tag de 16 bytes por elemento
+    } else {
+        if (pgo_ativo() || !laco_candidato_vetor(node)) return;
+        LacoVetor lv;
+        int temps = 0;
+        if (!analisar_laco_vetor(node, lv, temps)) return;
+        const int32_t lanes = vet_avx() ? 4 : 2;
+        std::vector<size_t> escalar;
+
+        // Checagens: 0 <= início, tamanho de cada lista >= fim
+        emit_mov_reg_rbp(reg::RAX, var_off);
+        emit_test_reg_reg(reg::RAX, reg::RAX);
+        escalar.push_back(emit_jcc_rel32(CC_L));
+        emit_mov_reg_rbp(reg::RCX, end_off);
+        for (size_t k = 0; k < lv.listas.size(); k++) {
+            uint8_t base = VET_BASES[k];
+            emit_mov_reg_rbp(base, find_local(lv.listas[k]));
+            emit_rex_w(reg::RAX, base);
+            text_->emit_u8(0x8B);
+            text_->emit_u8(static_cast<uint8_t>(0x40 | (base & 7)));
+            text_->emit_u8(static_cast<uint8_t>(LIST_OFF_COUNT));   // MOV RAX, [base+8]
+            emit_cmp_reg_reg(reg::RAX, reg::RCX);
+            escalar.push_back(emit_jcc_rel32(CC_L));
+            emit_rex_w(base, base);
+            text_->emit_u8(0x8B);
+            text_->emit_u8(static_cast<uint8_t>(((base & 7) << 3) | (base & 7)));   // MOV base, [base]
+        }
+
+        // Lista escrita começando a menos de uma volta de outra: escalar
+        for (Sym w : lv.escritas) {
+            uint8_t bw = vet_base(lv, w);
+            for (Sym x : lv.listas) {
+                if (x == w) continue;
+                emit_mov_reg_reg(reg::RAX, bw);
+                emit_sub_reg_reg(reg::RAX, vet_base(lv, x));
+                emit_rex_w(0, reg::RAX);
+                text_->emit_u8(0x83);
+                text_->emit_u8(0xC0);
+                text_->emit_u8(static_cast<uint8_t>(lanes * 8 - 8));  // ADD RAX, (lanes-1)*8
+                emit_cmp_reg_imm32(reg::RAX, lanes * 16 - 16);
+                size_t longe = emit_jcc_rel32(CC_A);
+                emit_cmp_reg_imm32(reg::RAX, lanes * 8 - 8);
+                escalar.push_back(emit_jne_rel32());          // mesmos dados: ok
+                patch_jump(longe);
+            }
+        }
+
+        // Invariantes em XMM15, XMM14, ... (todos os lanes)
+        bool inteiro = lv.tipo == RuntimeType::Int;
+        for (auto* e : lv.invariantes) {
+            uint8_t x = vet_registrador_invariante(lv, *e);
+            if (auto* f = std::get_if<FloatLit>(&e->node)) {
+                emit_load_double_imm(x, f->value);
+            } else if (auto* n = std::get_if<NumberLit>(&e->node)) {
+                if (inteiro) {
+                    emit_mov_reg_imm32(reg::RAX, n->value);
+                    emit_movq_xmm_gpr(x, reg::RAX);
+                } else {
+                    emit_load_double_imm(x, static_cast<double>(n->value));
+                }
+            } else if (inteiro) {
+                emit_mov_reg_rbp(reg::RAX, find_local(std::get<VarExpr>(e->node).name));
+                emit_movq_xmm_gpr(x, reg::RAX);
+            } else {
+                emit_float_folha(*e, x);        // movsd, ou cvtsi2sd de variável Int
+            }
+            emit_vet_broadcast(x, inteiro);
+        }
+
+        // Laço: i + lanes <= fim
+        emit_mov_reg_rbp(reg::RAX, var_off);
+        emit_mov_reg_rbp(reg::RCX, end_off);
+        emit_rex_w(0, reg::RCX);
+        text_->emit_u8(0x83);
+        text_->emit_u8(0xE9);
+        text_->emit_u8(static_cast<uint8_t>(lanes - 1));   // SUB RCX, lanes-1
+        size_t topo = text_->pos();
+        emit_cmp_reg_reg(reg::RAX, reg::RCX);
+        size_t sair = emit_jge_rel32();
+        for (auto& stmt : node.body) {
+            auto& set = std::get<IndexSetStmt>(stmt->node);
+            emit_vet_expr(lv, *set.value, xmm::XMM0);
+            emit_vet_mem(0x11, xmm::XMM0, vet_base(lv, set.name));
+        }
+        emit_rex_w(0, reg::RAX);
+        text_->emit_u8(0x83);
+        text_->emit_u8(0xC0);
+        text_->emit_u8(static_cast<uint8_t>(lanes));        // ADD RAX, lanes
+        text_->emit_u8(0xE9);
+        text_->emit_i32(static_cast<int32_t>(topo) - static_cast<int32_t>(text_->pos() + 4));
+        patch_jump(sair);
+        emit_mov_rbp_reg(var_off, reg::RAX);                // o escalar continua daqui
+        if (vet_avx()) {
+            text_->emit_u8(0xC5);
+            text_->emit_u8(0xF8);
+            text_->emit_u8(0x77);                           // VZEROUPPER
+        }
+        for (size_t p : escalar) patch_jump(p);
+    }
+}
@@ -0,0 +1,69 @@
+// depuracao.hpp
+// Tabela de linhas e extensão das funções de um objeto — base para as
+// informações de depuração (DWARF no Linux)
+//
+// O codegen registra, para cada statement, o offset em .text onde o
+// código dele começa e a linha/arquivo .jp de origem; para cada função,
+// o intervalo [inicio, fim) em .text. O backend transforma isso nas
+// seções de depuração do formato do objeto.
+
+#ifndef JPLANG_DEPURACAO_HPP
+#define JPLANG_DEPURACAO_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace jplang {
+
+struct LinhaDepuracao {
+    uint32_t offset;       // em .text
+    uint32_t arquivo;      // índice em InfoDepuracao::arquivos
+    uint32_t linha;
+};
+
+struct FuncaoDepuracao {
+    std::string nome;
+    uint32_t inicio;       // [inicio, fim) em .text
+    uint32_t fim;
+    uint32_t arquivo;
+    uint32_t linha;
+};
+
+// Pedaço de .text que virou seção própria (.text.<funcao>, Linux)
+struct TrechoDepuracao {
+    size_t secao;          // índice da seção no emitter
+    uint32_t inicio;       // [inicio, fim) nos offsets de .text acima
+    uint32_t fim;
+};
+
+struct InfoDepuracao {
+    std::string unidade;                  // fonte que dá nome ao objeto
+    std::string diretorio;                // diretório de compilação
+    std::vector<std::string> arquivos;    // caminhos absolutos dos .jp
+    std::vector<LinhaDepuracao> linhas;   // offsets crescentes
+    std::vector<FuncaoDepuracao> funcoes;
+    std::vector<TrechoDepuracao> trechos; // vazio = tudo numa seção .text
+
+    uint32_t arquivo(const std::string& caminho) {
+        for (size_t i = 0; i < arquivos.size(); i++) {
+            if (arquivos[i] == caminho) return static_cast<uint32_t>(i);
+        }
+        arquivos.push_back(caminho);
+        return static_cast<uint32_t>(arquivos.size() - 1);
+    }
+
+    // Um statement que não gerou código é sobrescrito pelo seguinte;
+    // linhas repetidas em sequência viram uma só entrada
+    void linha(uint32_t offset, uint32_t arq, uint32_t ln) {
+        if (ln == 0) return;
+        if (!linhas.empty() && linhas.back().offset == offset) linhas.pop_back();
+        if (!linhas.empty() && linhas.back().arquivo == arq && linhas.back().linha == ln) return;
+        linhas.push_back({offset, arq, ln});
+    }
+};
+
+} // namespace jplang
+
+#endif // JPLANG_DEPURACAO_HPP
@@ -0,0 +1,73 @@
+// arena.hpp
+// Arena de alocação da AST
+//
+// Os nós Expr/Stmt são alocados em blocos contíguos (bump allocation) em
+// vez de um new por nó: a árvore fica compacta na memória e liberar o
+// programa inteiro é liberar meia dúzia de blocos. ExprPtr/StmtPtr
+// continuam sendo unique_ptr, mas o deleter só roda o destrutor — a
+// memória volta quando a arena é destruída.
+
+#ifndef JPLANG_ARENA_HPP
+#define JPLANG_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace jplang {
+
+// Deleter dos nós da AST: destrói, não libera
+struct AstDelete {
+    template <typename T>
+    void operator()(T* p) const { p->~T(); }
+};
+
+class AstArena {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    AstArena() = default;
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    void* allocate(size_t size, size_t align) {
+        size_t pad = (align - (reinterpret_cast<uintptr_t>(cur_) & (align - 1))) & (align - 1);
+        if (pad + size > left_) {
+            size_t block = size + align > BLOCK_SIZE ? size + align : BLOCK_SIZE;
+            blocks_.push_back(std::make_unique<char[]>(block));
+            cur_ = blocks_.back().get();
+            left_ = block;
+            pad = (align - (reinterpret_cast<uintptr_t>(cur_) & (align - 1))) & (align - 1);
+        }
+        char* p = cur_ + pad;
+        cur_ = p + size;
+        left_ -= pad + size;
+        bytes_ += size;
+        return p;
+    }
+
+    template <typename T, typename... Args>
+    std::unique_ptr<T, AstDelete> make(Args&&... args) {
+        void* mem = allocate(sizeof(T), alignof(T));
+        nodes_++;
+        return std::unique_ptr<T, AstDelete>(new (mem) T(std::forward<Args>(args)...));
+    }
+
+    size_t bytes_used() const { return bytes_; }
+    size_t node_count() const { return nodes_; }
+    size_t block_count() const { return blocks_.size(); }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cur_ = nullptr;
+    size_t left_ = 0;
+    size_t bytes_ = 0;
+    size_t nodes_ = 0;
+};
+
+} // namespace jplang
+
+#endif // JPLANG_ARENA_HPP
@@ -8,6 +8,9 @@
 #include <vector>
 #include <memory>
 #include <variant>
+#include <cstdint>
+#include "arena.hpp"
+#include "simbolos.hpp"
 
 namespace jplang {
 
@@ -50,6 +53,26 @@ enum class VarType {
     Nativo
 };
 
+// ============================================================================
+// TIPO EM TEMPO DE COMPILAÇÃO (para type tracking simples)
+// ============================================================================
+
+enum class RuntimeType {
+    Int,
+    Float,
+    String,
+    Bool,
+    Null,
+    Unknown
+};
+
+// Anotação de tipo gravada no nó pelo codegen (Codegen::infer_expr_type).
+// Vale enquanto `epoca` for a época de tipos corrente; 0 = não anotado.
+struct TipoAnotado {
+    uint32_t epoca = 0;
+    RuntimeType tipo = RuntimeType::Unknown;
+};
+
 // ============================================================================
 // CORES (para saída)
 // ============================================================================
@@ -69,8 +92,9 @@ enum class Cor : int {
 struct Expr;
 struct Stmt;
 
-using ExprPtr = std::unique_ptr<Expr>;
-using StmtPtr = std::unique_ptr<Stmt>;
+// Nós vivem na AstArena do Program (ver arena.hpp)
+using ExprPtr = std::unique_ptr<Expr, AstDelete>;
+using StmtPtr = std::unique_ptr<Stmt, AstDelete>;
 using StmtList = std::vector<StmtPtr>;
 
 // ============================================================================
@@ -114,7 +138,7 @@ struct NullLit {
 };
 
 struct VarExpr {
-    std::string name;
+    Sym name;
     int line;
 };
 
@@ -146,20 +170,20 @@ struct ConcatExpr {
 };
 
 struct ChamadaExpr {
-    std::string name;
+    Sym name;
     std::vector<ExprPtr> args;
     int line;
 };
 
 struct AttrGetExpr {
     ExprPtr object;
-    std::string attr;
+    Sym attr;
     int line;
 };
 
 struct MetodoChamadaExpr {
     ExprPtr object;
-    std::string method;
+    Sym method;
     std::vector<ExprPtr> args;
     int line;
 };
@@ -203,6 +227,7 @@ struct Expr {
         ListLitExpr,
         IndexGetExpr
     > node;
+    mutable TipoAnotado tipo;
 
     template <typename T>
     Expr(T&& val) : node(std::forward<T>(val)) {}
@@ -213,14 +238,14 @@ struct Expr {
 // ============================================================================
 
 struct AssignStmt {
-    std::string name;
+    Sym name;
     ExprPtr value;
     int line;
 };
 
 struct AttrSetStmt {
     ExprPtr object;
-    std::string attr;
+    Sym attr;
     ExprPtr value;
     int line;
 };
@@ -256,7 +281,7 @@ struct EnquantoStmt {
 };
 
 struct ParaStmt {
-    std::string var;
+    Sym var;
     ExprPtr start;
     ExprPtr end;
     ExprPtr step;           // pode ser nullptr (default = 1)
@@ -278,14 +303,14 @@ struct RetornaStmt {
 };
 
 struct FuncaoStmt {
-    std::string name;
-    std::vector<std::string> params;
+    Sym name;
+    std::vector<Sym> params;
     StmtList body;
     int line;
 };
 
 struct ClasseStmt {
-    std::string name;
+    Sym name;
     StmtList body;          // métodos (FuncaoStmt)
     int line;
 };
@@ -303,7 +328,7 @@ struct ExprStmt {
 };
 
 struct IndexSetStmt {
-    std::string name;
+    Sym name;
     ExprPtr index;
     ExprPtr value;
     int line;
@@ -336,12 +361,28 @@ struct Stmt {
     Stmt(T&& val) : node(std::forward<T>(val)) {}
 };
 
+// ============================================================================
+// MÓDULO IMPORTADO (importar "arquivo.jp")
+// As declarações continuam em Program::statements; aqui fica só quem é
+// dono de cada função/classe, para o codegen poder compilar o módulo
+// num objeto separado.
+// ============================================================================
+
+struct ModuloFonte {
+    std::string caminho;               // caminho canônico do .jp
+    std::vector<std::string> funcoes;  // funções declaradas no próprio arquivo
+    std::vector<std::string> classes;  // classes declaradas no próprio arquivo
+    bool puro = true;                  // só funcao/classe/importar no topo
+};
+
 // ============================================================================
 // PROGRAMA (nó raiz)
 // ============================================================================
 
 struct Program {
+    std::shared_ptr<AstArena> arena;   // dona dos nós; destruída por último
     StmtList statements;
+    std::vector<ModuloFonte> modulos;  // imports .jp, dependências primeiro
 };
 
 // ============================================================================
@@ -349,13 +390,13 @@ struct Program {
 // ============================================================================
 
 template <typename T, typename... Args>
-ExprPtr make_expr(Args&&... args) {
-    return std::make_unique<Expr>(T{std::forward<Args>(args)...});
+ExprPtr make_expr(AstArena& arena, Args&&... args) {
+    return arena.make<Expr>(T{std::forward<Args>(args)...});
 }
 
 template <typename T, typename... Args>
-StmtPtr make_stmt(Args&&... args) {
-    return std::make_unique<Stmt>(T{std::forward<Args>(args)...});
+StmtPtr make_stmt(AstArena& arena, Args&&... args) {
+    return arena.make<Stmt>(T{std::forward<Args>(args)...});
 }
 
 } // namespace jplang
@@ -5,10 +5,14 @@
 #define JPLANG_LEXER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <algorithm>
 #include <unordered_map>
 #include <stdexcept>
 #include <fstream>
+#include <cstdint>
 
 namespace jplang {
 
@@ -90,32 +94,44 @@ enum class TK {
 
 // ============================================================================
 // PARTE DE INTERPOLAÇÃO (para STRING_INTERP)
+// Fica numa tabela lateral do lexer; o token guarda só o intervalo.
 // ============================================================================
 
 struct TokenInterpPart {
     bool is_var;                // true = variável, false = texto
-    std::string value;
+    std::string_view value;
+};
+
+struct TokenInterpRange {
+    const TokenInterpPart* first;
+    const TokenInterpPart* last;
+    const TokenInterpPart* begin() const { return first; }
+    const TokenInterpPart* end() const { return last; }
 };
 
 // ============================================================================
 // TOKEN
+// `value` é uma view: aponta para o buffer do fonte (identificadores,
+// números, strings sem escape) ou para memória do próprio lexer (strings
+// com escape, nomes internos de builtins). Vale enquanto o lexer existir.
 // ============================================================================
 
 struct Token {
     TK type;
-    std::string value;
+    std::string_view value;
     int line;
 
-    // Partes de interpolação (só usado quando type == STRING_INTERP)
-    std::vector<TokenInterpPart> interp_parts;
+    // Intervalo na tabela de interpolação (só quando type == STRING_INTERP)
+    uint32_t interp_first = 0;
+    uint32_t interp_count = 0;
 
-    Token() : type(TK::TK_EOF), value(""), line(1) {}
+    Token() : type(TK::TK_EOF), value(), line(1) {}
 
-    Token(TK type, const std::string& value, int line)
+    Token(TK type, std::string_view value, int line)
         : type(type), value(value), line(line) {}
 
-    Token(TK type, std::vector<TokenInterpPart>&& parts, int line)
-        : type(type), value(""), line(line), interp_parts(std::move(parts)) {}
+    Token(TK type, uint32_t first, uint32_t count, int line)
+        : type(type), value(), line(line), interp_first(first), interp_count(count) {}
 };
 
 // ============================================================================
@@ -180,6 +196,80 @@ inline TK tk_from_internal_name(const std::string& name) {
     return TK::IDENT;
 }
 
+// ============================================================================
+// TABELA DE PALAVRAS (hash perfeito)
+// Gerada quando o JSON de idioma é carregado: palavras-chave e builtins
+// ficam numa tabela em que cada palavra ocupa um slot exclusivo, então
+// classificar um identificador custa um hash e uma comparação.
+// ============================================================================
+
+struct WordEntry {
+    std::string word;
+    TK type = TK::IDENT;        // IDENT = não é palavra-chave
+    std::string builtin;        // nome interno, se for builtin
+};
+
+class WordTable {
+public:
+    void build(const std::unordered_map<std::string, TK>& keywords,
+               const std::unordered_map<std::string, std::string>& builtins) {
+        std::vector<WordEntry> entries;
+        for (auto& [word, tk] : keywords) entries.push_back({word, tk, ""});
+        for (auto& [word, internal] : builtins) {
+            bool found = false;
+            for (auto& e : entries) {
+                if (e.word == word) { e.builtin = internal; found = true; break; }
+            }
+            if (!found) entries.push_back({word, TK::IDENT, internal});
+        }
+
+        // Procura uma semente sem colisões; se não achar, dobra a tabela
+        size_t size = 16;
+        while (size < entries.size() * 4) size *= 2;
+        for (;;) {
+            std::vector<int> used(size);
+            for (uint32_t seed = 1; seed <= 4096; seed++) {
+                std::fill(used.begin(), used.end(), -1);
+                bool ok = true;
+                for (size_t i = 0; i < entries.size() && ok; i++) {
+                    int& slot = used[hash(entries[i].word, seed) & (size - 1)];
+                    ok = slot < 0;
+                    slot = static_cast<int>(i);
+                }
+                if (!ok) continue;
+                slots_.assign(size, WordEntry{});
+                for (size_t i = 0; i < size; i++) {
+                    if (used[i] >= 0) slots_[i] = std::move(entries[used[i]]);
+                }
+                mask_ = static_cast<uint32_t>(size - 1);
+                seed_ = seed;
+                return;
+            }
+            size *= 2;
+        }
+    }
+
+    const WordEntry* find(std::string_view word) const {
+        if (slots_.empty() || word.empty()) return nullptr;
+        const WordEntry& e = slots_[hash(word, seed_) & mask_];
+        return e.word == word ? &e : nullptr;
+    }
+
+private:
+    std::vector<WordEntry> slots_;
+    uint32_t mask_ = 0;
+    uint32_t seed_ = 0;
+
+    static uint32_t hash(std::string_view s, uint32_t seed) {
+        uint32_t h = seed * 0x9E3779B9u ^ static_cast<uint32_t>(s.size());
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x01000193u;
+        }
+        return h ^ (h >> 16);
+    }
+};
+
 // ============================================================================
 // CONFIGURAÇÃO DE IDIOMA
 // ============================================================================
@@ -191,6 +281,9 @@ struct LangConfig {
     // builtins: palavra_no_idioma → nome_interno (ex: "entrada" → "entrada")
     std::unordered_map<std::string, std::string> builtins;
 
+    // keywords + builtins em hash perfeito (usado pelo lexer)
+    WordTable words;
+
     // saida
     std::string saida_prefix = "saida";
     std::string saida_no_newline_suffix = "l";
@@ -210,6 +303,10 @@ struct LangConfig {
     // ex (PT): "verdadeiro" / "falso", (ES): "verdadero" / "falso", (EN): "true" / "false"
     std::string bool_true = "verdadeiro";
     std::string bool_false = "falso";
+
+    // Caminho do JSON de idioma efetivamente lido (vazio = padrão embutido).
+    // Usado pelo cache de build como dependência.
+    std::string arquivo;
     std::string null_keyword = "nulo";
 
     // Mapa de cor interna → Cor (para o parser)
@@ -318,6 +415,7 @@ inline LangConfig load_lang_config(const std::string& lang_name, const std::stri
             json_content = std::string(
                 (std::istreambuf_iterator<char>(file)),
                 std::istreambuf_iterator<char>());
+            config.arquivo = path;
             break;
         }
     }
@@ -337,6 +435,7 @@ inline LangConfig load_lang_config(const std::string& lang_name, const std::stri
             {"lista", "lista"}, {"objeto", "objeto"},
             {"ponteiro", "ponteiro"}, {"nulo", "nulo"}
         };
+        config.words.build(config.keywords, config.builtins);
         return config;
     }
 
@@ -418,6 +517,7 @@ inline LangConfig load_lang_config(const std::string& lang_name, const std::stri
         }
     }
 
+    config.words.build(config.keywords, config.builtins);
     return config;
 }
 
@@ -427,7 +527,7 @@ inline LangConfig load_lang_config(const std::string& lang_name, const std::stri
 // Retorna o nome do idioma e a posição após a flag
 // ============================================================================
 
-inline std::string detect_lang_flag(const std::string& source, size_t& skip_pos) {
+inline std::string detect_lang_flag(std::string_view source, size_t& skip_pos) {
     skip_pos = 0;
     size_t pos = 0;
 
@@ -470,13 +570,15 @@ inline std::string detect_lang_flag(const std::string& source, size_t& skip_pos)
 // LEXER
 // ============================================================================
 
+// O lexer não copia o fonte: `source` (normalmente um SourceBuffer
+// mapeado) precisa viver mais que o lexer e os tokens que ele produz.
 class Lexer {
 public:
     // Construtor padrão: detecta idioma pela flag $idioma na primeira linha
-    explicit Lexer(const std::string& source, const std::string& base_dir = "")
+    explicit Lexer(std::string_view source, const std::string& base_dir = "")
         : src_(source), pos_(0), line_(1),
           pending_dedents_(0), at_line_start_(true), pending_newline_(false),
-          bracket_depth_(0)
+          bracket_depth_(0), config_(&own_config_)
     {
         indent_stack_.push_back(0);
         // Pular UTF-8 BOM se presente (EF BB BF)
@@ -490,7 +592,7 @@ public:
         // Detectar flag de idioma
         size_t skip = 0;
         std::string lang = detect_lang_flag(src_, skip);
-        lang_config_ = load_lang_config(lang, base_dir);
+        own_config_ = load_lang_config(lang, base_dir);
 
         // Se encontrou flag, pular a linha da flag
         if (lang != "portugues" && skip > 0) {
@@ -500,11 +602,12 @@ public:
         }
     }
 
-    // Construtor com config pré-carregada (usado por sub-parsers de interpolação)
-    Lexer(const std::string& source, const LangConfig& config)
+    // Construtor com config pré-carregada (sub-parsers de interpolação e
+    // imports); a config é referenciada, não copiada
+    Lexer(std::string_view source, const LangConfig& config)
         : src_(source), pos_(0), line_(1),
           pending_dedents_(0), at_line_start_(true), pending_newline_(false),
-          bracket_depth_(0), lang_config_(config)
+          bracket_depth_(0), config_(&config)
     {
         indent_stack_.push_back(0);
         if (src_.size() >= 3 &&
@@ -515,8 +618,17 @@ public:
         }
     }
 
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
+
     // Acesso à configuração de idioma (para o parser)
-    const LangConfig& lang_config() const { return lang_config_; }
+    const LangConfig& lang_config() const { return *config_; }
+
+    // Partes de um token STRING_INTERP
+    TokenInterpRange interp_parts(const Token& tk) const {
+        const TokenInterpPart* first = interp_parts_.data() + tk.interp_first;
+        return {first, first + tk.interp_count};
+    }
 
     // ========================================================================
     // PRÓXIMO TOKEN
@@ -727,11 +839,11 @@ public:
             return next();
         }
         advance();
-        return Token(TK::ERROR, std::string(1, c), line_);
+        return Token(TK::ERROR, src_.substr(pos_ - 1, 1), line_);
     }
 
 private:
-    std::string src_;
+    std::string_view src_;
     size_t pos_;
     int line_;
     std::vector<int> indent_stack_;
@@ -739,7 +851,16 @@ private:
     bool at_line_start_;
     bool pending_newline_;
     int bracket_depth_;             // profundidade de ( ) [ ] — suprime NEWLINE/INDENT/DEDENT quando > 0
-    LangConfig lang_config_;        // configuração do idioma ativo
+    LangConfig own_config_;         // config carregada por este lexer (construtor padrão)
+    const LangConfig* config_;      // configuração do idioma ativo
+    std::vector<TokenInterpPart> interp_parts_;  // tabela lateral de interpolação
+    std::deque<std::string> owned_text_;         // textos que não existem no fonte
+
+    // Guarda um texto decodificado; a view continua válida (deque não move)
+    std::string_view store(std::string&& text) {
+        owned_text_.push_back(std::move(text));
+        return owned_text_.back();
+    }
 
     // ========================================================================
     // AUXILIARES
@@ -865,7 +986,59 @@ private:
     // SCANNERS
     // ========================================================================
 
+    // Texto literal de uma string: view direto do fonte enquanto não
+    // aparece escape; a partir do primeiro escape, decodifica numa cópia
+    struct TextRun {
+        size_t start = 0;
+        bool escaped = false;
+        std::string decoded;
+    };
+
+    std::string_view take_text(TextRun& run) {
+        std::string_view v = run.escaped ? store(std::move(run.decoded))
+                                         : src_.substr(run.start, pos_ - run.start);
+        run.decoded.clear();
+        run.escaped = false;
+        return v;
+    }
+
+    // Escapes: \n \t \r \\ \" \{ \}
+    void scan_escape(TextRun& run) {
+        if (!run.escaped) {
+            run.decoded.assign(src_.substr(run.start, pos_ - run.start));
+            run.escaped = true;
+        }
+        advance();
+        char ch = peek();
+        switch (ch) {
+            case 'n':  run.decoded += '\n'; break;
+            case 't':  run.decoded += '\t'; break;
+            case 'r':  run.decoded += '\r'; break;
+            case '\\': run.decoded += '\\'; break;
+            case '"':  run.decoded += '"';  break;
+            case '{':  run.decoded += '{';  break;
+            case '}':  run.decoded += '}';  break;
+            default:   run.decoded += '\\'; run.decoded += ch; break;
+        }
+        advance();
+    }
+
     Token scan_string() {
+        uint32_t first = static_cast<uint32_t>(interp_parts_.size());
+        bool has_interp = false;
+        TextRun run;
+
+        auto finish = [&](std::string_view text) {
+            if (!has_interp) return Token(TK::STRING, text, line_);
+            if (!text.empty()) interp_parts_.push_back({false, text});
+            return Token(TK::STRING_INTERP, first,
+                         static_cast<uint32_t>(interp_parts_.size()) - first, line_);
+        };
+        auto fail = [&](std::string_view msg) {
+            interp_parts_.resize(first);
+            return Token(TK::ERROR, msg, line_);
+        };
+
         // Verifica se é string multilinha (""")
         // pos_ aponta para o primeiro ". Precisamos de mais 2 aspas consecutivas.
         if ((pos_ + 2) < src_.size() && src_[pos_] == '"' &&
@@ -878,39 +1051,19 @@ private:
             // Pula newline imediato após """ (opcional)
             if (!at_end() && peek() == '\r') advance();
             if (!at_end() && peek() == '\n') { advance(); line_++; }
-
-            std::string value;
-            bool has_interp = false;
-            std::vector<TokenInterpPart> parts;
+            run.start = pos_;
 
             while (!at_end()) {
                 // Verifica fechamento """
                 if (peek() == '"' && (pos_ + 1) < src_.size() && src_[pos_ + 1] == '"'
                     && (pos_ + 2) < src_.size() && src_[pos_ + 2] == '"') {
+                    std::string_view text = take_text(run);
                     advance(); advance(); advance(); // pula """
-
-                    if (has_interp) {
-                        if (!value.empty()) parts.push_back({false, value});
-                        return Token(TK::STRING_INTERP, std::move(parts), line_);
-                    }
-                    return Token(TK::STRING, value, line_);
+                    return finish(text);
                 }
 
-                // Escapes: \n \t \r \\ \" \{ \}
                 if (peek() == '\\' && (pos_ + 1) < src_.size()) {
-                    advance();
-                    char ch = peek();
-                    switch (ch) {
-                        case 'n':  value += '\n'; break;
-                        case 't':  value += '\t'; break;
-                        case 'r':  value += '\r'; break;
-                        case '\\': value += '\\'; break;
-                        case '"':  value += '"';  break;
-                        case '{':  value += '{';  break;
-                        case '}':  value += '}';  break;
-                        default:   value += '\\'; value += ch; break;
-                    }
-                    advance();
+                    scan_escape(run);
                     continue;
                 }
 
@@ -930,120 +1083,87 @@ private:
 
                     if (valid_ident) {
                         has_interp = true;
-                        if (!value.empty()) { parts.push_back({false, value}); value.clear(); }
+                        std::string_view text = take_text(run);
+                        if (!text.empty()) interp_parts_.push_back({false, text});
                         advance(); // pula {
-                        std::string var_name;
-                        while (!at_end() && peek() != '}') var_name += advance();
+                        size_t name_start = pos_;
+                        while (!at_end() && peek() != '}') advance();
+                        interp_parts_.push_back({true, src_.substr(name_start, pos_ - name_start)});
                         advance(); // pula }
-                        parts.push_back({true, var_name});
+                        run.start = pos_;
                         continue;
                     }
                     // Não é interpolação, trata { como texto literal
                 }
 
                 if (peek() == '\n') line_++;
-                value += peek();
+                if (run.escaped) run.decoded += peek();
                 advance();
             }
-            return Token(TK::ERROR, "String multilinha não terminada", line_);
+            return fail("String multilinha não terminada");
         }
 
         // String simples "..."
         advance();  // pula "
-        std::string value;
-        bool has_interp = false;
-        std::vector<TokenInterpPart> parts;
+        run.start = pos_;
 
         while (!at_end() && peek() != '"') {
             if (peek() == '\\' && (pos_ + 1) < src_.size()) {
-                advance();
-                char ch = peek();
-                switch (ch) {
-                    case 'n':  value += '\n'; break;
-                    case 't':  value += '\t'; break;
-                    case 'r':  value += '\r'; break;
-                    case '\\': value += '\\'; break;
-                    case '"':  value += '"';  break;
-                    case '{':  value += '{';  break;
-                    case '}':  value += '}';  break;
-                    default:   value += '\\'; value += ch; break;
-                }
-                advance();
+                scan_escape(run);
                 continue;
             }
 
             if (peek() == '{') {
                 has_interp = true;
                 // Salva texto acumulado
-                if (!value.empty()) {
-                    parts.push_back({false, value});
-                    value.clear();
-                }
+                std::string_view text = take_text(run);
+                if (!text.empty()) interp_parts_.push_back({false, text});
                 advance();  // pula {
-                std::string var_name;
-                while (!at_end() && peek() != '}') {
-                    var_name += advance();
-                }
+                size_t name_start = pos_;
+                while (!at_end() && peek() != '}') advance();
                 if (at_end()) {
-                    return Token(TK::ERROR, "Interpolação não terminada", line_);
+                    return fail("Interpolação não terminada");
                 }
+                interp_parts_.push_back({true, src_.substr(name_start, pos_ - name_start)});
                 advance();  // pula }
-                parts.push_back({true, var_name});
+                run.start = pos_;
                 continue;
             }
 
-            value += peek();
+            if (run.escaped) run.decoded += peek();
             advance();
         }
 
         if (at_end()) {
-            return Token(TK::ERROR, "String não terminada", line_);
+            return fail("String não terminada");
         }
+        std::string_view text = take_text(run);
         advance();  // pula " final
-
-        if (has_interp) {
-            // Salva texto restante
-            if (!value.empty()) {
-                parts.push_back({false, value});
-            }
-            return Token(TK::STRING_INTERP, std::move(parts), line_);
-        }
-
-        return Token(TK::STRING, value, line_);
+        return finish(text);
     }
 
     Token scan_number() {
-        std::string value;
-        while (is_digit(peek())) {
-            value += advance();
-        }
+        size_t start = pos_;
+        while (is_digit(peek())) advance();
         if (peek() == '.' && is_digit(peek_next())) {
-            value += advance();  // pula .
-            while (is_digit(peek())) {
-                value += advance();
-            }
+            advance();  // pula .
+            while (is_digit(peek())) advance();
         }
-        return Token(TK::NUMBER, value, line_);
+        return Token(TK::NUMBER, src_.substr(start, pos_ - start), line_);
     }
 
     Token scan_ident() {
-        std::string value;
+        size_t start = pos_;
         while (is_alnum(peek()) || peek() == '_' || is_utf8_lead(peek()) || is_utf8_cont(peek())) {
-            value += advance();
-        }
-
-        // Verificar keywords do idioma configurado
-        auto& kw = lang_config_.keywords;
-        auto it = kw.find(value);
-        if (it != kw.end()) {
-            return Token(it->second, value, line_);
+            advance();
         }
+        std::string_view value = src_.substr(start, pos_ - start);
 
-        // Verificar builtins: traduzir para nome interno
-        // Ex: "entrada" (espanhol) → "entrada" (interno), "input" (inglês) → "entrada"
-        auto bit = lang_config_.builtins.find(value);
-        if (bit != lang_config_.builtins.end()) {
-            return Token(TK::IDENT, bit->second, line_);
+        // Palavras-chave do idioma e builtins (traduzidos para o nome
+        // interno, ex: "input" (inglês) → "entrada")
+        if (const WordEntry* w = config_->words.find(value)) {
+            if (w->type != TK::IDENT) return Token(w->type, value, line_);
+            if (!w->builtin.empty()) return Token(TK::IDENT, w->builtin, line_);
         }
 
         return Token(TK::IDENT, value, line_);
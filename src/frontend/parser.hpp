@@ -5,7 +5,9 @@
 #define JPLANG_PARSER_HPP
 
 #include "lexer.hpp"
+#include "source_buffer.hpp"
 #include "ast.hpp"
+#include "../tempos.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -36,17 +38,21 @@ inline Cor cor_from_name(const std::string& name) {
 
 class Parser {
 public:
+    // arena: compartilhada com sub-parsers (imports, interpolação), cujos
+    // nós acabam no mesmo Program
     explicit Parser(Lexer& lexer, const std::string& base_dir = "",
-                    std::shared_ptr<std::set<std::string>> imported_files = nullptr)
+                    std::shared_ptr<std::set<std::string>> imported_files = nullptr,
+                    std::shared_ptr<AstArena> arena = nullptr)
         : lex_(lexer), had_error_(false), base_dir_(base_dir),
-          lang_config_(lexer.lang_config())
+          lang_config_(lexer.lang_config()),
+          arena_(arena ? std::move(arena) : std::make_shared<AstArena>())
     {
         if (imported_files) {
             imported_files_ = imported_files;
         } else {
             imported_files_ = std::make_shared<std::set<std::string>>();
         }
-        current_ = lex_.next();
+        current_ = fetch();
         next_token_ = std::nullopt;
     }
 
@@ -55,6 +61,9 @@ public:
     // Acesso à configuração de idioma
     const LangConfig& lang_config() const { return lang_config_; }
 
+    // Arquivos .jp importados (caminhos canônicos) — dependências do build
+    const std::vector<std::string>& imported_sources() const { return *imported_sources_; }
+
     // Método público para parsear uma única expressão (usado em interpolação)
     ExprPtr parse_expr_public() {
         return parse_expr();
@@ -66,6 +75,7 @@ public:
 
     std::optional<Program> parse() {
         Program prog;
+        prog.arena = arena_;
 
         while (!check(TK::TK_EOF) && !had_error_) {
             skip_newlines();
@@ -80,6 +90,10 @@ public:
                 prog.statements.push_back(std::move(s));
             }
             pending_imports_.clear();
+            for (auto& m : pending_modulos_) {
+                prog.modulos.push_back(std::move(m));
+            }
+            pending_modulos_.clear();
 
             skip_newlines();
         }
@@ -94,26 +108,40 @@ private:
     std::optional<Token> next_token_;
     bool had_error_;
     StmtList pending_imports_;  // statements de arquivos importados
+    std::vector<ModuloFonte> pending_modulos_;  // donos das declarações importadas
     std::string base_dir_;     // diretório base para resolver imports
-    LangConfig lang_config_;   // configuração do idioma ativo
+    const LangConfig& lang_config_;   // configuração do idioma ativo (do lexer)
+    std::shared_ptr<AstArena> arena_;  // onde os nós são alocados
     std::shared_ptr<std::set<std::string>> imported_files_;  // include guard
+    std::shared_ptr<std::vector<std::string>> imported_sources_ =
+        std::make_shared<std::vector<std::string>>();  // só .jp, em ordem
 
     // ========================================================================
     // AUXILIARES
     // ========================================================================
 
+    // Próximo token do lexer; com --tempos, mede o lexing separado do parsing
+    Token fetch() {
+        Tempos& tempos = Tempos::global();
+        if (!tempos.ativo()) return lex_.next();
+        Cronometro c;
+        Token tk = lex_.next();
+        tempos.token_lido(c.ms());
+        return tk;
+    }
+
     void do_advance() {
         if (next_token_.has_value()) {
             current_ = std::move(next_token_.value());
             next_token_ = std::nullopt;
         } else {
-            current_ = lex_.next();
+            current_ = fetch();
         }
     }
 
     bool peek_is(TK tk_type) {
         if (!next_token_.has_value()) {
-            next_token_ = lex_.next();
+            next_token_ = fetch();
         }
         return next_token_->type == tk_type;
     }
@@ -189,7 +217,7 @@ private:
             int line = cur_line();
             do_advance();
             auto right = parse_and();
-            auto node = std::make_unique<Expr>(LogicOpExpr{
+            auto node = arena_->make<Expr>(LogicOpExpr{
                 LogicOp::Or, std::move(left), std::move(right), line
             });
             left = std::move(node);
@@ -203,7 +231,7 @@ private:
             int line = cur_line();
             do_advance();
             auto right = parse_comparison();
-            auto node = std::make_unique<Expr>(LogicOpExpr{
+            auto node = arena_->make<Expr>(LogicOpExpr{
                 LogicOp::And, std::move(left), std::move(right), line
             });
             left = std::move(node);
@@ -232,7 +260,7 @@ private:
                 default: op = CmpOp::Eq; break;
             }
 
-            auto node = std::make_unique<Expr>(CmpOpExpr{
+            auto node = arena_->make<Expr>(CmpOpExpr{
                 op, std::move(left), std::move(right), line
             });
             left = std::move(node);
@@ -249,7 +277,7 @@ private:
             do_advance();
             auto right = parse_mul();
 
-            auto node = std::make_unique<Expr>(BinOpExpr{
+            auto node = arena_->make<Expr>(BinOpExpr{
                 op, std::move(left), std::move(right), line
             });
             left = std::move(node);
@@ -272,7 +300,7 @@ private:
             do_advance();
             auto right = parse_unary();
 
-            auto node = std::make_unique<Expr>(BinOpExpr{
+            auto node = arena_->make<Expr>(BinOpExpr{
                 op, std::move(left), std::move(right), line
             });
             left = std::move(node);
@@ -285,8 +313,8 @@ private:
             int line = cur_line();
             do_advance();
             auto operand = parse_unary();
-            auto zero = std::make_unique<Expr>(NumberLit{0, line});
-            return std::make_unique<Expr>(BinOpExpr{
+            auto zero = arena_->make<Expr>(NumberLit{0, line});
+            return arena_->make<Expr>(BinOpExpr{
                 BinOp::Sub, std::move(zero), std::move(operand), line
             });
         }
@@ -304,7 +332,7 @@ private:
                     error("Esperado nome após '.'");
                     break;
                 }
-                std::string attr = current_.value;
+                Sym attr = Sym::intern(current_.value);
                 int line = cur_line();
                 do_advance();
 
@@ -313,23 +341,23 @@ private:
                     do_advance();
                     auto args = parse_args();
                     expect(TK::RPAREN, "Esperado ')'");
-                    node = std::make_unique<Expr>(MetodoChamadaExpr{
+                    node = arena_->make<Expr>(MetodoChamadaExpr{
                         std::move(node), attr, std::move(args), line
                     });
                 } else {
-                    node = std::make_unique<Expr>(AttrGetExpr{
+                    node = arena_->make<Expr>(AttrGetExpr{
                         std::move(node), attr, line
                     });
                 }
             }
             // Chamada de função: func(args)
             else if (check(TK::LPAREN) && is_var_expr(node)) {
-                std::string name = get_var_name(node);
+                Sym name = get_var_name(node);
                 int line = cur_line();
                 do_advance();
                 auto args = parse_args();
                 expect(TK::RPAREN, "Esperado ')'");
-                node = std::make_unique<Expr>(ChamadaExpr{
+                node = arena_->make<Expr>(ChamadaExpr{
                     name, std::move(args), line
                 });
             }
@@ -339,7 +367,7 @@ private:
                 do_advance();  // consome '['
                 auto index = parse_expr();
                 expect(TK::RBRACKET, "Esperado ']'");
-                node = std::make_unique<Expr>(IndexGetExpr{
+                node = arena_->make<Expr>(IndexGetExpr{
                     std::move(node), std::move(index), line
                 });
             } else {
@@ -359,7 +387,7 @@ private:
                     error("Esperado nome após '.'");
                     break;
                 }
-                std::string attr = current_.value;
+                Sym attr = Sym::intern(current_.value);
                 int line = cur_line();
                 do_advance();
 
@@ -367,11 +395,11 @@ private:
                     do_advance();
                     auto args = parse_args();
                     expect(TK::RPAREN, "Esperado ')'");
-                    node = std::make_unique<Expr>(MetodoChamadaExpr{
+                    node = arena_->make<Expr>(MetodoChamadaExpr{
                         std::move(node), attr, std::move(args), line
                     });
                 } else {
-                    node = std::make_unique<Expr>(AttrGetExpr{
+                    node = arena_->make<Expr>(AttrGetExpr{
                         std::move(node), attr, line
                     });
                 }
@@ -381,7 +409,7 @@ private:
                 do_advance();
                 auto index = parse_expr();
                 expect(TK::RBRACKET, "Esperado ']'");
-                node = std::make_unique<Expr>(IndexGetExpr{
+                node = arena_->make<Expr>(IndexGetExpr{
                     std::move(node), std::move(index), line
                 });
             }
@@ -410,20 +438,20 @@ private:
         if (tk.type == TK::NUMBER) {
             do_advance();
             if (tk.value.find('.') != std::string::npos) {
-                return std::make_unique<Expr>(FloatLit{
-                    std::stod(tk.value), tk.line
+                return arena_->make<Expr>(FloatLit{
+                    std::stod(std::string(tk.value)), tk.line
                 });
             }
-            return std::make_unique<Expr>(NumberLit{
-                std::stoi(tk.value), tk.line
+            return arena_->make<Expr>(NumberLit{
+                std::stoi(std::string(tk.value)), tk.line
             });
         }
 
         // String simples
         if (tk.type == TK::STRING) {
             do_advance();
-            return std::make_unique<Expr>(StringLit{
-                tk.value, tk.line
+            return arena_->make<Expr>(StringLit{
+                std::string(tk.value), tk.line
             });
         }
 
@@ -431,9 +459,9 @@ private:
         if (tk.type == TK::STRING_INTERP) {
             do_advance();
             std::vector<InterpPart> parts;
-            for (auto& p : tk.interp_parts) {
+            for (auto& p : lex_.interp_parts(tk)) {
                 if (!p.is_var) {
-                    parts.push_back(InterpPart{false, p.value, nullptr});
+                    parts.push_back(InterpPart{false, std::string(p.value), nullptr});
                 } else {
                     // Tenta parsear como expressão completa
                     // Se é um identificador simples (sem operadores), mantém como string
@@ -448,22 +476,22 @@ private:
 
                     if (is_simple) {
                         // Nome simples ou "auto.attr" — mantém como antes
-                        parts.push_back(InterpPart{true, p.value, nullptr});
+                        parts.push_back(InterpPart{true, std::string(p.value), nullptr});
                     } else {
                         // Expressão complexa — parsear com sub-lexer/parser
                         Lexer sub_lex(p.value, lang_config_);
-                        Parser sub_parser(sub_lex);
+                        Parser sub_parser(sub_lex, "", nullptr, arena_);
                         auto expr = sub_parser.parse_expr_public();
                         if (expr && !sub_parser.had_error()) {
                             parts.push_back(InterpPart{true, "", std::move(expr)});
                         } else {
                             // Fallback: trata como texto
-                            parts.push_back(InterpPart{true, p.value, nullptr});
+                            parts.push_back(InterpPart{true, std::string(p.value), nullptr});
                         }
                     }
                 }
             }
-            return std::make_unique<Expr>(StringInterp{
+            return arena_->make<Expr>(StringInterp{
                 std::move(parts), tk.line
             });
         }
@@ -471,7 +499,7 @@ private:
         // Bool
         if (tk.type == TK::BOOL) {
             do_advance();
-            return std::make_unique<Expr>(BoolLit{
+            return arena_->make<Expr>(BoolLit{
                 tk.value == "verdadeiro", tk.line
             });
         }
@@ -479,20 +507,20 @@ private:
         // Nulo
         if (tk.type == TK::NULO) {
             do_advance();
-            return std::make_unique<Expr>(NullLit{tk.line});
+            return arena_->make<Expr>(NullLit{tk.line});
         }
 
         // Auto (self)
         if (tk.type == TK::AUTO) {
             do_advance();
-            return std::make_unique<Expr>(AutoExpr{tk.line});
+            return arena_->make<Expr>(AutoExpr{tk.line});
         }
 
         // Identificador
         if (tk.type == TK::IDENT) {
             do_advance();
-            return std::make_unique<Expr>(VarExpr{
-                tk.value, tk.line
+            return arena_->make<Expr>(VarExpr{
+                Sym::intern(tk.value), tk.line
             });
         }
 
@@ -516,14 +544,14 @@ private:
                 }
             }
             expect(TK::RBRACKET, "Esperado ']'");
-            return std::make_unique<Expr>(ListLitExpr{
+            return arena_->make<Expr>(ListLitExpr{
                 std::move(elements), line
             });
         }
 
-        error("Expressão inesperada: '" + tk.value + "'");
+        error("Expressão inesperada: '" + std::string(tk.value) + "'");
         do_advance();
-        return std::make_unique<Expr>(NumberLit{0, tk.line});
+        return arena_->make<Expr>(NumberLit{0, tk.line});
     }
 
     // ========================================================================
@@ -534,7 +562,7 @@ private:
         return std::holds_alternative<VarExpr>(expr->node);
     }
 
-    static std::string get_var_name(const ExprPtr& expr) {
+    static Sym get_var_name(const ExprPtr& expr) {
         return std::get<VarExpr>(expr->node).name;
     }
 
@@ -557,12 +585,12 @@ private:
 
         if (tk.type == TK::PARAR) {
             do_advance();
-            return std::make_unique<Stmt>(PararStmt{tk.line});
+            return arena_->make<Stmt>(PararStmt{tk.line});
         }
 
         if (tk.type == TK::CONTINUAR) {
             do_advance();
-            return std::make_unique<Stmt>(ContinuarStmt{tk.line});
+            return arena_->make<Stmt>(ContinuarStmt{tk.line});
         }
 
         if (tk.type == TK::FUNCAO)    return parse_funcao();
@@ -573,7 +601,7 @@ private:
         if (tk.type == TK::IDENT)     return parse_ident_stmt();
         if (tk.type == TK::AUTO)      return parse_auto_stmt();
 
-        error("Statement inesperado: '" + tk.value + "'");
+        error("Statement inesperado: '" + std::string(tk.value) + "'");
         do_advance();
         return nullptr;
     }
@@ -587,27 +615,20 @@ private:
     //     "salida", "salidal", "salida_rojo", "salidal_verde"
     // ========================================================================
 
-    bool is_saida_command(const std::string& name) const {
-        const std::string& prefix = lang_config_.saida_prefix;
-        const std::string& nl_suffix = lang_config_.saida_no_newline_suffix;
+    bool is_saida_command(std::string_view name) const {
+        std::string_view prefix = lang_config_.saida_prefix;
+        std::string_view nl_suffix = lang_config_.saida_no_newline_suffix;
 
-        if (name == prefix) return true;
-        if (name == prefix + nl_suffix) return true;
+        if (name.substr(0, prefix.size()) != prefix) return false;
+        std::string_view rest = name.substr(prefix.size());
 
-        // prefixo + cor (ex: saida_amarelo, output_yellow, salida_rojo)
-        if (name.size() > prefix.size() && name.substr(0, prefix.size()) == prefix
-            && name[prefix.size()] == '_') {
-            return true;
-        }
-
-        // prefixo + l + cor (ex: saidal_verde, outputl_yellow, salidal_rojo)
-        std::string prefix_nl = prefix + nl_suffix;
-        if (name.size() > prefix_nl.size() && name.substr(0, prefix_nl.size()) == prefix_nl
-            && name[prefix_nl.size()] == '_') {
-            return true;
-        }
+        // prefixo puro ou prefixo + cor (ex: saida, saida_amarelo, salida_rojo)
+        if (rest.empty() || rest[0] == '_') return true;
 
-        return false;
+        // prefixo + l, com ou sem cor (ex: saidal, saidal_verde, outputl_yellow)
+        if (rest.substr(0, nl_suffix.size()) != nl_suffix) return false;
+        rest = rest.substr(nl_suffix.size());
+        return rest.empty() || rest[0] == '_';
     }
 
     // ========================================================================
@@ -616,7 +637,7 @@ private:
 
     StmtPtr parse_saida() {
         Token tk = current_;
-        std::string name = tk.value;
+        std::string name(tk.value);
         do_advance();
         expect(TK::LPAREN, "Esperado '(' após " + name);
 
@@ -655,14 +676,14 @@ private:
         // combiná-los em cadeia de ConcatExpr
         while (match(TK::COMMA)) {
             auto next = parse_expr();
-            value = std::make_unique<Expr>(ConcatExpr{
+            value = arena_->make<Expr>(ConcatExpr{
                 std::move(value), std::move(next), tk.line
             });
         }
 
         expect(TK::RPAREN, "Esperado ')'");
 
-        return std::make_unique<Stmt>(SaidaStmt{
+        return arena_->make<Stmt>(SaidaStmt{
             std::move(value), newline, cor, tk.line
         });
     }
@@ -724,7 +745,7 @@ private:
             branches.push_back(CondBranch{nullptr, std::move(else_body)});
         }
 
-        return std::make_unique<Stmt>(IfStmt{std::move(branches), line});
+        return arena_->make<Stmt>(IfStmt{std::move(branches), line});
     }
 
     // ========================================================================
@@ -739,7 +760,7 @@ private:
         expect(TK::COLON, "Esperado ':' após repetir N");
         auto body = parse_block();
 
-        return std::make_unique<Stmt>(RepetirStmt{
+        return arena_->make<Stmt>(RepetirStmt{
             std::move(count), std::move(body), line
         });
     }
@@ -752,7 +773,7 @@ private:
         expect(TK::COLON, "Esperado ':' após condição");
         auto body = parse_block();
 
-        return std::make_unique<Stmt>(EnquantoStmt{
+        return arena_->make<Stmt>(EnquantoStmt{
             std::move(cond), std::move(body), line
         });
     }
@@ -765,7 +786,7 @@ private:
             error("Esperado nome de variável após 'para'");
             return nullptr;
         }
-        std::string var_name = current_.value;
+        Sym var_name = Sym::intern(current_.value);
         do_advance();
 
         expect(TK::EM, "Esperado 'em' após variável");
@@ -785,7 +806,7 @@ private:
         expect(TK::COLON, "Esperado ':'");
         auto body = parse_block();
 
-        return std::make_unique<Stmt>(ParaStmt{
+        return arena_->make<Stmt>(ParaStmt{
             var_name, std::move(start), std::move(end),
             std::move(step), std::move(body), line
         });
@@ -803,24 +824,24 @@ private:
             error("Esperado nome da função");
             return nullptr;
         }
-        std::string name = current_.value;
+        Sym name = Sym::intern(current_.value);
         do_advance();
 
         expect(TK::LPAREN, "Esperado '('");
-        std::vector<std::string> params;
+        std::vector<Sym> params;
 
         if (!check(TK::RPAREN)) {
             if (!check(TK::IDENT)) {
                 error("Esperado nome de parâmetro");
             } else {
-                params.push_back(current_.value);
+                params.push_back(Sym::intern(current_.value));
                 do_advance();
             }
             while (match(TK::COMMA)) {
                 if (!check(TK::IDENT)) {
                     error("Esperado nome de parâmetro");
                 } else {
-                    params.push_back(current_.value);
+                    params.push_back(Sym::intern(current_.value));
                     do_advance();
                 }
             }
@@ -830,7 +851,7 @@ private:
         expect(TK::COLON, "Esperado ':'");
         auto body = parse_block();
 
-        return std::make_unique<Stmt>(FuncaoStmt{
+        return arena_->make<Stmt>(FuncaoStmt{
             name, std::move(params), std::move(body), line
         });
     }
@@ -844,7 +865,7 @@ private:
             value = parse_expr();
         }
 
-        return std::make_unique<Stmt>(RetornaStmt{std::move(value), line});
+        return arena_->make<Stmt>(RetornaStmt{std::move(value), line});
     }
 
     // ========================================================================
@@ -859,13 +880,13 @@ private:
             error("Esperado nome da classe");
             return nullptr;
         }
-        std::string name = current_.value;
+        Sym name = Sym::intern(current_.value);
         do_advance();
 
         expect(TK::COLON, "Esperado ':'");
         auto body = parse_block();
 
-        return std::make_unique<Stmt>(ClasseStmt{
+        return arena_->make<Stmt>(ClasseStmt{
             name, std::move(body), line
         });
     }
@@ -882,7 +903,7 @@ private:
             error("Esperado caminho da biblioteca");
             return nullptr;
         }
-        std::string lib_path = current_.value;
+        std::string lib_path(current_.value);
         do_advance();
 
         // Sintaxe com lista explícita: nativo "dll" importar func1, func2
@@ -894,17 +915,17 @@ private:
                     error("Esperado nome da função");
                     break;
                 }
-                funcs.push_back(current_.value);
+                funcs.emplace_back(current_.value);
                 do_advance();
                 if (!match(TK::COMMA)) break;
             }
-            return std::make_unique<Stmt>(NativoStmt{
+            return arena_->make<Stmt>(NativoStmt{
                 lib_path, std::move(funcs), false, line
             });
         }
 
         // Sintaxe automática: nativo "bibliotecas/tempo"
-        return std::make_unique<Stmt>(NativoStmt{
+        return arena_->make<Stmt>(NativoStmt{
             lib_path, {}, true, line
         });
     }
@@ -918,7 +939,7 @@ private:
         do_advance();  // consome 'importar'
 
         if (check(TK::IDENT)) {
-            std::string name = current_.value;
+            std::string name(current_.value);
             do_advance();
 
             // Verifica se vem .jpd (tokens: DOT + IDENT "jpd")
@@ -932,7 +953,7 @@ private:
                 if (dot_ext == "jpd") {
                     // importar ola.jpd → trata como DLL dinâmica
                     std::string lib_path = name + ".jpd";
-                    return std::make_unique<Stmt>(NativoStmt{
+                    return arena_->make<Stmt>(NativoStmt{
                         lib_path, {}, true, line
                     });
                 }
@@ -951,13 +972,13 @@ private:
             }
             imported_files_->insert(lib_path);
 
-            return std::make_unique<Stmt>(NativoStmt{
+            return arena_->make<Stmt>(NativoStmt{
                 lib_path, {}, true, line
             });
         }
 
         if (check(TK::STRING)) {
-            std::string path = current_.value;
+            std::string path(current_.value);
             do_advance();
 
             // Se termina em .jp, importa como código-fonte
@@ -986,19 +1007,24 @@ private:
                     return nullptr;  // já importado, pula
                 }
                 imported_files_->insert(canonical);
+                imported_sources_->push_back(canonical);
 
-                std::stringstream buf;
-                buf << file.rdbuf();
-                std::string source = buf.str();
+                file.close();
+                SourceBuffer source;
+                if (!source.open(full_path)) {
+                    error("Não foi possível abrir: " + path);
+                    return nullptr;
+                }
 
-                Lexer imp_lex(source, lang_config_);
+                Lexer imp_lex(source.view(), lang_config_);
                 // Calcula diretório do arquivo importado para imports aninhados
                 std::string imp_dir;
                 size_t last_sep = full_path.find_last_of("/\\");
                 if (last_sep != std::string::npos) {
                     imp_dir = full_path.substr(0, last_sep);
                 }
-                Parser imp_parser(imp_lex, imp_dir, imported_files_);
+                Parser imp_parser(imp_lex, imp_dir, imported_files_, arena_);
+                imp_parser.imported_sources_ = imported_sources_;
                 auto result = imp_parser.parse();
 
                 if (!result || imp_parser.had_error()) {
@@ -1006,6 +1032,29 @@ private:
                     return nullptr;
                 }
 
+                // Registra o módulo: declarações que vieram de imports
+                // aninhados pertencem ao módulo aninhado, não a este
+                ModuloFonte modulo;
+                modulo.caminho = canonical;
+                std::set<std::string> aninhadas;
+                for (auto& m : result->modulos) {
+                    for (auto& f : m.funcoes) aninhadas.insert(f);
+                    for (auto& c : m.classes) aninhadas.insert(c);
+                }
+                for (auto& s : result->statements) {
+                    if (auto* f = std::get_if<FuncaoStmt>(&s->node)) {
+                        if (!aninhadas.count(f->name)) modulo.funcoes.push_back(f->name);
+                    } else if (auto* c = std::get_if<ClasseStmt>(&s->node)) {
+                        if (!aninhadas.count(c->name)) modulo.classes.push_back(c->name);
+                    } else if (!std::holds_alternative<NativoStmt>(s->node)) {
+                        modulo.puro = false;
+                    }
+                }
+                for (auto& m : result->modulos) {
+                    pending_modulos_.push_back(std::move(m));
+                }
+                pending_modulos_.push_back(std::move(modulo));
+
                 // Insere todos os statements do arquivo no pending
                 for (auto& s : result->statements) {
                     pending_imports_.push_back(std::move(s));
@@ -1017,13 +1066,13 @@ private:
 
             // Se termina em .jpd entre aspas: importar "caminho/lib.jpd"
             if (path.size() > 4 && path.substr(path.size() - 4) == ".jpd") {
-                return std::make_unique<Stmt>(NativoStmt{
+                return arena_->make<Stmt>(NativoStmt{
                     path, {}, true, line
                 });
             }
 
             // Senão, trata como biblioteca nativa
-            return std::make_unique<Stmt>(NativoStmt{
+            return arena_->make<Stmt>(NativoStmt{
                 path, {}, true, line
             });
         }
@@ -1038,13 +1087,13 @@ private:
 
     StmtPtr parse_ident_stmt() {
         Token tk = current_;
-        std::string name = tk.value;
+        Sym name = Sym::intern(tk.value);
         do_advance();
 
         // Atribuição: nome = expr
         if (match(TK::EQUALS)) {
             auto value = parse_expr();
-            return std::make_unique<Stmt>(AssignStmt{
+            return arena_->make<Stmt>(AssignStmt{
                 name, std::move(value), tk.line
             });
         }
@@ -1058,21 +1107,21 @@ private:
             // nome[index] = valor (atribuição simples)
             if (match(TK::EQUALS)) {
                 auto value = parse_expr();
-                return std::make_unique<Stmt>(IndexSetStmt{
+                return arena_->make<Stmt>(IndexSetStmt{
                     name, std::move(index), std::move(value), tk.line
                 });
             }
 
             // Constrói expressão base: nome[index]
-            ExprPtr node = std::make_unique<Expr>(IndexGetExpr{
-                std::make_unique<Expr>(VarExpr{name, tk.line}),
+            ExprPtr node = arena_->make<Expr>(IndexGetExpr{
+                arena_->make<Expr>(VarExpr{name, tk.line}),
                 std::move(index), tk.line
             });
 
             // Encadeia postfix: .attr, .metodo(), [index]
             node = parse_postfix_chain(std::move(node));
 
-            return std::make_unique<Stmt>(ExprStmt{
+            return arena_->make<Stmt>(ExprStmt{
                 std::move(node), tk.line
             });
         }
@@ -1084,14 +1133,14 @@ private:
                 error("Esperado nome após '.'");
                 return nullptr;
             }
-            std::string attr = current_.value;
+            Sym attr = Sym::intern(current_.value);
             do_advance();
 
             // nome.attr = expr
             if (match(TK::EQUALS)) {
                 auto value = parse_expr();
-                auto obj = std::make_unique<Expr>(VarExpr{name, tk.line});
-                return std::make_unique<Stmt>(AttrSetStmt{
+                auto obj = arena_->make<Expr>(VarExpr{name, tk.line});
+                return arena_->make<Stmt>(AttrSetStmt{
                     std::move(obj), attr, std::move(value), tk.line
                 });
             }
@@ -1101,11 +1150,11 @@ private:
                 do_advance();
                 auto args = parse_args();
                 expect(TK::RPAREN, "Esperado ')'");
-                auto obj = std::make_unique<Expr>(VarExpr{name, tk.line});
-                auto call = std::make_unique<Expr>(MetodoChamadaExpr{
+                auto obj = arena_->make<Expr>(VarExpr{name, tk.line});
+                auto call = arena_->make<Expr>(MetodoChamadaExpr{
                     std::move(obj), attr, std::move(args), tk.line
                 });
-                return std::make_unique<Stmt>(ExprStmt{
+                return arena_->make<Stmt>(ExprStmt{
                     std::move(call), tk.line
                 });
             }
@@ -1119,10 +1168,10 @@ private:
             do_advance();
             auto args = parse_args();
             expect(TK::RPAREN, "Esperado ')'");
-            auto call = std::make_unique<Expr>(ChamadaExpr{
+            auto call = arena_->make<Expr>(ChamadaExpr{
                 name, std::move(args), tk.line
             });
-            return std::make_unique<Stmt>(ExprStmt{
+            return arena_->make<Stmt>(ExprStmt{
                 std::move(call), tk.line
             });
         }
@@ -1144,14 +1193,14 @@ private:
             error("Esperado nome de atributo após 'auto.'");
             return nullptr;
         }
-        std::string attr = current_.value;
+        Sym attr = Sym::intern(current_.value);
         do_advance();
 
         // auto.attr = expr
         if (match(TK::EQUALS)) {
             auto value = parse_expr();
-            auto obj = std::make_unique<Expr>(AutoExpr{tk.line});
-            return std::make_unique<Stmt>(AttrSetStmt{
+            auto obj = arena_->make<Expr>(AutoExpr{tk.line});
+            return arena_->make<Stmt>(AttrSetStmt{
                 std::move(obj), attr, std::move(value), tk.line
             });
         }
@@ -1161,11 +1210,11 @@ private:
             do_advance();
             auto args = parse_args();
             expect(TK::RPAREN, "Esperado ')'");
-            auto obj = std::make_unique<Expr>(AutoExpr{tk.line});
-            auto call = std::make_unique<Expr>(MetodoChamadaExpr{
+            auto obj = arena_->make<Expr>(AutoExpr{tk.line});
+            auto call = arena_->make<Expr>(MetodoChamadaExpr{
                 std::move(obj), attr, std::move(args), tk.line
             });
-            return std::make_unique<Stmt>(ExprStmt{
+            return arena_->make<Stmt>(ExprStmt{
                 std::move(call), tk.line
             });
         }
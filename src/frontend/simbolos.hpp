@@ -0,0 +1,133 @@
+// simbolos.hpp
+// Identificadores internados (Sym)
+//
+// Cada nome distinto (variável, função, classe, atributo, método) é
+// guardado uma única vez numa tabela global e representado por um ID de
+// 32 bits. A AST guarda Sym em vez de std::string, e os mapas do codegen
+// usam Sym como chave: comparar e hashear um nome custa um inteiro.
+//
+// A tabela é compartilhada pelas threads do codegen paralelo: intern()
+// usa um mutex; str() não trava, porque as strings ficam em blocos que
+// nunca são realocados.
+
+#ifndef JPLANG_SIMBOLOS_HPP
+#define JPLANG_SIMBOLOS_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <ostream>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+namespace jplang {
+
+// ============================================================================
+// TABELA DE SÍMBOLOS
+// ============================================================================
+
+class SymbolTable {
+public:
+    static constexpr uint32_t CHUNK_BITS = 12;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static constexpr uint32_t MAX_CHUNKS = 1024;
+
+    SymbolTable() { intern(""); }   // ID 0 = nome vazio
+
+    static SymbolTable& global() {
+        static SymbolTable table;
+        return table;
+    }
+
+    uint32_t intern(std::string_view text) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(text);
+        if (it != index_.end()) return it->second;
+
+        uint32_t id = count_;
+        uint32_t chunk = id >> CHUNK_BITS;
+        if (chunk >= MAX_CHUNKS) {
+            std::cerr << "Erro: limite de identificadores excedido" << std::endl;
+            std::abort();
+        }
+        if (!chunks_[chunk]) chunks_[chunk] = std::make_unique<std::string[]>(CHUNK_SIZE);
+        std::string& slot = chunks_[chunk][id & (CHUNK_SIZE - 1)];
+        slot.assign(text.data(), text.size());
+        index_.emplace(std::string_view(slot), id);
+        count_ = id + 1;
+        return id;
+    }
+
+    const std::string& str(uint32_t id) const {
+        return chunks_[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)];
+    }
+
+    uint32_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unique_ptr<std::string[]> chunks_[MAX_CHUNKS];
+    std::unordered_map<std::string_view, uint32_t> index_;
+    uint32_t count_ = 0;
+};
+
+// ============================================================================
+// SYM
+// Lê como um const std::string& (conversão implícita, ==, +, <<), mas
+// igualdade e hash são do ID.
+// ============================================================================
+
+class Sym {
+public:
+    Sym() = default;
+
+    static Sym intern(std::string_view text) {
+        Sym s;
+        s.id_ = SymbolTable::global().intern(text);
+        return s;
+    }
+
+    uint32_t id() const { return id_; }
+    const std::string& str() const { return SymbolTable::global().str(id_); }
+    operator const std::string&() const { return str(); }
+
+    bool empty() const { return id_ == 0; }
+    size_t size() const { return str().size(); }
+
+    friend bool operator==(Sym a, Sym b) { return a.id_ == b.id_; }
+    friend bool operator!=(Sym a, Sym b) { return a.id_ != b.id_; }
+    friend bool operator==(Sym a, const std::string& b) { return a.str() == b; }
+    friend bool operator!=(Sym a, const std::string& b) { return a.str() != b; }
+    friend bool operator==(const std::string& a, Sym b) { return a == b.str(); }
+    friend bool operator!=(const std::string& a, Sym b) { return a != b.str(); }
+    friend bool operator==(Sym a, const char* b) { return a.str() == b; }
+    friend bool operator!=(Sym a, const char* b) { return a.str() != b; }
+
+    friend std::string operator+(Sym a, const std::string& b) { return a.str() + b; }
+    friend std::string operator+(const std::string& a, Sym b) { return a + b.str(); }
+    friend std::string operator+(Sym a, const char* b) { return a.str() + b; }
+    friend std::string operator+(const char* a, Sym b) { return a + b.str(); }
+
+    friend std::ostream& operator<<(std::ostream& os, Sym s) { return os << s.str(); }
+
+private:
+    uint32_t id_ = 0;
+};
+
+} // namespace jplang
+
+namespace std {
+template <>
+struct hash<jplang::Sym> {
+    size_t operator()(jplang::Sym s) const noexcept { return s.id(); }
+};
+} // namespace std
+
+#endif // JPLANG_SIMBOLOS_HPP
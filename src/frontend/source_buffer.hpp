@@ -0,0 +1,121 @@
+// source_buffer.hpp
+// Buffer de código-fonte somente leitura, mapeado em memória
+//
+// O lexer trabalha direto sobre os bytes do arquivo: tokens são views
+// (std::string_view) para dentro deste buffer, sem cópia. O buffer precisa
+// viver enquanto lexer, parser e tokens existirem. Se o mapeamento falhar
+// (arquivo especial, sistema sem mmap), cai para leitura normal.
+
+#ifndef JPLANG_SOURCE_BUFFER_HPP
+#define JPLANG_SOURCE_BUFFER_HPP
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace jplang {
+
+class SourceBuffer {
+public:
+    SourceBuffer() = default;
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    ~SourceBuffer() { close(); }
+
+    // Abre e mapeia o arquivo; false se não existe ou não pode ser lido
+    bool open(const std::string& path) {
+        close();
+        if (map_file(path)) return true;
+
+        // Fallback: lê para memória própria
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        owned_ = ss.str();
+        data_ = owned_.data();
+        size_ = owned_.size();
+        return true;
+    }
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    bool mapped() const { return mapped_; }
+
+private:
+    const char* data_ = "";
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string owned_;
+    #ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+    #endif
+
+    bool map_file(const std::string& path) {
+        #ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping_) { close(); return false; }
+        void* p = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (!p) { close(); return false; }
+        data_ = static_cast<const char*>(p);
+        size_ = static_cast<size_t>(size.QuadPart);
+        #else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(p);
+        size_ = static_cast<size_t>(st.st_size);
+        #endif
+        mapped_ = true;
+        return true;
+    }
+
+    void close() {
+        #ifdef _WIN32
+        if (mapped_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = NULL;
+        file_ = INVALID_HANDLE_VALUE;
+        #else
+        if (mapped_) munmap(const_cast<char*>(data_), size_);
+        #endif
+        mapped_ = false;
+        owned_.clear();
+        data_ = "";
+        size_ = 0;
+    }
+};
+
+} // namespace jplang
+
+#endif // JPLANG_SOURCE_BUFFER_HPP
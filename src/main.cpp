@@ -1,6 +1,7 @@
 // main.cpp
 // Entry point de TESTE do compilador JPLang — codegen unificado (só saida por enquanto)
 
+#include "src/frontend/source_buffer.hpp"
 #include "src/frontend/lexer.hpp"
 #include "src/frontend/parser.hpp"
 #include "src/codegen_comum/codegen.hpp"
@@ -21,6 +22,12 @@
 // Gerenciador de bibliotecas
 #include "src/jp_install.hpp"
 
+// Cache de build incremental
+#include "src/build_cache.hpp"
+
+// Tempos por fase (--tempos)
+#include "src/tempos.hpp"
+
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -80,15 +87,13 @@ static std::string get_exe_dir(const char* argv0) {
 // LEITURA DE ARQUIVO
 // ============================================================================
 
-static std::string read_file(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+// Mapeia o fonte em memória; o lexer lê direto do buffer, sem cópia
+static bool read_file(const std::string& path, jplang::SourceBuffer& out) {
+    if (!out.open(path)) {
         std::cerr << "Erro: Não foi possível abrir '" << path << "'" << std::endl;
-        return "";
+        return false;
     }
-    std::ostringstream ss;
-    ss << file.rdbuf();
-    return ss.str();
+    return !out.empty();
 }
 
 // ============================================================================
@@ -154,7 +159,8 @@ static void copiar_dlls(const std::vector<std::string>& dll_paths,
 // COMPILAÇÃO: fonte → .obj/.o
 // ============================================================================
 
-static bool compile_to_obj(const std::string& source,
+static bool compile_to_obj(std::string_view source,
+                           const std::string& source_path,
                            const std::string& obj_path,
                            const std::string& base_dir,
                            const std::string& exe_dir,
@@ -162,7 +168,20 @@ static bool compile_to_obj(const std::string& source,
                            std::vector<std::string>& extra_libs,
                            std::vector<std::string>& extra_lib_paths,
                            std::vector<std::string>& extra_dlls,
-                           bool debug = false) {
+                           bool debug = false,
+                           std::vector<std::string>* deps = nullptr,
+                           const std::string& modulos_dir = "",
+                           unsigned threads = 0,
+                           bool perfil = false,
+                           bool contadores = false,
+                           bool pgo_gerar = false,
+                           const std::string& pgo_usar = "",
+                           bool alvo_nativo = false,
+                           bool ieee_estrito = false,
+                           bool sem_checagem = false,
+                           jplang::RelatorioTamanho* tamanho = nullptr,
+                           bool depuracao = false) {
+    jplang::Cronometro parsing;
     jplang::Lexer lexer(source, base_dir);
     jplang::Parser parser(lexer, base_dir);
 
@@ -172,19 +191,57 @@ static bool compile_to_obj(const std::string& source,
         return false;
     }
 
+    // Lexing é medido token a token dentro do parse; parsing fica com o resto
+    jplang::Tempos& tempos = jplang::Tempos::global();
+    tempos.fase("lexing", tempos.lex_ms(), {{"tokens", tempos.tokens()}});
+    tempos.fase("parsing", parsing.ms() - tempos.lex_ms(),
+                {{"nos", program->arena->node_count()},
+                 {"bytes_ast", program->arena->bytes_used()}});
+
     jplang::Codegen codegen;
     codegen.set_exe_dir(exe_dir);
+    codegen.set_source_path(source_path);
     codegen.set_debug_mode(debug);
+    codegen.set_module_cache_dir(modulos_dir);
+    codegen.set_codegen_threads(threads);
+    codegen.set_perfil(perfil);
+    codegen.set_contadores(contadores);
+    codegen.set_pgo_gerar(pgo_gerar);
+    codegen.set_alvo_nativo(alvo_nativo);
+    codegen.set_ieee_estrito(ieee_estrito);
+    codegen.set_sem_checagem(sem_checagem);
+    codegen.set_depuracao(depuracao);
+    codegen.set_tamanho(tamanho != nullptr);
+    if (!pgo_usar.empty()) {
+        auto perfil_pgo = std::make_shared<jplang::PerfilPgo>();
+        std::string erro;
+        if (!perfil_pgo->carregar(pgo_usar, erro)) {
+            std::cerr << "Erro: -pgo-usar: " << erro << std::endl;
+            return false;
+        }
+        codegen.set_pgo_usar(std::move(perfil_pgo));
+    }
     if (!codegen.compile(program.value(), obj_path, base_dir, parser.lang_config())) {
         std::cerr << "Erro na geração de código." << std::endl;
         return false;
     }
 
+    if (tamanho) *tamanho = codegen.relatorio_tamanho();
     extra_objs = codegen.extra_obj_paths();
     extra_libs = codegen.extra_libs();
     extra_lib_paths = codegen.extra_lib_paths();
     extra_dlls = codegen.extra_dll_paths();
 
+    // Dependências para o cache de build (o fonte principal vem do chamador)
+    if (deps) {
+        for (auto& f : parser.imported_sources()) deps->push_back(f);
+        if (!parser.lang_config().arquivo.empty())
+            deps->push_back(parser.lang_config().arquivo);
+        for (auto& f : codegen.manifest_paths()) deps->push_back(f);
+        for (auto& f : extra_objs) deps->push_back(f);
+        for (auto& f : extra_dlls) deps->push_back(f);
+    }
+
     return true;
 }
 
@@ -192,9 +249,10 @@ static bool compile_to_obj(const std::string& source,
 // MODO RUN: compila, linka, executa, apaga
 // ============================================================================
 
-static int mode_run(const std::string& input_path, bool debug = false) {
-    std::string source = read_file(input_path);
-    if (source.empty()) return 1;
+static int mode_run(const std::string& input_path, bool debug = false,
+                    unsigned threads = 0) {
+    jplang::SourceBuffer source;
+    if (!read_file(input_path, source)) return 1;
 
     std::string base_dir = fs::path(input_path).parent_path().string();
 
@@ -209,8 +267,9 @@ static int mode_run(const std::string& input_path, bool debug = false) {
     std::vector<std::string> extra_libs;
     std::vector<std::string> extra_lib_paths;
     std::vector<std::string> extra_dlls;
-    if (!compile_to_obj(source, obj_path.string(), base_dir, g_exe_dir,
-                        extra_objs, extra_libs, extra_lib_paths, extra_dlls, debug)) {
+    if (!compile_to_obj(source.view(), input_path, obj_path.string(), base_dir, g_exe_dir,
+                        extra_objs, extra_libs, extra_lib_paths, extra_dlls, debug,
+                        nullptr, "", threads)) {
         fs::remove_all(temp_dir);
         return 1;
     }
@@ -250,43 +309,117 @@ static int mode_run(const std::string& input_path, bool debug = false) {
 // MODO BUILD: compila e linka em output/
 // ============================================================================
 
-static int mode_build(const std::string& input_path, bool windowed = false,
-                      bool debug = false) {
-    std::string source = read_file(input_path);
-    if (source.empty()) return 1;
+// Relatório de --tempos: tabela no terminal ou output/<nome>/tempos.json
+static void report_tempos(const std::string& modo, const fs::path& out_dir,
+                          const jplang::Cronometro& total) {
+    if (modo.empty()) return;
+    auto& tempos = jplang::Tempos::global();
+    if (modo == "json") {
+        fs::create_directories(out_dir);
+        fs::path json_path = out_dir / "tempos.json";
+        std::ofstream out(json_path);
+        tempos.relatorio_json(out, total.ms());
+        std::cout << "Tempos: " << json_path.string() << std::endl;
+    } else {
+        tempos.relatorio(std::cout, total.ms());
+    }
+}
 
-    std::string base_dir = fs::path(input_path).parent_path().string();
+static int mode_build(const std::string& input_path, bool windowed = false,
+                      bool debug = false, bool usar_cache = true,
+                      unsigned threads = 0, const std::string& tempos_modo = "",
+                      bool perfil = false, bool contadores = false,
+                      bool pgo_gerar = false, const std::string& pgo_usar = "",
+                      bool alvo_nativo = false, bool ieee_estrito = false,
+                      bool sem_checagem = false, bool tamanho = false,
+                      bool depuracao = false, bool estatico = false) {
+    jplang::Cronometro total;
+    auto& tempos = jplang::Tempos::global();
+    if (!tempos_modo.empty()) tempos.ativar();
 
     fs::path stem = fs::path(input_path).stem();
     fs::path out_dir = fs::path("output") / stem;
-    fs::create_directories(out_dir);
-
     fs::path obj_path = out_dir / (stem.string() + JP_OBJ_EXT);
     fs::path exe_path = out_dir / (stem.string() + JP_EXE_EXT);
 
+    // Cache: se nada mudou desde o último build, não compila nem linka
+    jplang::Cronometro fase;
+    std::string flags = std::string(windowed ? "-w " : "") + (debug ? "-debug" : "");
+    if (perfil) flags += " -perfil";
+    if (contadores) flags += " -contadores";
+    if (pgo_gerar) flags += " -pgo-gerar";
+    if (!pgo_usar.empty()) flags += " -pgo-usar=" + pgo_usar;
+    if (alvo_nativo) flags += " -alvo=nativo";
+    if (ieee_estrito) flags += " -ieee-estrito";
+    if (sem_checagem) flags += " -sem-checagem";
+    if (depuracao) flags += " -g";
+    if (estatico) flags += " -estatico";
+    jplang::BuildCache cache("output", input_path, flags);
+    // --tamanho precisa da emissão: sem cache do executável nem dos módulos
+    bool hit = usar_cache && !tamanho && cache.hit(exe_path);
+    if (usar_cache) tempos.fase("cache", fase.ms(), {{"acerto", hit ? 1u : 0u}});
+    if (hit) {
+        std::cout << "Compilado (cache): " << input_path << " -> " << exe_path.string() << std::endl;
+        report_tempos(tempos_modo, out_dir, total);
+        return 0;
+    }
+    cache.invalidate();
+
+    jplang::SourceBuffer source;
+    if (!read_file(input_path, source)) return 1;
+
+    std::string base_dir = fs::path(input_path).parent_path().string();
+
+    fs::create_directories(out_dir);
+
     std::vector<std::string> extra_objs;
     std::vector<std::string> extra_libs;
     std::vector<std::string> extra_lib_paths;
     std::vector<std::string> extra_dlls;
-    if (!compile_to_obj(source, obj_path.string(), base_dir, g_exe_dir,
-                        extra_objs, extra_libs, extra_lib_paths, extra_dlls, debug)) {
+    std::vector<std::string> deps = {input_path};
+    jplang::RelatorioTamanho relatorio;
+    if (!pgo_usar.empty()) deps.push_back(pgo_usar);   // perfil novo → recompila
+    // Módulos .jp importados: um objeto por módulo, reaproveitado entre builds
+    // (com -perfil/-contadores/-pgo-* tudo fica no objeto principal, coberto
+    // pelas tabelas e pela ordem das funções; com --tamanho, para entrar no
+    // relatório)
+    bool instrumentado = perfil || contadores || pgo_gerar || !pgo_usar.empty();
+    std::string modulos_dir = (usar_cache && !instrumentado && !tamanho)
+        ? (fs::path("output") / jplang::BUILD_CACHE_DIR / "modulos").string()
+        : "";
+    if (!compile_to_obj(source.view(), input_path, obj_path.string(), base_dir, g_exe_dir,
+                        extra_objs, extra_libs, extra_lib_paths, extra_dlls, debug,
+                        &deps, modulos_dir, threads, perfil, contadores,
+                        pgo_gerar, pgo_usar, alvo_nativo, ieee_estrito, sem_checagem,
+                        tamanho ? &relatorio : nullptr, depuracao)) {
         return 1;
     }
 
     std::cout << "Objeto gerado: " << obj_path.string() << std::endl;
 
+    fase = jplang::Cronometro();
     if (!jplang::link_with_ld(obj_path.string(), exe_path.string(),
-                               extra_objs, extra_libs, extra_lib_paths, extra_dlls, windowed)) {
+                               extra_objs, extra_libs, extra_lib_paths, extra_dlls, windowed,
+                               estatico)) {
         return 1;
     }
+    tempos.fase("link_with_ld", fase.ms(), {{"objetos", 1 + extra_objs.size()}});
 
     // Copiar DLLs dinâmicas para output/ (para distribuição)
     if (!extra_dlls.empty()) {
         copiar_dlls(extra_dlls, out_dir);
     }
 
+    cache.store(deps, exe_path);
+
     std::string modo = windowed ? " (GUI, sem console)" : "";
+    if (perfil) modo += " (perfil: grava jp-perfil.folded ao sair)";
+    if (contadores) modo += " (contadores: relatorio ao sair)";
+    if (pgo_gerar) modo += " (pgo: grava " + stem.string() + ".jpprof ao sair)";
+    if (!pgo_usar.empty()) modo += " (pgo: " + pgo_usar + ")";
     std::cout << "Compilado: " << input_path << " -> " << exe_path.string() << modo << std::endl;
+    if (tamanho) relatorio.relatorio(std::cout);
+    report_tempos(tempos_modo, out_dir, total);
     return 0;
 }
 
@@ -296,6 +429,7 @@ static int mode_build(const std::string& input_path, bool windowed = false,
 
 int main(int argc, char* argv[]) {
     g_exe_dir = get_exe_dir(argv[0]);
+    jplang::set_toolchain_exe_dir(g_exe_dir);
 
     if (argc < 2) {
         std::cerr << "JPLang Compiler v1.0 (" << JP_PLATFORM << ")" << std::endl;
@@ -306,12 +440,28 @@ int main(int argc, char* argv[]) {
         std::cerr << "  jp build <arquivo.jp>       Compila e linka em output/" << std::endl;
         std::cerr << "  jp build <arquivo.jp> -w    Compila como aplicativo GUI (sem console)" << std::endl;
         std::cerr << "  jp build <arquivo.jp> -debug  Compila com diagnostico FFI" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -g    Inclui informacoes de depuracao (DWARF, linux)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> --sem-cache  Ignora o cache em output/.cache" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -j N  Gera codigo com N threads (1 = serial)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> --tempos  Mostra tempo e contadores de cada fase" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> --tempos=json  Grava os tempos em output/<nome>/tempos.json" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> --tamanho Mostra bytes por funcao e construcao, .rodata e relocacoes" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -perfil  Perfil por amostragem em jp-perfil.folded (Linux)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -contadores  Chamadas e ciclos por funcao ao sair (Linux)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -pgo-gerar  Instrumenta e grava <nome>.jpprof ao sair (Linux)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -pgo-usar <arquivo.jpprof>  Otimiza com o perfil (Linux)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -alvo=nativo  Usa as instrucoes desta CPU (FMA em a*b + c)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -ieee-estrito  Float arredondado a cada operacao (sem FMA)" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -sem-checagem  lista[i] sem checagem de limites" << std::endl;
+        std::cerr << "  jp build <arquivo.jp> -estatico  Executavel estatico via ld (padrao linux: libc dinamica)" << std::endl;
         std::cerr << std::endl;
         std::cerr << "Gerenciador de bibliotecas:" << std::endl;
         std::cerr << "  jp instalar <nome>          Instala biblioteca do repositorio" << std::endl;
         std::cerr << "  jp desinstalar <nome>       Remove biblioteca instalada" << std::endl;
         std::cerr << "  jp listar                   Lista bibliotecas instaladas" << std::endl;
         std::cerr << "  jp listar --remoto          Lista bibliotecas disponiveis" << std::endl;
+        std::cerr << std::endl;
+        std::cerr << "  jp diagnostico              Mostra toolchain detectado e tempo com/sem cache" << std::endl;
         return 1;
     }
 
@@ -325,6 +475,19 @@ int main(int argc, char* argv[]) {
         // Verifica flags -w (windowed) e -debug
         bool windowed = false;
         bool debug = false;
+        bool usar_cache = true;
+        unsigned threads = 0;
+        std::string tempos_modo;
+        bool perfil = false;
+        bool contadores = false;
+        bool pgo_gerar = false;
+        std::string pgo_usar;
+        bool alvo_nativo = false;
+        bool ieee_estrito = false;
+        bool sem_checagem = false;
+        bool tamanho = false;
+        bool depuracao = false;
+        bool estatico = false;
         std::string build_file = argv[2];
         for (int i = 3; i < argc; i++) {
             std::string flag = argv[i];
@@ -334,8 +497,58 @@ int main(int argc, char* argv[]) {
             if (flag == "-debug" || flag == "--debug") {
                 debug = true;
             }
+            if (flag == "--sem-cache") {
+                usar_cache = false;
+            }
+            if (flag == "-j" && i + 1 < argc) {
+                threads = static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+            if (flag == "--tempos") {
+                tempos_modo = "texto";
+            }
+            if (flag == "--tempos=json") {
+                tempos_modo = "json";
+            }
+            if (flag == "-perfil" || flag == "--perfil") {
+                perfil = true;
+            }
+            if (flag == "-contadores" || flag == "--contadores") {
+                contadores = true;
+            }
+            if (flag == "-pgo-gerar" || flag == "--pgo-gerar") {
+                pgo_gerar = true;
+            }
+            if ((flag == "-pgo-usar" || flag == "--pgo-usar") && i + 1 < argc) {
+                pgo_usar = argv[++i];
+            }
+            if (flag == "-alvo=nativo" || flag == "--alvo=nativo") {
+                alvo_nativo = true;
+            }
+            if (flag == "-ieee-estrito" || flag == "--ieee-estrito") {
+                ieee_estrito = true;
+            }
+            if (flag == "-sem-checagem" || flag == "--sem-checagem") {
+                sem_checagem = true;
+            }
+            if (flag == "--tamanho") {
+                tamanho = true;
+            }
+            if (flag == "-g" || flag == "--depuracao") {
+                depuracao = true;
+            }
+            if (flag == "-estatico" || flag == "--estatico") {
+                estatico = true;
+            }
         }
-        return mode_build(build_file, windowed, debug);
+        #ifdef _WIN32
+        if (perfil || contadores || pgo_gerar || !pgo_usar.empty()) {
+            std::cerr << "Erro: -perfil, -contadores e -pgo-* so sao suportados no Linux" << std::endl;
+            return 1;
+        }
+        #endif
+        return mode_build(build_file, windowed, debug, usar_cache, threads, tempos_modo,
+                          perfil, contadores, pgo_gerar, pgo_usar, alvo_nativo, ieee_estrito,
+                          sem_checagem, tamanho, depuracao, estatico);
     }
 
     if (first_arg == "instalar") {
@@ -355,19 +568,27 @@ int main(int argc, char* argv[]) {
         return jplang::uninstall_lib(argv[2], g_exe_dir);
     }
 
+    if (first_arg == "diagnostico") {
+        return jplang::diagnostico_toolchain();
+    }
+
     if (first_arg == "listar") {
         bool show_remote = (argc >= 3 && std::string(argv[2]) == "--remoto");
         return jplang::list_libs(show_remote, g_exe_dir);
     }
 
-    // Modo run: verifica -debug nos args restantes
+    // Modo run: verifica -debug e -j nos args restantes
     bool debug = false;
+    unsigned threads = 0;
     for (int i = 2; i < argc; i++) {
         std::string flag = argv[i];
         if (flag == "-debug" || flag == "--debug") {
             debug = true;
         }
+        if (flag == "-j" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
     }
 
-    return mode_run(first_arg, debug);
+    return mode_run(first_arg, debug, threads);
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+// pgo.hpp
+// Perfil de execução para otimização guiada (`jp build -pgo-gerar` /
+// `jp build -pgo-usar arquivo.jpprof`)
+//
+// O programa instrumentado grava, ao sair, um .jpprof em texto com uma
+// linha por ponto contado:
+//
+//   <tipo> <arquivo>:<linha>:<ordinal> <funcao> <contagem1> <contagem2>
+//
+//   funcao   entradas na função             (contagem2 = 0)
+//   se       condição avaliada, verdadeira  (um por ramo com condição)
+//   laco     entradas no laço, iterações    (enquanto / para)
+//   chamada  chamadas feitas naquele ponto  (contagem2 = 0)
+//
+// O ordinal numera os pontos do mesmo tipo na mesma linha, dentro da
+// função. A chave não tem offsets de código, então editar outra parte do
+// fonte não invalida o perfil; pontos que não existem mais são ignorados
+// e pontos novos contam como "sem perfil".
+//
+// Rodar o programa de novo soma as contagens no arquivo existente.
+
+#ifndef JPLANG_PGO_HPP
+#define JPLANG_PGO_HPP
+
+#include <string>
+#include <unordered_map>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <cstdint>
+
+namespace jplang {
+
+struct PerfilPgo {
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> pontos;   // chave → contagens
+    std::unordered_map<std::string, uint64_t> funcoes;                        // símbolo → entradas
+
+    // chave = "<tipo> <arquivo>:<linha>:<ordinal> <funcao>"
+    static std::string chave(const std::string& tipo, const std::string& arquivo,
+                             uint32_t linha, uint32_t ordinal, const std::string& funcao) {
+        return tipo + " " + arquivo + ":" + std::to_string(linha) + ":" +
+               std::to_string(ordinal) + " " + funcao;
+    }
+
+    bool carregar(const std::string& caminho, std::string& erro) {
+        std::ifstream in(caminho);
+        if (!in.is_open()) {
+            erro = "nao foi possivel abrir " + caminho;
+            return false;
+        }
+        std::string linha;
+        size_t n = 0;
+        while (std::getline(in, linha)) {
+            n++;
+            if (linha.empty() || linha[0] == '#') continue;
+            std::istringstream campos(linha);
+            std::string tipo, local, funcao;
+            uint64_t c1 = 0, c2 = 0;
+            if (!(campos >> tipo >> local >> funcao >> c1 >> c2)) {
+                erro = caminho + ":" + std::to_string(n) + ": linha invalida";
+                return false;
+            }
+            auto& p = pontos[tipo + " " + local + " " + funcao];
+            p.first += c1;
+            p.second += c2;
+            if (tipo == "funcao") funcoes[funcao] += c1;
+        }
+        return true;
+    }
+
+    const std::pair<uint64_t, uint64_t>* ponto(const std::string& chave) const {
+        auto it = pontos.find(chave);
+        return it != pontos.end() ? &it->second : nullptr;
+    }
+
+    uint64_t entradas(const std::string& funcao) const {
+        auto it = funcoes.find(funcao);
+        return it != funcoes.end() ? it->second : 0;
+    }
+};
+
+} // namespace jplang
+
+#endif // JPLANG_PGO_HPP
@@ -0,0 +1,107 @@
+// tamanho.hpp
+// Relatório de tamanho do código gerado — jp build arquivo.jp --tamanho
+//
+// O codegen anota, durante a emissão, quantos bytes de .text cada função
+// e cada tipo de construção (instrução, operação de lista, concatenação,
+// diagnóstico FFI...) produziu; no fim soma o uso de .rodata e as
+// relocações do objeto. Serve para achar inchaço de código entre versões
+// e decidir o que vale tirar de linha (runtime/jprt.o).
+
+#ifndef JPLANG_TAMANHO_HPP
+#define JPLANG_TAMANHO_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+namespace jplang {
+
+// ============================================================================
+// REGISTROS
+// ============================================================================
+
+struct TamanhoFuncao {
+    std::string nome;
+    uint64_t bytes;     // corpo + blocos frios anexados no fim
+};
+
+struct RelatorioTamanho {
+    uint64_t texto = 0;                         // .text do objeto principal
+    std::vector<TamanhoFuncao> funcoes;         // em ordem de emissão
+    std::map<std::string, uint64_t> construcoes;   // bytes exclusivos (sem os aninhados)
+
+    uint64_t rodata = 0;
+    uint64_t rodata_textos = 0;                 // literais de texto (add_string)
+    uint64_t rodata_doubles = 0;                // constantes de add_double_constant
+    uint64_t rodata_tabelas = 0;                // tabelas de saltos (se/ou_se)
+
+    std::map<std::string, uint64_t> relocacoes;    // tipo → quantidade
+
+    // ========================================================================
+    // RELATÓRIO TEXTO
+    // ========================================================================
+
+    void relatorio(std::ostream& os) const {
+        os << std::endl << "Tamanho do código:" << std::endl;
+        linha(os, ".text", texto, texto);
+
+        std::vector<const TamanhoFuncao*> fs;
+        for (auto& f : funcoes) fs.push_back(&f);
+        std::stable_sort(fs.begin(), fs.end(),
+                         [](const TamanhoFuncao* a, const TamanhoFuncao* b) {
+                             return a->bytes > b->bytes;
+                         });
+        os << std::endl << "Por função (" << fs.size() << "):" << std::endl;
+        for (auto* f : fs) linha(os, f->nome, f->bytes, texto);
+
+        std::vector<std::pair<std::string, uint64_t>> cs(construcoes.begin(),
+                                                         construcoes.end());
+        uint64_t atribuido = 0;
+        for (auto& [nome, bytes] : cs) atribuido += bytes;
+        if (texto > atribuido) cs.push_back({"(prologo/epilogo e outros)", texto - atribuido});
+        std::stable_sort(cs.begin(), cs.end(), [](const auto& a, const auto& b) {
+            return a.second > b.second;
+        });
+        os << std::endl << "Por construção:" << std::endl;
+        for (auto& [nome, bytes] : cs) {
+            if (bytes) linha(os, nome, bytes, texto);
+        }
+
+        uint64_t conhecido = rodata_textos + rodata_doubles + rodata_tabelas;
+        os << std::endl << ".rodata:" << std::endl;
+        linha(os, "textos", rodata_textos, rodata);
+        linha(os, "doubles", rodata_doubles, rodata);
+        linha(os, "tabelas de saltos", rodata_tabelas, rodata);
+        linha(os, "(alinhamento e outros)", rodata > conhecido ? rodata - conhecido : 0, rodata);
+        linha(os, "total", rodata, rodata);
+
+        uint64_t total = 0;
+        for (auto& [tipo, n] : relocacoes) total += n;
+        os << std::endl << "Relocações: " << total;
+        const char* sep = "   ";
+        for (auto& [tipo, n] : relocacoes) {
+            os << sep << tipo << "=" << n;
+            sep = ", ";
+        }
+        os << std::endl;
+    }
+
+private:
+    static void linha(std::ostream& os, const std::string& nome, uint64_t bytes,
+                      uint64_t total) {
+        char pct[16];
+        std::snprintf(pct, sizeof(pct), "%5.1f%%",
+                      total ? 100.0 * static_cast<double>(bytes) / static_cast<double>(total) : 0.0);
+        os << "  " << std::left << std::setw(32) << nome << std::right
+           << std::setw(10) << bytes << " bytes  " << pct << std::endl;
+    }
+};
+
+} // namespace jplang
+
+#endif // JPLANG_TAMANHO_HPP
@@ -0,0 +1,191 @@
+// tempos.hpp
+// Tempos por fase do compilador — jp build arquivo.jp --tempos[=json]
+//
+// Cada fase (lexing, parsing, pré-análises, emissão, escrita do objeto,
+// toolchain, link) registra tempo de parede e contadores num coletor
+// global. Desligado, o custo é um teste de bool por ponto de medição.
+// A emissão também guarda estatísticas por função (bytes, locais,
+// temporários); no codegen paralelo elas vivem no fragmento e entram no
+// relatório quando ele é juntado, então funções regeradas não contam
+// duas vezes.
+
+#ifndef JPLANG_TEMPOS_HPP
+#define JPLANG_TEMPOS_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+namespace jplang {
+
+// ============================================================================
+// CRONÔMETRO
+// ============================================================================
+
+class Cronometro {
+public:
+    Cronometro() : inicio_(std::chrono::steady_clock::now()) {}
+
+    double ms() const {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - inicio_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point inicio_;
+};
+
+// ============================================================================
+// REGISTROS
+// ============================================================================
+
+struct TempoContador {
+    std::string nome;
+    uint64_t valor;
+};
+
+struct TempoFase {
+    std::string nome;
+    double ms;
+    std::vector<TempoContador> contadores;
+};
+
+struct TempoFuncao {
+    std::string nome;
+    double ms;
+    uint64_t bytes;
+    uint64_t locais;
+    uint64_t temps;    // locais sintetizados pelo codegen (prefixo "__")
+};
+
+// ============================================================================
+// COLETOR
+// ============================================================================
+
+class Tempos {
+public:
+    static Tempos& global() {
+        static Tempos t;
+        return t;
+    }
+
+    bool ativo() const { return ativo_; }
+    void ativar() { ativo_ = true; }
+
+    // Lexing é puxado pelo parser token a token: acumula em vez de fase
+    void token_lido(double ms) { lex_ms_ += ms; tokens_++; }
+    double lex_ms() const { return lex_ms_; }
+    uint64_t tokens() const { return tokens_; }
+
+    void fase(const std::string& nome, double ms,
+              std::vector<TempoContador> contadores = {}) {
+        if (!ativo_) return;
+        fases_.push_back({nome, ms, std::move(contadores)});
+    }
+
+    void funcoes(const std::vector<TempoFuncao>& fs) {
+        if (!ativo_) return;
+        funcoes_.insert(funcoes_.end(), fs.begin(), fs.end());
+    }
+
+    // ========================================================================
+    // RELATÓRIO TEXTO
+    // ========================================================================
+
+    void relatorio(std::ostream& os, double total_ms) const {
+        os << std::endl << "Tempos de compilação:" << std::endl;
+        for (auto& f : fases_) {
+            os << "  " << std::left << std::setw(32) << f.nome << std::right
+               << std::setw(10) << std::fixed << std::setprecision(3) << f.ms << " ms";
+            for (size_t i = 0; i < f.contadores.size(); i++) {
+                os << (i == 0 ? "   " : ", ") << f.contadores[i].nome
+                   << "=" << f.contadores[i].valor;
+            }
+            os << std::endl;
+        }
+        os << "  " << std::left << std::setw(32) << "total" << std::right
+           << std::setw(10) << std::fixed << std::setprecision(3) << total_ms
+           << " ms" << std::endl;
+
+        if (funcoes_.empty()) return;
+        std::vector<const TempoFuncao*> lentas;
+        for (auto& f : funcoes_) lentas.push_back(&f);
+        size_t n = std::min<size_t>(10, lentas.size());
+        std::partial_sort(lentas.begin(), lentas.begin() + n, lentas.end(),
+                          [](const TempoFuncao* a, const TempoFuncao* b) {
+                              return a->ms > b->ms;
+                          });
+        os << std::endl << "Funções mais lentas (" << n << " de "
+           << funcoes_.size() << "):" << std::endl;
+        for (size_t i = 0; i < n; i++) {
+            auto& f = *lentas[i];
+            os << "  " << std::left << std::setw(32) << f.nome << std::right
+               << std::setw(10) << std::fixed << std::setprecision(3) << f.ms << " ms"
+               << "   bytes=" << f.bytes << ", locais=" << f.locais
+               << ", temps=" << f.temps << std::endl;
+        }
+    }
+
+    // ========================================================================
+    // RELATÓRIO JSON (--tempos=json, para CI)
+    // ========================================================================
+
+    void relatorio_json(std::ostream& os, double total_ms) const {
+        os << "{\n  \"total_ms\": " << numero(total_ms) << ",\n  \"fases\": [";
+        for (size_t i = 0; i < fases_.size(); i++) {
+            auto& f = fases_[i];
+            os << (i ? ",\n" : "\n") << "    {\"nome\": " << texto(f.nome)
+               << ", \"ms\": " << numero(f.ms) << ", \"contadores\": {";
+            for (size_t j = 0; j < f.contadores.size(); j++) {
+                os << (j ? ", " : "") << texto(f.contadores[j].nome)
+                   << ": " << f.contadores[j].valor;
+            }
+            os << "}}";
+        }
+        os << "\n  ],\n  \"funcoes\": [";
+        for (size_t i = 0; i < funcoes_.size(); i++) {
+            auto& f = funcoes_[i];
+            os << (i ? ",\n" : "\n") << "    {\"nome\": " << texto(f.nome)
+               << ", \"ms\": " << numero(f.ms) << ", \"bytes\": " << f.bytes
+               << ", \"locais\": " << f.locais << ", \"temps\": " << f.temps << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+private:
+    bool ativo_ = false;
+    double lex_ms_ = 0;
+    uint64_t tokens_ = 0;
+    std::vector<TempoFase> fases_;
+    std::vector<TempoFuncao> funcoes_;
+
+    static std::string numero(double v) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.3f", v);
+        return buf;
+    }
+
+    static std::string texto(const std::string& s) {
+        std::string out = "\"";
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+                continue;
+            }
+            out += c;
+        }
+        return out + "\"";
+    }
+};
+
+} // namespace jplang
+
+#endif // JPLANG_TEMPOS_HPP
@@ -0,0 +1,56 @@
+// gerador.cpp
+// Linha de comando do gerador de programas sintéticos
+//
+//   g++ -std=c++17 -O2 -o gerador testes/bench_compilador/gerador.cpp
+//   ./gerador --funcoes 2000 --classes 50 --stmts 10 -o grande.jp
+
+#include "gerador.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+static void uso() {
+    std::cerr << "Uso: gerador [opcoes] [-o arquivo.jp]" << std::endl;
+    std::cerr << "  --funcoes N       funcoes de topo (padrao 100)" << std::endl;
+    std::cerr << "  --classes N       classes com construtor e metodos (padrao 10)" << std::endl;
+    std::cerr << "  --stmts N         statements por funcao (padrao 8)" << std::endl;
+    std::cerr << "  --profundidade N  profundidade das expressoes (padrao 4)" << std::endl;
+    std::cerr << "  --strings N       literais de texto distintos (padrao 100)" << std::endl;
+    std::cerr << "  --lista N         elementos por lista literal (padrao 8)" << std::endl;
+    std::cerr << "  --semente N       semente do sorteio (padrao 1)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    jpbench::ConfigGerador cfg;
+    std::string saida;
+
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) { uso(); return 1; }
+        int valor = std::atoi(argv[i + 1]);
+        if (flag == "-o")                  saida = argv[++i];
+        else if (flag == "--funcoes")      { cfg.funcoes = valor; i++; }
+        else if (flag == "--classes")      { cfg.classes = valor; i++; }
+        else if (flag == "--stmts")        { cfg.stmts = valor; i++; }
+        else if (flag == "--profundidade") { cfg.profundidade = valor; i++; }
+        else if (flag == "--strings")      { cfg.strings = valor; i++; }
+        else if (flag == "--lista")        { cfg.lista = valor; i++; }
+        else if (flag == "--semente")      { cfg.semente = static_cast<uint32_t>(valor); i++; }
+        else { uso(); return 1; }
+    }
+
+    std::string programa = jpbench::gerar_programa(cfg);
+    if (saida.empty()) {
+        std::cout << programa;
+        return 0;
+    }
+    std::ofstream out(saida, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Erro: Não foi possível criar '" << saida << "'" << std::endl;
+        return 1;
+    }
+    out << programa;
+    return 0;
+}
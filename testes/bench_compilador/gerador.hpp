@@ -0,0 +1,179 @@
+// gerador.hpp
+// Gerador de programas .jp sintéticos para medir o próprio compilador
+//
+// Cada eixo escala uma parte diferente do pipeline: número de funções e
+// classes (declarações, símbolos, pré-análises), statements por função
+// (emissão), profundidade de expressão (inferência de tipo, recursão do
+// parser), literais de texto (pool de strings) e tamanho das listas
+// literais. A saída é determinística para a mesma configuração e semente.
+
+#ifndef JPBENCH_GERADOR_HPP
+#define JPBENCH_GERADOR_HPP
+
+#include <string>
+#include <sstream>
+#include <cstdint>
+
+namespace jpbench {
+
+// ============================================================================
+// CONFIGURAÇÃO
+// ============================================================================
+
+struct ConfigGerador {
+    int funcoes = 100;        // funções de topo
+    int classes = 10;         // classes (construtor + 2 métodos cada)
+    int stmts = 8;            // statements por função
+    int profundidade = 4;     // profundidade das expressões aritméticas
+    int strings = 100;        // literais de texto distintos no programa
+    int lista = 8;            // elementos por lista literal
+    uint32_t semente = 1;
+};
+
+// ============================================================================
+// GERADOR
+// ============================================================================
+
+class Gerador {
+public:
+    explicit Gerador(const ConfigGerador& cfg) : cfg_(cfg), estado_(cfg.semente | 1) {}
+
+    std::string gerar() {
+        gerar_classes();
+        gerar_folhas();
+        for (int i = 0; i < cfg_.funcoes; i++) gerar_funcao(i);
+        gerar_textos_restantes();
+        gerar_main();
+        return out_.str();
+    }
+
+private:
+    static constexpr int FOLHAS = 8;
+
+    ConfigGerador cfg_;
+    uint32_t estado_;
+    int proxima_string_ = 0;
+    std::ostringstream out_;
+
+    // xorshift32: mesma sequência em qualquer plataforma/compilador
+    uint32_t sorteio(uint32_t n) {
+        estado_ ^= estado_ << 13;
+        estado_ ^= estado_ >> 17;
+        estado_ ^= estado_ << 5;
+        return n ? estado_ % n : 0;
+    }
+
+    std::string novo_texto() {
+        int id = proxima_string_++;
+        if (cfg_.strings > 0) id %= cfg_.strings;
+        return "\"texto_" + std::to_string(id) + "\"";
+    }
+
+    std::string folha() {
+        switch (sorteio(3)) {
+            case 0:  return "a";
+            case 1:  return "b";
+            default: return std::to_string(1 + sorteio(99));
+        }
+    }
+
+    // Cadeia aninhada: tamanho linear, profundidade = d
+    std::string expressao(int d) {
+        std::string e = folha();
+        static const char* ops[] = {" + ", " - ", " * "};
+        for (int i = 0; i < d; i++) {
+            e = "(" + e + ops[sorteio(3)] + folha() + ")";
+        }
+        return e;
+    }
+
+    void gerar_classes() {
+        for (int c = 0; c < cfg_.classes; c++) {
+            out_ << "classe Caixa" << c << ":\n"
+                 << "    funcao criar(v, nome):\n"
+                 << "        auto.v = v\n"
+                 << "        auto.nome = nome\n"
+                 << "        retorna auto\n"
+                 << "    funcao dobro():\n"
+                 << "        retorna auto.v * 2\n"
+                 << "    funcao rotulo():\n"
+                 << "        saida(\"Caixa {auto.nome}\")\n\n";
+        }
+    }
+
+    void gerar_folhas() {
+        for (int j = 0; j < FOLHAS; j++) {
+            out_ << "funcao folha" << j << "(a, b):\n"
+                 << "    retorna a + b * " << (j + 1) << "\n\n";
+        }
+    }
+
+    void gerar_funcao(int i) {
+        out_ << "funcao f" << i << "(a, b):\n"
+             << "    r = 0\n";
+        for (int k = 0; k < cfg_.stmts; k++) {
+            switch (sorteio(cfg_.classes > 0 ? 7 : 6)) {
+                case 0:
+                    out_ << "    x" << k << " = " << expressao(cfg_.profundidade) << "\n"
+                         << "    r = r + x" << k << "\n";
+                    break;
+                case 1:
+                    out_ << "    s" << k << " = " << novo_texto() << "\n";
+                    break;
+                case 2:
+                    out_ << "    l" << k << " = [";
+                    for (int e = 0; e < cfg_.lista; e++) {
+                        out_ << (e ? ", " : "") << sorteio(1000);
+                    }
+                    out_ << "]\n"
+                         << "    l" << k << ".adicionar(a)\n";
+                    break;
+                case 3:
+                    out_ << "    se a > " << sorteio(100) << ":\n"
+                         << "        r = r + 1\n"
+                         << "    senao:\n"
+                         << "        r = r - 1\n";
+                    break;
+                case 4:
+                    out_ << "    para k" << k << " em intervalo(0, 3):\n"
+                         << "        r = r + k" << k << "\n";
+                    break;
+                case 5:
+                    out_ << "    r = r + folha" << sorteio(FOLHAS) << "(a, b)\n";
+                    break;
+                default:
+                    out_ << "    o" << k << " = Caixa" << sorteio(cfg_.classes)
+                         << ".criar(a, " << novo_texto() << ")\n"
+                         << "    r = r + o" << k << ".dobro()\n";
+                    break;
+            }
+        }
+        out_ << "    retorna r\n\n";
+    }
+
+    // Garante `strings` literais distintos mesmo com poucos statements
+    void gerar_textos_restantes() {
+        if (proxima_string_ >= cfg_.strings) return;
+        out_ << "funcao textos():\n";
+        while (proxima_string_ < cfg_.strings) {
+            out_ << "    t = " << novo_texto() << "\n";
+        }
+        out_ << "    retorna 0\n\n";
+    }
+
+    void gerar_main() {
+        out_ << "total = 0\n";
+        for (int i = 0; i < cfg_.funcoes; i++) {
+            out_ << "total = total + f" << i << "(" << (i % 10) << ", 2)\n";
+        }
+        out_ << "saida(total)\n";
+    }
+};
+
+inline std::string gerar_programa(const ConfigGerador& cfg) {
+    return Gerador(cfg).gerar();
+}
+
+} // namespace jpbench
+
+#endif // JPBENCH_GERADOR_HPP
@@ -0,0 +1,310 @@
+// medir.cpp
+// Benchmark de vazão do compilador: gera os casos sintéticos, compila cada
+// um N vezes e compara tempo, pico de memória e tamanho do objeto com a
+// baseline gravada
+//
+//   linux:   g++ -std=c++17 -O2 -o medir testes/bench_compilador/medir.cpp
+//   windows: g++ -std=c++17 -O2 -o medir.exe testes/bench_compilador/medir.cpp -lpsapi
+//
+//   ./medir --jp ./jp                 compara com baseline.txt
+//   ./medir --jp ./jp --gravar        regrava baseline.txt com os valores atuais
+//
+// Sai com código 1 se algum caso passar do limite de regressão. Tempo e
+// memória dependem da máquina: grave a baseline na mesma máquina que vai
+// comparar (a do CI). O tamanho do objeto é determinístico.
+
+#include "gerador.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <cstdlib>
+#include <cstdint>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+    #define JP_OBJ_EXT ".obj"
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/wait.h>
+    #include <sys/resource.h>
+    #define JP_OBJ_EXT ".o"
+#endif
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// CASOS
+// Cada caso força um eixo do gerador; os demais ficam pequenos
+// ============================================================================
+
+struct Caso {
+    const char* nome;
+    jpbench::ConfigGerador cfg;
+};
+
+static std::vector<Caso> casos_padrao() {
+    auto cfg = [](int funcoes, int classes, int stmts, int prof, int strings, int lista) {
+        jpbench::ConfigGerador c;
+        c.funcoes = funcoes;
+        c.classes = classes;
+        c.stmts = stmts;
+        c.profundidade = prof;
+        c.strings = strings;
+        c.lista = lista;
+        return c;
+    };
+    return {
+        {"funcoes",      cfg(3000,   0,   6,   3,   200,    4)},
+        {"classes",      cfg( 300, 400,   6,   3,   200,    4)},
+        {"stmts",        cfg(  40,   5, 600,   3,   200,    4)},
+        {"profundidade", cfg(  40,   0,  20, 400,    50,    4)},
+        {"strings",      cfg(  50,   0,  10,   2, 30000,    4)},
+        {"listas",       cfg(  50,   0,  10,   2,   100, 2000)},
+        {"misto",        cfg(1000,  50,  12,   8,  3000,   16)},
+    };
+}
+
+// ============================================================================
+// EXECUÇÃO DO COMPILADOR
+// ============================================================================
+
+struct Medida {
+    double tempo_ms = 0;
+    uint64_t rss_kb = 0;
+    uint64_t objeto_bytes = 0;
+};
+
+// Roda `jp build arquivo.jp --sem-cache -j 1` em `dir`; false se falhar
+static bool executar(const std::string& jp, const std::string& dir,
+                     const std::string& arquivo, double& tempo_ms, uint64_t& rss_kb) {
+    auto inicio = std::chrono::steady_clock::now();
+    #ifdef _WIN32
+    std::string cmd = "\"" + jp + "\" build " + arquivo + " --sem-cache -j 1";
+    SECURITY_ATTRIBUTES sa = {sizeof(sa), NULL, TRUE};
+    HANDLE nul = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_WRITE, &sa,
+                             OPEN_EXISTING, 0, NULL);
+    STARTUPINFOA si = {};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdOutput = nul;
+    si.hStdError = nul;
+    PROCESS_INFORMATION pi = {};
+    std::vector<char> linha(cmd.begin(), cmd.end());
+    linha.push_back(0);
+    if (!CreateProcessA(NULL, linha.data(), NULL, NULL, TRUE, 0, NULL,
+                        dir.c_str(), &si, &pi)) {
+        CloseHandle(nul);
+        return false;
+    }
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    DWORD codigo = 1;
+    GetExitCodeProcess(pi.hProcess, &codigo);
+    PROCESS_MEMORY_COUNTERS pmc = {};
+    GetProcessMemoryInfo(pi.hProcess, &pmc, sizeof(pmc));
+    rss_kb = pmc.PeakWorkingSetSize / 1024;
+    CloseHandle(pi.hProcess);
+    CloseHandle(pi.hThread);
+    CloseHandle(nul);
+    bool ok = codigo == 0;
+    #else
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        int nul = open("/dev/null", O_WRONLY);
+        if (nul >= 0) { dup2(nul, 1); dup2(nul, 2); }
+        if (chdir(dir.c_str()) != 0) _exit(127);
+        execl(jp.c_str(), jp.c_str(), "build", arquivo.c_str(),
+              "--sem-cache", "-j", "1", static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage uso;
+    if (wait4(pid, &status, 0, &uso) < 0) return false;
+    rss_kb = static_cast<uint64_t>(uso.ru_maxrss);   // KB no Linux
+    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    #endif
+    tempo_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - inicio).count();
+    return ok;
+}
+
+static bool medir_caso(const std::string& jp, const fs::path& dir, const Caso& caso,
+                       int repeticoes, Medida& m) {
+    std::string arquivo = std::string(caso.nome) + ".jp";
+    {
+        std::ofstream out(dir / arquivo, std::ios::binary);
+        out << jpbench::gerar_programa(caso.cfg);
+    }
+
+    std::vector<double> tempos;
+    std::vector<uint64_t> rss;
+    for (int r = 0; r < repeticoes; r++) {
+        double t = 0;
+        uint64_t kb = 0;
+        if (!executar(jp, dir.string(), arquivo, t, kb)) {
+            std::cerr << "Erro: falha ao compilar o caso '" << caso.nome << "'" << std::endl;
+            return false;
+        }
+        tempos.push_back(t);
+        rss.push_back(kb);
+    }
+    std::sort(tempos.begin(), tempos.end());
+    std::sort(rss.begin(), rss.end());
+    m.tempo_ms = tempos[tempos.size() / 2];
+    m.rss_kb = rss[rss.size() / 2];
+
+    std::error_code ec;
+    fs::path obj = dir / "output" / caso.nome / (std::string(caso.nome) + JP_OBJ_EXT);
+    m.objeto_bytes = fs::file_size(obj, ec);
+    if (ec) m.objeto_bytes = 0;
+    return true;
+}
+
+// ============================================================================
+// BASELINE
+// Uma linha por caso: nome tempo_ms rss_kb objeto_bytes
+// ============================================================================
+
+static std::map<std::string, Medida> ler_baseline(const std::string& path) {
+    std::map<std::string, Medida> base;
+    std::ifstream in(path);
+    std::string linha;
+    while (std::getline(in, linha)) {
+        if (linha.empty() || linha[0] == '#') continue;
+        std::istringstream ss(linha);
+        std::string nome;
+        Medida m;
+        if (ss >> nome >> m.tempo_ms >> m.rss_kb >> m.objeto_bytes) base[nome] = m;
+    }
+    return base;
+}
+
+static bool gravar_baseline(const std::string& path,
+                            const std::vector<std::pair<std::string, Medida>>& medidas) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    out << "# baseline do bench_compilador (gerada por medir --gravar)\n"
+        << "# caso tempo_ms rss_kb objeto_bytes\n";
+    for (auto& [nome, m] : medidas) {
+        out << nome << " " << std::fixed << std::setprecision(1) << m.tempo_ms
+            << " " << m.rss_kb << " " << m.objeto_bytes << "\n";
+    }
+    return true;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void uso() {
+    std::cerr << "Uso: medir --jp <compilador> [opcoes]" << std::endl;
+    std::cerr << "  --repeticoes N      compilacoes por caso; usa a mediana (padrao 5)" << std::endl;
+    std::cerr << "  --baseline ARQ      arquivo de baseline (padrao: baseline.txt ao lado deste fonte)" << std::endl;
+    std::cerr << "  --gravar            regrava a baseline com os valores medidos" << std::endl;
+    std::cerr << "  --casos a,b,...     roda so os casos listados" << std::endl;
+    std::cerr << "  --limite-tempo P    regressao de tempo tolerada em % (padrao 15)" << std::endl;
+    std::cerr << "  --limite-rss P      regressao de memoria tolerada em % (padrao 10)" << std::endl;
+    std::cerr << "  --limite-objeto P   crescimento do objeto tolerado em % (padrao 0)" << std::endl;
+}
+
+static double variacao(double atual, double base) {
+    return base > 0 ? (atual - base) * 100.0 / base : 0.0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string jp;
+    std::string baseline = (fs::path(__FILE__).parent_path() / "baseline.txt").string();
+    std::string filtro;
+    int repeticoes = 5;
+    bool gravar = false;
+    double limite_tempo = 15, limite_rss = 10, limite_objeto = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        bool tem_valor = i + 1 < argc;
+        if (flag == "--gravar")                           gravar = true;
+        else if (flag == "--jp" && tem_valor)             jp = argv[++i];
+        else if (flag == "--repeticoes" && tem_valor)     repeticoes = std::max(1, std::atoi(argv[++i]));
+        else if (flag == "--baseline" && tem_valor)       baseline = argv[++i];
+        else if (flag == "--casos" && tem_valor)          filtro = "," + std::string(argv[++i]) + ",";
+        else if (flag == "--limite-tempo" && tem_valor)   limite_tempo = std::atof(argv[++i]);
+        else if (flag == "--limite-rss" && tem_valor)     limite_rss = std::atof(argv[++i]);
+        else if (flag == "--limite-objeto" && tem_valor)  limite_objeto = std::atof(argv[++i]);
+        else { uso(); return 1; }
+    }
+    if (jp.empty()) { uso(); return 1; }
+    jp = fs::absolute(jp).string();
+
+    fs::path dir = fs::absolute("_bench_compilador");
+    fs::create_directories(dir);
+
+    auto base = ler_baseline(baseline);
+    std::vector<std::pair<std::string, Medida>> medidas;
+    bool regressao = false;
+
+    std::cout << std::left << std::setw(14) << "caso" << std::right
+              << std::setw(12) << "tempo ms" << std::setw(9) << "var%"
+              << std::setw(12) << "rss KB" << std::setw(9) << "var%"
+              << std::setw(12) << "objeto" << std::setw(9) << "var%" << std::endl;
+
+    for (auto& caso : casos_padrao()) {
+        if (!filtro.empty() && filtro.find("," + std::string(caso.nome) + ",") == std::string::npos)
+            continue;
+        Medida m;
+        if (!medir_caso(jp, dir, caso, repeticoes, m)) return 1;
+        medidas.push_back({caso.nome, m});
+
+        std::cout << std::left << std::setw(14) << caso.nome << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << m.tempo_ms;
+        auto it = base.find(caso.nome);
+        if (it == base.end()) {
+            std::cout << std::setw(9) << "-" << std::setw(12) << m.rss_kb << std::setw(9) << "-"
+                      << std::setw(12) << m.objeto_bytes << std::setw(9) << "-"
+                      << "   (sem baseline)" << std::endl;
+            continue;
+        }
+        const Medida& b = it->second;
+        double dt = variacao(m.tempo_ms, b.tempo_ms);
+        double dr = variacao(static_cast<double>(m.rss_kb), static_cast<double>(b.rss_kb));
+        double dobj = variacao(static_cast<double>(m.objeto_bytes), static_cast<double>(b.objeto_bytes));
+        std::cout << std::setw(9) << dt << std::setw(12) << m.rss_kb << std::setw(9) << dr
+                  << std::setw(12) << m.objeto_bytes << std::setw(9) << dobj;
+        std::vector<std::string> falhas;
+        if (dt > limite_tempo)    falhas.push_back("tempo");
+        if (dr > limite_rss)      falhas.push_back("rss");
+        if (dobj > limite_objeto) falhas.push_back("objeto");
+        if (!falhas.empty()) {
+            regressao = true;
+            std::cout << "   REGRESSAO:";
+            for (auto& f : falhas) std::cout << " " << f;
+        }
+        std::cout << std::endl;
+    }
+
+    if (gravar) {
+        // Com --casos, os casos não medidos mantêm a linha antiga
+        for (auto& [nome, b] : base) {
+            bool medido = std::any_of(medidas.begin(), medidas.end(),
+                                      [&](const auto& p) { return p.first == nome; });
+            if (!medido) medidas.push_back({nome, b});
+        }
+        if (!gravar_baseline(baseline, medidas)) {
+            std::cerr << "Erro: Não foi possível gravar '" << baseline << "'" << std::endl;
+            return 1;
+        }
+        std::cout << "Baseline gravada: " << baseline << std::endl;
+        return 0;
+    }
+    return regressao ? 1 : 0;
+}
@@ -0,0 +1,14 @@
+/* Matemática de ponto flutuante — referência C de decimal.jp */
+#include <stdio.h>
+
+int main(void) {
+    double h = 0.0, pi = 0.0, sinal = 1.0;
+    for (long long i = 1; i <= 5000000; i++) {
+        h = h + 1.0 / (double)i;
+        pi = pi + sinal * 4.0 / (double)(2 * i - 1);
+        sinal = 0.0 - sinal;
+    }
+    printf("%g\n", h);
+    printf("%g\n", pi);
+    return 0;
+}
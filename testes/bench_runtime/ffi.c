@@ -0,0 +1,22 @@
+/* Chamadas FFI — referência C de ffi.jp, ligada aos mesmos objetos de
+   bibliotecas/texto e bibliotecas/hash */
+#include <stdio.h>
+#include <stdint.h>
+
+const char* hash_sha256(const char* texto);
+const char* txt_upper(const char* texto);
+int64_t txt_tamanho(const char* texto);
+
+int main(void) {
+    long long total = 0;
+    const char* h = "";
+    for (long long i = 0; i < 20000; i++) {
+        char m[64];
+        snprintf(m, sizeof(m), "jp %lld", i);
+        h = hash_sha256(m);
+        total += txt_tamanho(txt_upper(h));
+    }
+    printf("%lld\n", total);
+    printf("%s\n", h);
+    return 0;
+}
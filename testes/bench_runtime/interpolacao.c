@@ -0,0 +1,12 @@
+/* Interpolação de texto: "{expr}" dentro de saida — referência C de interpolacao.jp */
+#include <stdio.h>
+
+int main(void) {
+    long long n = 200000;
+    const char* nome = "item";
+    for (long long i = 0; i < n; i++) {
+        double p = (double)i * 0.25 + 1;
+        printf("%s %lld de %lld: %g [%lld]\n", nome, i, n, p, i + 1);
+    }
+    return 0;
+}
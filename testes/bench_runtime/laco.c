@@ -0,0 +1,13 @@
+/* Laços aninhados com aritmética inteira — referência C de laco.jp */
+#include <stdio.h>
+
+int main(void) {
+    long long total = 0;
+    for (long long i = 0; i < 3000; i++) {
+        for (long long j = 0; j < 3000; j++) {
+            total += (i * j + i - j) % 7;
+        }
+    }
+    printf("%lld\n", total);
+    return 0;
+}
@@ -0,0 +1,28 @@
+/* Listas — referência C de listas.jp (vetor dinâmico com realloc) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(void) {
+    long long cap = 8, count = 0;
+    long long* l = malloc(cap * sizeof(long long));
+    for (long long i = 0; i < 1000000; i++) {
+        if (count == cap) {
+            cap *= 2;
+            l = realloc(l, cap * sizeof(long long));
+        }
+        l[count++] = i;
+    }
+    long long soma = 0;
+    for (long long i = 0; i < 1000000; i++) soma += l[i] % 1000;
+    for (int i = 0; i < 1000; i++) count--;
+    for (int i = 0; i < 100; i++) {
+        memmove(l, l + 1, (size_t)(count - 1) * sizeof(long long));
+        count--;
+    }
+    printf("%lld\n", soma);
+    printf("%lld\n", count);
+    printf("%lld\n", l[0]);
+    free(l);
+    return 0;
+}
@@ -0,0 +1,30 @@
+/* Objetos — referência C de objetos.jp */
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct { long long x, y; } Ponto;
+
+static Ponto* ponto_criar(long long x, long long y) {
+    Ponto* p = malloc(sizeof(Ponto));
+    p->x = x;
+    p->y = y;
+    return p;
+}
+
+static long long ponto_soma(Ponto* p) { return p->x + p->y; }
+
+static long long ponto_escala(Ponto* p, long long k) {
+    p->x = p->x * k;
+    return p->x;
+}
+
+int main(void) {
+    long long total = 0;
+    for (long long i = 0; i < 1000000; i++) {
+        Ponto* p = ponto_criar(i % 100, 2);
+        total = total + ponto_soma(p) + ponto_escala(p, 3);
+        free(p);
+    }
+    printf("%lld\n", total);
+    return 0;
+}
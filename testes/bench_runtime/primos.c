@@ -0,0 +1,18 @@
+/* Primos por divisão de tentativa — referência C de primos.jp */
+#include <stdio.h>
+
+int main(void) {
+    long long total = 0;
+    for (long long n = 2; n < 2000000; n++) {
+        int primo = 1;
+        for (long long d = 2; d * d <= n; d++) {
+            if (n % d == 0) {
+                primo = 0;
+                break;
+            }
+        }
+        if (primo) total++;
+    }
+    printf("%lld\n", total);
+    return 0;
+}
@@ -0,0 +1,214 @@
+// rodar.cpp
+// Benchmark de desempenho em tempo de execução: cada kernel .jp tem um
+// equivalente em C escrito à mão. Compila os dois, executa cada um N
+// vezes, confere se a saída é idêntica e mostra a mediana e a razão JP/C
+//
+//   linux:   g++ -std=c++17 -O2 -o rodar testes/bench_runtime/rodar.cpp
+//   windows: g++ -std=c++17 -O2 -o rodar.exe testes/bench_runtime/rodar.cpp
+//
+//   ./rodar --jp ./jp                      todos os kernels, 5 execuções
+//   ./rodar --jp ./jp --kernels primos,ffi --repeticoes 10
+//
+// O jp precisa estar ao lado de bibliotecas/ (o kernel ffi importa texto
+// e hash; a referência C liga os mesmos objetos). Sai com código 1 se
+// algum kernel não compilar ou se as saídas divergirem.
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+    #define popen _popen
+    #define pclose _pclose
+    #define JP_LIB_EXT ".obj"
+    #define JP_EXE_EXT ".exe"
+#else
+    #define JP_LIB_EXT ".o"
+    #define JP_EXE_EXT ""
+#endif
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+
+struct Kernel {
+    const char* nome;
+    std::vector<std::string> bibliotecas;   // objetos ligados à referência C
+};
+
+static const std::vector<Kernel> KERNELS = {
+    {"primos",  {}},
+    {"laco",    {}},
+    {"decimal", {}},
+    {"textos",  {}},
+    {"interpolacao", {}},
+    {"listas",  {}},
+    {"objetos", {}},
+    {"ffi",     {"texto", "hash"}},
+};
+
+// ============================================================================
+// PROCESSOS
+// ============================================================================
+
+static std::string aspas(const std::string& s) { return "\"" + s + "\""; }
+
+// Executa `cmd` e devolve a saída padrão; false se o código de saída != 0
+static bool capturar(const std::string& cmd, std::string& saida) {
+    saida.clear();
+    FILE* p = popen(cmd.c_str(), "r");
+    if (!p) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), p)) > 0) saida.append(buf, n);
+    return pclose(p) == 0;
+}
+
+struct Medida {
+    double mediana_ms = 0;
+    std::string saida;
+    bool ok = false;
+};
+
+static Medida medir(const std::string& cmd, int repeticoes) {
+    Medida m;
+    std::vector<double> tempos;
+    for (int r = 0; r < repeticoes; r++) {
+        std::string saida;
+        auto inicio = std::chrono::steady_clock::now();
+        bool ok = capturar(cmd, saida);
+        tempos.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - inicio).count());
+        if (!ok || (r > 0 && saida != m.saida)) return m;
+        m.saida = saida;
+    }
+    std::sort(tempos.begin(), tempos.end());
+    m.mediana_ms = tempos[tempos.size() / 2];
+    m.ok = true;
+    return m;
+}
+
+// ============================================================================
+// COMPILAÇÃO
+// ============================================================================
+
+static bool compilar_jp(const std::string& jp, const fs::path& fonte, const fs::path& dir,
+                        fs::path& exe) {
+    std::string nome = fonte.stem().string();
+    fs::copy_file(fonte, dir / fonte.filename(), fs::copy_options::overwrite_existing);
+    std::string cmd = "cd " + aspas(dir.string()) + " && " + aspas(jp) + " build " +
+                      fonte.filename().string() + " --sem-cache";
+    std::string log;
+    if (!capturar(cmd + " 2>&1", log)) {
+        std::cerr << log;
+        return false;
+    }
+    exe = dir / "output" / nome / (nome + JP_EXE_EXT);
+    return true;
+}
+
+static bool compilar_c(const std::string& cc, const fs::path& fonte, const fs::path& dir,
+                       const fs::path& raiz, const Kernel& k, fs::path& exe) {
+    exe = dir / (fonte.stem().string() + "_c" + JP_EXE_EXT);
+    std::string cmd = aspas(cc) + " -O2 -o " + aspas(exe.string()) + " " + aspas(fonte.string());
+    for (auto& lib : k.bibliotecas) {
+        cmd += " " + aspas((raiz / "bibliotecas" / lib / (lib + JP_LIB_EXT)).string());
+    }
+    if (!k.bibliotecas.empty()) cmd += " -lstdc++";
+    cmd += " -lm";
+    std::string log;
+    if (!capturar(cmd + " 2>&1", log)) {
+        std::cerr << log;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void uso() {
+    std::cerr << "Uso: rodar --jp <compilador> [opcoes]" << std::endl;
+    std::cerr << "  --cc CMD          compilador C das referencias (padrao: $CC ou cc)" << std::endl;
+    std::cerr << "  --repeticoes N    execucoes por programa; usa a mediana (padrao 5)" << std::endl;
+    std::cerr << "  --kernels a,b     roda so os kernels listados" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string jp;
+    const char* cc_env = std::getenv("CC");
+    std::string cc = cc_env ? cc_env : "cc";
+    std::string filtro;
+    int repeticoes = 5;
+
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        bool tem_valor = i + 1 < argc;
+        if (flag == "--jp" && tem_valor)               jp = argv[++i];
+        else if (flag == "--cc" && tem_valor)          cc = argv[++i];
+        else if (flag == "--repeticoes" && tem_valor)  repeticoes = std::max(1, std::atoi(argv[++i]));
+        else if (flag == "--kernels" && tem_valor)     filtro = "," + std::string(argv[++i]) + ",";
+        else { uso(); return 1; }
+    }
+    if (jp.empty()) { uso(); return 1; }
+    jp = fs::absolute(jp).string();
+
+    // Fontes: ao lado do jp (raiz do repositório) ou relativos a este arquivo
+    fs::path raiz = fs::path(jp).parent_path();
+    fs::path fontes = raiz / "testes" / "bench_runtime";
+    if (!fs::exists(fontes)) fontes = fs::absolute(fs::path(__FILE__).parent_path());
+    fs::path dir = fs::absolute("_bench_runtime");
+    fs::create_directories(dir);
+
+    std::cout << std::left << std::setw(14) << "kernel" << std::right
+              << std::setw(12) << "jp ms" << std::setw(12) << "c ms"
+              << std::setw(10) << "jp/c" << std::endl;
+
+    bool falhou = false;
+    for (auto& k : KERNELS) {
+        if (!filtro.empty() && filtro.find("," + std::string(k.nome) + ",") == std::string::npos)
+            continue;
+        std::cout << std::left << std::setw(14) << k.nome << std::right << std::flush;
+
+        fs::path exe_jp, exe_c;
+        if (!compilar_jp(jp, fontes / (std::string(k.nome) + ".jp"), dir, exe_jp)) {
+            std::cout << "   ERRO: falha ao compilar o .jp" << std::endl;
+            falhou = true;
+            continue;
+        }
+        if (!compilar_c(cc, fontes / (std::string(k.nome) + ".c"), dir, raiz, k, exe_c)) {
+            std::cout << "   ERRO: falha ao compilar o .c" << std::endl;
+            falhou = true;
+            continue;
+        }
+
+        Medida mj = medir(aspas(exe_jp.string()), repeticoes);
+        Medida mc = medir(aspas(exe_c.string()), repeticoes);
+        if (!mj.ok || !mc.ok) {
+            std::cout << "   ERRO: execucao falhou ou saida instavel" << std::endl;
+            falhou = true;
+            continue;
+        }
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(12) << mj.mediana_ms << std::setw(12) << mc.mediana_ms
+                  << std::setprecision(2) << std::setw(10)
+                  << (mc.mediana_ms > 0 ? mj.mediana_ms / mc.mediana_ms : 0.0);
+        if (mj.saida != mc.saida) {
+            std::cout << "   SAIDA DIFERENTE";
+            falhou = true;
+        }
+        std::cout << std::endl;
+    }
+    return falhou ? 1 : 0;
+}
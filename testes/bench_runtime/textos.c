@@ -0,0 +1,22 @@
+/* Construção de texto: conversão e concatenação — referência C de textos.jp */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(void) {
+    long long n = 300000;
+    char* c = NULL;
+    for (long long i = 0; i < n; i++) {
+        char m[64];
+        int len = snprintf(m, sizeof(m), "item %lld de %lld", i, n);
+        free(c);
+        c = malloc((size_t)len + 3);
+        c[0] = '[';
+        memcpy(c + 1, m, (size_t)len);
+        c[len + 1] = ']';
+        c[len + 2] = 0;
+    }
+    printf("%s\n", c);
+    free(c);
+    return 0;
+}